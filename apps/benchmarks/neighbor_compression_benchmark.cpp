@@ -0,0 +1,163 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file neighbor_compression_benchmark.cpp
+   \brief Benchmark of the MTLED forces kernel with plain and compressed neighbor indices storage.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/support_domain/cell_list_search.hpp"
+#include "CLOUDEA/engine/support_domain/compressed_neighbor_list.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/timer.hpp"
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// Accumulate the forces of the integration points in [start, end) with the gather-scatter pattern of the MTLED forces kernel.
+template <typename NEIGHBORS_T>
+void ForcesKernel(const NEIGHBORS_T &neighbor_ids, const std::vector<Eigen::MatrixXd> &deriv_mats,
+                  const Eigen::MatrixXd &disp, std::size_t start, std::size_t end, Eigen::MatrixXd &forces)
+{
+    forces.setZero();
+    for (std::size_t ip = start; ip != end; ++ip) {
+        auto support_size = static_cast<Eigen::Index>(neighbor_ids.ListSize(ip));
+        Eigen::MatrixXd disp_local(support_size, 3);
+        neighbor_ids.ForEach(ip, [&](std::size_t id, int neigh_id) { disp_local.row(id) = disp.row(neigh_id); });
+
+        // Linear elastic surrogate of the material response.
+        Eigen::Matrix3d FT = deriv_mats[ip].transpose() * disp_local;
+        FT += Eigen::Matrix3d::Identity();
+        Eigen::Matrix3d stress = 0.5*(FT.transpose()*FT - Eigen::Matrix3d::Identity());
+        Eigen::MatrixXd forces_local = deriv_mats[ip] * stress.transpose() * FT;
+
+        neighbor_ids.ForEach(ip, [&](std::size_t id, int neigh_id) { forces.row(neigh_id) += forces_local.row(id); });
+    }
+}
+
+
+// Run explicit steps of the forces kernel and return the steps per second.
+template <typename NEIGHBORS_T>
+double StepsPerSec(const NEIGHBORS_T &neighbor_ids, const std::vector<Eigen::MatrixXd> &deriv_mats,
+                   std::size_t nodes_num, std::size_t threads_num, int steps_num, Eigen::MatrixXd &forces)
+{
+    Eigen::MatrixXd disp = Eigen::MatrixXd::Constant(static_cast<Eigen::Index>(nodes_num), 3, 1.e-3);
+    std::vector<Eigen::MatrixXd> thread_forces(threads_num, Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(nodes_num), 3));
+    std::size_t chunk = (neighbor_ids.ListsNum() + threads_num - 1) / threads_num;
+
+    Timer timer;
+    for (int step = 0; step != steps_num; ++step) {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t != threads_num; ++t) {
+            std::size_t start = std::min(t*chunk, neighbor_ids.ListsNum());
+            std::size_t end = std::min(start+chunk, neighbor_ids.ListsNum());
+            threads.emplace_back(std::thread(&ForcesKernel<NEIGHBORS_T>, std::cref(neighbor_ids), std::cref(deriv_mats),
+                                             std::cref(disp), start, end, std::ref(thread_forces[t])));
+        }
+        std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+        forces.setZero(static_cast<Eigen::Index>(nodes_num), 3);
+        for (const auto &f : thread_forces) { forces += f; }
+        disp -= 1.e-6*forces;
+    }
+    return steps_num / timer.ElapsedSecs();
+}
+
+
+int main(int argc, char *argv[])
+{
+    try {
+        // Read the number of nodes per side, the number of steps and the number of threads.
+        std::size_t side_num = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 40;
+        int steps_num = argc > 2 ? std::atoi(argv[2]) : 20;
+        std::size_t threads_num = argc > 3 ? static_cast<std::size_t>(std::atoi(argv[3])) : std::thread::hardware_concurrency();
+        if (side_num < 2) { side_num = 2; }
+        if (steps_num < 1) { steps_num = 1; }
+        if (threads_num < 1) { threads_num = 1; }
+
+        // Generate spatially ordered nodes on a jittered lattice.
+        double h = 1. / static_cast<double>(side_num-1);
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> jitter(-0.2*h, 0.2*h);
+        std::vector<Vec3<double> > nodes;
+        nodes.reserve(side_num*side_num*side_num);
+        for (std::size_t k = 0; k != side_num; ++k) {
+            for (std::size_t j = 0; j != side_num; ++j) {
+                for (std::size_t i = 0; i != side_num; ++i) {
+                    nodes.emplace_back(Vec3<double>(i*h + jitter(generator), j*h + jitter(generator), k*h + jitter(generator)));
+                }
+            }
+        }
+
+        // Support domains of the nodes used as integration points.
+        CellListSearch<3> cell_list;
+        cell_list.SetSpheres(nodes, std::vector<double>(nodes.size(), 2.2*h));
+        NeighborList neighbor_ids = cell_list.ContainingSpheresIds(nodes);
+        CompressedNeighborList compressed_ids(neighbor_ids);
+
+        if (compressed_ids.Decompress() != neighbor_ids) {
+            std::cerr << Logger::Error("Decompressed neighbor lists differ from the original neighbor lists.") << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Random shape function derivatives.
+        std::vector<Eigen::MatrixXd> deriv_mats;
+        deriv_mats.reserve(neighbor_ids.ListsNum());
+        for (std::size_t ip = 0; ip != neighbor_ids.ListsNum(); ++ip) {
+            deriv_mats.emplace_back(Eigen::MatrixXd::Random(static_cast<Eigen::Index>(neighbor_ids.ListSize(ip)), 3));
+        }
+
+        std::cout << Logger::Message("Neighbor compression benchmark: ") << nodes.size() << " nodes, "
+                  << neighbor_ids.IdsNum() << " neighbors, " << threads_num << " threads\n";
+        std::cout << Logger::Message("Neighbor indices memory | Plain: ") << neighbor_ids.MemoryBytes()/1024 << " KB"
+                  << " | Compressed: " << compressed_ids.MemoryBytes()/1024 << " KB, "
+                  << compressed_ids.CompressedListsNum() << "/" << compressed_ids.ListsNum() << " points with 16-bit offsets\n";
+
+        Eigen::MatrixXd plain_forces, compressed_forces;
+        double plain_rate = StepsPerSec(neighbor_ids, deriv_mats, nodes.size(), threads_num, steps_num, plain_forces);
+        double compressed_rate = StepsPerSec(compressed_ids, deriv_mats, nodes.size(), threads_num, steps_num, compressed_forces);
+
+        std::cout << Logger::Message("Forces kernel | Plain: ") << plain_rate << " steps/s"
+                  << " | Compressed: " << compressed_rate << " steps/s"
+                  << " | Identical: " << std::boolalpha << (plain_forces == compressed_forces) << "\n";
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
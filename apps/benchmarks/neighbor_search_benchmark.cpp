@@ -0,0 +1,170 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file neighbor_search_benchmark.cpp
+   \brief Benchmark of the CGAL kd-tree and the cell list variable-radius neighbor search.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/elements/node.hpp"
+#include "CLOUDEA/engine/elements/tetrahedron.hpp"
+#include "CLOUDEA/engine/support_domain/inf_support_domain.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/timer.hpp"
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// Generate a jittered structured tetrahedral mesh of the unit cube with cells_num cubes per side.
+void GenerateMesh(std::size_t cells_num, std::vector<Node> &nodes, std::vector<Tetrahedron> &tetras)
+{
+    std::size_t n = cells_num + 1;
+    double h = 1. / static_cast<double>(cells_num);
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> jitter(-0.2*h, 0.2*h);
+
+    nodes.clear();
+    nodes.reserve(n*n*n);
+    for (std::size_t k = 0; k != n; ++k) {
+        for (std::size_t j = 0; j != n; ++j) {
+            for (std::size_t i = 0; i != n; ++i) {
+                // Jitter only the interior nodes.
+                bool interior = i > 0 && j > 0 && k > 0 && i < cells_num && j < cells_num && k < cells_num;
+                double dx = interior ? jitter(generator) : 0.;
+                double dy = interior ? jitter(generator) : 0.;
+                double dz = interior ? jitter(generator) : 0.;
+
+                Node node;
+                node.SetId(static_cast<int>(nodes.size()));
+                node.SetCoordinates(i*h + dx, j*h + dy, k*h + dz);
+                nodes.emplace_back(node);
+            }
+        }
+    }
+
+    // Split each cube in six tetrahedra sharing the main diagonal.
+    auto id = [n](std::size_t i, std::size_t j, std::size_t k) { return static_cast<int>(i + n*(j + n*k)); };
+    tetras.clear();
+    tetras.reserve(6*cells_num*cells_num*cells_num);
+    for (std::size_t k = 0; k != cells_num; ++k) {
+        for (std::size_t j = 0; j != cells_num; ++j) {
+            for (std::size_t i = 0; i != cells_num; ++i) {
+                int v[8] = {id(i,j,k), id(i+1,j,k), id(i+1,j+1,k), id(i,j+1,k),
+                            id(i,j,k+1), id(i+1,j,k+1), id(i+1,j+1,k+1), id(i,j+1,k+1)};
+                const int conn[6][4] = {{0,1,2,6}, {0,2,3,6}, {0,3,7,6}, {0,7,4,6}, {0,4,5,6}, {0,5,1,6}};
+                for (const auto &c : conn) {
+                    Tetrahedron tetra;
+                    tetra.SetId(static_cast<int>(tetras.size()));
+                    tetra.SetConnectivity(v[c[0]], v[c[1]], v[c[2]], v[c[3]]);
+                    tetras.emplace_back(tetra);
+                }
+            }
+        }
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    try {
+        // Read the number of cubes per side and the maximum number of threads.
+        std::size_t cells_num = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 30;
+        std::size_t max_threads = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+        if (cells_num < 1) { cells_num = 1; }
+        if (max_threads < 1) { max_threads = 1; }
+
+        std::vector<Node> nodes;
+        std::vector<Tetrahedron> tetras;
+        GenerateMesh(cells_num, nodes, tetras);
+
+        std::vector<Vec3<double> > eval_coords;
+        eval_coords.reserve(nodes.size());
+        for (const auto &node : nodes) { eval_coords.emplace_back(node.Coordinates()); }
+
+        InfSupportDomain support_domain;
+        support_domain.SetInfluenceNodes(nodes);
+        support_domain.SetInfluenceTetrahedra(tetras);
+        support_domain.ComputeInfluenceNodesRadiuses(1.5);
+
+        std::cout << Logger::Message("Neighbor search benchmark: ") << nodes.size() << " nodes, "
+                  << tetras.size() << " tetrahedra\n";
+
+        Timer timer;
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            support_domain.SetThreadsNumber(threads);
+
+            timer.Reset();
+            auto cgal_ids = support_domain.CgalClosestNodesIdsTo(eval_coords);
+            double cgal_time = timer.ElapsedMilliSecs();
+
+            timer.Reset();
+            auto cell_list_ids = support_domain.CellListClosestNodesIdsTo(eval_coords);
+            double cell_list_time = timer.ElapsedMilliSecs();
+
+            std::cout << Logger::Message("Threads: ") << threads
+                      << " | CGAL: " << cgal_time << " ms"
+                      << " | Cell list: " << cell_list_time << " ms"
+                      << " | Identical: " << std::boolalpha << (cgal_ids == cell_list_ids) << "\n";
+
+            if (cgal_ids != cell_list_ids) {
+                std::cerr << Logger::Error("Cell list neighbor lists differ from the CGAL neighbor lists.") << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Compare the storage of the neighbor lists in nested vectors and in compressed sparse row format.
+        auto neighbor_ids = support_domain.CellListClosestNodesIdsTo(eval_coords);
+
+        timer.Reset();
+        {
+            auto nested_ids = neighbor_ids.ToNested();
+        }
+        double nested_time = timer.ElapsedMilliSecs();
+
+        timer.Reset();
+        {
+            NeighborList csr_ids(neighbor_ids);
+        }
+        double csr_time = timer.ElapsedMilliSecs();
+
+        std::size_t nested_bytes = neighbor_ids.ListsNum()*sizeof(std::vector<int>) + neighbor_ids.IdsNum()*sizeof(int);
+        std::cout << Logger::Message("Neighbor list build and teardown | Nested: ") << nested_time << " ms, >= "
+                  << nested_bytes/1024 << " KB in " << neighbor_ids.ListsNum() << " heap blocks"
+                  << " | CSR: " << csr_time << " ms, " << neighbor_ids.MemoryBytes()/1024 << " KB in 2 heap blocks\n";
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
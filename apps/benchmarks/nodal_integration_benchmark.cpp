@@ -0,0 +1,235 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file nodal_integration_benchmark.cpp
+   \brief Accuracy and speed benchmark of the stabilized nodal integration against the four-point tetrahedral integration.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/approximants/mmls_3d.hpp"
+#include "CLOUDEA/engine/integration/integ_options.hpp"
+#include "CLOUDEA/engine/integration/integ_points.hpp"
+#include "CLOUDEA/engine/mesh/tetramesh.hpp"
+#include "CLOUDEA/engine/support_domain/inf_support_domain.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/timer.hpp"
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// Lame parameters of the benchmark material.
+const double lambda = 1.;
+const double mu = 0.5;
+
+
+// Linear elastic strain energy of the given nodal displacements integrated on the integration points.
+double StrainEnergy(const NeighborList &neighbor_ids, const std::vector<Eigen::MatrixXd> &deriv_mats,
+                    const std::vector<double> &weights, const Eigen::MatrixXd &disp)
+{
+    double energy = 0.;
+    for (std::size_t ip = 0; ip != neighbor_ids.ListsNum(); ++ip) {
+        Eigen::Matrix3d grad = Eigen::Matrix3d::Zero();
+        auto support = neighbor_ids[ip];
+        for (std::size_t i = 0; i != support.size(); ++i) {
+            grad += disp.row(support[i]).transpose() * deriv_mats[ip].row(static_cast<Eigen::Index>(i));
+        }
+        Eigen::Matrix3d strain = 0.5*(grad + grad.transpose());
+        energy += weights[ip] * (0.5*lambda*strain.trace()*strain.trace() + mu*strain.cwiseProduct(strain).sum());
+    }
+    return energy;
+}
+
+
+// Run explicit steps of the gather-scatter forces kernel of MTLED and return the steps per second.
+double StepsPerSec(const NeighborList &neighbor_ids, const std::vector<Eigen::MatrixXd> &deriv_mats,
+                   const std::vector<double> &weights, std::size_t nodes_num, int steps_num)
+{
+    Eigen::MatrixXd disp = Eigen::MatrixXd::Constant(static_cast<Eigen::Index>(nodes_num), 3, 1.e-3);
+    Eigen::MatrixXd forces(static_cast<Eigen::Index>(nodes_num), 3);
+
+    Timer timer;
+    for (int step = 0; step != steps_num; ++step) {
+        forces.setZero();
+        for (std::size_t ip = 0; ip != neighbor_ids.ListsNum(); ++ip) {
+            auto support = neighbor_ids[ip];
+            Eigen::MatrixXd disp_local(static_cast<Eigen::Index>(support.size()), 3);
+            for (std::size_t i = 0; i != support.size(); ++i) { disp_local.row(static_cast<Eigen::Index>(i)) = disp.row(support[i]); }
+
+            // St. Venant-Kirchhoff surrogate of the material response.
+            Eigen::Matrix3d FT = deriv_mats[ip].transpose() * disp_local + Eigen::Matrix3d::Identity();
+            Eigen::Matrix3d green = 0.5*(FT.transpose()*FT - Eigen::Matrix3d::Identity());
+            Eigen::Matrix3d stress = lambda*green.trace()*Eigen::Matrix3d::Identity() + 2.*mu*green;
+            Eigen::MatrixXd forces_local = weights[ip] * deriv_mats[ip] * stress * FT;
+
+            for (std::size_t i = 0; i != support.size(); ++i) { forces.row(support[i]) += forces_local.row(static_cast<Eigen::Index>(i)); }
+        }
+        disp -= 1.e-6*forces;
+    }
+    return steps_num / timer.ElapsedSecs();
+}
+
+
+int main(int argc, char *argv[])
+{
+    try {
+        // Read the number of cells per side and the number of steps.
+        int cells_num = argc > 1 ? std::atoi(argv[1]) : 12;
+        int steps_num = argc > 2 ? std::atoi(argv[2]) : 20;
+        if (cells_num < 2) { cells_num = 2; }
+        if (steps_num < 1) { steps_num = 1; }
+
+        // Generate the nodes of a unit cube. The interior nodes are jittered.
+        int side_num = cells_num + 1;
+        double h = 1. / static_cast<double>(cells_num);
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> jitter(-0.15*h, 0.15*h);
+        std::vector<Node> nodes;
+        for (int k = 0; k != side_num; ++k) {
+            for (int j = 0; j != side_num; ++j) {
+                for (int i = 0; i != side_num; ++i) {
+                    bool interior = i > 0 && i < cells_num && j > 0 && j < cells_num && k > 0 && k < cells_num;
+                    Node node;
+                    node.SetId(static_cast<int>(nodes.size()));
+                    node.SetCoordinates(i*h + (interior ? jitter(generator) : 0.),
+                                        j*h + (interior ? jitter(generator) : 0.),
+                                        k*h + (interior ? jitter(generator) : 0.));
+                    nodes.emplace_back(node);
+                }
+            }
+        }
+
+        // Split each cell in six tetrahedra along its main diagonal.
+        std::vector<Tetrahedron> tetras;
+        auto node_id = [side_num](int i, int j, int k) { return i + side_num*(j + side_num*k); };
+        const std::array<std::array<int, 3>, 6> axes_orders{{ {{0,1,2}}, {{0,2,1}}, {{1,0,2}}, {{1,2,0}}, {{2,0,1}}, {{2,1,0}} }};
+        for (int k = 0; k != cells_num; ++k) {
+            for (int j = 0; j != cells_num; ++j) {
+                for (int i = 0; i != cells_num; ++i) {
+                    for (const auto &axes : axes_orders) {
+                        std::array<int, 3> corner{{i, j, k}};
+                        std::array<int, 4> conn;
+                        conn[0] = node_id(corner[0], corner[1], corner[2]);
+                        for (std::size_t a = 0; a != 3; ++a) {
+                            corner[axes[a]]++;
+                            conn[a+1] = node_id(corner[0], corner[1], corner[2]);
+                        }
+                        Tetrahedron tetra;
+                        tetra.SetId(static_cast<int>(tetras.size()));
+                        tetra.SetConnectivity(conn[0], conn[1], conn[2], conn[3]);
+                        tetras.emplace_back(tetra);
+                    }
+                }
+            }
+        }
+
+        TetraMesh tetramesh;
+        tetramesh.SetNodes(std::move(nodes));
+        tetramesh.SetElements(std::move(tetras));
+
+        // Influence domains of the nodes.
+        InfSupportDomain support_dom;
+        support_dom.SetInfluenceNodes(tetramesh.SharedNodes());
+        support_dom.SetInfluenceTetrahedra(tetramesh.SharedElements());
+        support_dom.ComputeInfluenceNodesRadiuses(2.4);
+
+        Mmls3d mmls;
+        mmls.SetBasisFunctionType("quadratic");
+        mmls.SetExactDerivativesMode(true);
+
+        // Quadratic displacement field with exact strain energy a^2 (5 lambda + 4 mu) on the unit cube
+        // and checkerboard displacement field of the nodes.
+        const double a = 1.e-2;
+        const double exact_energy = a*a*(5.*lambda + 4.*mu);
+        Eigen::MatrixXd quad_disp(tetramesh.NodesNum(), 3), checker_disp(tetramesh.NodesNum(), 3);
+        for (int k = 0; k != side_num; ++k) {
+            for (int j = 0; j != side_num; ++j) {
+                for (int i = 0; i != side_num; ++i) {
+                    int id = node_id(i, j, k);
+                    const auto &coords = tetramesh.Nodes()[id].Coordinates();
+                    quad_disp.row(id) << a*coords.X()*coords.X(), a*coords.Y()*coords.Y(), a*coords.Z()*coords.Z();
+                    double sign = ((i + j + k) % 2 == 0) ? a : -a;
+                    checker_disp.row(id) << sign, sign, sign;
+                }
+            }
+        }
+
+        std::cout << Logger::Message("Nodal integration benchmark: ") << tetramesh.NodesNum() << " nodes, "
+                  << tetramesh.Elements().size() << " tetrahedra\n";
+
+        const std::vector<std::string> schemes{"Four-point", "Nodal", "Stabilized nodal"};
+        double reference_checker_energy = 0.;
+        for (const auto &scheme : schemes) {
+            IntegOptions options;
+            options.integ_points_per_tetra_ = 4;
+            options.is_nodal_ = (scheme != "Four-point");
+            options.stress_points_fraction_ = (scheme == "Nodal") ? 0. : 0.25;
+
+            Timer timer;
+            IntegPoints integ_points;
+            integ_points.Generate(tetramesh, options, support_dom);
+
+            // Shape function derivatives of the support nodes at the integration points.
+            NeighborList neighbor_ids = support_dom.CellListClosestNodesIdsTo(integ_points.Coordinates());
+            std::vector<Eigen::MatrixXd> deriv_mats(neighbor_ids.ListsNum());
+            std::vector<double> dx, dy, dz;
+            for (std::size_t ip = 0; ip != neighbor_ids.ListsNum(); ++ip) {
+                mmls.ComputeDerivsAt(tetramesh.Nodes(), integ_points.Coordinates()[ip], neighbor_ids[ip].ToVector(),
+                                     support_dom.InfluenceNodesRadiuses(), dx, dy, dz);
+                deriv_mats[ip].resize(static_cast<Eigen::Index>(dx.size()), 3);
+                for (std::size_t i = 0; i != dx.size(); ++i) {
+                    deriv_mats[ip].row(static_cast<Eigen::Index>(i)) << dx[i], dy[i], dz[i];
+                }
+            }
+            double setup_time = timer.ElapsedMilliSecs();
+
+            double quad_error = std::abs(StrainEnergy(neighbor_ids, deriv_mats, integ_points.Weights(), quad_disp) - exact_energy) / exact_energy;
+            double checker_energy = StrainEnergy(neighbor_ids, deriv_mats, integ_points.Weights(), checker_disp);
+            if (scheme == "Four-point") { reference_checker_energy = checker_energy; }
+            double rate = StepsPerSec(neighbor_ids, deriv_mats, integ_points.Weights(), tetramesh.Nodes().size(), steps_num);
+
+            std::cout << Logger::Message(scheme + " | Points: ") << integ_points.PointsNum()
+                      << " (" << static_cast<double>(integ_points.PointsNum()) / tetramesh.NodesNum() << " per node)"
+                      << " | Setup: " << setup_time << " ms"
+                      << " | Forces kernel: " << rate << " steps/s"
+                      << " | Quadratic field energy error: " << 100.*quad_error << " %"
+                      << " | Checkerboard energy ratio: " << checker_energy / reference_checker_energy << "\n";
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
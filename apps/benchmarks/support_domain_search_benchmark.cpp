@@ -0,0 +1,113 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file support_domain_search_benchmark.cpp
+   \brief Scaling benchmark of the parallel CGAL-based support nodes searches of SupportDomain.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/support_domain/support_domain.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/timer.hpp"
+
+#include <IMP/Vectors>
+#include <IMP/Tesselations>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+int main(int argc, char *argv[])
+{
+    try {
+        // Read the number of nodes per side, the number of nearest neighbors and the maximum number of threads.
+        std::size_t side_num = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 100;
+        int neigh_num = argc > 2 ? std::atoi(argv[2]) : 20;
+        std::size_t max_threads = argc > 3 ? static_cast<std::size_t>(std::atoi(argv[3])) : std::thread::hardware_concurrency();
+        if (side_num < 2) { side_num = 2; }
+        if (max_threads < 1) { max_threads = 1; }
+
+        // Generate a jittered grid of field nodes. 100 nodes per side give a million-node grid.
+        double h = 1. / static_cast<double>(side_num-1);
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> jitter(-0.2*h, 0.2*h);
+        std::vector<IMP::Vec<3, double>> field_nodes;
+        field_nodes.reserve(side_num*side_num*side_num);
+        for (std::size_t k = 0; k != side_num; ++k) {
+            for (std::size_t j = 0; j != side_num; ++j) {
+                for (std::size_t i = 0; i != side_num; ++i) {
+                    field_nodes.emplace_back(IMP::Vec<3, double>({i*h + jitter(generator), j*h + jitter(generator), k*h + jitter(generator)}));
+                }
+            }
+        }
+
+        std::cout << Logger::Message("Support domain search benchmark: ") << field_nodes.size() << " field nodes\n";
+
+        SupportDomain<3> support;
+        support.SetFieldNodesNum(static_cast<int>(field_nodes.size()));
+
+        Timer timer;
+        NeighborList range_ids_serial, nearest_ids_serial;
+        for (std::size_t threads = 1; threads <= max_threads; threads = (threads == max_threads) ? threads+1 : std::min(2*threads, max_threads)) {
+            support.SetThreadsNumber(threads);
+
+            // Range search with a uniform support radius.
+            support.SetRadius(h);
+            support.SetDilateCoeff(2.2);
+            timer.Reset();
+            support.IdentifyInfluenceNodesInRange(field_nodes, field_nodes);
+            double range_time = timer.ElapsedMilliSecs();
+            if (threads == 1) { range_ids_serial = support.InfluenceNodeIds(); }
+            bool range_identical = (support.InfluenceNodeIds() == range_ids_serial);
+
+            // Nearest neighbors search without surface nodes.
+            timer.Reset();
+            support.IdentifyNearestInfluenceNodes(field_nodes, IMP::NodeSet(), neigh_num);
+            double nearest_time = timer.ElapsedMilliSecs();
+            if (threads == 1) { nearest_ids_serial = support.InfluenceNodeIds(); }
+            bool nearest_identical = (support.InfluenceNodeIds() == nearest_ids_serial);
+
+            std::cout << Logger::Message("Threads: ") << threads
+                      << " | Range search: " << range_time << " ms"
+                      << " | Nearest search: " << nearest_time << " ms"
+                      << " | Identical to serial: " << std::boolalpha << (range_identical && nearest_identical) << "\n";
+
+            if (!range_identical || !nearest_identical) {
+                std::cerr << Logger::Error("Parallel support nodes differ from the serial support nodes.") << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file neighbor_list_converter.cpp
+   \brief Conversion of text neighbor list files to the binary memory-mapped neighbor list format.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/integration/integ_points.hpp"
+#include "CLOUDEA/engine/mesh/tetramesh.hpp"
+#include "CLOUDEA/engine/support_domain/inf_support_domain.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+int main(int argc, char *argv[])
+{
+    if (argc < 5) {
+        std::cerr << "Usage: " << argv[0] << " <mesh.inp> <neighbors.txt> <neighbors.nbl> <dilatation_coeff>"
+                  << " [--points <integ_points.ipt>] [--compress]\n"
+                  << "The evaluation points of the neighbor list are the mesh nodes unless an integration points file is given.\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::string mesh_file(argv[1]);
+        std::string txt_file(argv[2]);
+        std::string nbl_file(argv[3]);
+        double dilatation_coeff = std::atof(argv[4]);
+        std::string points_file("");
+        bool compress = false;
+        for (int i = 5; i < argc; ++i) {
+            std::string arg(argv[i]);
+            if (arg == "--compress") { compress = true; }
+            else if (arg == "--points" && i+1 < argc) { points_file = argv[++i]; }
+            else {
+                std::cerr << Logger::Error("Unknown argument: ") << arg << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Load the mesh the neighbor list was computed for.
+        TetraMesh mesh;
+        mesh.LoadFrom(mesh_file);
+
+        // Set the support domain to store its mesh hash and dilatation coefficient in the binary file.
+        InfSupportDomain support_domain;
+        support_domain.SetInfluenceNodes(mesh.SharedNodes());
+        support_domain.SetInfluenceTetrahedra(mesh.SharedElements());
+        support_domain.ComputeInfluenceNodesRadiuses(dilatation_coeff);
+
+        // The evaluation points of the neighbor list are stored as a hash in the binary file.
+        std::vector<Vec3<double> > eval_coords;
+        if (points_file.empty()) {
+            eval_coords = mesh.NodeCoordinates();
+        } else {
+            IntegPoints integ_points;
+            integ_points.LoadFromFile(points_file);
+            eval_coords = integ_points.Coordinates();
+        }
+
+        auto neighbor_ids = support_domain.LoadClosestNodesFrom(txt_file, eval_coords);
+        support_domain.SaveClosestNodesTo(nbl_file, eval_coords, neighbor_ids, compress);
+
+        std::cout << Logger::Message("Saved neighbor list with ") << neighbor_ids.ListsNum() << " points and "
+                  << neighbor_ids.IdsNum() << " neighbors to: " << nbl_file << "\n";
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@
 
 #include "CLOUDEA/engine/approximants/approximant_props.hpp"
 #include "CLOUDEA/engine/approximants/fem_factory.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
 
 #include <IMP/IMP>
 #include <Eigen/Dense>
@@ -51,7 +52,7 @@ class FemMats
 {
 private:
 
-    std::vector<std::vector<int>> fbar_patches_;
+    NeighborList fbar_patches_;
 
     std::vector<Eigen::VectorXd> shape_funcs_;
 
@@ -97,7 +98,7 @@ public:
     inline auto & FbarPatches() const { return this->fbar_patches_; }
 
 
-    inline auto & FbarPatches(std::size_t id) const { return this->fbar_patches_[id]; }
+    inline auto FbarPatches(std::size_t id) const { return this->fbar_patches_[id]; }
 
 
     /**
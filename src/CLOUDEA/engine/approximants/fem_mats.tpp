@@ -47,8 +47,7 @@ FemMats<DIM,CELL_VERTS>::~FemMats()
 template<short DIM, short CELL_VERTS>
 void FemMats<DIM,CELL_VERTS>::ComputeFbarPatches(IMP::Mesh<DIM,CELL_VERTS> mesh)
 {
-    this->fbar_patches_.clear();
-    this->fbar_patches_.resize(mesh.CellsNum());
+    this->fbar_patches_.Clear();
 
     auto patch_size = 0;
     if (DIM == 2 && CELL_VERTS == 3) {
@@ -57,6 +56,9 @@ void FemMats<DIM,CELL_VERTS>::ComputeFbarPatches(IMP::Mesh<DIM,CELL_VERTS> mesh)
         patch_size = 8;
     }
 
+    // Populate the patches in fixed size slots per cell. The filled slots are compacted in the patches list.
+    auto patch_ids = std::vector<int>(mesh.CellsNum()*patch_size, 0);
+    auto patch_sizes = std::vector<std::size_t>(mesh.CellsNum(), 0);
     auto in_patch_flag = std::vector<int>(mesh.CellsNum(), 0);
     auto attached_cell_ids = std::vector<int>{};
     for (auto i = int{0}; i != mesh.NodesNum(); ++i) {
@@ -65,16 +67,21 @@ void FemMats<DIM,CELL_VERTS>::ComputeFbarPatches(IMP::Mesh<DIM,CELL_VERTS> mesh)
         // Iterate attached cell ids to populate the patches.
         for (const auto &cid : attached_cell_ids) {
             for (const auto &neigh : attached_cell_ids) {
-                if (this->fbar_patches_[cid].size() != patch_size) {
-                    this->fbar_patches_[cid].emplace_back(neigh);
+                if (patch_sizes[cid] != static_cast<std::size_t>(patch_size)) {
+                    patch_ids[cid*patch_size + patch_sizes[cid]++] = neigh;
                 }
             }
             in_patch_flag[cid] = 1;
         }
     }
 
-    for (const auto &patch : this->fbar_patches_) {
-        std::cout << patch.size() << std::endl;
+    this->fbar_patches_.Allocate(patch_sizes);
+    for (std::size_t cid = 0; cid != patch_sizes.size(); ++cid) {
+        std::copy_n(patch_ids.begin() + cid*patch_size, patch_sizes[cid], this->fbar_patches_.Data(cid));
+    }
+
+    for (std::size_t cid = 0; cid != this->fbar_patches_.ListsNum(); ++cid) {
+        std::cout << this->fbar_patches_.ListSize(cid) << std::endl;
     }
 
 
@@ -62,7 +62,7 @@ protected:
     * \return [void]
     */
    inline void ComputeCorrelationFunction(const IMP::Vec<DIM, double> &eval_point, const std::vector<IMP::Vec<DIM, double>> &neigh_nodes,
-                                          const std::vector<int> &neigh_ids, arma::vec &mki_values, arma::mat &mki_grad);
+                                          const NeighborSpan &neigh_ids, arma::vec &mki_values, arma::mat &mki_grad);
 
 
 public:
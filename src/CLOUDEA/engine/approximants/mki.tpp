@@ -26,7 +26,7 @@ namespace CLOUDEA {
 
 template <short DIM>
 void Mki<DIM>::ComputeCorrelationFunction(const IMP::Vec<DIM, double> &eval_point, const std::vector<IMP::Vec<DIM, double>> &neigh_nodes, 
-                                          const std::vector<int> &neigh_ids, arma::vec &mki_values, arma::mat &mki_grad)
+                                          const NeighborSpan &neigh_ids, arma::vec &mki_values, arma::mat &mki_grad)
 {
     // Get the number of neighbor field nodes in the support domain.
     std::size_t neighs_num = neigh_nodes.size();
@@ -61,7 +61,7 @@ void Mmls3d::SetExactDerivativesMode(const bool &exact_derivatives)
 
 void Mmls3d::ComputeShFuncAndDerivs(const std::vector<Node> &geom_nodes,
                                          const std::vector<Vec3<double> > &eval_nodes_coords,
-                                         const std::vector<std::vector<int> > &support_nodes_ids,
+                                         const NeighborList &support_nodes_ids,
                                          const std::vector<double> &influence_radiuses)
 {
     // Check if base function type is initialized.
@@ -378,8 +378,173 @@ void Mmls3d::ComputeShFuncAndDerivs(const std::vector<Node> &geom_nodes,
 }
 
 
+void Mmls3d::ComputeDerivsAt(const std::vector<Node> &geom_nodes, const Vec3<double> &eval_coords,
+                             const std::vector<int> &support_ids, const std::vector<double> &influence_radiuses,
+                             std::vector<double> &sh_func_dx, std::vector<double> &sh_func_dy, std::vector<double> &sh_func_dz) const
+{
+    // Moment matrix and basis vector with storage for up to the quadratic basis. No dynamic memory allocation.
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 10, 10> MomentMatrix;
+    typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, 10, 1> BasisVector;
+
+    // Check if base function type is initialized.
+    if (this->base_function_type_ == "") {
+        std::string error = "[CLOUDEA ERROR] Cannot compute shape function derivatives. Set first the base function type.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Set moment matrix A rows, cols size. For base function type linear.
+    const bool is_quadratic = (this->base_function_type_ == "quadratic");
+    const int m = is_quadratic ? 10 : 4;
+
+    // Compute the basis vector at the given coordinates.
+    auto basis = [is_quadratic](const Vec3<double> &c, BasisVector &p) {
+        p(0) = 1.; p(1) = c.X(); p(2) = c.Y(); p(3) = c.Z();
+        if (is_quadratic) {
+            p(4) = c.X()*c.X(); p(5) = c.Y()*c.Y(); p(6) = c.Z()*c.Z();
+            p(7) = c.X()*c.Y(); p(8) = c.Y()*c.Z(); p(9) = c.X()*c.Z();
+        }
+    };
+
+    // Compute the quartic spline weight of the ith support node and its spatial derivatives.
+    auto weight = [&](std::size_t i, double &w, double &w_x, double &w_y, double &w_z) {
+        const auto &neigh_id = support_ids[i];
+        const auto &r = influence_radiuses[neigh_id];
+        double dx = geom_nodes[neigh_id].Coordinates().X() - eval_coords.X();
+        double dy = geom_nodes[neigh_id].Coordinates().Y() - eval_coords.Y();
+        double dz = geom_nodes[neigh_id].Coordinates().Z() - eval_coords.Z();
+        double dist = std::sqrt(dx*dx + dy*dy + dz*dz) / r;
+
+        w = 1. - 6.*dist*dist + 8.*dist*dist*dist - 3.*dist*dist*dist*dist;
+        double w_dist_div_dist = - 12. + 24.*dist - 12.*dist*dist;
+        w_x = - w_dist_div_dist * dx / (r*r);
+        w_y = - w_dist_div_dist * dy / (r*r);
+        w_z = - w_dist_div_dist * dz / (r*r);
+    };
+
+    // Compute moment matrix A and its derivatives.
+    MomentMatrix a = MomentMatrix::Zero(m, m);
+    MomentMatrix a_x = MomentMatrix::Zero(m, m);
+    MomentMatrix a_y = MomentMatrix::Zero(m, m);
+    MomentMatrix a_z = MomentMatrix::Zero(m, m);
+    BasisVector px(m);
+    double w = 0., w_x = 0., w_y = 0., w_z = 0.;
+    for (std::size_t i = 0; i != support_ids.size(); ++i) {
+        weight(i, w, w_x, w_y, w_z);
+        basis(geom_nodes[support_ids[i]].Coordinates(), px);
+
+        a.noalias() += w * px * px.transpose();
+        if (this->exact_derivatives_) {
+            a_x.noalias() += w_x * px * px.transpose();
+            a_y.noalias() += w_y * px * px.transpose();
+            a_z.noalias() += w_z * px * px.transpose();
+        }
+    }
+
+    // Apply correction factor on moment matrix A lower diagonal if quadratic base function is used.
+    if (is_quadratic) {
+        double cf = 1e-7;
+        a(4,4) += cf; a(5,5) += cf; a(6,6) += cf;
+        a(7,7) += cf; a(8,8) += cf; a(9,9) += cf;
+    }
+
+    // The derivatives of the basis vector at the evaluation node.
+    BasisVector p_x = BasisVector::Zero(m), p_y = BasisVector::Zero(m), p_z = BasisVector::Zero(m);
+    p_x(1) = 1.; p_y(2) = 1.; p_z(3) = 1.;
+    if (is_quadratic) {
+        p_x(4) = 2.*eval_coords.X(); p_x(7) = eval_coords.Y(); p_x(9) = eval_coords.Z();
+        p_y(5) = 2.*eval_coords.Y(); p_y(7) = eval_coords.X(); p_y(8) = eval_coords.Z();
+        p_z(6) = 2.*eval_coords.Z(); p_z(8) = eval_coords.Y(); p_z(9) = eval_coords.X();
+    }
+
+    // Solve for gamma = A^-1 p(x) and its derivatives gamma_x = A^-1 (p_x - A_x gamma).
+    // The shape function derivative of the ith support node is then w_x p_i gamma + w p_i gamma_x.
+    // For diffuse derivatives the derivatives of the weights and the moment matrix are neglected.
+    Eigen::LLT<MomentMatrix> llt(a);
+    BasisVector p_eval(m);
+    basis(eval_coords, p_eval);
+    BasisVector gamma = llt.solve(p_eval);
+    BasisVector gamma_x = llt.solve(p_x - a_x*gamma);
+    BasisVector gamma_y = llt.solve(p_y - a_y*gamma);
+    BasisVector gamma_z = llt.solve(p_z - a_z*gamma);
+
+    // Compute the shape function derivatives of the support nodes.
+    sh_func_dx.resize(support_ids.size());
+    sh_func_dy.resize(support_ids.size());
+    sh_func_dz.resize(support_ids.size());
+    for (std::size_t i = 0; i != support_ids.size(); ++i) {
+        weight(i, w, w_x, w_y, w_z);
+        basis(geom_nodes[support_ids[i]].Coordinates(), px);
+
+        double p_gamma = px.dot(gamma);
+        if (!this->exact_derivatives_) { p_gamma = 0.; }
+        sh_func_dx[i] = w_x*p_gamma + w*px.dot(gamma_x);
+        sh_func_dy[i] = w_y*p_gamma + w*px.dot(gamma_y);
+        sh_func_dz[i] = w_z*p_gamma + w*px.dot(gamma_z);
+    }
+
+}
+
+
+void Mmls3d::UpdateShFuncAndDerivs(const std::vector<Node> &geom_nodes,
+                                   const std::vector<Vec3<double> > &eval_nodes_coords,
+                                   const NeighborList &support_nodes_ids,
+                                   const std::vector<double> &influence_radiuses,
+                                   const std::vector<int> &updated_eval_ids)
+{
+    // Check if shape functions have been already computed.
+    auto prev_cols_num = static_cast<std::size_t>(this->sh_func_.cols());
+    if (prev_cols_num == 0 || prev_cols_num > eval_nodes_coords.size()) {
+        std::string error = Logger::Error("Cannot update shape functions and derivatives. "
+                                          "Compute shape functions and derivatives for all the evaluation nodes first.");
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Check that the appended evaluation nodes are updated.
+    std::vector<char> is_updated(eval_nodes_coords.size(), 0);
+    for (const auto &eval_id : updated_eval_ids) {
+        if (eval_id < 0 || static_cast<std::size_t>(eval_id) >= eval_nodes_coords.size()) {
+            throw std::out_of_range(Logger::Error("Cannot update shape functions and derivatives. "
+                                                  "Updated evaluation node index is out of range.").c_str());
+        }
+        is_updated[eval_id] = 1;
+    }
+    if (std::find(is_updated.begin() + static_cast<std::ptrdiff_t>(prev_cols_num), is_updated.end(), 0) != is_updated.end()) {
+        throw std::invalid_argument(Logger::Error("Cannot update shape functions and derivatives. "
+                                                  "The appended evaluation nodes must be updated.").c_str());
+    }
+
+    // Nothing to update.
+    if (updated_eval_ids.empty()) { return; }
+
+    // Gather the coordinates and support nodes of the updated evaluation nodes.
+    std::vector<Vec3<double> > updated_coords;
+    NeighborList updated_support_ids;
+    updated_coords.reserve(updated_eval_ids.size());
+    updated_support_ids.Reserve(updated_eval_ids.size(), 0);
+    for (const auto &eval_id : updated_eval_ids) {
+        updated_coords.emplace_back(eval_nodes_coords[eval_id]);
+        updated_support_ids.Append(support_nodes_ids[eval_id]);
+    }
+
+    // Compute shape functions and derivatives for the updated evaluation nodes.
+    Mmls3d updated;
+    updated.SetBasisFunctionType(this->base_function_type_);
+    updated.SetExactDerivativesMode(this->exact_derivatives_);
+    updated.ComputeShFuncAndDerivs(geom_nodes, updated_coords, updated_support_ids, influence_radiuses);
+
+    // Patch the updated columns of the shape function and derivatives matrices.
+    auto rows_num = static_cast<Eigen::Index>(geom_nodes.size());
+    auto cols_num = static_cast<Eigen::Index>(eval_nodes_coords.size());
+    this->sh_func_ = ReplaceColumns(this->sh_func_, updated.sh_func_, updated_eval_ids, rows_num, cols_num);
+    this->sh_func_dx_ = ReplaceColumns(this->sh_func_dx_, updated.sh_func_dx_, updated_eval_ids, rows_num, cols_num);
+    this->sh_func_dy_ = ReplaceColumns(this->sh_func_dy_, updated.sh_func_dy_, updated_eval_ids, rows_num, cols_num);
+    this->sh_func_dz_ = ReplaceColumns(this->sh_func_dz_, updated.sh_func_dz_, updated_eval_ids, rows_num, cols_num);
+
+}
+
+
 void Mmls3d::LoadShFuncAndDerivsFromFile(const std::string &sh_func_file, const std::vector<Node> &geom_nodes,
-                                         const std::vector<std::vector<int> > &support_nodes_ids)
+                                         const NeighborList &support_nodes_ids)
 {
     // Print reading status message.
     std::cout << Logger::Message("Reading shape function and derivatives from file: ") << sh_func_file << "\n";
@@ -453,10 +618,10 @@ void Mmls3d::LoadShFuncAndDerivsFromFile(const std::string &sh_func_file, const
     sh_func_fstream.close();
 
     // Initialize shape function and derivative matrices.
-    this->sh_func_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.size());
-    this->sh_func_dx_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.size());
-    this->sh_func_dy_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.size());
-    this->sh_func_dz_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.size());
+    this->sh_func_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.ListsNum());
+    this->sh_func_dx_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.ListsNum());
+    this->sh_func_dy_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.ListsNum());
+    this->sh_func_dz_ = Eigen::SparseMatrix<double>(geom_nodes.size(), support_nodes_ids.ListsNum());
 
     // Populate shape function and derivatives matrices.
     this->sh_func_.setFromTriplets(triplet_sh_func.begin(), triplet_sh_func.end());
@@ -467,6 +632,41 @@ void Mmls3d::LoadShFuncAndDerivsFromFile(const std::string &sh_func_file, const
 }
 
 
+Eigen::SparseMatrix<double> Mmls3d::ReplaceColumns(const Eigen::SparseMatrix<double> &mat,
+                                                   const Eigen::SparseMatrix<double> &new_cols,
+                                                   const std::vector<int> &col_ids, Eigen::Index rows_num,
+                                                   Eigen::Index cols_num)
+{
+    // Map each column of the patched matrix to its replacement column, if any.
+    std::vector<int> replacement(static_cast<std::size_t>(cols_num), -1);
+    for (std::size_t i = 0; i != col_ids.size(); ++i) { replacement[col_ids[i]] = static_cast<int>(i); }
+
+    // Count the non-zero entries of each column of the patched matrix.
+    Eigen::VectorXi col_nnz(cols_num);
+    for (Eigen::Index col = 0; col != cols_num; ++col) {
+        int nnz = 0;
+        if (replacement[col] < 0) { for (Eigen::SparseMatrix<double>::InnerIterator it(mat, col); it; ++it) { nnz++; } }
+        else { for (Eigen::SparseMatrix<double>::InnerIterator it(new_cols, replacement[col]); it; ++it) { nnz++; } }
+        col_nnz[col] = nnz;
+    }
+
+    // Populate the patched matrix column by column in increasing row order.
+    Eigen::SparseMatrix<double> patched(rows_num, cols_num);
+    patched.reserve(col_nnz);
+    for (Eigen::Index col = 0; col != cols_num; ++col) {
+        if (replacement[col] < 0) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(mat, col); it; ++it) { patched.insert(it.row(), col) = it.value(); }
+        }
+        else {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(new_cols, replacement[col]); it; ++it) { patched.insert(it.row(), col) = it.value(); }
+        }
+    }
+    patched.makeCompressed();
+
+    return patched;
+}
+
+
 Mmls3d & Mmls3d::operator = (const Mmls3d &mmls)
 {
     if (this != &mmls) {
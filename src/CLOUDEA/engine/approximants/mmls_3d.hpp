@@ -30,6 +30,7 @@
 
 #include "CLOUDEA/engine/vectors/vec3.hpp"
 #include "CLOUDEA/engine/elements/node.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
 #include "CLOUDEA/engine/utilities/logger.hpp"
 
 #include <Eigen/Dense>
@@ -104,16 +105,61 @@ public:
      */
     void ComputeShFuncAndDerivs(const std::vector<Node> &geom_nodes,
                                 const std::vector<Vec3<double> > &eval_nodes_coords,
-                                const std::vector<std::vector<int> > &support_nodes_ids,
+                                const NeighborList &support_nodes_ids,
                                 const std::vector<double> &influence_radiuses);
 
+
+    /*!
+     * \brief Compute the shape function derivatives of the support nodes at a single evaluation node.
+     *
+     * Lightweight evaluator that does not store the shape function matrices. The moment matrix is stored
+     * in fixed-capacity storage and only four solves with it are required, thus the evaluator is suitable
+     * for repeated evaluations at scattered points. Thread-safe.
+     *
+     * \param [in] geom_nodes The nodes describing the model's geometry.
+     * \param [in] eval_coords The coordinates of the evaluation node.
+     * \param [in] support_ids The indices of the nodes belonging in the support domain of the evaluation node.
+     * \param [in] influence_radiuses The radiuses of influence of the model's geometry nodes.
+     * \param [out] sh_func_dx The shape function x derivative of each support node.
+     * \param [out] sh_func_dy The shape function y derivative of each support node.
+     * \param [out] sh_func_dz The shape function z derivative of each support node.
+     * \return [void]
+     */
+    void ComputeDerivsAt(const std::vector<Node> &geom_nodes, const Vec3<double> &eval_coords,
+                         const std::vector<int> &support_ids, const std::vector<double> &influence_radiuses,
+                         std::vector<double> &sh_func_dx, std::vector<double> &sh_func_dy, std::vector<double> &sh_func_dz) const;
+
+
+    /*!
+     * \brief Recompute the shape functions and their derivatives only for the given evaluation nodes.
+     *
+     * The columns of the updated evaluation nodes are replaced in the shape function and derivatives
+     * matrices while all the other columns are kept. The number of rows is extended if nodes
+     * have been appended to the model's geometry. Evaluation nodes appended at the end of the coordinates
+     * container (e.g. the integration points of refined elements) must be included in the updated
+     * evaluation nodes. Removal of evaluation nodes requires a full computation.
+     *
+     * \param [in] geom_nodes The nodes describing the model's geometry.
+     * \param [in] eval_nodes_coords The coordinates of all the evaluation nodes of the shape functions.
+     * \param [in] support_nodes_ids The indices of the nodes belonging in the support domain of each evaluation node.
+     * \param [in] influence_radiuses The radiuses of influence of the model's geometry nodes.
+     * \param [in] updated_eval_ids The indices of the evaluation nodes to be recomputed.
+     * \return [void]
+     */
+    void UpdateShFuncAndDerivs(const std::vector<Node> &geom_nodes,
+                               const std::vector<Vec3<double> > &eval_nodes_coords,
+                               const NeighborList &support_nodes_ids,
+                               const std::vector<double> &influence_radiuses,
+                               const std::vector<int> &updated_eval_ids);
+
+
     /*!
      * \brief Load the shape functions and their derivatives from a file.
      * \param [in] sh_func_file The file to load the shape function and derivatives.
      * \return [void]
      */
     void LoadShFuncAndDerivsFromFile(const std::string &sh_func_file, const std::vector<Node> &geom_nodes,
-                                     const std::vector<std::vector<int> > &support_nodes_ids);
+                                     const NeighborList &support_nodes_ids);
 
     /*!
      * Mmls3d copy assignment operator.
@@ -166,6 +212,22 @@ public:
 
 
 
+protected:
+    /*!
+     * \brief Replace columns of a sparse matrix.
+     * \param [in] mat The sparse matrix to be patched.
+     * \param [in] new_cols The sparse matrix containing the replacement columns in the order of col_ids.
+     * \param [in] col_ids The indices of the columns of the patched matrix to be replaced. The appended columns must be replaced.
+     * \param [in] rows_num The number of rows of the patched matrix.
+     * \param [in] cols_num The number of columns of the patched matrix. Not smaller than the columns of mat.
+     * \return [Eigen::SparseMatrix<double>] The patched sparse matrix.
+     */
+    static Eigen::SparseMatrix<double> ReplaceColumns(const Eigen::SparseMatrix<double> &mat,
+                                                      const Eigen::SparseMatrix<double> &new_cols,
+                                                      const std::vector<int> &col_ids, Eigen::Index rows_num,
+                                                      Eigen::Index cols_num);
+
+
 private:
     std::string base_function_type_;            /*!< The type of the base function to be used during shape functions and derivatives calculation. */
 
@@ -66,7 +66,7 @@ protected:
     * \param [in] rbf_grad 
     */
    inline void ComputeEnrichedRbf(const IMP::Vec<DIM, double> &eval_point, const std::vector<IMP::Vec<DIM, double>> &neigh_nodes,
-                                  const std::vector<int> &neigh_ids, arma::vec &rpi_values, arma::mat &rpki_grad);
+                                  const NeighborSpan &neigh_ids, arma::vec &rpi_values, arma::mat &rpki_grad);
 
 
 public:
@@ -39,7 +39,7 @@ Rpi<DIM>::~Rpi()
 
 template <short DIM>
 void Rpi<DIM>::ComputeEnrichedRbf(const IMP::Vec<DIM, double> &eval_point, const std::vector<IMP::Vec<DIM, double>> &neigh_nodes,
-                                  const std::vector<int> &neigh_ids, arma::vec &rpi_values, arma::mat &rpi_grad)
+                                  const NeighborSpan &neigh_ids, arma::vec &rpi_values, arma::mat &rpi_grad)
 {
 
     // Compute monomial basis for eval_point.
@@ -43,6 +43,9 @@ void ConditionsHandler::AddLoading(const LoadCurve &load_curve, const bool &x, c
     // Add the new loading condition in the loadings container.
     this->loading_conds_.push_back(new_load);
 
+    // The node indices of the new condition are not extracted yet.
+    this->InvalidateCompiledConditions();
+
 }
 
 
@@ -58,6 +61,9 @@ void ConditionsHandler::AddDirichlet(const bool &x, const bool &y, const bool &z
     // Add the new dirichlet condition in the dirichlet conditions container.
     this->dirichlet_conds_.push_back(new_dirichlet);
 
+    // The node indices of the new condition are not extracted yet.
+    this->InvalidateCompiledConditions();
+
 }
 
 
@@ -78,7 +84,7 @@ void ConditionsHandler::AddEbciem(const WeakModel3D &model, const InfSupportDoma
 }
 
 
-void ConditionsHandler::AddEbciem2(const WeakModel3D &model, const Mmls3d &approximants, const bool &is_simplified)
+void ConditionsHandler::AddEbciem2(const WeakModel3D &model, const std::shared_ptr<const Mmls3d> &approximants, const bool &is_simplified)
 {
     // Check if dirichlet and loading boundary nodes indices have been set before adding the EBCIEM correction.
     if (!this->bound_node_ids_are_extracted_) {
@@ -167,6 +173,9 @@ void ConditionsHandler::ExtractBoundaryNodeIds(const std::vector<NodeSet> &node_
         }
     }
 
+    // Compile the conditions for their application.
+    this->CompileConditions();
+
     // Set the boolean declaring the nodes indices extraction to true.
     this->bound_node_ids_are_extracted_ = true;
 
@@ -176,204 +185,199 @@ void ConditionsHandler::ExtractBoundaryNodeIds(const std::vector<NodeSet> &node_
 
 void ConditionsHandler::ApplyLoadingConditions(const int &time_step, Eigen::MatrixXd &displacements) const
 {
-    // Check if loading conditions have been added in the conditions handler.
-    if (this->loading_conds_.size() == 0) {
-        std::runtime_error(Logger::Error("Cannot apply loading conditions. No loading "
-                                         "conditions available in the conditions handler.").c_str());
-    }
+    this->CheckConditionsCompiled();
 
-    // Iterate over loading conditions.
-    for (auto &loading : this->loading_conds_) {
-        // Iterate over loading condition's nodes indices for loading application in the displacement matrix.
-        for (auto &node_id : loading.NodesIds()) {
-            // Application on the X direction.
-            if (loading.Direction().coeff(0) != 0) { displacements.coeffRef(node_id, 0) = loading.Curve().LoadDispAt(time_step); }
-
-            // Application on the Y direction.
-            if (loading.Direction().coeff(1) != 0) { displacements.coeffRef(node_id, 1) = loading.Curve().LoadDispAt(time_step); }
-
-            // Application on the Z direction.
-            if (loading.Direction().coeff(2) != 0) { displacements.coeffRef(node_id, 2) = loading.Curve().LoadDispAt(time_step); }
-        }
+    // Evaluate the load curves once for all the axes.
+    const auto &curve_values = this->LoadCurveValues(time_step);
 
-    }
+    // Iterate over axes.
+    for (std::size_t k = 0; k != 3; ++k) { this->ApplyAxisLoadings(k, curve_values, displacements.col(k).data()); }
 
 }
 
 
 void ConditionsHandler::ResetLoadingConditionsForces(Eigen::MatrixXd &forces) const
 {
-    // Check if loading conditions have been added in the conditions handler.
-    if (this->loading_conds_.size() == 0) {
-        std::runtime_error(Logger::Error("Cannot apply loading conditions. No loading "
-                                         "conditions available in the conditions handler.").c_str());
-    }
-
-    // Iterate over loading conditions.
-    for (auto &loading : this->loading_conds_) {
-        // Iterate over loading condition's nodes indices to reset force to zero.
-        for (auto &node_id : loading.NodesIds()) {
-            // Application on the X direction.
-            if (loading.Direction().coeff(0) != 0) { forces.coeffRef(node_id, 0) = 0.; }
+    this->CheckConditionsCompiled();
 
-            // Application on the Y direction.
-            if (loading.Direction().coeff(1) != 0) { forces.coeffRef(node_id, 1) = 0.; }
-
-            // Application on the Z direction.
-            if (loading.Direction().coeff(2) != 0) { forces.coeffRef(node_id, 2) = 0.; }
-        }
-    } // End Iterate over loading conditions.
+    // Iterate over axes to reset the forces of the loading conditions' nodes to zero.
+    for (std::size_t k = 0; k != 3; ++k) {
+        ScatterValue(this->loading_dofs_[k].data(), this->loading_dofs_[k].size(), 0., forces.col(k).data());
+    }
 
 }
 
 
 void ConditionsHandler::ApplyDirichletConditions(Eigen::MatrixXd &displacements) const
 {
-    // Check if dirichlet conditions have been added in the conditions handler.
-    if (this->dirichlet_conds_.size() == 0) {
-        std::runtime_error(Logger::Error("Cannot apply dirichlet conditions. No dirichlet "
-                                         "conditions available in the conditions handler.").c_str());
-    }
+    this->CheckConditionsCompiled();
 
-    // Iterate over dirichlet conditions.
-    for (auto &dirichlet : this->dirichlet_conds_) {
-        // Iterate over dirichlet condition's nodes indices for dirichlet application.
-        for (auto &node_id : dirichlet.NodesIds()) {
-            // Application on the X direction.
-            if (dirichlet.Direction().coeff(0) != 0) { displacements.coeffRef(node_id, 0) = 0.; }
-
-            // Application on the Y direction.
-            if (dirichlet.Direction().coeff(1) != 0) { displacements.coeffRef(node_id, 1) = 0.; }
-
-            // Application on the Z direction.
-            if (dirichlet.Direction().coeff(2) != 0) { displacements.coeffRef(node_id, 2) = 0.; }
-        }
+    // Iterate over axes to fix the displacements of the dirichlet conditions' nodes.
+    for (std::size_t k = 0; k != 3; ++k) {
+        ScatterValue(this->dirichlet_dofs_[k].data(), this->dirichlet_dofs_[k].size(), 0., displacements.col(k).data());
     }
 
 }
 
 
-void ConditionsHandler::RestoreDescribedDisplacements(const Eigen::MatrixXd &original_disp, Eigen::MatrixXd &current_disp) const
+void ConditionsHandler::ApplyConstraints(const int &time_step, Eigen::MatrixXd &displacements) const
 {
-    // Check if dirichlet conditions have been added in the conditions handler.
-    if (this->dirichlet_conds_.size() == 0) {
-        std::runtime_error(Logger::Error("Cannot apply dirichlet conditions. No dirichlet "
-                                         "conditions available in the conditions handler.").c_str());
+    this->CheckConditionsCompiled();
+
+    // Evaluate the load curves once for all the axes.
+    const auto &curve_values = this->LoadCurveValues(time_step);
+
+    // Iterate over axes. The dirichlet conditions are applied after the loading conditions of each axis.
+    for (std::size_t k = 0; k != 3; ++k) {
+        double *column = displacements.col(k).data();
+        this->ApplyAxisLoadings(k, curve_values, column);
+        ScatterValue(this->dirichlet_dofs_[k].data(), this->dirichlet_dofs_[k].size(), 0., column);
     }
 
-    // Iterate over dirichlet conditions.
-    for (auto &dirichlet : this->dirichlet_conds_) {
-        // Iterate over dirichlet condition's nodes indices for dirichlet application.
-        for (auto &node_id : dirichlet.NodesIds()) {
-            // Application on the X direction.
-            if (dirichlet.Direction().coeff(0) != 0) { current_disp.coeffRef(node_id, 0) = original_disp.coeffRef(node_id, 0); }
+}
 
-            // Application on the Y direction.
-            if (dirichlet.Direction().coeff(1) != 0) { current_disp.coeffRef(node_id, 1) = original_disp.coeffRef(node_id, 1); }
 
-            // Application on the Z direction.
-            if (dirichlet.Direction().coeff(2) != 0) { current_disp.coeffRef(node_id, 2) = original_disp.coeffRef(node_id, 2); }
-        }
+void ConditionsHandler::ResetConstrainedForces(Eigen::MatrixXd &forces) const
+{
+    this->CheckConditionsCompiled();
+
+    // Iterate over axes to reset the forces of the constrained nodes to zero.
+    for (std::size_t k = 0; k != 3; ++k) {
+        double *column = forces.col(k).data();
+        ScatterValue(this->loading_dofs_[k].data(), this->loading_dofs_[k].size(), 0., column);
+        ScatterValue(this->dirichlet_dofs_[k].data(), this->dirichlet_dofs_[k].size(), 0., column);
     }
 
-    // Iterate over loading conditions.
-    for (auto &loading : this->loading_conds_) {
-        // Iterate over loading condition's nodes indices to reset force to zero.
-        for (auto &node_id : loading.NodesIds()) {
-            // Application on the X direction.
-            if (loading.Direction().coeff(0) != 0) { current_disp.coeffRef(node_id, 0) = original_disp.coeffRef(node_id, 0); }
+}
 
-            // Application on the Y direction.
-            if (loading.Direction().coeff(1) != 0) { current_disp.coeffRef(node_id, 1) = original_disp.coeffRef(node_id, 1); }
 
-            // Application on the Z direction.
-            if (loading.Direction().coeff(2) != 0) { current_disp.coeffRef(node_id, 2) = original_disp.coeffRef(node_id, 2); }
-        }
-    } // End Iterate over loading conditions.
+void ConditionsHandler::RestoreDescribedDisplacements(const Eigen::MatrixXd &original_disp, Eigen::MatrixXd &current_disp) const
+{
+    this->CheckConditionsCompiled();
+
+    // Iterate over axes to copy the original displacements of the constrained nodes.
+    for (std::size_t k = 0; k != 3; ++k) {
+        const double *original = original_disp.col(k).data();
+        double *current = current_disp.col(k).data();
+        for (const auto &node_id : this->dirichlet_dofs_[k]) { current[node_id] = original[node_id]; }
+        for (const auto &node_id : this->loading_dofs_[k]) { current[node_id] = original[node_id]; }
+    }
 
 }
 
 
 void ConditionsHandler::ApplyEbciem(const int &load_time_step, Eigen::MatrixXd &displacements) const
 {
-    // Check if dirichlet and loading conditions have been added in the conditions handler.
-    if (this->dirichlet_conds_.size() == 0 || this->loading_conds_.size() == 0) {
-        std::runtime_error(Logger::Error("Cannot apply dirichlet conditions. No dirichlet of loading "
-                                         "conditions available in the conditions handler.").c_str());
-    }
+    this->CheckConditionsCompiled();
 
-    // Create modified displacement matrix.
-    Eigen::MatrixXd mod_disp = this->ebciem_.NodalMmls().ShapeFunction().transpose()*displacements;
+    // Approximated displacements at the boundary nodes only.
+    Eigen::MatrixXd bound_disp = this->ebciem_.BoundaryShapeFunctions()*displacements;
 
-    // Initialize total imposition matrix for displacements correction.
-    Eigen::MatrixXd total_imposed = Eigen::MatrixXd::Zero(displacements.rows(), displacements.cols());
+    // Initialize the imposed corrections of the boundary nodes.
+    Eigen::MatrixXd imposed = Eigen::MatrixXd::Zero(bound_disp.rows(), bound_disp.cols());
+    const auto &offsets = this->ebciem_.BoundaryOffsets();
 
     // Iterate over dirichlet conditions.
-    for (auto &dirichlet : this->dirichlet_conds_) {
-        // The condition's index in the container.
+    for (const auto &dirichlet : this->dirichlet_conds_) {
         auto cond_id = &dirichlet - &this->dirichlet_conds_[0];
+        auto rows = static_cast<Eigen::Index>(dirichlet.NodesIds().size());
+        auto first_row = static_cast<Eigen::Index>(offsets[cond_id]);
 
-        // Initialize dirichlet imposition matrix for displacements correction.
-        Eigen::MatrixXd dirichlet_imposed = Eigen::MatrixXd::Zero(dirichlet.NodesIds().size(), displacements.cols());
-
-        // Iterate over dirichlet condition's nodes indices for dirichlet application.
-        for (auto &node_id : dirichlet.NodesIds()) {
-            // The row index of the imposed_disp matrix.
-            auto row_id = &node_id - &dirichlet.NodesIds()[0];
+        // Correct the approximated displacements to zero along the condition's directions.
+        for (Eigen::Index k = 0; k != 3; ++k) {
+            if (dirichlet.Direction().coeff(k) != 0) { imposed.col(k).segment(first_row, rows) = -bound_disp.col(k).segment(first_row, rows); }
+        }
+    }
 
-            // Application on the X direction.
-            if (dirichlet.Direction().coeff(0) != 0) { dirichlet_imposed.coeffRef(row_id, 0) = -1.*mod_disp.coeff(node_id, 0); }
+    // Iterate over loading conditions.
+    for (const auto &loading : this->loading_conds_) {
+        auto cond_id = &loading - &this->loading_conds_[0];
+        auto rows = static_cast<Eigen::Index>(loading.NodesIds().size());
+        auto first_row = static_cast<Eigen::Index>(offsets[this->dirichlet_conds_.size()+cond_id]);
+
+        // Correct the approximated displacements to the load curve value along the condition's directions.
+        const double value = loading.Curve().LoadDispAt(load_time_step);
+        for (Eigen::Index k = 0; k != 3; ++k) {
+            if (loading.Direction().coeff(k) != 0) {
+                imposed.col(k).segment(first_row, rows) = (value - bound_disp.col(k).segment(first_row, rows).array()).matrix();
+            }
+        }
+    }
 
-            // Application on the Y direction.
-            if (dirichlet.Direction().coeff(1) != 0) { dirichlet_imposed.coeffRef(row_id, 1) = -1.*mod_disp.coeff(node_id, 1); }
+    // Apply imposition correction to the affected nodes of the displacements.
+    this->ebciem_.ApplyCorrection(imposed, displacements);
 
-            // Application on the Z direction.
-            if (dirichlet.Direction().coeff(2) != 0) { dirichlet_imposed.coeffRef(row_id, 2) = -1.*mod_disp.coeff(node_id, 2); }
-        }
+}
 
-        // Update total imposition matrix (add dirichlet correction matrix * dirichlet imposition matrix).
-        total_imposed += this->ebciem_.DirichletCorrMats()[cond_id]*dirichlet_imposed;
 
-    } // End Iterate over dirichlet conditions.
+const std::vector<double> & ConditionsHandler::LoadCurveValues(const int &time_step) const
+{
+    // Fill the buffer sized by CompileConditions in place.
+    for (std::size_t c = 0; c != this->loading_conds_.size(); ++c) {
+        this->curve_values_[c] = this->loading_conds_[c].Curve().LoadDispAt(time_step);
+    }
+    return this->curve_values_;
+}
 
-    // Iterate over loading conditions.
-    for (auto &loading : this->loading_conds_) {
-        // The condition's index in the container.
-        auto cond_id = &loading - &this->loading_conds_[0];
 
-        // Initialize loading imposition matrix for displacements correction.
-        Eigen::MatrixXd loading_imposed = Eigen::MatrixXd::Zero(loading.NodesIds().size(), displacements.cols());
+void ConditionsHandler::ApplyAxisLoadings(std::size_t axis, const std::vector<double> &curve_values, double *column) const
+{
+    // Scatter the load curve value of each loading condition to its nodes.
+    const auto &offsets = this->loading_offsets_[axis];
+    for (std::size_t c = 0; c+1 < offsets.size(); ++c) {
+        ScatterValue(this->loading_dofs_[axis].data()+offsets[c], offsets[c+1]-offsets[c], curve_values[c], column);
+    }
+}
 
-        // Iterate over loading condition's nodes indices for loading application.
-        for (auto &node_id : loading.NodesIds()) {
-            // The row index of the imposed_disp matrix.
-            auto row_id = &node_id - &loading.NodesIds()[0];
 
-            // Application on the X direction.
-            if (loading.Direction().coeff(0) != 0) {
-                loading_imposed.coeffRef(row_id, 0) = loading.Curve().LoadDispAt(load_time_step) - mod_disp.coeff(node_id, 0);
+void ConditionsHandler::CompileConditions()
+{
+    for (std::size_t k = 0; k != 3; ++k) {
+        // Group the node indices of the loading conditions that apply on the axis.
+        this->loading_dofs_[k].clear();
+        this->loading_offsets_[k].assign(1, 0);
+        for (const auto &loading : this->loading_conds_) {
+            if (loading.Direction().coeff(k) != 0) {
+                this->loading_dofs_[k].insert(this->loading_dofs_[k].end(), loading.NodesIds().begin(), loading.NodesIds().end());
             }
+            this->loading_offsets_[k].emplace_back(this->loading_dofs_[k].size());
+        }
 
-            // Application on the Y direction.
-            if (loading.Direction().coeff(1) != 0) {
-                loading_imposed.coeffRef(row_id, 1) = loading.Curve().LoadDispAt(load_time_step) - mod_disp.coeff(node_id, 1);
+        // Collect the node indices of the dirichlet conditions that apply on the axis.
+        this->dirichlet_dofs_[k].clear();
+        for (const auto &dirichlet : this->dirichlet_conds_) {
+            if (dirichlet.Direction().coeff(k) != 0) {
+                this->dirichlet_dofs_[k].insert(this->dirichlet_dofs_[k].end(), dirichlet.NodesIds().begin(), dirichlet.NodesIds().end());
             }
+        }
+    }
 
-            // Application on the Z direction.
-            if (loading.Direction().coeff(2) != 0) {
-                loading_imposed.coeffRef(row_id, 2) = loading.Curve().LoadDispAt(load_time_step) - mod_disp.coeff(node_id, 2);
-            }
+    // Allocate the load curve values buffer once for all the applications.
+    this->curve_values_.assign(this->loading_conds_.size(), 0.);
+}
 
-        } // End Iterate over loading condition's nodes indices for loading application.
 
-        // Update total imposition matrix (add loading correction matrix * loading imposition matrix).
-        total_imposed += this->ebciem_.LoadingCorrMats()[cond_id]*loading_imposed;
+void ConditionsHandler::InvalidateCompiledConditions()
+{
+    this->bound_node_ids_are_extracted_ = false;
+    for (std::size_t k = 0; k != 3; ++k) {
+        this->loading_dofs_[k].clear();
+        this->loading_offsets_[k].clear();
+        this->dirichlet_dofs_[k].clear();
+    }
+    this->curve_values_.clear();
+}
 
-    } // End Iterate over loading conditions.
 
-    // Apply imposition correction to displacements.
-    displacements += total_imposed;
+void ConditionsHandler::CheckConditionsCompiled() const
+{
+    // A handler without conditions has nothing to apply.
+    if (this->loading_conds_.empty() && this->dirichlet_conds_.empty()) { return; }
 
+    if (!this->bound_node_ids_are_extracted_) {
+        throw std::runtime_error(Logger::Error("Could not apply the boundary conditions. The node indices of the "
+                                               "conditions have not been extracted since the last added condition.").c_str());
+    }
 }
 
 
@@ -44,6 +44,9 @@
 
 #include <Eigen/Dense>
 
+#include <cstddef>
+#include <array>
+#include <memory>
 #include <algorithm>
 #include <string>
 #include <vector>
@@ -64,6 +67,11 @@ namespace CLOUDEA {
  * \class ConditionsHandler
  * \brief Class handling the imposition of the boundary conditions.
  *
+ * The loading and dirichlet conditions are compiled, when their node indices are extracted, in flat arrays of the
+ * constrained node indices per axis. The loading indices are grouped by condition, so that the load curve value
+ * of each condition is fetched once per application and scattered to the displacements columns.
+ * Adding a condition invalidates the compiled arrays until the node indices are extracted again.
+ *
  * \note Conditions are handled by reading the boundary id of the mesh.
  * Some nodes have more than one conditions and should see how to process correctly
  * under general conditions for extraction of the nodes ids.
@@ -87,6 +95,9 @@ public:
 
     /*!
      * \brief Add a loading condition in the imposition handler of boundary conditions.
+     *
+     * The boundary node indices must be extracted again before the conditions are applied.
+     *
      * \param [in] load_curve The load curve of the added loading condition for imposition.
      * \param [in] x The conditional stating if the added loading condition is applied on the x axis.
      * \param [in] y The conditional stating if the added loading condition is applied on the y axis.
@@ -100,6 +111,9 @@ public:
 
     /*!
      * \brief Add a dirichlet condition in the imposition handler of boundary conditions.
+     *
+     * The boundary node indices must be extracted again before the conditions are applied.
+     *
      * \param [in] x The conditional stating if the added dirichlet condition is applied on the x axis.
      * \param [in] y The conditional stating if the added dirichlet condition is applied on the y axis.
      * \param [in] z The conditional stating if the added dirichlet condition is applied on the z axis.
@@ -112,7 +126,7 @@ public:
     void AddEbciem(const WeakModel3D &model, const InfSupportDomain &support,
                    const std::string &mmls_base_func_type, const bool &use_mmls_exact_derivs, const bool &is_simplified);
 
-    void AddEbciem2(const WeakModel3D &model, const Mmls3d &approximants, const bool &is_simplified);
+    void AddEbciem2(const WeakModel3D &model, const std::shared_ptr<const Mmls3d> &approximants, const bool &is_simplified);
 
 
     /*!
@@ -149,6 +163,35 @@ public:
     void ApplyDirichletConditions(Eigen::MatrixXd &displacements) const;
 
 
+    /*!
+     * \brief Apply the loading and the dirichlet conditions on the displacements matrix in a single pass.
+     *
+     * Equivalent to ApplyLoadingConditions followed by ApplyDirichletConditions.
+     *
+     * \param [in] time_step The timestep of which the corresponding loading conditions will be applied on the displacements matrix.
+     * \param [out] displacements The displacements matrix to be processed for conditions application.
+     * \return [void]
+     */
+    void ApplyConstraints(const int &time_step, Eigen::MatrixXd &displacements) const;
+
+
+    /*!
+     * \brief Reset to zero the forces matrix entries that correspond to the constrained degrees of freedom of the loading and dirichlet conditions.
+     *
+     * Equivalent to ResetLoadingConditionsForces followed by ApplyDirichletConditions on the forces matrix.
+     *
+     * \param [out] forces The forces matrix where the entries of the constrained degrees of freedom will be set to zero.
+     * \return [void]
+     */
+    void ResetConstrainedForces(Eigen::MatrixXd &forces) const;
+
+
+    /*!
+     * \brief Restore the displacements of the constrained degrees of freedom of the dirichlet and loading conditions.
+     * \param [in] original_disp The displacements matrix with the described displacements.
+     * \param [out] current_disp The displacements matrix where the described displacements are restored.
+     * \return [void]
+     */
     void RestoreDescribedDisplacements(const Eigen::MatrixXd &original_disp, Eigen::MatrixXd &current_disp) const;
 
 
@@ -183,6 +226,64 @@ public:
 
 
 
+protected:
+
+    /*!
+     * \brief Compile the loading and dirichlet conditions in flat arrays of constrained node indices per axis.
+     * \return [void]
+     */
+    void CompileConditions();
+
+
+    /*!
+     * \brief Invalidate the compiled conditions and the extraction of the boundary node indices.
+     * \return [void]
+     */
+    void InvalidateCompiledConditions();
+
+
+    /*!
+     * \brief Check that the node indices of the conditions have been extracted and compiled since the last added condition.
+     * \return [void]
+     */
+    void CheckConditionsCompiled() const;
+
+
+    /*!
+     * \brief Evaluate the load curves of the loading conditions at a time step.
+     *
+     * The values are written in place in a buffer of the handler, so the conditions of a handler
+     * must not be applied concurrently.
+     *
+     * \param [in] time_step The timestep of the evaluation.
+     * \return [std::vector<double>] The displacement of the load curve of each loading condition.
+     */
+    const std::vector<double> & LoadCurveValues(const int &time_step) const;
+
+
+    /*!
+     * \brief Apply the loading conditions of an axis on a displacements column.
+     * \param [in] axis The index of the axis.
+     * \param [in] curve_values The displacement of the load curve of each loading condition.
+     * \param [out] column The data of the displacements column of the axis.
+     * \return [void]
+     */
+    void ApplyAxisLoadings(std::size_t axis, const std::vector<double> &curve_values, double *column) const;
+
+
+    /*!
+     * \brief Assign a value to the entries of a matrix column.
+     * \param [in] ids The row indices of the entries.
+     * \param [in] ids_num The number of the entries.
+     * \param [in] value The assigned value.
+     * \param [out] column The data of the matrix column.
+     * \return [void]
+     */
+    inline static void ScatterValue(const int *ids, std::size_t ids_num, double value, double *column) {
+        for (std::size_t i = 0; i != ids_num; ++i) { column[ids[i]] = value; }
+    }
+
+
 private:
     std::vector<Loading> loading_conds_;         /*!< The container of the loading conditions to be imposed. */
 
@@ -192,6 +293,14 @@ private:
 
     Ebciem ebciem_;                              /*!< The EBCIEM correction for essential conditions imposition. */
 
+    std::array<std::vector<int>, 3> loading_dofs_;              /*!< The node indices of the loading conditions per axis, grouped by condition. */
+
+    std::array<std::vector<std::size_t>, 3> loading_offsets_;   /*!< The offsets of the loading conditions' groups in the node indices per axis. */
+
+    std::array<std::vector<int>, 3> dirichlet_dofs_;            /*!< The node indices of the dirichlet conditions per axis. */
+
+    mutable std::vector<double> curve_values_;                  /*!< The load curve value of each loading condition at the applied time step. */
+
 };
 
 
@@ -24,7 +24,7 @@
 namespace CLOUDEA {
 
 
-Ebciem::Ebciem()
+Ebciem::Ebciem() : nodal_mmls_(std::make_shared<const Mmls3d>())
 {}
 
 
@@ -34,8 +34,10 @@ Ebciem::~Ebciem()
 
 void Ebciem::SetNodalMmlsProperties(const std::string &basis_func_type, const bool &use_exact_derivatives)
 {
-    this->nodal_mmls_.SetBasisFunctionType(basis_func_type);
-    this->nodal_mmls_.SetExactDerivativesMode(use_exact_derivatives);
+    auto nodal_mmls = std::make_shared<Mmls3d>();
+    nodal_mmls->SetBasisFunctionType(basis_func_type);
+    nodal_mmls->SetExactDerivativesMode(use_exact_derivatives);
+    this->nodal_mmls_ = nodal_mmls;
 }
 
 
@@ -56,12 +58,22 @@ void Ebciem::ComputeCorrectionMatrices(const WeakModel3D &model, const InfSuppor
     }
 
 
+    // Check if the properties of the nodal mmls approximants are set.
+    if (this->nodal_mmls_->BaseFunctionType().empty()) {
+        throw std::runtime_error(Logger::Error("Could not apply EBCIEM correction. "
+                                               "The properties of the nodal MMLS approximants are not set.").c_str());
+    }
+
     // Find influence nodes indices of the model's mesh nodes.
-    auto neighs_ids = support.CgalClosestNodesIdsTo(model.TetrahedralMesh().NodeCoordinates());
+    const auto nodes_coords = model.TetrahedralMesh().NodeCoordinates();
+    auto neighs_ids = support.CgalClosestNodesIdsTo(nodes_coords);
 
-    // Compute shape functions and derivatives.
-    this->nodal_mmls_.ComputeShFuncAndDerivs(model.TetrahedralMesh().Nodes(), model.TetrahedralMesh().NodeCoordinates(),
-                                             neighs_ids, support.InfluenceNodesRadiuses());
+    // Compute shape functions and derivatives in new approximants. Views of the previous ones remain valid.
+    auto nodal_mmls = std::make_shared<Mmls3d>();
+    nodal_mmls->SetBasisFunctionType(this->nodal_mmls_->BaseFunctionType());
+    nodal_mmls->SetExactDerivativesMode(this->nodal_mmls_->UseExactDerivatives());
+    nodal_mmls->ComputeShFuncAndDerivs(model.TetrahedralMesh().Nodes(), nodes_coords, neighs_ids, support.InfluenceNodesRadiuses());
+    this->nodal_mmls_ = nodal_mmls;
 
     // Initialize inverse mass matrix triplet.
     std::vector<Eigen::Triplet<double> > inv_mass_trip;
@@ -77,9 +89,9 @@ void Ebciem::ComputeCorrectionMatrices(const WeakModel3D &model, const InfSuppor
     Eigen::SparseMatrix<double> inv_mass(model.TetrahedralMesh().NodesNum(), model.TetrahedralMesh().NodesNum());
     inv_mass.setFromTriplets(inv_mass_trip.begin(), inv_mass_trip.end());
 
-    // Reset correction matrices containers.
-    this->dirichlet_corr_mats_.clear(); this->dirichlet_corr_mats_.reserve(dirichlet_conds.size());
-    this->loading_corr_mats_.clear(); this->loading_corr_mats_.reserve(loading_conds.size());
+    // Reset correction containers.
+    this->corr_bases_.clear(); this->corr_bases_.reserve(dirichlet_conds.size() + loading_conds.size());
+    this->corr_factors_.clear(); this->corr_factors_.reserve(dirichlet_conds.size() + loading_conds.size());
 
     // Set simplified to true until full EBCIEM is implemented.
     if (!is_simplified) {
@@ -93,15 +105,13 @@ void Ebciem::ComputeCorrectionMatrices(const WeakModel3D &model, const InfSuppor
         // Dirichlet nodes correction matrices.
         for (const auto &dirichlet : dirichlet_conds) {
             // Add dirichlet boundary correction matrix.
-            this->dirichlet_corr_mats_.emplace_back(this->SebciemCorrMat(model.TetrahedralMesh().NodesNum(),
-                                                                     dirichlet.NodesIds(), inv_mass));
+            this->AddSebciemCorrection(model.TetrahedralMesh().NodesNum(), dirichlet.NodesIds(), inv_mass);
         }
 
         // Loading nodes correction matrices.
         for (const auto &loading : loading_conds) {
             // Add loading boundary correction matrix.
-            this->loading_corr_mats_.emplace_back(this->SebciemCorrMat(model.TetrahedralMesh().NodesNum(),
-                                                                     loading.NodesIds(), inv_mass));
+            this->AddSebciemCorrection(model.TetrahedralMesh().NodesNum(), loading.NodesIds(), inv_mass);
         }
 
     }
@@ -109,11 +119,14 @@ void Ebciem::ComputeCorrectionMatrices(const WeakModel3D &model, const InfSuppor
         //nothing to do for now.
     } // Get the correction matrices.
 
+    // Compute the reduced shape functions operator of the boundary nodes.
+    this->ComputeBoundaryShapeFunctions(dirichlet_conds, loading_conds);
+
 
 }
 
 
-void Ebciem::ComputeCorrectionMatrices2(const WeakModel3D &model, const Mmls3d &approximants,
+void Ebciem::ComputeCorrectionMatrices2(const WeakModel3D &model, const std::shared_ptr<const Mmls3d> &approximants,
                                        const std::vector<Dirichlet> &dirichlet_conds,
                                        const std::vector<Loading> &loading_conds, bool is_simplified)
 {
@@ -129,7 +142,13 @@ void Ebciem::ComputeCorrectionMatrices2(const WeakModel3D &model, const Mmls3d &
                                                   "The Loading conditions container is empty.").c_str());
     }
 
-    // Set the shape functions and derivatives.
+    // Check if the approximants view is valid.
+    if (!approximants) {
+        throw std::invalid_argument(Logger::Error("Could not apply EBCIEM correction. "
+                                                  "The given approximants view is empty.").c_str());
+    }
+
+    // Share the shape functions and derivatives.
     this->nodal_mmls_ = approximants;
 
     // Initialize inverse mass matrix triplet.
@@ -146,9 +165,9 @@ void Ebciem::ComputeCorrectionMatrices2(const WeakModel3D &model, const Mmls3d &
     Eigen::SparseMatrix<double> inv_mass(model.TetrahedralMesh().NodesNum(), model.TetrahedralMesh().NodesNum());
     inv_mass.setFromTriplets(inv_mass_trip.begin(), inv_mass_trip.end());
 
-    // Reset correction matrices containers.
-    this->dirichlet_corr_mats_.clear(); this->dirichlet_corr_mats_.reserve(dirichlet_conds.size());
-    this->loading_corr_mats_.clear(); this->loading_corr_mats_.reserve(loading_conds.size());
+    // Reset correction containers.
+    this->corr_bases_.clear(); this->corr_bases_.reserve(dirichlet_conds.size() + loading_conds.size());
+    this->corr_factors_.clear(); this->corr_factors_.reserve(dirichlet_conds.size() + loading_conds.size());
 
     // Set simplified to true until full EBCIEM is implemented.
     if (!is_simplified) {
@@ -162,13 +181,13 @@ void Ebciem::ComputeCorrectionMatrices2(const WeakModel3D &model, const Mmls3d &
         // Dirichlet nodes correction matrices.
         for (const auto &dirichlet : dirichlet_conds) {
             // Add dirichlet boundary correction matrix.
-            this->dirichlet_corr_mats_.emplace_back(this->SebciemCorrMat(model.TetrahedralMesh().NodesNum(), dirichlet.NodesIds(), inv_mass));
+            this->AddSebciemCorrection(model.TetrahedralMesh().NodesNum(), dirichlet.NodesIds(), inv_mass);
         }
 
         // Loading nodes correction matrices.
         for (const auto &loading : loading_conds) {
             // Add loading boundary correction matrix.
-            this->loading_corr_mats_.emplace_back(this->SebciemCorrMat(model.TetrahedralMesh().NodesNum(), loading.NodesIds(), inv_mass));
+            this->AddSebciemCorrection(model.TetrahedralMesh().NodesNum(), loading.NodesIds(), inv_mass);
         }
 
     }
@@ -176,12 +195,73 @@ void Ebciem::ComputeCorrectionMatrices2(const WeakModel3D &model, const Mmls3d &
         //nothing to do for now.
     } // Get the correction matrices.
 
+    // Compute the reduced shape functions operator of the boundary nodes.
+    this->ComputeBoundaryShapeFunctions(dirichlet_conds, loading_conds);
+
+
+}
+
+
+void Ebciem::ApplyCorrection(const Eigen::MatrixXd &imposed, Eigen::MatrixXd &displacements) const
+{
+    // Check if the imposed corrections correspond to the boundary nodes.
+    if (static_cast<std::size_t>(imposed.rows()) != this->bound_offsets_.back()) {
+        throw std::invalid_argument(Logger::Error("Could not apply EBCIEM correction. The imposed corrections "
+                                                  "do not correspond to the boundary nodes.").c_str());
+    }
+
+    // Iterate over the corrections of the dirichlet and then the loading conditions.
+    for (std::size_t c = 0; c != this->corr_bases_.size(); ++c) {
+        const auto &corr_basis = this->corr_bases_[c];
+        auto first_row = static_cast<Eigen::Index>(this->bound_offsets_[c]);
 
+        // Skip boundaries without imposed corrections.
+        const auto bound_imposed = imposed.middleRows(first_row, corr_basis.cols());
+        if (bound_imposed.isZero(0.)) { continue; }
+
+        // Solve with the boundary's factorization for the correction weights of the boundary nodes.
+        Eigen::MatrixXd corr_weights = this->corr_factors_[c]->solve(Eigen::MatrixXd(bound_imposed));
+
+        // Scatter the correction of each boundary node to the nodes affected by it.
+        for (Eigen::Index j = 0; j != corr_basis.outerSize(); ++j) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(corr_basis, j); it; ++it) {
+                displacements.row(it.row()) += it.value() * corr_weights.row(j);
+            }
+        }
+    }
+}
+
+
+void Ebciem::ComputeBoundaryShapeFunctions(const std::vector<Dirichlet> &dirichlet_conds, const std::vector<Loading> &loading_conds)
+{
+    const auto &shape_funcs = this->nodal_mmls_->ShapeFunction();
+
+    // Offsets of the dirichlet and loading conditions' rows.
+    this->bound_offsets_.assign(1, 0);
+    for (const auto &dirichlet : dirichlet_conds) { this->bound_offsets_.emplace_back(this->bound_offsets_.back() + dirichlet.NodesIds().size()); }
+    for (const auto &loading : loading_conds) { this->bound_offsets_.emplace_back(this->bound_offsets_.back() + loading.NodesIds().size()); }
+
+    // Gather the columns of the shape functions matrix of the boundary nodes as rows.
+    std::vector<Eigen::Triplet<double> > bound_trip;
+    Eigen::Index row_id = 0;
+    auto gather_rows = [&](const std::vector<int> &nodes_ids) {
+        for (const auto &node_id : nodes_ids) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(shape_funcs, node_id); it; ++it) {
+                bound_trip.emplace_back(Eigen::Triplet<double>(row_id, it.row(), it.value()));
+            }
+            row_id++;
+        }
+    };
+    for (const auto &dirichlet : dirichlet_conds) { gather_rows(dirichlet.NodesIds()); }
+    for (const auto &loading : loading_conds) { gather_rows(loading.NodesIds()); }
+
+    this->bound_shape_funcs_.resize(static_cast<Eigen::Index>(this->bound_offsets_.back()), shape_funcs.rows());
+    this->bound_shape_funcs_.setFromTriplets(bound_trip.begin(), bound_trip.end());
 }
 
 
-Eigen::SparseMatrix<double> Ebciem::SebciemCorrMat(const int &model_nodes_num, const std::vector<int> &bound_nodes_ids,
-                                                   const Eigen::SparseMatrix<double> &model_inv_mass_mat) const
+void Ebciem::AddSebciemCorrection(const int &model_nodes_num, const std::vector<int> &bound_nodes_ids,
+                                  const Eigen::SparseMatrix<double> &model_inv_mass_mat)
 {
     // Initialize V matrix for EBCIEM.
     Eigen::SparseMatrix<double> v_mat(model_nodes_num, bound_nodes_ids.size());
@@ -190,26 +270,22 @@ Eigen::SparseMatrix<double> Ebciem::SebciemCorrMat(const int &model_nodes_num, c
     // Iterate over boundary nodes.
     for (const auto &node_id : bound_nodes_ids) {
         auto it_id = &node_id - &bound_nodes_ids[0];
-        v_mat.col(it_id) = this->nodal_mmls_.ShapeFunction().col(node_id);
+        v_mat.col(it_id) = this->nodal_mmls_->ShapeFunction().col(node_id);
     }
 
-    // Compute decomposition of the v_mat_transpose*inv_mass*v_mat product.
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > decomp_prod;
-    decomp_prod.compute(v_mat.transpose()*model_inv_mass_mat*v_mat);
-
-    // Compute identity matrix.
-    Eigen::SparseMatrix<double> identity(bound_nodes_ids.size(), bound_nodes_ids.size());
-    identity.setIdentity();
+    // Compute the correction basis. It has the sparsity of the boundary nodes' shape functions.
+    Eigen::SparseMatrix<double> corr_basis = model_inv_mass_mat*v_mat;
 
-    // Compute the inverse matrix of the product.
-    Eigen::SparseMatrix<double> inv_prod = decomp_prod.solve(identity);
-
-    // Compute the correction matrix.
-    Eigen::SparseMatrix<double> corr_mat = model_inv_mass_mat*v_mat*inv_prod;
-
-    // Return the correction matrix.
-    return corr_mat;
+    // Compute and keep the decomposition of the v_mat_transpose*inv_mass*v_mat product.
+    auto decomp_prod = std::make_shared<Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > >();
+    decomp_prod->compute(v_mat.transpose()*corr_basis);
+    if (decomp_prod->info() != Eigen::Success) {
+        throw std::runtime_error(Logger::Error("Could not compute EBCIEM correction. The boundary shape functions "
+                                               "product is not positive definite.").c_str());
+    }
 
+    this->corr_bases_.emplace_back(std::move(corr_basis));
+    this->corr_factors_.emplace_back(std::move(decomp_prod));
 }
 
 
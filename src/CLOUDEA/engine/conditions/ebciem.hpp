@@ -39,6 +39,8 @@
 #include <Eigen/Sparse>
 #include <Eigen/SparseCholesky>
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -100,7 +102,7 @@ public:
                                    const std::vector<Dirichlet> &dirichlet_conds,
                                    const std::vector<Loading> &loading_conds, bool is_simplified);
 
-    void ComputeCorrectionMatrices2(const WeakModel3D &model, const Mmls3d &approximants,
+    void ComputeCorrectionMatrices2(const WeakModel3D &model, const std::shared_ptr<const Mmls3d> &approximants,
                                     const std::vector<Dirichlet> &dirichlet_conds,
                                     const std::vector<Loading> &loading_conds, bool is_simplified);
 
@@ -109,44 +111,84 @@ public:
      * \brief Get the nodal mmsl approximant.
      * \return [CLOUDEA::Mmls3d] The nodal mmsl approximant.
      */
-    inline const Mmls3d & NodalMmls() const { return this->nodal_mmls_; }
+    inline const Mmls3d & NodalMmls() const { return *this->nodal_mmls_; }
 
 
     /*!
-     * \brief Get the correction matrices of the fixed boundaries.
-     * \return [std::vector<Eigen::SparseMatrix<double> >] The correction matrices of the fixed boundaries.
+     * \brief Get the correction bases M^-1 V of the fixed and then the displaced boundaries.
+     *
+     * The column j of the correction basis of a boundary is the nodal shape function of its j-th node scaled by the inverse nodal masses.
+     *
+     * \return [std::vector<Eigen::SparseMatrix<double> >] The correction bases of the boundaries.
      */
-    inline const std::vector<Eigen::SparseMatrix<double> > & DirichletCorrMats() const { return this->dirichlet_corr_mats_; }
+    inline const std::vector<Eigen::SparseMatrix<double> > & CorrectionBases() const { return this->corr_bases_; }
 
 
     /*!
-     * \brief Get the correction matrices of the displaced boundaries.
-     * \return [std::vector<Eigen::SparseMatrix<double> >] The correction matrices of the displaced boundaries.
+     * \brief Get the rows of the transposed nodal shape functions matrix at the boundary nodes.
+     *
+     * The rows follow the nodes of the dirichlet conditions and then the nodes of the loading conditions, in the order
+     * of the conditions. The product with the displacements gives the approximated displacements at the boundary nodes.
+     *
+     * \return [Eigen::SparseMatrix<double, Eigen::RowMajor>] The reduced shape functions operator of the boundary nodes.
      */
-    inline const std::vector<Eigen::SparseMatrix<double> > & LoadingCorrMats() const { return this->loading_corr_mats_; }
+    inline const Eigen::SparseMatrix<double, Eigen::RowMajor> & BoundaryShapeFunctions() const { return this->bound_shape_funcs_; }
+
+
+    /*!
+     * \brief Get the offsets of the conditions' rows in the reduced shape functions operator of the boundary nodes.
+     * \return [std::vector<std::size_t>] The offsets of the dirichlet and then the loading conditions' rows. The last entry is the total number of rows.
+     */
+    inline const std::vector<std::size_t> & BoundaryOffsets() const { return this->bound_offsets_; }
+
+
+    /*!
+     * \brief Apply the correction of the imposed boundary displacements on the affected nodes.
+     * \param [in] imposed The imposed displacement corrections of the boundary nodes, in the rows order of the reduced shape functions operator.
+     * \param [out] displacements The displacements matrix to be corrected.
+     * \return [void]
+     */
+    void ApplyCorrection(const Eigen::MatrixXd &imposed, Eigen::MatrixXd &displacements) const;
 
 
 
 protected:
 
     /*!
-     * \brief Create and get the correction matrix for a specific boundary using (s)implified EBCIEM.
+     * \brief Compute the reduced shape functions operator of the boundary nodes.
+     * \param [in] dirichlet_conds The fixed boundary conditions container.
+     * \param [in] loading_conds The displaced boundary conditions container.
+     * \return [void]
+     */
+    void ComputeBoundaryShapeFunctions(const std::vector<Dirichlet> &dirichlet_conds, const std::vector<Loading> &loading_conds);
+
+
+    /*!
+     * \brief Compute the correction basis and the Cholesky factorization of the (s)implified EBCIEM correction of a specific boundary.
+     *
+     * The correction M^-1 V (V^T M^-1 V)^-1 is applied at run time by solving with the kept factorization,
+     * thus the dense nodes x boundary nodes correction matrix is never formed.
+     *
      * \param [in] model_nodes_num The number of the model's geometry nodes.
      * \param [in] bound_nodes_ids The indices of the nodes belonging to the specific boundary.
      * \param [in] model_inv_mass_mat The inverse of the model's nodal mass matrix.
      * \return [void]
      */
-    Eigen::SparseMatrix<double> SebciemCorrMat(const int &model_nodes_num, const std::vector<int> &bound_nodes_ids,
-                                               const Eigen::SparseMatrix<double> &model_inv_mass_mat) const;
+    void AddSebciemCorrection(const int &model_nodes_num, const std::vector<int> &bound_nodes_ids,
+                              const Eigen::SparseMatrix<double> &model_inv_mass_mat);
 
 
 private:
 
-    Mmls3d nodal_mmls_;                                             /*!< The mmls approximants of the nodes of the specified model. */
+    std::shared_ptr<const Mmls3d> nodal_mmls_;                         /*!< The mmls approximants of the nodes of the specified model. Shared if they were given. */
+
+    std::vector<Eigen::SparseMatrix<double> > corr_bases_;             /*!< The correction bases M^-1 V of the fixed and then the displaced boundaries. */
+
+    std::vector<std::shared_ptr<const Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > > > corr_factors_;   /*!< The Cholesky factorizations of V^T M^-1 V of the boundaries. */
 
-    std::vector<Eigen::SparseMatrix<double> > dirichlet_corr_mats_;     /*!< The correction matrices for all the fixed boundaries. */
+    Eigen::SparseMatrix<double, Eigen::RowMajor> bound_shape_funcs_;   /*!< The rows of the transposed nodal shape functions matrix at the boundary nodes. */
 
-    std::vector<Eigen::SparseMatrix<double> > loading_corr_mats_;      /*!< The correction matrices for all the displaced boundaries. */
+    std::vector<std::size_t> bound_offsets_;                           /*!< The offsets of the conditions' rows in the boundary shape functions operator. */
 
 };
 
@@ -23,7 +23,8 @@
 
 namespace CLOUDEA {
 
-LoadCurve::LoadCurve() : load_time_(0.), max_displacement_(0.), load_steps_num_(0)
+LoadCurve::LoadCurve() : load_time_(0.), max_displacement_(0.), load_steps_num_(0), solver_time_step_(0.),
+                         shape_(LoadCurveShape::smooth_step), frequency_(0.)
 {}
 
 
@@ -31,74 +32,86 @@ LoadCurve::~LoadCurve()
 {}
 
 
-void LoadCurve::ComputeLoadStepsNum(const double &solver_time_step)
+void LoadCurve::SetShape(const LoadCurveShape &shape)
 {
-    // Check if loading curve application time is initialized to a "reasonable" value.
-    if (this->load_time_ < 0.0000001) {
-        std::string error = "[CLOUDEA ERROR] Cannot compute number of load curve application steps. "
-                            "The load curve application time has not been set or is too small.";
-        throw std::runtime_error(error.c_str());
+    this->shape_ = shape;
+
+    // Invalidate the load steps of a tabulated load curve without a table.
+    if (this->shape_ == LoadCurveShape::tabulated && this->table_times_.empty()) {
+        this->load_steps_num_ = 0;
     }
+}
 
-    // Compute the number of time steps for load curve application.
-    this->load_steps_num_ = static_cast<int>(std::floor((this->load_time_ / solver_time_step) + 0.5));
 
+void LoadCurve::SetFrequency(const double &frequency)
+{
+    if (frequency < 0.) {
+        std::string error = "[CLOUDEA ERROR] Cannot set the load curve frequency. The frequency can not be negative.";
+        throw std::invalid_argument(error.c_str());
+    }
+    this->frequency_ = frequency;
 }
 
 
-void LoadCurve::ComputeLoadStepDisplacements(const double &solver_time_step)
+void LoadCurve::SetTable(const std::vector<double> &times, const std::vector<double> &amplitudes)
 {
-
-    // Check if the maximum displacement that is applied by the load curve is initialized.
-    if (std::abs(this->max_displacement_) < 0.0000001) {
-        std::string error = "[CLOUDEA ERROR] Cannnot compute the displacement variation in each loading time step. "
-                            "The maximum displacement to be applied by the load curve is not initialized.";
-        throw std::runtime_error(error.c_str());
+    // Check the consistency of the table.
+    if (times.empty() || times.size() != amplitudes.size()) {
+        std::string error = "[CLOUDEA ERROR] Cannot set the load curve table. The times and amplitudes must be non-empty and of equal size.";
+        throw std::invalid_argument(error.c_str());
     }
-
-    // Check if the number of time steps for load curve application has been computed.
-    if (this->load_steps_num_ <= 0) {
-        std::string error = "[CLOUDEA ERROR] Cannnot compute the displacement variation in each loading time step. "
-                            "The number of loading steps has not been computed.";
-        throw std::runtime_error(error.c_str());
+    if (!std::is_sorted(times.begin(), times.end())) {
+        std::string error = "[CLOUDEA ERROR] Cannot set the load curve table. The times must be in increasing order.";
+        throw std::invalid_argument(error.c_str());
     }
 
-    // Clear the container of the displacement variation in each loading time step.
-    this->load_step_displacements_.clear();
-
-    // The total loading application time with respect to the solver's time step.
-    double total_load_time = this->load_steps_num_ * solver_time_step;
-
-    // Compute the displacement variation in each loading step.
-    double load_step_displacement = 0.;
-    for (auto load_step = 0; load_step != this->load_steps_num_; ++load_step) {
+    this->table_times_ = times;
+    this->table_amplitudes_ = amplitudes;
+}
 
-        // The normalized loading time step.
-        double norm_tstep = ((load_step+1) * solver_time_step) / total_load_time;
 
-        // Calculate loading step's displacement.
-        load_step_displacement = this->max_displacement_ * (10.*norm_tstep*norm_tstep*norm_tstep -
-                                                            15.*norm_tstep*norm_tstep*norm_tstep*norm_tstep +
-                                                            6.*norm_tstep*norm_tstep*norm_tstep*norm_tstep*norm_tstep);
+void LoadCurve::ComputeLoadStepsNum(const double &solver_time_step)
+{
+    // Check if loading curve application time is initialized to a "reasonable" value.
+    if (this->load_time_ < 0.0000001) {
+        std::string error = "[CLOUDEA ERROR] Cannot compute number of load curve application steps. "
+                            "The load curve application time has not been set or is too small.";
+        throw std::runtime_error(error.c_str());
+    }
 
-        // Store the loading step's displacement in the container.
-        this->load_step_displacements_.emplace_back(load_step_displacement);
+    // Check if the solver time step is positive.
+    if (solver_time_step <= 0.) {
+        std::string error = "[CLOUDEA ERROR] Cannot compute number of load curve application steps. "
+                            "The solver time step must be positive.";
+        throw std::invalid_argument(error.c_str());
+    }
 
+    // Check if the tabulated load curve has a table.
+    if (this->shape_ == LoadCurveShape::tabulated && this->table_times_.empty()) {
+        std::string error = "[CLOUDEA ERROR] Cannot compute number of load curve application steps. "
+                            "The table of the tabulated load curve has not been set.";
+        throw std::runtime_error(error.c_str());
     }
 
+    // Compute the number of time steps for load curve application.
+    // At least one step is required for the load curve's application.
+    this->load_steps_num_ = std::max(1, static_cast<int>(std::floor((this->load_time_ / solver_time_step) + 0.5)));
+    this->solver_time_step_ = solver_time_step;
+
 }
 
 
-const double & LoadCurve::LoadDispAt(const size_t &step) const
+double LoadCurve::TableAmplitude(double time) const
 {
-    // Check if displacement exists for the required time step.
-    if (step > this->load_step_displacements_.size()) {
-        std::string error = "[CLOUDEA ERROR] Cannot retreive displacement variation for the requested time step. "
-                            "The requested step exceeds the size of the variation displacement container.";
-        throw std::invalid_argument(error.c_str());
-    }
-
-    return this->load_step_displacements_[step];
+    // Keep the amplitude constant outside the table's times.
+    if (time <= this->table_times_.front()) { return this->table_amplitudes_.front(); }
+    if (time >= this->table_times_.back()) { return this->table_amplitudes_.back(); }
+
+    // Interpolate linearly in the table's interval containing the time.
+    auto upper = std::upper_bound(this->table_times_.begin(), this->table_times_.end(), time);
+    auto i = static_cast<std::size_t>(upper - this->table_times_.begin());
+    double weight = (time - this->table_times_[i-1]) / (this->table_times_[i] - this->table_times_[i-1]);
+    return (1. - weight)*this->table_amplitudes_[i-1] + weight*this->table_amplitudes_[i];
 }
 
 
@@ -108,7 +121,11 @@ bool LoadCurve::operator == (const LoadCurve &load_curve) const
     return ((this->load_time_ == load_curve.load_time_) &&
             (this->max_displacement_ == load_curve.max_displacement_) &&
             (this->load_steps_num_ == load_curve.load_steps_num_) &&
-            (this->load_step_displacements_ == load_curve.load_step_displacements_) );
+            (this->solver_time_step_ == load_curve.solver_time_step_) &&
+            (this->shape_ == load_curve.shape_) &&
+            (this->frequency_ == load_curve.frequency_) &&
+            (this->table_times_ == load_curve.table_times_) &&
+            (this->table_amplitudes_ == load_curve.table_amplitudes_) );
 }
 
 
@@ -119,19 +136,4 @@ bool LoadCurve::operator != (const LoadCurve &load_curve) const
 }
 
 
-LoadCurve & LoadCurve::operator = (const LoadCurve &load_curve) {
-
-    // Assign the variables of the given load curve.
-    if (this != &load_curve) {
-        this->load_time_ = load_curve.load_time_;
-        this->max_displacement_ = load_curve.max_displacement_;
-        this->load_steps_num_ = load_curve.load_steps_num_;
-        this->load_step_displacements_ = load_curve.load_step_displacements_;
-    }
-    return *this;
-}
-
-
-
-
 } //end of namespace CLOUDEA
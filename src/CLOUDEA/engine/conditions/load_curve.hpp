@@ -29,9 +29,11 @@
 */
 
 
+#include <cstddef>
 #include <cmath>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include <stdexcept>
 #include <exception>
@@ -44,11 +46,24 @@ namespace CLOUDEA {
  */
 
 
+/*!
+ * \enum LoadCurveShape
+ * \brief The shape of the displacement variation applied by a load curve.
+ */
+enum struct LoadCurveShape: int {smooth_step = 1,     /*!< Smooth step polynomial 10t^3 - 15t^4 + 6t^5 over the load time. */
+                                 linear_ramp = 2,     /*!< Linear ramp over the load time. */
+                                 tabulated = 3,       /*!< Piecewise linear interpolation of tabulated time-amplitude pairs. */
+                                 sinusoidal = 4,      /*!< Sinusoidal variation with given frequency. */
+                                };
+
+
 /*!
  * \class LoadCurve
  * \brief Class implemmenting a load curve to be used in load condition.
  *
  * The load curve applies the loading progressively, in load time steps, to maintain stability of the solution.
+ * The displacement of a load step is evaluated analytically from the curve's shape, thus no table of the load
+ * steps' displacements is stored. The amplitude of the curve is scaled by the maximum displacement.
  *
  */
 
@@ -59,6 +74,7 @@ public:
      * \brief The LoadCurve constructor.
      *
      * Provides zero initialization for variables: load_time_, max_displacement_, and load_steps_num_.
+     * The default shape of the curve is the smooth step.
      *
      */
     LoadCurve();
@@ -87,19 +103,43 @@ public:
 
 
     /*!
-     * \brief Compute the number of time steps required for the load curve's application.
-     * \param [in] solver_time_step The time step of the explicit solver for stable solution.
+     * \brief Set the shape of the load curve.
+     *
+     * The table of a tabulated load curve is checked when the number of load steps is computed, thus
+     * ComputeLoadStepsNum must be called again if the shape is changed to tabulated afterwards.
+     *
+     * \param [in] shape The shape of the load curve.
      * \return [void]
      */
-    void ComputeLoadStepsNum(const double &solver_time_step);
+    void SetShape(const LoadCurveShape &shape);
 
 
     /*!
-     * \brief Compute the displacement variation in each loading time step.
+     * \brief Set the frequency of the sinusoidal load curve.
+     * \param [in] frequency The frequency of the sinusoidal load curve. If zero, the quarter period equals to the load time.
+     * \return [void]
+     */
+    void SetFrequency(const double &frequency);
+
+
+    /*!
+     * \brief Set the time-amplitude pairs of the tabulated load curve.
+     *
+     * The amplitude is interpolated linearly between the given times and is kept constant outside them.
+     *
+     * \param [in] times The times of the table in increasing order.
+     * \param [in] amplitudes The amplitudes of the table, scaled by the maximum displacement.
+     * \return [void]
+     */
+    void SetTable(const std::vector<double> &times, const std::vector<double> &amplitudes);
+
+
+    /*!
+     * \brief Compute the number of time steps required for the load curve's application.
      * \param [in] solver_time_step The time step of the explicit solver for stable solution.
      * \return [void]
      */
-    void ComputeLoadStepDisplacements(const double &solver_time_step);
+    void ComputeLoadStepsNum(const double &solver_time_step);
 
 
     /*!
@@ -117,25 +157,30 @@ public:
 
 
     /*!
-     * \brief Get the number of time steps required for the load curve's application.
-     * \return [int] The number of time steps required for the load curve's application.
+     * \brief Get the shape of the load curve.
+     * \return [CLOUDEA::LoadCurveShape] The shape of the load curve.
      */
-    inline const int & LoadStepsNum() const { return this->load_steps_num_; }
+    inline const LoadCurveShape & Shape() const { return this->shape_; }
 
 
     /*!
-     * \brief Get the displacement variation in each loading time step.
-     * \return [std::vector<double>] The displacement variation in each loading time step.
+     * \brief Get the number of time steps required for the load curve's application.
+     * \return [int] The number of time steps required for the load curve's application.
      */
-    inline const std::vector<double> & LoadStepDisplacements() const { return this->load_step_displacements_; }
+    inline const int & LoadStepsNum() const { return this->load_steps_num_; }
 
 
     /*!
-     * \brief Get the displacement variation at a specific time step.
-     * \param [in] step The step at which the displacement variation is requested.
-     * \return [double] The displacement variation at a specific time step.
+     * \brief Get the displacement at a specific load step.
+     *
+     * The step is evaluated at time (step+1) * solver_time_step. The smooth step and linear ramp
+     * curves keep the maximum displacement after the load time. The number of load steps must have been
+     * computed with ComputeLoadStepsNum, otherwise an exception is thrown.
+     *
+     * \param [in] step The step at which the displacement is requested.
+     * \return [double] The displacement at the load step.
      */
-    const double & LoadDispAt(const size_t &step) const;
+    inline double LoadDispAt(const std::size_t &step) const;
 
 
     /*!
@@ -154,13 +199,14 @@ public:
     bool operator != (const LoadCurve &load_curve) const;
 
 
+protected:
+
     /*!
-     * \brief Assignment operator.
-     * \param [in] load_curve the load curve to be assigned.
-     * \return [CLOUDEA::LoadCurve] Returns the load curve for multiple assignment.
+     * \brief Interpolate the amplitude of the tabulated load curve.
+     * \param [in] time The time of the interpolation.
+     * \return [double] The interpolated amplitude.
      */
-    LoadCurve & operator = (const LoadCurve &load_curve);
-
+    double TableAmplitude(double time) const;
 
 
 private:
@@ -170,11 +216,47 @@ private:
 
     int load_steps_num_;                                /*!< The number of time steps required for the load curve's application. */
 
-    std::vector<double> load_step_displacements_;       /*!< The displacement variation in each loading time step. */
+    double solver_time_step_;                           /*!< The time step of the explicit solver. */
+
+    LoadCurveShape shape_;                              /*!< The shape of the load curve. */
+
+    double frequency_;                                  /*!< The frequency of the sinusoidal load curve. */
+
+    std::vector<double> table_times_;                   /*!< The times of the tabulated load curve. */
+
+    std::vector<double> table_amplitudes_;              /*!< The amplitudes of the tabulated load curve. */
 
 };
 
 
+inline double LoadCurve::LoadDispAt(const std::size_t &step) const
+{
+    // Check if the number of load steps has been computed.
+    if (this->load_steps_num_ < 1) {
+        std::string error = "[CLOUDEA ERROR] Cannot compute the load curve displacement. "
+                            "The number of load curve application steps has not been computed.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Time of the load step and normalized time over the load steps.
+    const double time = (step+1) * this->solver_time_step_;
+    const double norm_time = std::min(1., static_cast<double>(step+1) / this->load_steps_num_);
+
+    switch (this->shape_) {
+    case LoadCurveShape::linear_ramp :
+        return this->max_displacement_ * norm_time;
+    case LoadCurveShape::tabulated :
+        return this->max_displacement_ * this->TableAmplitude(time);
+    case LoadCurveShape::sinusoidal : {
+        // Quarter period equal to the load time if no frequency is given.
+        const double two_pi = 6.283185307179586;
+        const double frequency = (this->frequency_ > 0.) ? this->frequency_ : 0.25 / (this->load_steps_num_ * this->solver_time_step_);
+        return this->max_displacement_ * std::sin(two_pi*frequency*time);
+    }
+    default :
+        return this->max_displacement_ * norm_time*norm_time*norm_time * (10. - 15.*norm_time + 6.*norm_time*norm_time);
+    }
+}
 
 
 /*! @} End of Doxygen Groups*/
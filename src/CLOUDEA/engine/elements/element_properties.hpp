@@ -28,6 +28,8 @@
 #ifndef CLOUDEA_ELEMENTS_ELEMENT_PROPERTIES_HPP_
 #define CLOUDEA_ELEMENTS_ELEMENT_PROPERTIES_HPP_
 
+#include "CLOUDEA/engine/elements/name_table.hpp"
+
 #include <string>
 
 namespace CLOUDEA {
@@ -55,12 +57,19 @@ enum struct ElementType: int {node = 1,                 /*!< Element type -> nod
  */
 typedef struct Partition{
     int id_;                /*!< The index of the partition. */
-    std::string name_;      /*!< The name of the partition. */
+    int name_id_;           /*!< The index of the name of the partition in the NameTable. */
+
+
+    Partition() : id_(0), name_id_(0) {}
+
+
+    inline const std::string & Name() const { return NameTable::Name(this->name_id_); }
+
 
     bool operator == (const Partition &part) const
     {
         return ((this->id_ == part.id_) &&
-                (this->name_ == part.name_) );
+                (this->name_id_ == part.name_id_) );
     }
 
 
@@ -73,7 +82,7 @@ typedef struct Partition{
     Partition & operator = (const Partition &part) {
         if (this != &part) {
             this->id_ = part.id_;
-            this->name_ = part.name_;
+            this->name_id_ = part.name_id_;
         }
         return *this;
     }
@@ -86,16 +95,19 @@ typedef struct Partition{
  */
 typedef struct Boundary {
     int id_;                /*!< The index of the boundary. */
-    std::string name_;      /*!< The name of the boundary. */
+    int name_id_;           /*!< The index of the name of the boundary in the NameTable. */
+
+
+    Boundary() : id_(0), name_id_(0) {}
 
 
-    Boundary() : id_(0), name_("") {}
+    inline const std::string & Name() const { return NameTable::Name(this->name_id_); }
 
 
     bool operator == (const Boundary &boundary) const
     {
         return ((this->id_ == boundary.id_) &&
-                (this->name_ == boundary.name_) );
+                (this->name_id_ == boundary.name_id_) );
     }
 
 
@@ -108,7 +120,7 @@ typedef struct Boundary {
     Boundary & operator = (const Boundary &boundary) {
         if (this != &boundary) {
             this->id_ = boundary.id_;
-            this->name_ = boundary.name_;
+            this->name_id_ = boundary.name_id_;
         }
         return *this;
     }
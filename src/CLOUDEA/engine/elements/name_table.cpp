@@ -0,0 +1,76 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/elements/name_table.hpp"
+
+
+namespace CLOUDEA {
+
+
+int NameTable::Intern(const std::string &name)
+{
+    // The empty name is preinterned.
+    if (name.empty()) { return 0; }
+
+    auto &storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex_);
+
+    // Add the name if it is not interned yet.
+    auto found = storage.ids_.find(name);
+    if (found != storage.ids_.end()) { return found->second; }
+
+    auto name_id = static_cast<int>(storage.names_.size());
+    storage.names_.emplace_back(name);
+    storage.ids_.emplace(name, name_id);
+    return name_id;
+}
+
+
+const std::string & NameTable::Name(int name_id)
+{
+    auto &storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex_);
+
+    // Check if the index is in the table.
+    if (name_id < 0 || static_cast<std::size_t>(name_id) >= storage.names_.size()) {
+        std::string error = "[CLOUDEA ERROR] Could not get interned name. The index " + std::to_string(name_id) + " is not in the names table.";
+        throw std::out_of_range(error.c_str());
+    }
+
+    return storage.names_[static_cast<std::size_t>(name_id)];
+}
+
+
+std::size_t NameTable::NamesNum()
+{
+    auto &storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex_);
+    return storage.names_.size();
+}
+
+
+NameTable::Storage & NameTable::GetStorage()
+{
+    static Storage storage;
+    return storage;
+}
+
+
+} //end of namespace CLOUDEA
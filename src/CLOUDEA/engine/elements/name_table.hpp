@@ -0,0 +1,109 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_ELEMENTS_NAME_TABLE_HPP_
+#define CLOUDEA_ELEMENTS_NAME_TABLE_HPP_
+
+/*!
+   \file name_table.hpp
+   \brief NameTable class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Elements
+ *  @{
+ */
+
+
+/*!
+ * \class NameTable
+ * \brief Side table interning the partition and boundary names of the nodes and the elements.
+ *
+ * Each distinct name is stored once and the nodes and the elements keep only its integer index,
+ * so that they do not carry a string each. The empty name has always index 0. The interned names
+ * are never moved or removed, thus the references returned by NameTable::Name remain valid.
+ * The table is shared by all the meshes and is thread safe.
+ */
+class NameTable {
+public:
+
+    /*!
+     * \brief Get the index of a name, interning it if it is not already in the table.
+     * \param [in] name The name to intern.
+     * \return [int] The index of the name in the table.
+     */
+    static int Intern(const std::string &name);
+
+
+    /*!
+     * \brief Get the name of an index of the table.
+     * \param [in] name_id The index of the name in the table.
+     * \return [std::string] The interned name.
+     */
+    static const std::string & Name(int name_id);
+
+
+    /*!
+     * \brief Get the number of the interned names, including the empty name.
+     * \return [std::size_t] The number of the interned names.
+     */
+    static std::size_t NamesNum();
+
+
+private:
+
+    /*!
+     * \brief Storage of the interned names.
+     */
+    struct Storage {
+        std::mutex mutex_;                                   /*!< The mutex guarding the interning and the lookups. */
+        std::deque<std::string> names_;                      /*!< The interned names. The deque keeps their addresses stable. */
+        std::unordered_map<std::string, int> ids_;           /*!< The index of each interned name. */
+
+        Storage() : names_(1, std::string()), ids_{{std::string(), 0}} {}
+    };
+
+
+    /*!
+     * \brief Get the storage of the interned names, constructed on first use.
+     * \return [NameTable::Storage] The storage of the interned names.
+     */
+    static Storage & GetStorage();
+
+};
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_ELEMENTS_NAME_TABLE_HPP_
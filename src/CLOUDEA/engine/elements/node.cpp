@@ -33,11 +33,11 @@ Node::Node() : id_(-1), coordinates_(), normal_(), part_(), boundary_(), element
 
     // Initialize partition.
     part_.id_ = 0;
-    part_.name_ = "";
+    part_.name_id_ = 0;
 
     // Initialize boundary (zero -> no boundary).
     boundary_.id_ = 0;
-    boundary_.name_ = "";
+    boundary_.name_id_ = 0;
 }
 
 
@@ -128,7 +128,7 @@ void Node::SetPartition(const int &id, std::string name)
     this->part_.id_ = id;
 
     // Set the name of the partition the node belongs to.
-    this->part_.name_ = name;
+    this->part_.name_id_ = NameTable::Intern(name);
 }
 
 
@@ -138,7 +138,7 @@ void Node::SetBoundary(const int &id, std::string name)
     this->boundary_.id_ = id;
 
     // Set the name of the boundary the node belongs to.
-    this->boundary_.name_ = name;
+    this->boundary_.name_id_ = NameTable::Intern(name);
 }
 
 
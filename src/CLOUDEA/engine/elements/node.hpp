@@ -233,7 +233,7 @@ public:
      * \brief Get the name of the partition the node belongs to.
      * \return [std::string] The node's partition name.
      */
-    inline const std::string & PartitionName() const { return this->part_.name_; }
+    inline const std::string & PartitionName() const { return this->part_.Name(); }
 
 
     /*!
@@ -247,7 +247,7 @@ public:
      * \brief Get the name of the boundary the node belongs to.
      * \return [std::string] The node's boundary name.
      */
-    inline const std::string & BoundaryName() const { return this->boundary_.name_; }
+    inline const std::string & BoundaryName() const { return this->boundary_.Name(); }
 
 
     /*!
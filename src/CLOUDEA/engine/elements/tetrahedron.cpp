@@ -31,11 +31,11 @@ Tetrahedron::Tetrahedron() : id_(-1), n1_(-1), n2_(-1), n3_(-1), n4_(-1),
 
     // Initialize partition.
     part_.id_ = 0;
-    part_.name_ = "";
+    part_.name_id_ = 0;
 
     // Initialize boundary (zero -> no boundary).
     boundary_.id_ = 0;
-    boundary_.name_ = "";
+    boundary_.name_id_ = 0;
 }
 
 
@@ -101,7 +101,7 @@ void Tetrahedron::SetPartition(const int &id, std::string name)
     this->part_.id_ = id;
 
     // Set the name of the partition the tetrahedron belongs to.
-    this->part_.name_ = name;
+    this->part_.name_id_ = NameTable::Intern(name);
 }
 
 
@@ -111,7 +111,7 @@ void Tetrahedron::SetBoundary(const int &id, std::string name)
     this->boundary_.id_ = id;
 
     // Set the name of the boundary the tetrahedron belongs to.
-    this->boundary_.name_ = name;
+    this->boundary_.name_id_ = NameTable::Intern(name);
 }
 
 
@@ -209,7 +209,7 @@ public:
      * \brief Get the name of the partition the tetrahedron belongs to.
      * \return [std::string] The tetrahedron's partition name.
      */
-    inline const std::string & PartitionName() const { return this->part_.name_; }
+    inline const std::string & PartitionName() const { return this->part_.Name(); }
 
 
     /*!
@@ -223,7 +223,7 @@ public:
      * \brief Get the name of the boundary the tetrahedron belongs to.
      * \return [std::string] The tetrahedron's boundary name.
      */
-    inline const std::string & BoundaryName() const { return this->boundary_.name_; }
+    inline const std::string & BoundaryName() const { return this->boundary_.Name(); }
 
 
     /*!
@@ -337,6 +337,73 @@ void ParaviewExporter::AddVectorField(const Eigen::MatrixXd &vector_field, const
 }
 
 
+void ParaviewExporter::AddTensorField(const Eigen::MatrixXd &tensor_field, const std::string &tensor_field_name)
+{
+    // Check consistency of given tensor field's size with model's grid.
+    if (tensor_field.rows() != this->weak_model_3d_.Grid().NodesNum() || tensor_field.cols() != 6) {
+        std::string error = "[CLOUDEA Error] The given tensor field is not a [nodes x 6] matrix of the model's grid.";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Get the parent branch of the exporting xml file.
+    tinyxml2::XMLNode *parent_branch = this->output_.FirstChildElement("VTKFile");
+
+    // Check if parent branch is the expected one (VTKFile).
+    if (parent_branch == nullptr) {
+        std::string error = "[CLOUDEA Error] Unknown XML file. Parent branch expected to be VTKFile.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Get the Piece branch.
+    tinyxml2::XMLElement *piece = parent_branch->FirstChildElement("UnstructuredGrid")->FirstChildElement("Piece");
+
+    // Check if Piece branch was found.
+    if (piece == nullptr) {
+        std::string error = "[CLOUDEA Error] 'Piece' branch was not found. Expected XML tree is: VTKFile->UnstructuredGrid->Piece.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Get the PointData branch.
+    tinyxml2::XMLElement *point_data = piece->FirstChildElement("PointData");
+
+    // Create PointData branch if does not exist.
+    if (point_data == nullptr) {
+        point_data = this->output_.NewElement("PointData");
+        piece->InsertEndChild(point_data);
+    }
+
+    // Add tensor field attribute.
+    if (point_data->Attribute("Tensors") != nullptr) {
+        // Update existing attribute.
+        std::string new_attribute = std::string(point_data->Attribute("Tensors")) + " " + tensor_field_name;
+        point_data->SetAttribute("Tensors", new_attribute.c_str());
+    }
+    else {
+        point_data->SetAttribute("Tensors", tensor_field_name.c_str());
+    }
+
+    // Create tensor field branch. Six components are interpreted by ParaView as a symmetric tensor.
+    tinyxml2::XMLElement *point_tensors = this->output_.NewElement("DataArray");
+    point_tensors->SetAttribute("type", "Float64");
+    point_tensors->SetAttribute("Name", tensor_field_name.c_str());
+    point_tensors->SetAttribute("NumberOfComponents", 6);
+    point_tensors->SetAttribute("format", "ascii");
+
+    //Generate string with the values of the tensor field.
+    std::string tensors = "\n\t\t\t\t\t\t\t\t\t";
+    for (int i = 0; i != tensor_field.rows(); ++i) {
+        for (int j = 0; j != 6; ++j) {
+            tensors += std::to_string(tensor_field.coeff(i, j));
+            tensors += (j != 5) ? " " : "\n\t\t\t\t\t\t\t\t\t";
+        }
+    }
+
+    //Assign tensor values and insert tensor field branch in the xml tree.
+    point_tensors->SetText(tensors.c_str());
+    point_data->InsertEndChild(point_tensors);
+}
+
+
 void ParaviewExporter::ClearVectorFields()
 {
     // Get the PointData branch.
@@ -106,6 +106,15 @@ public:
     void AddVectorField(const Eigen::MatrixXd &vector_field, const std::string &vector_field_name);
 
 
+    /*!
+     * \brief Add a symmetric tensor field in the xml tree of the ParaView (.vtu) file.
+     * \param [in] tensor_field The tensor field given as [n x 6] matrix in Voigt order (xx, yy, zz, xy, yz, xz). n is the number of nodes of the model where the tensor field is applied.
+     * \param [in] tensor_field_name The name of the tensor field to be assigned in the corresponding branch of the Paraview (.vtu) xml file.
+     * \return [void]
+     */
+    void AddTensorField(const Eigen::MatrixXd &tensor_field, const std::string &tensor_field_name);
+
+
     /*!
      * \brief 
      * 
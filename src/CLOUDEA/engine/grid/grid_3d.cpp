@@ -23,7 +23,7 @@
 namespace CLOUDEA {
 
 
-Grid3D::Grid3D()
+Grid3D::Grid3D() : nodes_(std::make_shared<const std::vector<Node> >())
 {}
 
 
@@ -40,15 +40,35 @@ Grid3D::~Grid3D()
 
 void Grid3D::CopyNodesFromMesh(const TetraMesh &tetramesh)
 {
-    // Copy the mesh nodes.
-   this->nodes_ = tetramesh.Nodes();
+    // Share the mesh nodes.
+    this->nodes_ = tetramesh.SharedNodes();
+}
+
+
+void Grid3D::SetNodes(const std::shared_ptr<const std::vector<Node> > &nodes)
+{
+    // Check if the nodes view is valid.
+    if (!nodes) {
+        throw std::invalid_argument(Logger::Error("Could not set the grid nodes. The given nodes view is empty.").c_str());
+    }
+
+    this->nodes_ = nodes;
+}
+
+
+void Grid3D::EditNodes(const std::function<void(std::vector<Node> &)> &edit)
+{
+    // The shared nodes are never modified in place. Edit a copy and replace them.
+    auto nodes = std::make_shared<std::vector<Node> >(*this->nodes_);
+    edit(*nodes);
+    this->nodes_ = nodes;
 }
 
 
 bool Grid3D::operator == (const Grid3D &grid3D) const
 {
     // Compare tetrahedral meshes for equality.
-    return (this->nodes_ == grid3D.nodes_);
+    return ((this->nodes_ == grid3D.nodes_) || (*this->nodes_ == *grid3D.nodes_));
 }
 
 
@@ -62,7 +82,7 @@ bool Grid3D::operator != (const Grid3D &grid3D) const
 Grid3D & Grid3D::operator = (const Grid3D &grid3D)
 {
     if (this != &grid3D) {
-        // Assign values from tetrahedron.
+        // Assign values from tetrahedron. Nodes are shared until edited.
         this->nodes_ = grid3D.nodes_;
     }
 
@@ -32,6 +32,8 @@
 #include "CLOUDEA/engine/mesh/tetramesh.hpp"
 
 #include <vector>
+#include <memory>
+#include <functional>
 
 namespace CLOUDEA {
 
@@ -66,32 +68,55 @@ public:
 
 
     /*!
-     * \brief Copy the grid nodes from a tetrahedral mesh.
-     * \param tetramesh The tetrahedral mesh to copy the nodes from.
+     * \brief Set the grid nodes from a tetrahedral mesh.
+     *
+     * The nodes are shared with the mesh and are copied only if either the grid or the mesh is edited.
+     *
+     * \param tetramesh The tetrahedral mesh to get the nodes from.
      * \return [void]
      */
     void CopyNodesFromMesh(const TetraMesh &tetramesh);
 
 
     /*!
-     * \brief Write access to the nodes of the mesh.
-     * \return [std::vector<CLOUDEA::Node>] the mesh nodes with write access.
+     * \brief Set the grid nodes from a shared read-only view of nodes.
+     * \param [in] nodes The shared nodes of the grid.
+     * \return [void]
+     */
+    void SetNodes(const std::shared_ptr<const std::vector<Node> > &nodes);
+
+
+    /*!
+     * \brief Edit the nodes of the grid.
+     *
+     * The edit is applied on a copy of the grid nodes which then replaces them, so that the mesh
+     * or grids sharing the previous nodes remain unchanged.
+     *
+     * \param [in] edit The function editing the copy of the grid nodes.
+     * \return [void]
      */
-    inline std::vector<Node> & EditNodes() { return this->nodes_; }
+    void EditNodes(const std::function<void(std::vector<Node> &)> &edit);
 
 
     /*!
      * \brief Read-only access to the nodes of the mesh.
      * \return [std::vector<CLOUDEA::Node>] the mesh nodes with read-only access.
      */
-    inline const std::vector<Node> & Nodes() const { return this->nodes_; }
+    inline const std::vector<Node> & Nodes() const { return *this->nodes_; }
+
+
+    /*!
+     * \brief Get a shared read-only view of the nodes of the grid.
+     * \return [std::shared_ptr<const std::vector<CLOUDEA::Node> >] The shared grid nodes.
+     */
+    inline const std::shared_ptr<const std::vector<Node> > & SharedNodes() const { return this->nodes_; }
 
 
     /*!
      * \brief Get the number of the grid's nodes.
      * \return [int] The number of the grid's nodes.
      */
-    inline int NodesNum() const { return static_cast<int>(this->nodes_.size()); }
+    inline int NodesNum() const { return static_cast<int>(this->nodes_->size()); }
 
 
     /*!
@@ -127,7 +152,7 @@ public:
     Grid3D & operator = (const Grid3D &grid3D);
 
 private:
-    std::vector<Node> nodes_;        /*!< The nodes of the grid. */
+    std::shared_ptr<const std::vector<Node> > nodes_;        /*!< The nodes of the grid. Shared with the mesh they were set from. */
 
 };
 
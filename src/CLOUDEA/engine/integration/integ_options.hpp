@@ -47,13 +47,15 @@ typedef struct IntegOptions {
     /*!
      * \brief IntegOptions constructor.
      */
-    IntegOptions() : is_adaptive_(false), tetra_divisions_(0), integ_points_per_tetra_(0),
-        adaptive_level_(0), adaptive_eps_(0.)
+    IntegOptions() : is_adaptive_(false), is_nodal_(false), tetra_divisions_(0), integ_points_per_tetra_(0),
+        adaptive_level_(0), adaptive_eps_(0.), stress_points_fraction_(0.25)
     {}
 
 
     bool is_adaptive_;                      /*!< The type of integration. If true, adaptive integration is performed. */
 
+    bool is_nodal_;                         /*!< The type of integration. If true, stabilized nodal integration is performed. */
+
     int tetra_divisions_;                   /*!< The number of tetrahedral elements' divisions.
                                                  Admissible divisions [2/4/8]. Used for adaptive integration. */
 
@@ -64,6 +66,10 @@ typedef struct IntegOptions {
 
     double adaptive_eps_;                   /*!< The approximation estimation error for adaptation termination. */
 
+    double stress_points_fraction_;         /*!< The fraction of the tetrahedra volume assigned to stress points at their centroids.
+                                                 Admissible fraction [0, 1). Zero disables the stress points stabilization.
+                                                 Used for nodal integration. */
+
 } IntegOptions;
 
 
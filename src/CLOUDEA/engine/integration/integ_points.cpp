@@ -22,8 +22,24 @@
 
 namespace CLOUDEA {
 
-IntegPoints::IntegPoints()
-{}
+
+// The material region of an element is its partition.
+static std::uint16_t RegionOf(const Tetrahedron &elem)
+{
+    if (elem.PartitionId() < 0 || elem.PartitionId() > std::numeric_limits<std::uint16_t>::max()) {
+        std::string error = "[CLOUDEA ERROR] Cannot assign material region to integration points. Invalid partition index: " +
+                            std::to_string(elem.PartitionId());
+        throw std::out_of_range(error.c_str());
+    }
+    return static_cast<std::uint16_t>(elem.PartitionId());
+}
+
+
+IntegPoints::IntegPoints() : nodal_points_num_(0)
+{
+    // Use all the available hardware threads by default.
+    this->SetThreadsNumber(0);
+}
 
 
 IntegPoints::~IntegPoints()
@@ -36,9 +52,16 @@ void IntegPoints::Generate(const TetraMesh &tetramesh, const IntegOptions &optio
     // Clear integration points and weights containers.
     this->coordinates_.clear();
     this->weights_.clear();
+    this->nodal_volumes_.clear();
+    this->nodal_points_num_ = 0;
+    this->region_ids_.clear();
 
     // Generate integration points.
-    if (options.is_adaptive_) {
+    if (options.is_nodal_) {
+        // Use stabilized nodal integration.
+        this->GenerateNodalPoints(tetramesh, options.stress_points_fraction_);
+    }
+    else if (options.is_adaptive_) {
         // Use adaptive generation of integration points.
         this->GenerateAdaptivePointsPerTetra(tetramesh, options, support_dom);
     }
@@ -65,8 +88,24 @@ void IntegPoints::Generate(const TetraMesh &tetramesh, const IntegOptions &optio
                 throw std::invalid_argument(error.c_str());
                 break;
         }
+        this->AssignElementRegions(tetramesh, static_cast<std::size_t>(options.integ_points_per_tetra_));
     } // End Generate integration points.
 
+    // Keep the material regions only for multi-material meshes.
+    this->CompactRegionIds();
+
+}
+
+
+void IntegPoints::SetThreadsNumber(std::size_t threads_number)
+{
+    // Get the number of available hardware threads if not given.
+    if (threads_number == 0) {
+        const std::size_t available_threads = std::thread::hardware_concurrency();
+        threads_number = std::max(available_threads, std::size_t{1});
+    }
+
+    this->threads_number_ = threads_number;
 }
 
 
@@ -75,6 +114,9 @@ void IntegPoints::Generate2(const TetraMesh &tetramesh, short num_per_elem)
     // Clear integration points and weights containers.
     this->coordinates_.clear();
     this->weights_.clear();
+    this->nodal_volumes_.clear();
+    this->nodal_points_num_ = 0;
+    this->region_ids_.clear();
 
     this->coordinates_.reserve(tetramesh.Elements().size());
     this->weights_.reserve(tetramesh.Elements().size());
@@ -95,22 +137,65 @@ void IntegPoints::Generate2(const TetraMesh &tetramesh, short num_per_elem)
                                         "for given number of points per element. Supported: [1 | 4 | 5] integration points per element."));
             break;
     }
+    this->AssignElementRegions(tetramesh, static_cast<std::size_t>(num_per_elem));
+    this->CompactRegionIds();
     
 
 }
 
 
+void IntegPoints::SaveToFile(const std::string &ip_file) const
+{
+    IntegPointsIO ip_io;
+    ip_io.SetThreadsNumber(this->threads_number_);
+    ip_io.Save(ip_file, this->coordinates_, this->weights_, this->nodal_volumes_, static_cast<std::size_t>(this->nodal_points_num_),
+               this->region_ids_);
+}
+
+
+void IntegPoints::SetPoints(const std::vector<Vec3<double> > &coordinates, const std::vector<double> &weights,
+                            const std::vector<std::uint16_t> &region_ids)
+{
+    // Check that every integration point has a weight and a region, if any.
+    if (coordinates.size() != weights.size() || (!region_ids.empty() && region_ids.size() != coordinates.size())) {
+        std::string error = "[CLOUDEA ERROR] Cannot set integration points. The lists of integration"
+                            " points' coordinates, weights and regions do not have the same size.";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    this->coordinates_ = coordinates;
+    this->weights_ = weights;
+    this->nodal_volumes_.clear();
+    this->nodal_points_num_ = 0;
+    this->region_ids_ = region_ids;
+    this->CompactRegionIds();
+}
+
+
 void IntegPoints::LoadFromFile(const std::string & ip_file)
 {
     // Clear integration points and weights containers.
     this->coordinates_.clear();
     this->weights_.clear();
+    this->nodal_volumes_.clear();
+    this->nodal_points_num_ = 0;
+    this->region_ids_.clear();
 
     // Check if neighbors filename is not empty.
     if (ip_file.empty()) {
         throw std::invalid_argument(Logger::Error("No filename was given to load integration points"));
     }
 
+    // Load binary integration points files memory mapped.
+    if (IntegPointsIO::IsBinaryFile(ip_file)) {
+        IntegPointsIO ip_io;
+        ip_io.SetThreadsNumber(this->threads_number_);
+        std::size_t nodal_points_num = 0;
+        ip_io.Load(ip_file, this->coordinates_, this->weights_, this->nodal_volumes_, nodal_points_num, this->region_ids_);
+        this->nodal_points_num_ = static_cast<int>(nodal_points_num);
+        return;
+    }
+
     //Open neighbours list file.
     std::ifstream ipoints(ip_file.c_str(), std::ios::in);
 
@@ -120,9 +205,6 @@ void IntegPoints::LoadFromFile(const std::string & ip_file)
         throw std::runtime_error(error.c_str());
     }
 
-    // Make neighbors list container
-    std::vector<std::vector<int> > neighbors_ids;
-
     // Process file
     std::string line("");
     while (std::getline(ipoints, line)) {
@@ -153,17 +235,22 @@ void IntegPoints::LoadFromFile(const std::string & ip_file)
 
 void IntegPoints::GenerateOnePointPerTetra(const TetraMesh &tetramesh)
 {
+    // Contiguous coordinates and connectivity of the mesh.
+    const auto &coords = tetramesh.FlatCoordinates();
+    const auto &conn = tetramesh.Connectivity();
+
     // Generate one integration point for each tetrahedron of the mesh.
-    for (auto &elem : tetramesh.Elements()) {
+    for (std::size_t t = 0; t != conn.size()/4; ++t) {
+        const double *p1 = &coords[3*conn[4*t]];
+        const double *p2 = &coords[3*conn[4*t+1]];
+        const double *p3 = &coords[3*conn[4*t+2]];
+        const double *p4 = &coords[3*conn[4*t+3]];
 
         // Set the integration point at the element's centroid.
-        this->coordinates_.emplace_back((tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N4()].Coordinates()) / 4.);
+        this->coordinates_.emplace_back(0.25*(p1[0]+p2[0]+p3[0]+p4[0]), 0.25*(p1[1]+p2[1]+p3[1]+p4[1]), 0.25*(p1[2]+p2[2]+p3[2]+p4[2]));
 
         // Store the volume of the element as the integration point's weight.
-        this->weights_.emplace_back(elem.Volume(tetramesh.Nodes()));
+        this->weights_.emplace_back(TetraMesh::TetraVolume(p1, p2, p3, p4));
     }
 
 }
@@ -177,35 +264,22 @@ void IntegPoints::GenerateFourPointsPerTetra(const TetraMesh &tetramesh)
     // Initialize the weight of an integration point.
     double weight = 0.;
 
+    // Contiguous coordinates and connectivity of the mesh.
+    const auto &coords = tetramesh.FlatCoordinates();
+    const auto &conn = tetramesh.Connectivity();
+
     // Generate four integration points for each tetrahedron of the mesh.
-    for (auto &elem : tetramesh.Elements()) {
+    for (std::size_t t = 0; t != conn.size()/4; ++t) {
+        const double *p[4] = {&coords[3*conn[4*t]], &coords[3*conn[4*t+1]], &coords[3*conn[4*t+2]], &coords[3*conn[4*t+3]]};
 
         // The weight per integration point as the quarter of the element's volume.
-        weight = elem.Volume(tetramesh.Nodes()) / 4.;
-
-        // Store the 1st integration point coordinates.
-        this->coordinates_.emplace_back(alpha*tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                        beta*(tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                              tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                              tetramesh.Nodes()[elem.N4()].Coordinates()) );
-
-        // Store the 2nd integration point's coordinates.
-        this->coordinates_.emplace_back(alpha*tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                        beta*(tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                              tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                              tetramesh.Nodes()[elem.N4()].Coordinates()) );
-
-        // Store the 3rd integration point's coordinates.
-        this->coordinates_.emplace_back(alpha*tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                        beta*(tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                             tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                             tetramesh.Nodes()[elem.N4()].Coordinates()) );
-
-        // Store the 4th integration point's coordinates.
-        this->coordinates_.emplace_back(alpha*tetramesh.Nodes()[elem.N4()].Coordinates() +
-                                        beta*(tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                              tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                              tetramesh.Nodes()[elem.N3()].Coordinates()) );
+        weight = TetraMesh::TetraVolume(p[0], p[1], p[2], p[3]) / 4.;
+
+        // Store the integration points' coordinates. The i-th point is shifted towards the i-th node.
+        const double sum[3] = {p[0][0]+p[1][0]+p[2][0]+p[3][0], p[0][1]+p[1][1]+p[2][1]+p[3][1], p[0][2]+p[1][2]+p[2][2]+p[3][2]};
+        for (const auto &pi : p) {
+            this->coordinates_.emplace_back(alpha*pi[0] + beta*(sum[0]-pi[0]), alpha*pi[1] + beta*(sum[1]-pi[1]), alpha*pi[2] + beta*(sum[2]-pi[2]));
+        }
 
         // Store the weight for each of the 4 integration points.
         this->weights_.insert(this->weights_.end(), {weight, weight, weight, weight});
@@ -273,44 +347,29 @@ void IntegPoints::GenerateFivePointsPerTetra(const TetraMesh &tetramesh)
     // Initialize the weight of the centroid (1st) integration point and the rest 4 integration points.
     double weight_cent = 0.; double weight = 0.;
 
+    // Contiguous coordinates and connectivity of the mesh.
+    const auto &coords = tetramesh.FlatCoordinates();
+    const auto &conn = tetramesh.Connectivity();
+
     // Generate four integration points for each tetrahedron of the mesh.
-    for (const auto &elem : tetramesh.Elements()) {
+    for (std::size_t t = 0; t != conn.size()/4; ++t) {
+        const double *p[4] = {&coords[3*conn[4*t]], &coords[3*conn[4*t+1]], &coords[3*conn[4*t+2]], &coords[3*conn[4*t+3]]};
+        const double volume = TetraMesh::TetraVolume(p[0], p[1], p[2], p[3]);
 
         // The weight of the centroid (1st) integration point.
-        weight_cent = elem.Volume(tetramesh.Nodes()) * (-4. / 5.);
+        weight_cent = volume * (-4. / 5.);
 
         // The weight of the rest 4 integration points.
-        weight = elem.Volume(tetramesh.Nodes()) * (9. / 20.);
+        weight = volume * (9. / 20.);
 
         // Store the 1st integration point's coordinates.
-        this->coordinates_.emplace_back((tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N4()].Coordinates()) / 4.);
-
-        // Store the 2nd integration point's coordinates.
-        this->coordinates_.emplace_back((tetramesh.Nodes()[elem.N1()].Coordinates() / 2.) +
-                                        (tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N4()].Coordinates()) / 6.);
-
-        // Store the 3rd integration point coordinates.
-        this->coordinates_.emplace_back((tetramesh.Nodes()[elem.N2()].Coordinates() / 2.) +
-                                        (tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N3()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N4()].Coordinates()) / 6.);
-
-        // Store the 4th integration point coordinates.
-        this->coordinates_.emplace_back((tetramesh.Nodes()[elem.N3()].Coordinates() / 2.) +
-                                        (tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N4()].Coordinates()) / 6.);
-
-        // Store the 5th integration point coordinates.
-        this->coordinates_.emplace_back((tetramesh.Nodes()[elem.N4()].Coordinates() / 2.) +
-                                        (tetramesh.Nodes()[elem.N1()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N2()].Coordinates() +
-                                         tetramesh.Nodes()[elem.N3()].Coordinates()) / 6.);
+        const double sum[3] = {p[0][0]+p[1][0]+p[2][0]+p[3][0], p[0][1]+p[1][1]+p[2][1]+p[3][1], p[0][2]+p[1][2]+p[2][2]+p[3][2]};
+        this->coordinates_.emplace_back(sum[0] / 4., sum[1] / 4., sum[2] / 4.);
+
+        // Store the rest integration points' coordinates. The i-th point is shifted towards the i-th node.
+        for (const auto &pi : p) {
+            this->coordinates_.emplace_back(pi[0] / 2. + (sum[0]-pi[0]) / 6., pi[1] / 2. + (sum[1]-pi[1]) / 6., pi[2] / 2. + (sum[2]-pi[2]) / 6.);
+        }
 
         // Store the weight for the centroid and the rest 4 integration points.
         this->weights_.insert(this->weights_.end(), {weight_cent, weight, weight, weight, weight});
@@ -319,84 +378,216 @@ void IntegPoints::GenerateFivePointsPerTetra(const TetraMesh &tetramesh)
 }
 
 
-void IntegPoints::GenerateAdaptivePointsPerTetra(const TetraMesh &tetramesh, const IntegOptions &options,
-                                                 const InfSupportDomain &support_dom)
+void IntegPoints::AssignElementRegions(const TetraMesh &tetramesh, std::size_t points_per_elem)
 {
-    //Allocate memory for integration points coordinates and weights.
-    int ip_num = 0;
-    switch (options.tetra_divisions_) {
-        case 2 :
-            // 2 x 4 ip per element.
-            ip_num = 8*static_cast<int>(tetramesh.Elements().size());
-            break;
-        case 4 :
-            // 4 x 4 ip per element.
-            ip_num = 16*static_cast<int>(tetramesh.Elements().size());
-            break;
-        case 8 :
-            // 8 x 4 ip per element.
-            ip_num = 32*static_cast<int>(tetramesh.Elements().size());
-            break;
-        default:
-            ip_num = 0;
+    this->region_ids_.clear();
+    this->region_ids_.reserve(points_per_elem*tetramesh.Elements().size());
+    for (const auto &elem : tetramesh.Elements()) {
+        this->region_ids_.insert(this->region_ids_.end(), points_per_elem, RegionOf(elem));
     }
-    this->coordinates_.reserve(ip_num);
-    this->weights_.reserve(ip_num);
+}
 
-    // Iterate over all the elements of the mesh.
-    for (const auto &elem : tetramesh.Elements()) {
 
-        // Extract the nodes of the element.
-        std::vector<Node> elem_nodes(4, Node());
-        elem_nodes[0] = tetramesh.Nodes()[elem.N1()];
-        elem_nodes[1] = tetramesh.Nodes()[elem.N2()];
-        elem_nodes[2] = tetramesh.Nodes()[elem.N3()];
-        elem_nodes[3] = tetramesh.Nodes()[elem.N4()];
+void IntegPoints::CompactRegionIds()
+{
+    if (std::all_of(this->region_ids_.begin(), this->region_ids_.end(), [](std::uint16_t region) { return region == 0; })) {
+        std::vector<std::uint16_t>().swap(this->region_ids_);
+    }
+}
 
-        // Set the adaptive integration level.
-        int adaptive_level = options.adaptive_level_;
 
-        // Declare the element's integration points contribution.
-        std::vector<Vec3<double> > elem_ip_coords;
-        std::vector<double> elem_ip_weights;
+void IntegPoints::GenerateNodalPoints(const TetraMesh &tetramesh, double stress_points_fraction)
+{
+    // Check the stress points volume fraction.
+    if (stress_points_fraction < 0. || stress_points_fraction >= 1.) {
+        std::string error = "[CLOUDEA ERROR] Invalid stress points volume fraction requested for"
+                            " nodal integration. Admissible fraction: [0, 1)";
+        throw std::invalid_argument(error.c_str());
+    }
 
-        // Choose generation schedule from integration options.
-        switch (options.tetra_divisions_) {
-            case 2 :
-                this->AdaptiveTwoTetraDivisions(tetramesh, elem_nodes, support_dom, options.adaptive_eps_, adaptive_level,
-                                                elem_ip_coords, elem_ip_weights);
+    // Contiguous coordinates and connectivity of the mesh.
+    const auto &coords = tetramesh.FlatCoordinates();
+    const auto &conn = tetramesh.Connectivity();
+
+    // Compute the nodal volumes as the quarter of the volume of the elements connected to each node.
+    this->nodal_volumes_.assign(tetramesh.Nodes().size(), 0.);
+    std::vector<double> elem_volumes;
+    elem_volumes.reserve(tetramesh.Elements().size());
+    for (std::size_t t = 0; t != conn.size()/4; ++t) {
+        const int *n = &conn[4*t];
+        elem_volumes.emplace_back(TetraMesh::TetraVolume(&coords[3*n[0]], &coords[3*n[1]], &coords[3*n[2]], &coords[3*n[3]]));
+        double quarter_volume = elem_volumes.back() / 4.;
+        for (std::size_t i = 0; i != 4; ++i) { this->nodal_volumes_[n[i]] += quarter_volume; }
+    }
 
-                // Add integration points contribution from the element.
-                this->coordinates_.insert(this->coordinates_.end(), elem_ip_coords.begin(), elem_ip_coords.end());
-                this->weights_.insert(this->weights_.end(), elem_ip_weights.begin(), elem_ip_weights.end());
+    std::size_t stress_points_num = (stress_points_fraction > 0.) ? tetramesh.Elements().size() : 0;
+    this->coordinates_.reserve(tetramesh.Nodes().size() + stress_points_num);
+    this->weights_.reserve(tetramesh.Nodes().size() + stress_points_num);
 
-                break;
-            case 4 :
-                this->AdaptiveFourTetraDivisions(tetramesh, elem_nodes, support_dom, options.adaptive_eps_, adaptive_level,
-                                                 elem_ip_coords, elem_ip_weights);
+    // Set one integration point at each node with the nodal volume not assigned to stress points as weight.
+    for (const auto &node : tetramesh.Nodes()) {
+        auto id = &node - &tetramesh.Nodes()[0];
+        this->coordinates_.emplace_back(node.Coordinates());
+        this->weights_.emplace_back((1. - stress_points_fraction) * this->nodal_volumes_[id]);
+    }
+    this->nodal_points_num_ = static_cast<int>(tetramesh.Nodes().size());
 
-                // Add integration points contribution from the element.
-                this->coordinates_.insert(this->coordinates_.end(), elem_ip_coords.begin(), elem_ip_coords.end());
-                this->weights_.insert(this->weights_.end(), elem_ip_weights.begin(), elem_ip_weights.end());
+    // The region of a nodal point is the region of the first element connected to the node.
+    std::vector<int> node_regions(tetramesh.Nodes().size(), -1);
+    for (const auto &elem : tetramesh.Elements()) {
+        for (const auto &node_id : {elem.N1(), elem.N2(), elem.N3(), elem.N4()}) {
+            if (node_regions[node_id] == -1) { node_regions[node_id] = RegionOf(elem); }
+        }
+    }
+    this->region_ids_.reserve(tetramesh.Nodes().size() + stress_points_num);
+    for (const auto &region : node_regions) { this->region_ids_.emplace_back(static_cast<std::uint16_t>(std::max(region, 0))); }
 
-                break;
-            case 8 :
-                this->AdaptiveEightTetraDivisions(tetramesh, elem_nodes, support_dom, options.adaptive_eps_,
-                                                  elem_ip_coords, elem_ip_weights);
+    // Set one stress point at each element's centroid. The stress points sample the deformation
+    // between the nodes and suppress the zero-energy modes of the nodal integration.
+    if (stress_points_num == 0) { return; }
+    for (const auto &elem : tetramesh.Elements()) {
+        auto id = &elem - &tetramesh.Elements()[0];
+        const int *n = &conn[4*id];
+        double centroid[3] = {0., 0., 0.};
+        for (std::size_t i = 0; i != 4; ++i) {
+            for (std::size_t d = 0; d != 3; ++d) { centroid[d] += 0.25*coords[3*n[i]+d]; }
+        }
+        this->coordinates_.emplace_back(centroid[0], centroid[1], centroid[2]);
+        this->weights_.emplace_back(stress_points_fraction * elem_volumes[id]);
+        this->region_ids_.emplace_back(RegionOf(elem));
+    }
 
-                // Add integration points contribution from the element.
-                this->coordinates_.insert(this->coordinates_.end(), elem_ip_coords.begin(), elem_ip_coords.end());
-                this->weights_.insert(this->weights_.end(), elem_ip_weights.begin(), elem_ip_weights.end());
+}
 
-                break;
-            default :
-                std::string error = "[CLOUDEA ERROR] Invalid number of tetrahedral divisions requested for"
-                                    " adaptive integration. Admissible numbers: [2/4/8]";
-                throw std::invalid_argument(error.c_str());
-                break;
+
+void IntegPoints::GenerateAdaptivePointsPerTetra(const TetraMesh &tetramesh, const IntegOptions &options,
+                                                 const InfSupportDomain &support_dom)
+{
+    // Check the number of tetrahedral divisions before launching the generation.
+    if (options.tetra_divisions_ != 2 && options.tetra_divisions_ != 4 && options.tetra_divisions_ != 8) {
+        std::string error = "[CLOUDEA ERROR] Invalid number of tetrahedral divisions requested for"
+                            " adaptive integration. Admissible numbers: [2/4/8]";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // The elements are processed in chunks. Each chunk stores its integration points in its own buffer.
+    const std::size_t elems_num = tetramesh.Elements().size();
+    const std::size_t chunk_size = 16;
+    const std::size_t chunks_num = (elems_num + chunk_size - 1) / chunk_size;
+    std::vector<std::vector<Vec3<double> > > chunk_ip_coords(chunks_num);
+    std::vector<std::vector<double> > chunk_ip_weights(chunks_num);
+    std::vector<std::vector<std::uint16_t> > chunk_ip_regions(chunks_num);
+
+    // Index the influence spheres of the support domain once. It is queried per integration point.
+    std::vector<Vec3<double> > centers;
+    centers.reserve(support_dom.InfluenceNodes().size());
+    for (const auto &node : support_dom.InfluenceNodes()) { centers.emplace_back(node.Coordinates()); }
+    this->nodes_index_.SetThreadsNumber(this->threads_number_);
+    this->nodes_index_.SetSpheres(centers, support_dom.InfluenceNodesRadiuses());
+
+    // Set the single-point evaluator of the mmls shape function derivatives.
+    this->derivs_evaluator_.SetBasisFunctionType("linear");
+    this->derivs_evaluator_.SetExactDerivativesMode(true);
+
+    // The index of the next chunk to be processed. Chunks are claimed dynamically since the recursion depth varies between elements.
+    std::atomic<std::size_t> next_chunk(0);
+
+    // The number of elements that reached the maximum adaptation level.
+    std::atomic<std::size_t> max_level_elems_num(0);
+
+    // Generate the integration points of the claimed chunks until all chunks are processed.
+    auto generate_chunks = [&](std::exception_ptr &thread_error) {
+        try {
+            // Declare the element's integration points contribution.
+            std::vector<Vec3<double> > elem_ip_coords;
+            std::vector<double> elem_ip_weights;
+            std::vector<Node> elem_nodes(4, Node());
+
+            for (auto chunk = next_chunk++; chunk < chunks_num; chunk = next_chunk++) {
+                auto &ip_coords = chunk_ip_coords[chunk];
+                auto &ip_weights = chunk_ip_weights[chunk];
+                auto &ip_regions = chunk_ip_regions[chunk];
+
+                auto end_id = std::min(elems_num, (chunk+1)*chunk_size);
+                for (auto elem_id = chunk*chunk_size; elem_id != end_id; ++elem_id) {
+                    const auto &elem = tetramesh.Elements()[elem_id];
+
+                    // Extract the nodes of the element.
+                    elem_nodes[0] = tetramesh.Nodes()[elem.N1()];
+                    elem_nodes[1] = tetramesh.Nodes()[elem.N2()];
+                    elem_nodes[2] = tetramesh.Nodes()[elem.N3()];
+                    elem_nodes[3] = tetramesh.Nodes()[elem.N4()];
+
+                    // Set the adaptive integration level.
+                    int adaptive_level = options.adaptive_level_;
+
+                    // Choose generation schedule from integration options.
+                    if (options.tetra_divisions_ == 2) {
+                        this->AdaptiveTwoTetraDivisions(tetramesh, elem_nodes, support_dom, options.adaptive_eps_,
+                                                        adaptive_level, elem_ip_coords, elem_ip_weights);
+                    }
+                    else if (options.tetra_divisions_ == 4) {
+                        this->AdaptiveFourTetraDivisions(tetramesh, elem_nodes, support_dom, options.adaptive_eps_,
+                                                         adaptive_level, elem_ip_coords, elem_ip_weights);
+                    }
+                    else {
+                        this->AdaptiveEightTetraDivisions(tetramesh, elem_nodes, support_dom, options.adaptive_eps_,
+                                                          elem_ip_coords, elem_ip_weights);
+                    }
+                    if (options.tetra_divisions_ != 8 && adaptive_level <= 0) { max_level_elems_num++; }
+
+                    // Add integration points contribution from the element.
+                    ip_coords.insert(ip_coords.end(), elem_ip_coords.begin(), elem_ip_coords.end());
+                    ip_weights.insert(ip_weights.end(), elem_ip_weights.begin(), elem_ip_weights.end());
+                    ip_regions.insert(ip_regions.end(), elem_ip_weights.size(), RegionOf(elem));
+                }
+            }
+        }
+        catch (...) {
+            // Stop the other threads and keep the error to rethrow it after joining.
+            next_chunk = chunks_num;
+            thread_error = std::current_exception();
         }
+    };
+
+    // Run the generation in parallel.
+    std::size_t threads_num = std::max(std::size_t{1}, std::min(this->threads_number_, chunks_num));
+    std::vector<std::exception_ptr> thread_errors(threads_num);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < threads_num; ++t) { threads.emplace_back(std::thread(generate_chunks, std::ref(thread_errors[t]))); }
+    generate_chunks(thread_errors[0]);
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    // Release the influence nodes index and the derivatives evaluator. They are only needed during the generation.
+    this->nodes_index_ = CellListSearch<3>();
+    this->derivs_evaluator_ = Mmls3d();
+
+    for (const auto &thread_error : thread_errors) {
+        if (thread_error) { std::rethrow_exception(thread_error); }
+    }
 
-    } // End Iterate over all the elements of the mesh.
+    // Report the elements that reached the maximum adaptation level once for the whole generation.
+    if (max_level_elems_num > 0) {
+        std::cout << "[CLOUDEA WARNING] The maximum adaptation level of integration points has been reached in "
+                  << max_level_elems_num << " of " << elems_num << " elements.\n";
+    }
+
+    // Concatenate the chunks' integration points in element order.
+    std::size_t ip_num = 0;
+    for (const auto &ip_weights : chunk_ip_weights) { ip_num += ip_weights.size(); }
+    this->coordinates_.reserve(ip_num);
+    this->weights_.reserve(ip_num);
+    this->region_ids_.reserve(ip_num);
+    for (std::size_t chunk = 0; chunk != chunks_num; ++chunk) {
+        this->coordinates_.insert(this->coordinates_.end(), chunk_ip_coords[chunk].begin(), chunk_ip_coords[chunk].end());
+        this->weights_.insert(this->weights_.end(), chunk_ip_weights[chunk].begin(), chunk_ip_weights[chunk].end());
+        this->region_ids_.insert(this->region_ids_.end(), chunk_ip_regions[chunk].begin(), chunk_ip_regions[chunk].end());
+
+        // Release the chunk's buffers once merged.
+        std::vector<Vec3<double> >().swap(chunk_ip_coords[chunk]);
+        std::vector<double>().swap(chunk_ip_weights[chunk]);
+        std::vector<std::uint16_t>().swap(chunk_ip_regions[chunk]);
+    }
 
 }
 
@@ -414,10 +605,8 @@ void IntegPoints::AdaptiveTwoTetraDivisions(const TetraMesh &tetramesh, const st
     // Reduce the adaptation level.
     adaptive_level--;
 
-    if (adaptive_level <= 0) {
-        std::cout << "[CLOUDEA WARNING] The maximum adaptation level of integration points has been reached.\n";
-        return;
-    }
+    // Stop at the maximum adaptation level. It is reported once after the generation.
+    if (adaptive_level <= 0) { return; }
 
     // Compute the squares of the tetrahedron edges.
     double n12_sq = tet_nodes[0].Coordinates().Distance2(tet_nodes[1].Coordinates());
@@ -566,10 +755,8 @@ void IntegPoints::AdaptiveFourTetraDivisions(const TetraMesh &tetramesh, const s
     // Reduce the adaptation level.
     adaptive_level--;
 
-    if (adaptive_level <= 0) {
-        std::cout << "[CLOUDEA WARNING] The maximum adaptation level of integration points has been reached.\n";
-        return;
-    }
+    // Stop at the maximum adaptation level. It is reported once after the generation.
+    if (adaptive_level <= 0) { return; }
 
     // Apply 4 tetrahedral subdivision by adding a new node
     // at the midpoint at each edge of one of the tetrahedron's face.
@@ -831,37 +1018,42 @@ Vec3<double> IntegPoints::IntegrationValue(const TetraMesh &tetramesh, const std
         throw std::runtime_error(error.c_str());
     }
 
+    // Check if the influence nodes index is initialized.
+    if (this->nodes_index_.SpheresNum() == 0) {
+        std::string error = "[CLOUDEA ERROR] Cannot compute integration value. "
+                            "The influence nodes of the support domain have not been indexed.";
+        throw std::runtime_error(error.c_str());
+    }
+
     // Initialize the integration value vector.
     Vec3<double> val(0., 0., 0.);
 
-    // Compute tetrahedral neighbor nodes indices for the integration points.
-    auto neigh_ids = support_dom.CgalClosestNodesIdsTo(ip_coords);
-
-    // Compute mmls shape functions.
-    Mmls3d mmls3d;
-    mmls3d.SetBasisFunctionType("linear");
-    mmls3d.SetExactDerivativesMode(true);
-    mmls3d.ComputeShFuncAndDerivs(tetramesh.Nodes(), ip_coords, neigh_ids, support_dom.InfluenceNodesRadiuses());
+    // The support nodes and the shape function derivatives of an integration point.
+    std::vector<int> support_ids;
+    std::vector<double> derx, dery, derz;
 
     // Iterate over all the integration points.
     for (const auto &ip_coord : ip_coords) {
         // The integration point index.
         auto ip = &ip_coord - &ip_coords[0];
 
-        // Gather the values of x, y, z derivatives of the shape function values at the integration point ip.
-        Eigen::ArrayXd ip_derx_sq = mmls3d.ShapeFunctionDx().col(ip);
-        Eigen::ArrayXd ip_dery_sq = mmls3d.ShapeFunctionDy().col(ip);
-        Eigen::ArrayXd ip_derz_sq = mmls3d.ShapeFunctionDz().col(ip);
+        // Query the support nodes of the integration point in the influence nodes index.
+        this->nodes_index_.ContainingSpheresIds(ip_coord, support_ids);
 
-        // Square the x, y, z derivatives.
-        ip_derx_sq *= ip_derx_sq;
-        ip_dery_sq *= ip_dery_sq;
-        ip_derz_sq *= ip_derz_sq;
+        // Compute the x, y, z derivatives of the mmls shape functions at the integration point ip.
+        this->derivs_evaluator_.ComputeDerivsAt(tetramesh.Nodes(), ip_coord, support_ids, support_dom.InfluenceNodesRadiuses(),
+                                                derx, dery, derz);
 
-        // Add the contibution of each ip to the integration value.
-        val.SetX(val.X() + ip_weights[ip]*ip_derx_sq.sum());
-        val.SetY(val.Y() + ip_weights[ip]*ip_dery_sq.sum());
-        val.SetZ(val.Z() + ip_weights[ip]*ip_derz_sq.sum());
+        // Add the contibution of each ip to the integration value with the squared x, y, z derivatives.
+        double derx_sq = 0., dery_sq = 0., derz_sq = 0.;
+        for (std::size_t i = 0; i != support_ids.size(); ++i) {
+            derx_sq += derx[i]*derx[i];
+            dery_sq += dery[i]*dery[i];
+            derz_sq += derz[i]*derz[i];
+        }
+        val.SetX(val.X() + ip_weights[ip]*derx_sq);
+        val.SetY(val.Y() + ip_weights[ip]*dery_sq);
+        val.SetZ(val.Z() + ip_weights[ip]*derz_sq);
     }
 
     // Return the integration value.
@@ -31,6 +31,7 @@
 
 #include "CLOUDEA/engine/approximants/mmls_3d.hpp"
 #include "CLOUDEA/engine/support_domain/inf_support_domain.hpp"
+#include "CLOUDEA/engine/support_domain/cell_list_search.hpp"
 #include "CLOUDEA/engine/vectors/vec3.hpp"
 #include "CLOUDEA/engine/elements/element_properties.hpp"
 #include "CLOUDEA/engine/elements/node.hpp"
@@ -38,12 +39,19 @@
 #include "CLOUDEA/engine/mesh/mesh_properties.hpp"
 #include "CLOUDEA/engine/mesh/tetramesh.hpp"
 #include "CLOUDEA/engine/integration/integ_options.hpp"
+#include "CLOUDEA/engine/integration/integ_points_io.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <utility>
 #include <algorithm>
 #include <iostream>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <functional>
+#include <limits>
 
 
 namespace CLOUDEA {
@@ -76,6 +84,10 @@ public:
 
     /*!
      * \brief Generate the integration points for a given tetrahedral mesh.
+     *
+     * For nodal integration, the first integration points coincide with the mesh nodes in the same order
+     * and they are followed by the stress points of the elements, if any.
+     *
      * \param [in] tetramesh The tetrahedral mesh for which integration points will be generated.
      * \param [in] options The integration options for the generation of integration points.
      * \param [in] support_dom The support (influence) domains of the tetrahedral mesh nodes. Used for adaptive integration.
@@ -85,9 +97,53 @@ public:
 
     void Generate2(const TetraMesh &tetramesh, short num_per_elem);
 
+
+    /*!
+     * \brief Set the number of threads used in the adaptive generation and the binary input/output of integration points.
+     * \param [in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    void SetThreadsNumber(std::size_t threads_number);
+
+
+    /*!
+     * \brief Load the integration points from a file.
+     *
+     * Binary integration points files written by SaveToFile are detected by their identifier and loaded memory mapped
+     * with the threads of the integration points. Any other file is parsed as an ASCII file of coordinates and weights.
+     *
+     * \param [in] ip_file The file to load the integration points from.
+     * \return [void]
+     */
     void LoadFromFile(const std::string & ip_file);
 
 
+    /*!
+     * \brief Save the integration points in a binary file.
+     *
+     * The coordinates, the weights and the nodal volumes of nodal integration are stored as separate arrays
+     * of 64-bit floating point numbers protected by a checksum. See IntegPointsIO for the file layout.
+     *
+     * \param [in] ip_file The binary file where the integration points will be saved.
+     * \return [void]
+     */
+    void SaveToFile(const std::string &ip_file) const;
+
+
+    /*!
+     * \brief Set the integration points from the given coordinates and weights.
+     *
+     * The nodal integration information is cleared.
+     *
+     * \param [in] coordinates The coordinates of the integration points.
+     * \param [in] weights The weights of the integration points.
+     * \param [in] region_ids The material region indices of the integration points. Empty if all the points belong in region 0.
+     * \return [void]
+     */
+    void SetPoints(const std::vector<Vec3<double> > &coordinates, const std::vector<double> &weights,
+                   const std::vector<std::uint16_t> &region_ids = std::vector<std::uint16_t>());
+
+
     /*!
      * \brief Get the coordinates of the integration points.
      * \return [std::vector<CLOUDEA::Vec3<double> >] The coordinates of the integration points.
@@ -105,6 +161,48 @@ public:
     inline const std::vector<double> & Weights() const { return this->weights_; }
 
 
+    /*!
+     * \brief Get the material region indices of the integration points.
+     *
+     * The region of an integration point is the partition of the tetrahedron where it was generated.
+     * For nodal integration, the region of a nodal point is the partition of the first tetrahedron connected to the node.
+     *
+     * \return [std::vector<std::uint16_t>] The region indices of the integration points. Empty if all the points belong in region 0.
+     */
+    inline const std::vector<std::uint16_t> & RegionIds() const { return this->region_ids_; }
+
+
+    /*!
+     * \brief Get the number of threads used in the adaptive generation and the binary input/output of integration points.
+     * \return [std::size_t] The number of threads used in the adaptive generation and the binary input/output of integration points.
+     */
+    inline const std::size_t & ThreadsNumber() const { return this->threads_number_; }
+
+
+    /*!
+     * \brief Get the volumes of the nodes for nodal integration.
+     *
+     * The volume of a node is the quarter of the volume of the elements connected to it.
+     *
+     * \return [std::vector<double>] The volumes of the nodes. Empty if nodal integration is not used.
+     */
+    inline const std::vector<double> & NodalVolumes() const { return this->nodal_volumes_; }
+
+
+    /*!
+     * \brief Get the number of integration points coinciding with the mesh nodes.
+     * \return [int] The number of integration points coinciding with the mesh nodes. Zero if nodal integration is not used.
+     */
+    inline int NodalPointsNum() const { return this->nodal_points_num_; }
+
+
+    /*!
+     * \brief Check if the integration points were generated for nodal integration.
+     * \return [bool] True if nodal integration is used, false otherwise.
+     */
+    inline bool IsNodal() const { return this->nodal_points_num_ != 0; }
+
+
     /*!
      * \brief Get the number of integration points.
      * \return [int] The number of integration points.
@@ -160,8 +258,43 @@ protected:
     void GenerateFivePointsPerTetra(const TetraMesh &tetramesh);
 
 
+    /*!
+     * \brief Generate the integration points of stabilized nodal integration for a tetrahedral mesh.
+     *
+     * One integration point is set at each node and one stress point at the centroid of each element.
+     * The stress points take the given fraction of the volume of the elements and the nodal points the remainder
+     * of the nodal volumes. Pure nodal integration, i.e. without stress points, is obtained for zero fraction.
+     *
+     * \param [in] tetramesh The tetrahedral mesh.
+     * \param [in] stress_points_fraction The fraction of the elements volume assigned to the stress points.
+     * \return [void]
+     */
+    void GenerateNodalPoints(const TetraMesh &tetramesh, double stress_points_fraction);
+
+
+    /*!
+     * \brief Assign the material region of each integration point generated with a fixed number of points per tetrahedron.
+     * \param [in] tetramesh The tetrahedral mesh.
+     * \param [in] points_per_elem The number of integration points per tetrahedron.
+     * \return [void]
+     */
+    void AssignElementRegions(const TetraMesh &tetramesh, std::size_t points_per_elem);
+
+
+    /*!
+     * \brief Release the material region indices if all the integration points belong in region 0.
+     * \return [void]
+     */
+    void CompactRegionIds();
+
+
     /*!
      * \brief Generate adaptive integration points per tetrahedron of a tetrahedral mesh.
+     *
+     * The elements are processed in parallel in small chunks claimed dynamically by the threads,
+     * since the recursion depth varies between elements. The integration points of the chunks
+     * are concatenated in element order, thus the result is independent of the number of threads.
+     *
      * \param [in] tetramesh The tetrahedral mesh.
      * \param [in] options The integration options.
      * \param [in] support_dom The support domains of the tetrahedral mesh nodes.
@@ -222,10 +355,14 @@ protected:
 
     /*!
      * \brief Calculate the integration value.
+     *
+     * The support nodes of each integration point are queried in the influence nodes index
+     * and the shape function derivatives are computed by the single-point mmls evaluator,
+     * so the cost is independent of the total number of nodes.
+     *
      * \param [in] tetramesh The tetrahedral mesh.
      * \param [in] ip_coords The coordinates of the integration points.
      * \param [in] ip_weights The weights of the integration points.
-     * \param [in] neigh_ids The indices of neighbor tetrahedral nodes to the integration points.
      * \param [in] support_dom The support (influence) domains of the tetrahedral mesh nodes. Used for adaptive integration.
      * \return [CLOUDEA::Vec3<double>] The integration value.
      */
@@ -237,6 +374,18 @@ private:
     std::vector<Vec3<double> > coordinates_;      /*!< The coordinates of the integration points. */
 
     std::vector<double> weights_;                 /*!< The weight of the integration points. */
+
+    std::vector<double> nodal_volumes_;           /*!< The volumes of the nodes for nodal integration. */
+
+    int nodal_points_num_;                        /*!< The number of integration points coinciding with the mesh nodes. */
+
+    std::vector<std::uint16_t> region_ids_;       /*!< The material region indices of the integration points. Empty if all the points belong in region 0. */
+
+    std::size_t threads_number_;                  /*!< The number of threads used in the adaptive generation and the binary input/output of integration points. */
+
+    CellListSearch<3> nodes_index_;               /*!< The index of the influence spheres of the support domain for adaptive integration. Released after the generation. */
+
+    Mmls3d derivs_evaluator_;                     /*!< The single-point evaluator of the mmls shape function derivatives for adaptive integration. Released after the generation. */
 };
 
 
@@ -0,0 +1,290 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/integration/integ_points_io.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+
+namespace CLOUDEA {
+
+
+// The identifier and layout of the binary integration points files.
+static const char ipt_magic[8] = {'C', 'L', 'D', 'I', 'N', 'T', 'P', 'T'};
+static const std::uint32_t ipt_version = 1;
+static const std::size_t ipt_header_bytes = 64;
+static const std::size_t ipt_checksum_block = (std::size_t{1} << 20) / sizeof(std::uint64_t);
+
+// The FNV-1a 64-bit parameters.
+static const std::uint64_t fnv_offset = 14695981039346656037ULL;
+static const std::uint64_t fnv_prime = 1099511628211ULL;
+
+
+// Run the given function on contiguous ranges of [0, num) in parallel.
+static void ParallelRanges(std::size_t num, std::size_t threads_number, const std::function<void(std::size_t, std::size_t)> &func)
+{
+    std::size_t threads_num = std::max(std::size_t{1}, std::min(threads_number, num));
+    std::size_t chunk = (num + threads_num - 1) / threads_num;
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num);
+    for (std::size_t t = 0; t != threads_num; ++t) {
+        std::size_t start = std::min(t*chunk, num);
+        std::size_t end = std::min(start+chunk, num);
+        threads.emplace_back(std::thread(func, start, end));
+    }
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+}
+
+
+IntegPointsHeader IntegPointsIO::ParseHeader(const char *data, std::size_t file_size, const std::string &filename)
+{
+    if (file_size < ipt_header_bytes || std::memcmp(data, ipt_magic, sizeof(ipt_magic)) != 0) {
+        std::string error = Logger::Error("The file \"") + filename + "\" is not a binary integration points file";
+        throw std::runtime_error(error.c_str());
+    }
+
+    IntegPointsHeader header;
+    std::memcpy(&header.version, data+8, sizeof(std::uint32_t));
+    std::memcpy(&header.flags, data+12, sizeof(std::uint32_t));
+    std::memcpy(&header.points_num, data+16, sizeof(std::uint64_t));
+    std::memcpy(&header.nodal_points_num, data+24, sizeof(std::uint64_t));
+    std::memcpy(&header.checksum, data+32, sizeof(std::uint64_t));
+    std::memcpy(&header.payload_bytes, data+40, sizeof(std::uint64_t));
+
+    if (header.version != ipt_version) {
+        std::string error = Logger::Error("The binary integration points file \"") + filename + "\" has unsupported version " +
+                            std::to_string(header.version);
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Check that the file contains the coordinates, the weights, the nodal volumes and the regions, if any.
+    std::uint64_t regions_bytes = (header.flags & regions_flag) ? header.points_num*sizeof(std::uint16_t) : 0;
+    if (header.points_num > file_size || header.nodal_points_num > header.points_num || (header.flags & ~regions_flag) ||
+            header.payload_bytes != (4*header.points_num + header.nodal_points_num)*sizeof(double) + regions_bytes ||
+            ipt_header_bytes + header.payload_bytes != file_size) {
+        std::string error = Logger::Error("The binary integration points file \"") + filename + "\" is corrupted";
+        throw std::runtime_error(error.c_str());
+    }
+
+    return header;
+}
+
+
+std::uint64_t IntegPointsIO::Checksum(const void *data, std::size_t bytes) const
+{
+    const auto *bytes_data = static_cast<const unsigned char *>(data);
+    const std::size_t words_num = (bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    // Hash the blocks in parallel.
+    std::size_t blocks_num = (words_num + ipt_checksum_block - 1) / ipt_checksum_block;
+    std::vector<std::uint64_t> block_hashes(blocks_num);
+    ParallelRanges(blocks_num, this->threads_number_, [&](std::size_t start, std::size_t end) {
+        for (std::size_t b = start; b != end; ++b) {
+            std::size_t first = b*ipt_checksum_block;
+            std::size_t last = std::min(first+ipt_checksum_block, words_num);
+            std::uint64_t hash = fnv_offset;
+            for (std::size_t i = first; i != last; ++i) {
+                std::uint64_t word = 0;
+                std::memcpy(&word, bytes_data + i*sizeof(std::uint64_t), std::min(sizeof(std::uint64_t), bytes - i*sizeof(std::uint64_t)));
+                hash = (hash ^ word) * fnv_prime;
+            }
+            block_hashes[b] = hash;
+        }
+    });
+
+    // Combine the block hashes in order.
+    std::uint64_t checksum = fnv_offset ^ static_cast<std::uint64_t>(bytes);
+    for (const auto &hash : block_hashes) { checksum = (checksum ^ hash) * fnv_prime; }
+    return checksum;
+}
+
+
+IntegPointsIO::IntegPointsIO() : threads_number_(1)
+{
+    // Use all the available hardware threads by default.
+    this->SetThreadsNumber(0);
+}
+
+
+IntegPointsIO::~IntegPointsIO()
+{}
+
+
+void IntegPointsIO::SetThreadsNumber(std::size_t threads_number)
+{
+    // Get the number of available hardware threads if not given.
+    if (threads_number == 0) {
+        const std::size_t available_threads = std::thread::hardware_concurrency();
+        threads_number = std::max(available_threads, std::size_t{1});
+    }
+
+    this->threads_number_ = threads_number;
+}
+
+
+void IntegPointsIO::Save(const std::string &filename, const std::vector<Vec3<double> > &coordinates, const std::vector<double> &weights,
+                         const std::vector<double> &nodal_volumes, std::size_t nodal_points_num,
+                         const std::vector<std::uint16_t> &region_ids) const
+{
+    // Check if filename is not empty.
+    if (filename.empty()) {
+        throw std::invalid_argument(Logger::Error("No filename was given to save the binary integration points").c_str());
+    }
+
+    // Check the consistency of the integration points.
+    if (coordinates.size() != weights.size() || nodal_points_num > coordinates.size() ||
+            (nodal_points_num != 0 && nodal_volumes.size() != nodal_points_num) ||
+            (!region_ids.empty() && region_ids.size() != coordinates.size())) {
+        throw std::invalid_argument(Logger::Error("Could not save the binary integration points. "
+                                                  "The integration points' coordinates, weights, nodal volumes and regions are inconsistent.").c_str());
+    }
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::string error = Logger::Error("Could not open the binary integration points file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Reserve the header. It is written after the checksum of the arrays is known.
+    char header_bytes[ipt_header_bytes] = {};
+    file.write(header_bytes, ipt_header_bytes);
+
+    // Write the arrays and combine their checksums.
+    std::uint64_t checksum = fnv_offset;
+    auto write_array = [&](const void *values, std::size_t bytes) {
+        checksum = (checksum ^ this->Checksum(values, bytes)) * fnv_prime;
+        file.write(static_cast<const char *>(values), static_cast<std::streamsize>(bytes));
+    };
+
+    std::vector<double> component(coordinates.size());
+    for (std::size_t dim = 0; dim != 3; ++dim) {
+        ParallelRanges(coordinates.size(), this->threads_number_, [&](std::size_t start, std::size_t end) {
+            for (std::size_t i = start; i != end; ++i) { component[i] = coordinates[i][dim]; }
+        });
+        write_array(component.data(), component.size()*sizeof(double));
+    }
+    write_array(weights.data(), weights.size()*sizeof(double));
+    write_array(nodal_volumes.data(), nodal_points_num*sizeof(double));
+    if (!region_ids.empty()) { write_array(region_ids.data(), region_ids.size()*sizeof(std::uint16_t)); }
+
+    // Write the header.
+    IntegPointsHeader header;
+    header.version = ipt_version;
+    header.flags = region_ids.empty() ? 0 : regions_flag;
+    header.points_num = coordinates.size();
+    header.nodal_points_num = nodal_points_num;
+    header.checksum = checksum;
+    header.payload_bytes = (4*coordinates.size() + nodal_points_num)*sizeof(double) + region_ids.size()*sizeof(std::uint16_t);
+
+    std::memcpy(header_bytes, ipt_magic, sizeof(ipt_magic));
+    std::memcpy(header_bytes+8, &header.version, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+12, &header.flags, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+16, &header.points_num, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+24, &header.nodal_points_num, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+32, &header.checksum, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+40, &header.payload_bytes, sizeof(std::uint64_t));
+    file.seekp(0, std::ios::beg);
+    file.write(header_bytes, ipt_header_bytes);
+
+    if (!file) {
+        std::string error = Logger::Error("Could not write the binary integration points file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+}
+
+
+void IntegPointsIO::Load(const std::string &filename, std::vector<Vec3<double> > &coordinates, std::vector<double> &weights,
+                         std::vector<double> &nodal_volumes, std::size_t &nodal_points_num,
+                         std::vector<std::uint16_t> &region_ids) const
+{
+    // Check if filename is not empty.
+    if (filename.empty()) {
+        throw std::invalid_argument(Logger::Error("No filename was given to load the binary integration points").c_str());
+    }
+
+    std::size_t file_size = 0;
+    auto storage = MappedFile::Map(filename, "binary integration points", file_size);
+    const char *data = static_cast<const char *>(storage.get());
+    auto header = ParseHeader(data, file_size, filename);
+
+    auto points_num = static_cast<std::size_t>(header.points_num);
+    auto nodes_num = static_cast<std::size_t>(header.nodal_points_num);
+    const auto *x = reinterpret_cast<const double *>(data + ipt_header_bytes);
+    const auto *y = x + points_num;
+    const auto *z = y + points_num;
+    const auto *w = z + points_num;
+    const auto *volumes = w + points_num;
+    const auto *regions = reinterpret_cast<const std::uint16_t *>(volumes + nodes_num);
+    const std::size_t regions_num = (header.flags & regions_flag) ? points_num : 0;
+
+    // Verify the checksum of the arrays.
+    std::uint64_t checksum = fnv_offset;
+    for (const auto &array : {std::make_pair(x, points_num), std::make_pair(y, points_num), std::make_pair(z, points_num),
+                              std::make_pair(w, points_num), std::make_pair(volumes, nodes_num)}) {
+        checksum = (checksum ^ this->Checksum(array.first, array.second*sizeof(double))) * fnv_prime;
+    }
+    if (regions_num != 0) { checksum = (checksum ^ this->Checksum(regions, regions_num*sizeof(std::uint16_t))) * fnv_prime; }
+    if (checksum != header.checksum) {
+        std::string error = Logger::Error("The binary integration points file \"") + filename + "\" failed the checksum verification";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Convert the arrays to the integration points in parallel.
+    coordinates.resize(points_num);
+    weights.resize(points_num);
+    ParallelRanges(points_num, this->threads_number_, [&](std::size_t start, std::size_t end) {
+        for (std::size_t i = start; i != end; ++i) {
+            coordinates[i].Set(x[i], y[i], z[i]);
+            weights[i] = w[i];
+        }
+    });
+    nodal_volumes.assign(volumes, volumes+nodes_num);
+    nodal_points_num = nodes_num;
+    region_ids.assign(regions, regions+regions_num);
+}
+
+
+IntegPointsHeader IntegPointsIO::ReadHeader(const std::string &filename) const
+{
+    char header_bytes[ipt_header_bytes] = {};
+    auto file_size = MappedFile::ReadPrefix(filename, "binary integration points", header_bytes, ipt_header_bytes);
+
+    return ParseHeader(header_bytes, file_size, filename);
+}
+
+
+bool IntegPointsIO::IsBinaryFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open()) { return false; }
+
+    char magic[sizeof(ipt_magic)] = {};
+    file.read(magic, sizeof(ipt_magic));
+    return file.gcount() == static_cast<std::streamsize>(sizeof(ipt_magic)) &&
+           std::memcmp(magic, ipt_magic, sizeof(ipt_magic)) == 0;
+}
+
+
+} //end of namespace CLOUDEA
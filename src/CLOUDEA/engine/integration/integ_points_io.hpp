@@ -0,0 +1,203 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_INTEGRATION_INTEG_POINTS_IO_HPP_
+#define CLOUDEA_INTEGRATION_INTEG_POINTS_IO_HPP_
+
+/*!
+   \file integ_points_io.hpp
+   \brief IntegPointsIO class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Integration
+ *  @{
+ */
+
+
+/*!
+ * \struct IntegPointsHeader
+ * \brief Header of a binary integration points file.
+ */
+struct IntegPointsHeader
+{
+    std::uint32_t version;                  /*!< The version of the binary format. */
+
+    std::uint32_t flags;                    /*!< The storage flags of the optional arrays. */
+
+    std::uint64_t points_num;               /*!< The number of integration points. */
+
+    std::uint64_t nodal_points_num;         /*!< The number of integration points coinciding with the mesh nodes. Zero if nodal integration is not used. */
+
+    std::uint64_t checksum;                 /*!< The checksum of the stored arrays. */
+
+    std::uint64_t payload_bytes;            /*!< The size in bytes of the stored arrays. */
+};
+
+
+/*!
+ * \class IntegPointsIO
+ * \brief Binary input/output of integration points.
+ *
+ * The binary file stores a 64 byte header followed by the x, y, z coordinates and the weights of the integration
+ * points and the nodal volumes of nodal integration as separate arrays of 64-bit floating point numbers.
+ * The material region indices of multi-material models follow as an array of 16-bit integers.
+ * The arrays are protected by a checksum that is computed in parallel over blocks of 1 MiB. The file is memory mapped
+ * where supported and the arrays are converted to the integration points in parallel.
+ */
+
+class IntegPointsIO {
+protected:
+
+    /*!
+     * \brief Parse and validate the header of a binary integration points file.
+     * \param [in] data The contents of the file.
+     * \param [in] file_size The size of the file in bytes.
+     * \param [in] filename The file name used in the error messages.
+     * \return [IntegPointsHeader] The header of the file.
+     */
+    static IntegPointsHeader ParseHeader(const char *data, std::size_t file_size, const std::string &filename);
+
+
+    /*!
+     * \brief Compute the checksum of an array.
+     *
+     * The array is split in blocks of 1 MiB that are hashed in parallel with 64-bit word FNV-1a. A trailing partial
+     * word is padded with zeros. The block hashes are combined in order, thus the checksum does not depend on the number of threads.
+     *
+     * \param [in] data The array.
+     * \param [in] bytes The size of the array in bytes.
+     * \return [std::uint64_t] The checksum of the array.
+     */
+    std::uint64_t Checksum(const void *data, std::size_t bytes) const;
+
+
+public:
+
+    /*!
+     * \brief Flag of stored material region indices.
+     */
+    static const std::uint32_t regions_flag = 1;
+
+
+    /*!
+     * \brief IntegPointsIO constructor.
+     */
+    IntegPointsIO();
+
+
+    /*!
+     * \brief IntegPointsIO destructor.
+     */
+    virtual ~IntegPointsIO();
+
+
+    /*!
+     * \brief Set the number of threads used in the checksum and the conversion of the integration points.
+     * \param [in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    void SetThreadsNumber(std::size_t threads_number);
+
+
+    /*!
+     * \brief Save integration points in a binary file.
+     * \param [in] filename The binary file where the integration points will be saved.
+     * \param [in] coordinates The coordinates of the integration points.
+     * \param [in] weights The weights of the integration points.
+     * \param [in] nodal_volumes The volumes of the nodes for nodal integration. Empty if nodal integration is not used.
+     * \param [in] nodal_points_num The number of integration points coinciding with the mesh nodes.
+     * \param [in] region_ids The material region indices of the integration points. Empty if all the points belong in region 0.
+     * \return [void]
+     */
+    void Save(const std::string &filename, const std::vector<Vec3<double> > &coordinates, const std::vector<double> &weights,
+              const std::vector<double> &nodal_volumes, std::size_t nodal_points_num,
+              const std::vector<std::uint16_t> &region_ids = std::vector<std::uint16_t>()) const;
+
+
+    /*!
+     * \brief Load integration points from a binary file.
+     *
+     * The file is rejected if its checksum does not match with the stored arrays.
+     *
+     * \param [in] filename The binary file where the integration points will be loaded from.
+     * \param [out] coordinates The coordinates of the integration points.
+     * \param [out] weights The weights of the integration points.
+     * \param [out] nodal_volumes The volumes of the nodes for nodal integration. Empty if nodal integration is not used.
+     * \param [out] nodal_points_num The number of integration points coinciding with the mesh nodes.
+     * \param [out] region_ids The material region indices of the integration points. Empty if all the points belong in region 0.
+     * \return [void]
+     */
+    void Load(const std::string &filename, std::vector<Vec3<double> > &coordinates, std::vector<double> &weights,
+              std::vector<double> &nodal_volumes, std::size_t &nodal_points_num, std::vector<std::uint16_t> &region_ids) const;
+
+
+    /*!
+     * \brief Read the header of a binary integration points file.
+     * \param [in] filename The binary integration points file.
+     * \return [IntegPointsHeader] The header of the file.
+     */
+    IntegPointsHeader ReadHeader(const std::string &filename) const;
+
+
+    /*!
+     * \brief Check if a file is a binary integration points file.
+     * \param [in] filename The file to be checked.
+     * \return [bool] True if the file starts with the identifier of the binary integration points files, false otherwise.
+     */
+    static bool IsBinaryFile(const std::string &filename);
+
+
+    /*!
+     * \brief Get the number of threads used in the checksum and the conversion of the integration points.
+     * \return [std::size_t] The number of threads.
+     */
+    inline const std::size_t & ThreadsNumber() const { return this->threads_number_; }
+
+
+private:
+
+    std::size_t threads_number_;            /*!< The number of threads used in the checksum and the conversion of the integration points. */
+
+};
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_INTEGRATION_INTEG_POINTS_IO_HPP_
@@ -0,0 +1,378 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/integration/quadrature_compressor.hpp"
+
+
+namespace CLOUDEA {
+
+QuadratureCompressor::QuadratureCompressor() : tolerance_(1.e-3), threads_number_(1), original_points_num_(0),
+    compressed_points_num_(0), clusters_num_(0), compressed_clusters_num_(0), original_work_(0), compressed_work_(0),
+    force_error_(0.), cluster_cell_size_(0.)
+{
+    // Use all the available hardware threads by default.
+    this->SetThreadsNumber(0);
+}
+
+
+QuadratureCompressor::~QuadratureCompressor()
+{}
+
+
+void QuadratureCompressor::SetTolerance(double tolerance)
+{
+    if (tolerance <= 0. || tolerance >= 1.) {
+        throw std::invalid_argument(Logger::Error("Could not set quadrature compression tolerance. Admissible tolerance: (0, 1).").c_str());
+    }
+    this->tolerance_ = tolerance;
+}
+
+
+void QuadratureCompressor::SetClusterCellSize(double cell_size)
+{
+    if (cell_size < 0.) {
+        throw std::invalid_argument(Logger::Error("Could not set quadrature compression cluster cell size. Expected non-negative size.").c_str());
+    }
+    this->cluster_cell_size_ = cell_size;
+}
+
+
+void QuadratureCompressor::SetThreadsNumber(std::size_t threads_number)
+{
+    // Get the number of available hardware threads if not given.
+    if (threads_number == 0) {
+        const std::size_t available_threads = std::thread::hardware_concurrency();
+        threads_number = std::max(available_threads, std::size_t{1});
+    }
+
+    this->threads_number_ = threads_number;
+}
+
+
+void QuadratureCompressor::Compress(const std::vector<Node> &geom_nodes, const Mmls3d &approximant,
+                                    const std::vector<double> &influence_radiuses, IntegPoints &integ_points,
+                                    NeighborList &support_nodes_ids)
+{
+    // Check the integration points and their support nodes.
+    if (integ_points.IsNodal()) {
+        throw std::invalid_argument(Logger::Error("Could not compress integration points. Nodal integration points can not be compressed.").c_str());
+    }
+    const std::size_t points_num = static_cast<std::size_t>(integ_points.PointsNum());
+    if (support_nodes_ids.ListsNum() != points_num) {
+        throw std::invalid_argument(Logger::Error("Could not compress integration points. "
+                                                  "The number of support nodes lists does not match the number of integration points.").c_str());
+    }
+
+    this->original_points_num_ = points_num;
+    this->compressed_points_num_ = points_num;
+    this->clusters_num_ = 0;
+    this->compressed_clusters_num_ = 0;
+    this->original_work_ = support_nodes_ids.IdsNum();
+    this->compressed_work_ = support_nodes_ids.IdsNum();
+    this->force_error_ = 0.;
+    if (points_num == 0) { return; }
+
+    // Cluster the integration points. The stable sorting keeps the integration point with the smallest index first in each cluster.
+    // Points of different material regions are never clustered together.
+    const auto &region_ids = integ_points.RegionIds();
+    auto region_of = [&region_ids](std::size_t ip) { return region_ids.empty() ? 0 : static_cast<long long>(region_ids[ip]); };
+    std::vector<std::size_t> order(points_num);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<std::size_t> cluster_offsets{0};
+    if (this->cluster_cell_size_ > 0.) {
+        // Points in the same cell of a uniform grid.
+        std::vector<std::array<long long, 4> > cells(points_num);
+        for (std::size_t ip = 0; ip != points_num; ++ip) {
+            const auto &coords = integ_points.Coordinates()[ip];
+            cells[ip] = {{ region_of(ip),
+                           static_cast<long long>(std::floor(coords.X() / this->cluster_cell_size_)),
+                           static_cast<long long>(std::floor(coords.Y() / this->cluster_cell_size_)),
+                           static_cast<long long>(std::floor(coords.Z() / this->cluster_cell_size_)) }};
+        }
+        std::stable_sort(order.begin(), order.end(), [&cells](std::size_t a, std::size_t b) { return cells[a] < cells[b]; });
+        for (std::size_t i = 1; i != points_num; ++i) {
+            if (cells[order[i-1]] != cells[order[i]]) { cluster_offsets.emplace_back(i); }
+        }
+    }
+    else {
+        // Points with identical support nodes.
+        NeighborList sorted_ids;
+        sorted_ids.Reserve(points_num, support_nodes_ids.IdsNum());
+        std::vector<int> ids;
+        for (std::size_t ip = 0; ip != points_num; ++ip) {
+            ids = support_nodes_ids[ip].ToVector();
+            std::sort(ids.begin(), ids.end());
+            sorted_ids.Append(ids.begin(), ids.end());
+        }
+        auto span_less = [&sorted_ids, &region_of](std::size_t a, std::size_t b) {
+            if (region_of(a) != region_of(b)) { return region_of(a) < region_of(b); }
+            auto span_a = sorted_ids[a], span_b = sorted_ids[b];
+            if (span_a.size() != span_b.size()) { return span_a.size() < span_b.size(); }
+            return std::lexicographical_compare(span_a.begin(), span_a.end(), span_b.begin(), span_b.end());
+        };
+        std::stable_sort(order.begin(), order.end(), span_less);
+        for (std::size_t i = 1; i != points_num; ++i) {
+            if (span_less(order[i-1], order[i])) { cluster_offsets.emplace_back(i); }
+        }
+    }
+    cluster_offsets.emplace_back(points_num);
+    const std::size_t clusters_num = cluster_offsets.size() - 1;
+
+    // Random small displacements of the nodes to measure the error of the nodal forces.
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1.e-3, 1.e-3);
+    Eigen::VectorXd disp(3*geom_nodes.size());
+    for (Eigen::Index i = 0; i != disp.size(); ++i) { disp.coeffRef(i) = distribution(generator); }
+
+    // The retained integration points and their new weights.
+    std::vector<char> retained(points_num, 1);
+    std::vector<double> new_weights = integ_points.Weights();
+
+    // Process the clusters in parallel. Each cluster writes only the entries of its own integration points.
+    const std::size_t threads_num = std::max(std::size_t{1}, std::min(this->threads_number_, clusters_num));
+    std::atomic<std::size_t> next_cluster(0);
+    std::vector<Eigen::VectorXd> original_forces(threads_num, Eigen::VectorXd::Zero(disp.size()));
+    std::vector<Eigen::VectorXd> compressed_forces(threads_num, Eigen::VectorXd::Zero(disp.size()));
+    std::vector<std::size_t> thread_clusters(threads_num, 0), thread_compressed(threads_num, 0);
+    std::vector<std::exception_ptr> errors(threads_num);
+
+    auto compress_clusters = [&](std::size_t t) {
+        try {
+            std::vector<double> dx, dy, dz;
+            std::vector<int> point_ids;
+            std::vector<Eigen::Index> selected;
+            Eigen::VectorXd selected_weights;
+            for (std::size_t c = next_cluster++; c < clusters_num; c = next_cluster++) {
+                const std::size_t first = cluster_offsets[c];
+                const auto points_in = static_cast<Eigen::Index>(cluster_offsets[c+1] - first);
+
+                // The union of the support nodes of the cluster's points. The derivatives of the nodes
+                // outside the support domain of a point are zero.
+                std::vector<int> cluster_ids;
+                for (std::size_t i = first; i != cluster_offsets[c+1]; ++i) {
+                    auto point_ids = support_nodes_ids[order[i]];
+                    cluster_ids.insert(cluster_ids.end(), point_ids.begin(), point_ids.end());
+                }
+                std::sort(cluster_ids.begin(), cluster_ids.end());
+                cluster_ids.erase(std::unique(cluster_ids.begin(), cluster_ids.end()), cluster_ids.end());
+                const auto support_size = static_cast<Eigen::Index>(cluster_ids.size());
+
+                Eigen::MatrixXd derivs = Eigen::MatrixXd::Zero(3*support_size, points_in);
+                Eigen::VectorXd weights(points_in);
+                for (Eigen::Index p = 0; p != points_in; ++p) {
+                    const std::size_t ip = order[first+static_cast<std::size_t>(p)];
+                    point_ids = support_nodes_ids[ip].ToVector();
+                    approximant.ComputeDerivsAt(geom_nodes, integ_points.Coordinates()[ip], point_ids, influence_radiuses, dx, dy, dz);
+                    for (std::size_t i = 0; i != point_ids.size(); ++i) {
+                        auto row = std::lower_bound(cluster_ids.begin(), cluster_ids.end(), point_ids[i]) - cluster_ids.begin();
+                        derivs.coeffRef(row, p) = dx[i];
+                        derivs.coeffRef(support_size+row, p) = dy[i];
+                        derivs.coeffRef(2*support_size+row, p) = dz[i];
+                    }
+                    weights.coeffRef(p) = integ_points.Weights()[ip];
+                }
+                this->AddElasticForces(derivs, weights, cluster_ids, disp, original_forces[t]);
+
+                // Scale the derivatives with the mean influence radius of the support nodes to integrate dimensionless quantities.
+                bool is_compressed = false;
+                if (points_in > 1) {
+                    thread_clusters[t]++;
+                    double mean_radius = 0.;
+                    for (const auto &id : cluster_ids) { mean_radius += influence_radiuses[id]; }
+                    mean_radius /= static_cast<double>(support_size);
+
+                    is_compressed = this->SelectClusterPoints(mean_radius*derivs, weights, selected, selected_weights);
+                }
+
+                if (!is_compressed) {
+                    this->AddElasticForces(derivs, weights, cluster_ids, disp, compressed_forces[t]);
+                    continue;
+                }
+
+                // Keep only the selected points of the cluster with their new weights.
+                thread_compressed[t]++;
+                Eigen::MatrixXd selected_derivs(derivs.rows(), static_cast<Eigen::Index>(selected.size()));
+                for (Eigen::Index p = 0; p != points_in; ++p) { retained[order[first+static_cast<std::size_t>(p)]] = 0; }
+                for (std::size_t s = 0; s != selected.size(); ++s) {
+                    const std::size_t ip = order[first+static_cast<std::size_t>(selected[s])];
+                    retained[ip] = 1;
+                    new_weights[ip] = selected_weights.coeff(static_cast<Eigen::Index>(s));
+                    selected_derivs.col(static_cast<Eigen::Index>(s)) = derivs.col(selected[s]);
+                }
+                this->AddElasticForces(selected_derivs, selected_weights, cluster_ids, disp, compressed_forces[t]);
+            }
+        }
+        catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num);
+    for (std::size_t t = 0; t != threads_num; ++t) {
+        threads.emplace_back(std::thread(compress_clusters, t));
+    }
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    for (const auto &error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+
+    // Reduce the statistics and the nodal forces of the threads.
+    Eigen::VectorXd original_total = Eigen::VectorXd::Zero(disp.size());
+    Eigen::VectorXd compressed_total = Eigen::VectorXd::Zero(disp.size());
+    for (std::size_t t = 0; t != threads_num; ++t) {
+        original_total += original_forces[t];
+        compressed_total += compressed_forces[t];
+        this->clusters_num_ += thread_clusters[t];
+        this->compressed_clusters_num_ += thread_compressed[t];
+    }
+    double forces_norm = original_total.norm();
+    this->force_error_ = (forces_norm > 0.) ? (compressed_total - original_total).norm() / forces_norm : 0.;
+
+    // Store the retained integration points in their original order.
+    std::vector<Vec3<double> > coordinates;
+    std::vector<double> weights;
+    std::vector<std::uint16_t> regions;
+    NeighborList compressed_ids;
+    std::size_t retained_num = static_cast<std::size_t>(std::count(retained.begin(), retained.end(), 1));
+    coordinates.reserve(retained_num);
+    weights.reserve(retained_num);
+    compressed_ids.Reserve(retained_num, support_nodes_ids.IdsNum());
+    for (std::size_t ip = 0; ip != points_num; ++ip) {
+        if (!retained[ip]) { continue; }
+        coordinates.emplace_back(integ_points.Coordinates()[ip]);
+        weights.emplace_back(new_weights[ip]);
+        if (!region_ids.empty()) { regions.emplace_back(region_ids[ip]); }
+        compressed_ids.Append(support_nodes_ids[ip]);
+    }
+
+    integ_points.SetPoints(coordinates, weights, regions);
+    support_nodes_ids = std::move(compressed_ids);
+    this->compressed_points_num_ = retained_num;
+    this->compressed_work_ = support_nodes_ids.IdsNum();
+}
+
+
+void QuadratureCompressor::PrintStatistics() const
+{
+    double reduction = (this->original_points_num_ == 0) ? 0. :
+            100. * (1. - static_cast<double>(this->compressed_points_num_) / static_cast<double>(this->original_points_num_));
+
+    std::cout << Logger::Message("Quadrature compression | Integration points: ") << this->original_points_num_
+              << " -> " << this->compressed_points_num_ << " (" << reduction << " % fewer)\n";
+    std::cout << Logger::Message("Quadrature compression | Compressed clusters: ") << this->compressed_clusters_num_
+              << "/" << this->clusters_num_ << " | Relative force error: " << this->force_error_
+              << " | Estimated forces kernel speedup: " << this->EstimatedSpeedup() << "x\n";
+}
+
+
+bool QuadratureCompressor::SelectClusterPoints(const Eigen::MatrixXd &scaled_derivs, const Eigen::VectorXd &weights,
+                                               std::vector<Eigen::Index> &selected, Eigen::VectorXd &selected_weights) const
+{
+    const Eigen::Index points_in = scaled_derivs.cols();
+
+    // Gram matrix of the integrands of the cluster points. The integrands are the unit function, the derivatives and
+    // the unique products of the derivatives. The products contribute ((a.b)^2 + sum_k a_k^2 b_k^2) / 2, so the
+    // integrands are never formed explicitly.
+    Eigen::MatrixXd inner = scaled_derivs.transpose() * scaled_derivs;
+    Eigen::MatrixXd squares = scaled_derivs.cwiseAbs2().transpose() * scaled_derivs.cwiseAbs2();
+    Eigen::MatrixXd gram = Eigen::MatrixXd::Ones(points_in, points_in) + inner + 0.5*(inner.cwiseAbs2() + squares);
+
+    // Factorize the Gram matrix as H^T H. The columns of H reproduce the inner products of the integrands,
+    // thus the integration error of any weights is measured exactly in the H space.
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(gram);
+    if (eigen_solver.info() != Eigen::Success) { return false; }
+    Eigen::MatrixXd H = eigen_solver.eigenvalues().cwiseMax(0.).cwiseSqrt().asDiagonal() * eigen_solver.eigenvectors().transpose();
+
+    const Eigen::VectorXd target = H * weights;
+    const double target_norm = target.norm();
+    if (target_norm == 0.) { return false; }
+
+    // Greedy selection of points with non-negative least squares weights.
+    selected.clear();
+    std::vector<char> excluded(static_cast<std::size_t>(points_in), 0);
+    Eigen::VectorXd residual = target;
+    for (Eigen::Index iter = 0; iter != 2*points_in; ++iter) {
+        if (residual.norm() <= this->tolerance_*target_norm) { break; }
+
+        // The candidate point most aligned with the residual.
+        Eigen::Index candidate = -1;
+        double max_alignment = 0.;
+        for (Eigen::Index p = 0; p != points_in; ++p) {
+            if (excluded[static_cast<std::size_t>(p)] || std::find(selected.begin(), selected.end(), p) != selected.end()) { continue; }
+            double col_norm = H.col(p).norm();
+            if (col_norm == 0.) { continue; }
+            double alignment = H.col(p).dot(residual) / col_norm;
+            if (alignment > max_alignment) { max_alignment = alignment; candidate = p; }
+        }
+        if (candidate == -1) { break; }
+        selected.emplace_back(candidate);
+
+        // Least squares weights of the selected points. Points with non-positive weights are excluded.
+        while (!selected.empty()) {
+            Eigen::MatrixXd H_selected(H.rows(), static_cast<Eigen::Index>(selected.size()));
+            for (std::size_t s = 0; s != selected.size(); ++s) { H_selected.col(static_cast<Eigen::Index>(s)) = H.col(selected[s]); }
+            selected_weights = H_selected.colPivHouseholderQr().solve(target);
+
+            Eigen::Index min_id = 0;
+            if (selected_weights.minCoeff(&min_id) > 0.) {
+                residual = target - H_selected*selected_weights;
+                break;
+            }
+            excluded[static_cast<std::size_t>(selected[static_cast<std::size_t>(min_id)])] = 1;
+            selected.erase(selected.begin()+min_id);
+            residual = target;
+        }
+    }
+
+    return !selected.empty() && static_cast<Eigen::Index>(selected.size()) < points_in &&
+           residual.norm() <= this->tolerance_*target_norm;
+}
+
+
+void QuadratureCompressor::AddElasticForces(const Eigen::MatrixXd &derivs, const Eigen::VectorXd &weights,
+                                            const std::vector<int> &support_ids, const Eigen::VectorXd &disp,
+                                            Eigen::VectorXd &forces) const
+{
+    // Lame parameters of a linear elastic material with unit shear modulus and Poisson's ratio 0.25.
+    const double lambda = 1., mu = 1.;
+
+    const auto support_size = static_cast<Eigen::Index>(support_ids.size());
+    Eigen::MatrixXd disp_local(support_size, 3);
+    for (Eigen::Index i = 0; i != support_size; ++i) {
+        disp_local.row(i) = disp.segment<3>(3*support_ids[static_cast<std::size_t>(i)]).transpose();
+    }
+
+    for (Eigen::Index p = 0; p != derivs.cols(); ++p) {
+        Eigen::Map<const Eigen::MatrixXd> point_derivs(derivs.col(p).data(), support_size, 3);
+        Eigen::Matrix3d grad = disp_local.transpose() * point_derivs;
+        Eigen::Matrix3d strain = 0.5*(grad + grad.transpose());
+        Eigen::Matrix3d stress = lambda*strain.trace()*Eigen::Matrix3d::Identity() + 2.*mu*strain;
+
+        Eigen::MatrixXd forces_local = weights.coeff(p) * point_derivs * stress;
+        for (Eigen::Index i = 0; i != support_size; ++i) {
+            forces.segment<3>(3*support_ids[static_cast<std::size_t>(i)]) += forces_local.row(i).transpose();
+        }
+    }
+}
+
+
+} //end of namespace CLOUDEA
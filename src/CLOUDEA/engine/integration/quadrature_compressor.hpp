@@ -0,0 +1,279 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_INTEGRATION_QUADRATURE_COMPRESSOR_HPP_
+#define CLOUDEA_INTEGRATION_QUADRATURE_COMPRESSOR_HPP_
+
+/*!
+   \file quadrature_compressor.hpp
+   \brief QuadratureCompressor class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+
+#include "CLOUDEA/engine/approximants/mmls_3d.hpp"
+#include "CLOUDEA/engine/integration/integ_points.hpp"
+#include "CLOUDEA/engine/elements/node.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <functional>
+#include <random>
+#include <stdexcept>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Integration
+ *  @{
+ */
+
+
+/*!
+ * \class QuadratureCompressor
+ * \brief Class implementing the compression of integration points sharing the same support domain.
+ *
+ * The integration points with identical support nodes, or optionally the integration points lying in the same cell
+ * of a uniform grid, are clustered. Each cluster is replaced by a subset of its points with new non-negative weights,
+ * selected greedily in the style of the empirical cubature method, so that the volume, the shape function derivatives
+ * and the products of the shape function derivatives over the cluster are integrated exactly up to the requested tolerance.
+ * The products of the derivatives span the integrands of the linear elastic stiffness, thus the compressed points
+ * reproduce the nodal forces of small deformations within the tolerance.
+ */
+
+class QuadratureCompressor {
+public:
+
+    /*!
+     * \brief QuadratureCompressor constructor.
+     */
+    QuadratureCompressor();
+
+
+    /*!
+     * \brief QuadratureCompressor destructor.
+     */
+    virtual ~QuadratureCompressor();
+
+
+    /*!
+     * \brief Set the relative tolerance of the integrals over each cluster of integration points.
+     *
+     * Larger tolerances retain fewer integration points. The default tolerance is 1e-3.
+     *
+     * \param [in] tolerance The relative tolerance. Admissible values: (0, 1).
+     * \return [void]
+     */
+    void SetTolerance(double tolerance);
+
+
+    /*!
+     * \brief Set the cell size of the uniform grid used to cluster the integration points.
+     *
+     * The integrals over a cluster are computed on the union of the support nodes of its points, thus clusters
+     * of points with nearly identical support nodes can be compressed as well.
+     *
+     * \param [in] cell_size The cell size. If zero, only the integration points with identical support nodes are clustered.
+     * \return [void]
+     */
+    void SetClusterCellSize(double cell_size);
+
+
+    /*!
+     * \brief Set the number of threads used in the compression of the integration points.
+     * \param [in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    void SetThreadsNumber(std::size_t threads_number);
+
+
+    /*!
+     * \brief Compress the integration points sharing the same support domain.
+     *
+     * The order of the retained integration points is preserved. Clusters that can not be integrated
+     * within the tolerance with fewer points are kept unchanged. Nodal integration points can not be compressed.
+     *
+     * The approximant is only used to evaluate the shape function derivatives at the integration points and it is not modified.
+     * Shape functions already computed by the approximant refer to the original integration points, thus they must be
+     * recomputed on the compressed integration points, e.g. with Mmls3d::ComputeShFuncAndDerivs, before solving.
+     *
+     * \param [in] geom_nodes The nodes describing the model's geometry.
+     * \param [in] approximant The approximant used to evaluate the shape function derivatives at the integration points.
+     * \param [in] influence_radiuses The radiuses of influence of the model's geometry nodes.
+     * \param [in,out] integ_points The integration points to be compressed.
+     * \param [in,out] support_nodes_ids The indices of the support nodes of each integration point.
+     * \return [void]
+     */
+    void Compress(const std::vector<Node> &geom_nodes, const Mmls3d &approximant, const std::vector<double> &influence_radiuses,
+                  IntegPoints &integ_points, NeighborList &support_nodes_ids);
+
+
+    /*!
+     * \brief Print the statistics of the last compression.
+     *
+     * The estimated speedup of the forces kernel is the ratio of the total support nodes number
+     * of the integration points before and after the compression.
+     *
+     * \return [void]
+     */
+    void PrintStatistics() const;
+
+
+    /*!
+     * \brief Get the relative tolerance of the integrals over each cluster of integration points.
+     * \return [double] The relative tolerance.
+     */
+    inline double Tolerance() const { return this->tolerance_; }
+
+
+    /*!
+     * \brief Get the cell size of the uniform grid used to cluster the integration points.
+     * \return [double] The cell size. Zero if only the integration points with identical support nodes are clustered.
+     */
+    inline double ClusterCellSize() const { return this->cluster_cell_size_; }
+
+
+    /*!
+     * \brief Get the number of threads used in the compression of the integration points.
+     * \return [std::size_t] The number of threads.
+     */
+    inline const std::size_t & ThreadsNumber() const { return this->threads_number_; }
+
+
+    /*!
+     * \brief Get the number of integration points before the last compression.
+     * \return [std::size_t] The number of integration points before the last compression.
+     */
+    inline std::size_t OriginalPointsNum() const { return this->original_points_num_; }
+
+
+    /*!
+     * \brief Get the number of integration points after the last compression.
+     * \return [std::size_t] The number of integration points after the last compression.
+     */
+    inline std::size_t CompressedPointsNum() const { return this->compressed_points_num_; }
+
+
+    /*!
+     * \brief Get the number of clusters with more than one integration point in the last compression.
+     * \return [std::size_t] The number of clusters with more than one integration point.
+     */
+    inline std::size_t ClustersNum() const { return this->clusters_num_; }
+
+
+    /*!
+     * \brief Get the number of clusters that were compressed in the last compression.
+     * \return [std::size_t] The number of compressed clusters.
+     */
+    inline std::size_t CompressedClustersNum() const { return this->compressed_clusters_num_; }
+
+
+    /*!
+     * \brief Get the relative error of the nodal forces of a random small deformation after the last compression.
+     *
+     * The forces of a linear elastic material with Poisson's ratio 0.25 are compared in the Euclidean norm.
+     *
+     * \return [double] The relative error of the nodal forces.
+     */
+    inline double ForceError() const { return this->force_error_; }
+
+
+    /*!
+     * \brief Get the estimated speedup of the forces kernel after the last compression.
+     * \return [double] The estimated speedup of the forces kernel.
+     */
+    inline double EstimatedSpeedup() const {
+        return (this->compressed_work_ == 0) ? 1. : static_cast<double>(this->original_work_) / static_cast<double>(this->compressed_work_);
+    }
+
+
+protected:
+
+    /*!
+     * \brief Select the retained integration points of a cluster and their weights.
+     * \param [in] scaled_derivs The scaled shape function derivatives (x, y, z blocks) of the cluster points in columns.
+     * \param [in] weights The weights of the cluster points.
+     * \param [out] selected The indices of the retained points in the cluster.
+     * \param [out] selected_weights The weights of the retained points.
+     * \return [bool] True if the cluster can be integrated within the tolerance with fewer points, false otherwise.
+     */
+    bool SelectClusterPoints(const Eigen::MatrixXd &scaled_derivs, const Eigen::VectorXd &weights,
+                             std::vector<Eigen::Index> &selected, Eigen::VectorXd &selected_weights) const;
+
+
+    /*!
+     * \brief Add the linear elastic nodal forces of the cluster points to the given forces vector.
+     * \param [in] derivs The shape function derivatives (x, y, z blocks) of the cluster points in columns.
+     * \param [in] weights The weights of the cluster points.
+     * \param [in] support_ids The indices of the support nodes of the cluster in ascending order.
+     * \param [in] disp The nodal displacements.
+     * \param [in,out] forces The nodal forces.
+     * \return [void]
+     */
+    void AddElasticForces(const Eigen::MatrixXd &derivs, const Eigen::VectorXd &weights, const std::vector<int> &support_ids,
+                          const Eigen::VectorXd &disp, Eigen::VectorXd &forces) const;
+
+
+private:
+
+    double tolerance_;                      /*!< The relative tolerance of the integrals over each cluster. */
+
+    std::size_t threads_number_;            /*!< The number of threads used in the compression. */
+
+    std::size_t original_points_num_;       /*!< The number of integration points before the last compression. */
+
+    std::size_t compressed_points_num_;     /*!< The number of integration points after the last compression. */
+
+    std::size_t clusters_num_;              /*!< The number of clusters with more than one point in the last compression. */
+
+    std::size_t compressed_clusters_num_;   /*!< The number of compressed clusters in the last compression. */
+
+    std::size_t original_work_;             /*!< The total support nodes number before the last compression. */
+
+    std::size_t compressed_work_;           /*!< The total support nodes number after the last compression. */
+
+    double force_error_;                    /*!< The relative error of the nodal forces after the last compression. */
+
+    double cluster_cell_size_;              /*!< The cell size of the uniform grid used to cluster the integration points. */
+
+};
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_INTEGRATION_QUADRATURE_COMPRESSOR_HPP_
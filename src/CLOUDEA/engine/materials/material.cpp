@@ -0,0 +1,177 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/materials/material.hpp"
+
+
+namespace CLOUDEA {
+
+
+Material::Material() : points_number_(-1), regions_number_(1)
+{}
+
+
+Material::~Material()
+{}
+
+
+void Material::SetPointsNumber(const int &points_number)
+{
+    //Set the number of points of the material.
+    this->points_number_ = points_number;
+
+    // Reset to a single region if the point regions do not match the new number of points.
+    // The parameters of region 0 are kept, so that the material stays consistent.
+    if (this->point_regions_.size() != static_cast<std::size_t>(points_number)) {
+        this->point_regions_.clear();
+        this->regions_number_ = 1;
+        for (auto table : this->RegionTables()) {
+            if (table->size() > 1) { table->resize(1); }
+        }
+    }
+}
+
+
+void Material::SetPointRegions(const std::vector<std::uint16_t> &point_regions)
+{
+    // Check if number of material points has been assigned.
+    if (this->points_number_ == -1) {
+        std::string error = "ERROR: No number of points has been assigned to the material.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    if (!point_regions.empty() && point_regions.size() != static_cast<std::size_t>(this->points_number_)) {
+        std::string error = "[CLOUDEA ERROR] Could not set the material regions. The number of region indices is different "
+                            "from the number of the material points.";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // The number of regions is given by the largest region index.
+    std::size_t regions_number = 1;
+    if (!point_regions.empty()) {
+        regions_number = static_cast<std::size_t>(*std::max_element(point_regions.begin(), point_regions.end())) + 1;
+    }
+
+    // Store the point regions only for multi-region materials.
+    this->regions_number_ = regions_number;
+    if (regions_number == 1) { this->point_regions_.clear(); }
+    else { this->point_regions_ = point_regions; }
+
+    // Copy the assigned parameters of region 0 to the new regions.
+    for (auto table : this->RegionTables()) {
+        if (!table->empty()) { table->resize(regions_number, table->front()); }
+    }
+}
+
+
+void Material::SetDensity(const double &d_value)
+{
+    this->AssignAllRegionsValue(d_value, this->density_);
+}
+
+
+void Material::SetDensity(const double &d_value, std::size_t region)
+{
+    this->AssignRegionValue(d_value, region, this->density_);
+}
+
+
+void Material::SetWaveSpeed(const double &wv_speed)
+{
+    this->AssignAllRegionsValue(wv_speed, this->wave_speed_);
+}
+
+
+void Material::SetWaveSpeed(const double &wv_speed, std::size_t region)
+{
+    this->AssignRegionValue(wv_speed, region, this->wave_speed_);
+}
+
+
+void Material::AssignAllRegionsValue(double value, std::vector<double> &table) const
+{
+    // Check if number of material points has been assigned.
+    if (this->points_number_ == -1) {
+        std::string error = "ERROR: No number of points has been assigned to the material.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Assign the given value to all the material regions.
+    table.assign(this->regions_number_, value);
+}
+
+
+void Material::AssignRegionValue(double value, std::size_t region, std::vector<double> &table) const
+{
+    // Check if number of material points has been assigned.
+    if (this->points_number_ == -1) {
+        std::string error = "ERROR: No number of points has been assigned to the material.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    if (region >= this->regions_number_) {
+        std::string error = "[CLOUDEA ERROR] Could not assign material parameter to region " + std::to_string(region) +
+                            ". The material has " + std::to_string(this->regions_number_) + " regions.";
+        throw std::out_of_range(error.c_str());
+    }
+
+    // Assign the given value to the requested region. Unassigned regions are marked with NaN.
+    table.resize(this->regions_number_, std::numeric_limits<double>::quiet_NaN());
+    table[region] = value;
+}
+
+
+void Material::CheckRegionsAssigned(const std::vector<double> &table, const std::string &parameter) const
+{
+    for (std::size_t region = 0; region != table.size(); ++region) {
+        if (std::isnan(table[region])) {
+            std::string error = "[CLOUDEA ERROR] The material " + parameter + " has not been assigned to region " +
+                                std::to_string(region) + ".";
+            throw std::runtime_error(error.c_str());
+        }
+    }
+}
+
+
+std::vector<double> Material::PointValues(const std::vector<double> &table) const
+{
+    if (table.empty() || this->points_number_ < 0) { return std::vector<double>(); }
+
+    // Expand the region values to the material points.
+    if (this->point_regions_.empty()) {
+        return std::vector<double>(static_cast<std::size_t>(this->points_number_), table[0]);
+    }
+
+    std::vector<double> point_values;
+    point_values.reserve(this->point_regions_.size());
+    for (const auto &region : this->point_regions_) {
+        point_values.emplace_back(table[region]);
+    }
+    return point_values;
+}
+
+
+std::vector<std::vector<double>*> Material::RegionTables()
+{
+    return std::vector<std::vector<double>*>{&this->density_, &this->wave_speed_};
+}
+
+
+} //end of namespace CLOUDEA
@@ -0,0 +1,270 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_MATERIALS_MATERIAL_HPP_
+#define CLOUDEA_MATERIALS_MATERIAL_HPP_
+
+/*!
+   \file material.hpp
+   \brief Material class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Materials
+ *  @{
+ */
+
+
+/*!
+ * \class Material
+ * \brief Base class of the material models storing the material parameters per material region.
+ *
+ * Each material point stores the index of its region, e.g. the partition of the tetrahedron where an integration point
+ * was generated. The region indices are stored only for multi-region materials.
+ *
+ * The material models are passed to the solvers as template policies, thus their stress evaluation is inlined.
+ * A material model derives from Material and provides:
+ * - Eigen::Matrix3d SpkStress(const Eigen::Matrix3d &FT, const int &point_id) const
+ * - void SpkStresses(const Eigen::Matrix3d *FT, std::size_t points_num, std::size_t first_point_id, Eigen::Matrix3d *spk_stress) const
+ * - double StrainEnergy(const Eigen::Matrix3d &FT, const int &point_id) const
+ */
+
+class Material {
+public:
+
+    /*!
+     * \brief Material constructor.
+     */
+    Material();
+
+
+    /*!
+     * \brief Material destructor.
+     */
+    virtual ~Material();
+
+
+    /*!
+     * \brief Set the number of points represented by the material.
+     * \param [in] points_number The number of points.
+     * \return [void]
+     */
+    void SetPointsNumber(const int &points_number);
+
+
+    /*!
+     * \brief Set the material regions of the points.
+     *
+     * The material parameters are stored per region and each point stores the index of its region.
+     * Parameters that have already been assigned are copied from region 0 to the new regions.
+     *
+     * \param [in] point_regions The region index of each material point. If empty, all the points belong in region 0.
+     * \return [void]
+     */
+    void SetPointRegions(const std::vector<std::uint16_t> &point_regions);
+
+
+    /*!
+     * \brief Set the density of all the material regions.
+     * \param [in] d_value The density value.
+     * \return [void]
+     */
+    void SetDensity(const double &d_value);
+
+
+    /*!
+     * \brief Set the density of a material region.
+     * \param [in] d_value The density value.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetDensity(const double &d_value, std::size_t region);
+
+
+    /*!
+     * \brief Set the wave speed of all the material regions.
+     * \param [in] wv_speed The wave speed value.
+     * \return [void]
+     */
+    void SetWaveSpeed(const double &wv_speed);
+
+
+    /*!
+     * \brief Set the wave speed of a material region.
+     * \param [in] wv_speed The wave speed value.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetWaveSpeed(const double &wv_speed, std::size_t region);
+
+
+    /*!
+     * \brief Get the number of points associated with the material.
+     * \return [int] The number of points associated with the material.
+     */
+    inline const int &PointsNumber() const { return this->points_number_; }
+
+
+    /*!
+     * \brief Get the number of material regions.
+     * \return [std::size_t] The number of material regions.
+     */
+    inline std::size_t RegionsNumber() const { return this->regions_number_; }
+
+
+    /*!
+     * \brief Check if all the material points share the same material parameters.
+     * \return [bool] True if the material has a single region, false otherwise.
+     */
+    inline bool IsUniform() const { return this->regions_number_ == 1; }
+
+
+    /*!
+     * \brief Get the region index of the material points.
+     * \return [std::vector<std::uint16_t>] The region index of the material points. Empty if all the points belong in region 0.
+     */
+    inline const std::vector<std::uint16_t> & PointRegions() const { return this->point_regions_; }
+
+
+    /*!
+     * \brief Get the region index of a material point.
+     * \param [in] point_id The index of the material point.
+     * \return [std::size_t] The region index of the material point.
+     */
+    inline std::size_t PointRegion(std::size_t point_id) const {
+        return this->point_regions_.empty() ? 0 : this->point_regions_[point_id];
+    }
+
+
+    /*!
+     * \brief Get the density of the material points.
+     * \return [std::vector<double>] The density of the material points.
+     */
+    inline std::vector<double> Density() const { return this->PointValues(this->density_); }
+
+
+    /*!
+     * \brief Get the wave speed of the material points.
+     * \return [std::vector<double>] The wave speed of the material points.
+     */
+    inline std::vector<double> WaveSpeed() const { return this->PointValues(this->wave_speed_); }
+
+
+    /*!
+     * \brief Get the density of the material regions.
+     * \return [std::vector<double>] The density of the material regions.
+     */
+    inline const std::vector<double> & RegionDensity() const { return this->density_; }
+
+
+    /*!
+     * \brief Get the wave speed of the material regions.
+     * \return [std::vector<double>] The wave speed of the material regions.
+     */
+    inline const std::vector<double> & RegionWaveSpeed() const { return this->wave_speed_; }
+
+
+protected:
+
+    /*!
+     * \brief Assign a parameter value to all the material regions.
+     * \param [in] value The parameter value.
+     * \param [in,out] table The parameter values of the material regions.
+     * \return [void]
+     */
+    void AssignAllRegionsValue(double value, std::vector<double> &table) const;
+
+
+    /*!
+     * \brief Assign a parameter value to a material region.
+     *
+     * The regions that have not been assigned a value yet are marked as unassigned (NaN), and are rejected by CheckRegionsAssigned.
+     *
+     * \param [in] value The parameter value.
+     * \param [in] region The index of the material region. Must be smaller than the number of regions.
+     * \param [in,out] table The parameter values of the material regions.
+     * \return [void]
+     */
+    void AssignRegionValue(double value, std::size_t region, std::vector<double> &table) const;
+
+
+    /*!
+     * \brief Check that a parameter has been assigned to every material region.
+     * \param [in] table The parameter values of the material regions.
+     * \param [in] parameter The name of the parameter, used in the error message.
+     * \return [void]
+     */
+    void CheckRegionsAssigned(const std::vector<double> &table, const std::string &parameter) const;
+
+
+    /*!
+     * \brief Expand the parameter values of the material regions to the material points.
+     * \param [in] table The parameter values of the material regions.
+     * \return [std::vector<double>] The parameter values of the material points.
+     */
+    std::vector<double> PointValues(const std::vector<double> &table) const;
+
+
+    /*!
+     * \brief Get the parameter tables of the material regions.
+     *
+     * Derived material models append their own parameter tables, so that they are resized when the material regions are set.
+     *
+     * \return [std::vector<std::vector<double>*>] The parameter tables of the material regions.
+     */
+    virtual std::vector<std::vector<double>*> RegionTables();
+
+
+    std::vector<double> density_;           /*!< The density values of the material regions. */
+
+    std::vector<double> wave_speed_;        /*!< The wave speed of the material regions. */
+
+
+private:
+
+    int points_number_;                     /*!< The number of the material points. */
+
+    std::size_t regions_number_;            /*!< The number of the material regions. */
+
+    std::vector<std::uint16_t> point_regions_;  /*!< The region index of the material points. Empty if all the points belong in region 0. */
+
+};
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_MATERIALS_MATERIAL_HPP_
@@ -24,7 +24,7 @@
 namespace CLOUDEA {
 
 
-NeoHookean::NeoHookean() : points_number_(-1)
+NeoHookean::NeoHookean()
 {}
 
 
@@ -32,156 +32,82 @@ NeoHookean::~NeoHookean()
 {}
 
 
-void NeoHookean::SetPointsNumber(const int &points_number)
+void NeoHookean::SetYoungModulus(const double &ym_value)
 {
-    //Set the number of points of the material.
-    this->points_number_ = points_number;
+    this->AssignAllRegionsValue(ym_value, this->young_modulus_);
 }
 
 
-void NeoHookean::SetDensity(const double &d_value)
+void NeoHookean::SetYoungModulus(const double &ym_value, std::size_t region)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
-
-    // Clear the density container.
-    this->density_.clear();
-
-    // Assign the given density value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->density_.push_back(d_value);
-    }
+    this->AssignRegionValue(ym_value, region, this->young_modulus_);
 }
 
 
-void NeoHookean::SetYoungModulus(const double &ym_value)
+void NeoHookean::SetPoissonRatio(const double &pr_value)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
-
-    // Clear the Young modulus container.
-    this->young_modulus_.clear();
-
-    // Assign the given Young modulus value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->young_modulus_.push_back(ym_value);
-    }
+    this->AssignAllRegionsValue(pr_value, this->poisson_ratio_);
 }
 
 
-void NeoHookean::SetPoissonRatio(const double &pr_value)
+void NeoHookean::SetPoissonRatio(const double &pr_value, std::size_t region)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
-
-    // Clear the Poisson's ratio container.
-    this->poisson_ratio_.clear();
-
-    // Assign the given Poisson's ratio value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->poisson_ratio_.push_back(pr_value);
-    }
+    this->AssignRegionValue(pr_value, region, this->poisson_ratio_);
 }
 
 
 void NeoHookean::SetBulkModulus(const double &bulk_value)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
+    this->AssignAllRegionsValue(bulk_value, this->bulk_modulus_);
+}
 
-    // Clear the Bulk modulus container.
-    this->bulk_modulus_.clear();
 
-    // Assign the given Bulk modulus value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->bulk_modulus_.push_back(bulk_value);
-    }
+void NeoHookean::SetBulkModulus(const double &bulk_value, std::size_t region)
+{
+    this->AssignRegionValue(bulk_value, region, this->bulk_modulus_);
 }
 
 
 void NeoHookean::SetLameLambda(const double &l_value)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
-
-    // Clear the Lame lambda constant container.
-    this->lambda_.clear();
+    this->AssignAllRegionsValue(l_value, this->lambda_);
+}
 
-    // Assign the given Lame lambda value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->lambda_.push_back(l_value);
-    }
 
+void NeoHookean::SetLameLambda(const double &l_value, std::size_t region)
+{
+    this->AssignRegionValue(l_value, region, this->lambda_);
 }
 
 
 void NeoHookean::SetLameMu(const double &mu_value)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
-
-    // Clear the Lame mu (shear modulus) constant container.
-    this->mu_.clear();
-
-    // Assign the given Lame mu (shear modulus) value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->mu_.push_back(mu_value);
-    }
-
+    this->AssignAllRegionsValue(mu_value, this->mu_);
 }
 
 
-void NeoHookean::SetWaveSpeed(const double &wv_speed)
+void NeoHookean::SetLameMu(const double &mu_value, std::size_t region)
 {
-    // Check if number of material points has been assigned.
-    if (this->points_number_ == -1) {
-        std::string error = "ERROR: No number of points has been assigned to the material.";
-        throw std::runtime_error(error.c_str());
-    }
-
-    // Clear the wave speed constant container.
-    this->wave_speed_.clear();
-
-    // Assign the given wave speed value to all the material points.
-    for (int i = 0; i != this->points_number_; ++i) {
-        this->wave_speed_.push_back(wv_speed);
-    }
-
+    this->AssignRegionValue(mu_value, region, this->mu_);
 }
 
 
 void NeoHookean::ComputeLameLambdaMu()
 {
     // Check if Young modulus and Poisson's ratio are initialized and are equal.
-    if ((this->young_modulus_.size() == 0) &&
+    if ((this->young_modulus_.size() == 0) ||
             (this->young_modulus_.size() != this->poisson_ratio_.size()) ) {
         std::string error = "ERROR: Young modulus and Poisson's ratio containers are not consistently initialized.";
         throw std::runtime_error(error.c_str());
     }
+    this->CheckRegionsAssigned(this->young_modulus_, "Young modulus");
+    this->CheckRegionsAssigned(this->poisson_ratio_, "Poisson's ratio");
 
     // Clear Lame constants containers.
     this->lambda_.clear();
     this->mu_.clear();
 
-    // Calculate the lame constants.
+    // Calculate the lame constants of each region.
     double lame_l = 0.; double lame_m = 0.;
     for (std::vector<double>::size_type i = 0; i != this->young_modulus_.size(); ++i) {
         // Lame lambda parameter.
@@ -202,16 +128,18 @@ void NeoHookean::ComputeLameLambdaMu()
 void NeoHookean::ComputeBulkModulus()
 {
     // Check if Young modulus and Poisson's ratio are initialized and are equal.
-    if ((this->young_modulus_.size() == 0) &&
+    if ((this->young_modulus_.size() == 0) ||
             (this->young_modulus_.size() != this->poisson_ratio_.size()) ) {
         std::string error = "ERROR: Young modulus and Poisson's ratio containers are not consistently initialized.";
         throw std::runtime_error(error.c_str());
     }
+    this->CheckRegionsAssigned(this->young_modulus_, "Young modulus");
+    this->CheckRegionsAssigned(this->poisson_ratio_, "Poisson's ratio");
 
     // Clear Bulk modulus container.
     this->bulk_modulus_.clear();
 
-    // Calculate the Bulk modulus.
+    // Calculate the Bulk modulus of each region.
     double bulk = 0.;
     for (std::vector<double>::size_type i = 0; i != this->young_modulus_.size(); ++i) {
         bulk = this->young_modulus_.at(i) / (3. * (1. - 2.*this->poisson_ratio_.at(i) ) );
@@ -232,13 +160,16 @@ void NeoHookean::ComputeWaveSpeed()
         std::string error = "[CLOUDEA ERROR] Lame constants (lambda, mu) and density containers are not consistently initialized.";
         throw std::runtime_error(error.c_str());
     }
+    this->CheckRegionsAssigned(this->lambda_, "Lame lambda");
+    this->CheckRegionsAssigned(this->mu_, "Lame mu");
+    this->CheckRegionsAssigned(this->density_, "density");
 
     // Clear wave speed container.
     this->wave_speed_.clear();
 
-    // Calculate the wave speed.
+    // Calculate the wave speed of each region.
     double speed = 0.;
-    for (std::vector<double>::size_type i = 0; i != this->young_modulus_.size(); ++i) {
+    for (std::vector<double>::size_type i = 0; i != this->lambda_.size(); ++i) {
         speed = std::sqrt((this->lambda_.at(i) + 2.*this->mu_.at(i)) / this->density_.at(i) );
 
         this->wave_speed_.push_back(speed);
@@ -248,81 +179,17 @@ void NeoHookean::ComputeWaveSpeed()
 }
 
 
-Eigen::Matrix3d NeoHookean::SpkStress(const Eigen::Matrix3d &FT, const int &integ_point_id) const
-{
-
-    // Determinant of deformation gradient.
-    double det = std::abs(FT.determinant());
-
-    // 3x3 Identity matrix.
-    const Eigen::Matrix3d identity = Eigen::Matrix3d::Identity(3, 3);
-
-    // Right Cauchy Green deformation tensor (Bathe P506).
-    Eigen::Matrix3d C = Eigen::Matrix3d::Zero(3, 3);
-    C.noalias() = FT * FT.transpose();
-
-    // Inverse of the right Cauchy Green deformation tensor.
-    Eigen::Matrix3d Cinv = C.inverse();
-
-    return this->mu_[static_cast<std::size_t>(integ_point_id)] * std::pow(det, -(2./3.)) * (identity - C.trace()/3.*Cinv) +
-           this->bulk_modulus_[static_cast<std::size_t>(integ_point_id)] * det * (det - 1.) * Cinv;
-
-}
-
-
-Eigen::Matrix3d NeoHookean::SpkStressOgden(const Eigen::Matrix3d &FT, const int &integ_point_id) const
-{
-	// Right Cauchy-Green deformation tensor
-	Eigen::Matrix3d C = Eigen::Matrix3d::Zero(3, 3);
-	C.noalias() = FT * FT.transpose();
-
-	// Ogden model parameters
-	double alpha = -1.1;
-	double mu = 643.6;
-	double D1 = 0.00012598;
-
-	// Eigenvalues and eigenvectors
-	Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es;
-	es.computeDirect(C);
-	Eigen::Vector3d Eigs = es.eigenvalues();
-	Eigen::Matrix3d Dirs = es.eigenvectors();
-
-	// Principal stretches
-	double lamda1 = sqrt(Eigs(0));
-	double lamda2 = sqrt(Eigs(1));
-	double lamda3 = sqrt(Eigs(2));
-
-	// Strain energy function derivatives
-	double J = lamda1 * lamda2 * lamda3;
-	double Slambda = std::pow(lamda1, alpha) + std::pow(lamda2, alpha) + std::pow(lamda3, alpha);
-	double b = 2.0 * mu / alpha * std::pow(J, (-alpha / 3.0));
-	double a = (2./D1) * J * (J - 1.0) - b/3.0 * Slambda;
-
-	double dUdl1 = a / lamda1 + b * std::pow(lamda1, (alpha - 1.0));
-	double dUdl2 = a / lamda2 + b * std::pow(lamda2, (alpha - 1.0));
-	double dUdl3 = a / lamda3 + b * std::pow(lamda3, (alpha - 1.0));
-
-	// Second Piola-Kirchhoff stress tensor
-	Eigen::Vector3d S_principal;
-	S_principal << dUdl1/lamda1, dUdl2/lamda2, dUdl3/lamda3;
-	Eigen::Matrix3d S;
-	S.noalias() = Dirs * S_principal.asDiagonal() * Dirs.inverse();
-
-	return S;
-}
-
-
 std::vector<double> NeoHookean::StrainEnergyDensity(const Eigen::MatrixX3d &disps, const Mmls3d &approximants,
-                                                           const std::vector<std::vector<int> > &neigh_list) const
+                                                           const NeighborList &neigh_list) const
 {
     std::vector<double> strain_energy_density;
-    strain_energy_density.reserve(static_cast<std::size_t>(this->points_number_));
+    strain_energy_density.reserve(static_cast<std::size_t>(this->PointsNumber()));
 
     // Iterate over material points
-    for (int point = 0; point != this->points_number_; ++point) {
+    for (int point = 0; point != this->PointsNumber(); ++point) {
 
         // Neighbor nodes of the material point.
-        std::vector<int> neigh_nodes = neigh_list[point];
+        auto neigh_nodes = neigh_list[point];
 
         Eigen::MatrixX3d point_displacement =  Eigen::MatrixX3d::Zero(neigh_nodes.size(),3);
 
@@ -355,18 +222,8 @@ std::vector<double> NeoHookean::StrainEnergyDensity(const Eigen::MatrixX3d &disp
         // Deformation gradient (transposed)
         Eigen::Matrix3d FT = Eigen::Matrix3d::Identity(3,3) + point_derivs.transpose()*point_displacement;
 
-        // Determinant of deformation gradient.
-        double det = std::abs(FT.determinant());
-
-        // Right Cauchy Green deformation tensor (Bathe P506).
-        Eigen::Matrix3d C = Eigen::Matrix3d::Zero(3, 3);
-        C.noalias() = FT * FT.transpose();
-
-        // Trace of Right Cauchy Green deformation tensor.
-        double I = C.trace();
-
-        double point_strain_energy = 0.5*this->mu_[point]*(I-3.) - this->mu_[point]*log(det) +
-                0.5*this->lambda_[point]*log(det)*log(det);
+        // Strain energy density consistent with the stress evaluation.
+        double point_strain_energy = this->StrainEnergy(FT, point);
 
         strain_energy_density.emplace_back(point_strain_energy);
     }
@@ -376,4 +233,12 @@ std::vector<double> NeoHookean::StrainEnergyDensity(const Eigen::MatrixX3d &disp
 }
 
 
+std::vector<std::vector<double>*> NeoHookean::RegionTables()
+{
+    auto tables = Material::RegionTables();
+    tables.insert(tables.end(), {&this->young_modulus_, &this->poisson_ratio_, &this->bulk_modulus_, &this->lambda_, &this->mu_});
+    return tables;
+}
+
+
 } //end of namespace CLOUDEA
@@ -28,13 +28,17 @@
    \date 20/05/2017
 */
 
+#include "CLOUDEA/engine/materials/material.hpp"
 #include "CLOUDEA/engine/approximants/mmls_3d.hpp"
 
 #include <Eigen/Dense>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <iterator>
+#include <algorithm>
 
 #include <stdexcept>
 #include <exception>
@@ -53,9 +57,12 @@ namespace CLOUDEA {
 /*!
  * \class NeoHookean
  * \brief Class implemmenting a neo-hookean material for meshless models [strong-form/weak-form].
+ *
+ * The material parameters are stored per material region. Each material point stores the index of its region,
+ * e.g. the partition of the tetrahedron where an integration point was generated.
  */
 
-class NeoHookean{
+class NeoHookean : public Material {
 public:
 
     /*!
@@ -69,41 +76,42 @@ public:
      */
     virtual ~NeoHookean();
 
-
     /*!
-     * \brief Set the number of points represented by the material.
-     * \param [in] points_number The number of points.
+     * \brief Set the Young modulus of all the material regions.
+     * \param [in] ym_value The Young modulus value.
      * \return [void]
      */
-    void SetPointsNumber(const int &point_number);
+    void SetYoungModulus(const double &ym_value);
 
 
     /*!
-     * \brief Set the density of the material points.
-     * \param [in] d_value The density value.
+     * \brief Set the Young modulus of a material region.
+     * \param [in] ym_value The Young modulus value.
+     * \param [in] region The index of the material region.
      * \return [void]
      */
-    void SetDensity(const double &d_value);
+    void SetYoungModulus(const double &ym_value, std::size_t region);
 
 
     /*!
-     * \brief Set the Young modulus of the material points.
-     * \param [in] ym_value The Young modulus value.
+     * \brief Set the Poisson's ratio of all the material regions.
+     * \param [in] pr_value The Poisson's ratio value.
      * \return [void]
      */
-    void SetYoungModulus(const double &ym_value);
+    void SetPoissonRatio(const double &pr_value);
 
 
     /*!
-     * \brief Set the Poisson's ratio of the material points.
+     * \brief Set the Poisson's ratio of a material region.
      * \param [in] pr_value The Poisson's ratio value.
+     * \param [in] region The index of the material region.
      * \return [void]
      */
-    void SetPoissonRatio(const double &pr_value);
+    void SetPoissonRatio(const double &pr_value, std::size_t region);
 
 
     /*!
-     * \brief Set the Bulk modulus of the material points.
+     * \brief Set the Bulk modulus of all the material regions.
      * \param [in] bulk_value The Bulk modulus value.
      * \return [void]
      */
@@ -111,7 +119,16 @@ public:
 
 
     /*!
-     * \brief Set the Lame lambda of the material points.
+     * \brief Set the Bulk modulus of a material region.
+     * \param [in] bulk_value The Bulk modulus value.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetBulkModulus(const double &bulk_value, std::size_t region);
+
+
+    /*!
+     * \brief Set the Lame lambda of all the material regions.
      * \param [in] l_value The Lame lambda value.
      * \return [void]
      */
@@ -119,7 +136,16 @@ public:
 
 
     /*!
-     * \brief Set the Lame mu (shear modulus) of the material points.
+     * \brief Set the Lame lambda of a material region.
+     * \param [in] l_value The Lame lambda value.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetLameLambda(const double &l_value, std::size_t region);
+
+
+    /*!
+     * \brief Set the Lame mu (shear modulus) of all the material regions.
      * \param [in] mu_value The Lame mu (shear modulus) value.
      * \return [void]
      */
@@ -127,126 +153,273 @@ public:
 
 
     /*!
-     * \brief Set the wave speed of the material points.
-     * \param [in] wv_speed The wave speed value.
+     * \brief Set the Lame mu (shear modulus) of a material region.
+     * \param [in] mu_value The Lame mu (shear modulus) value.
+     * \param [in] region The index of the material region.
      * \return [void]
      */
-    void SetWaveSpeed(const double &wv_speed);
+    void SetLameMu(const double &mu_value, std::size_t region);
 
 
     /*!
-     * \brief Compute the Lame lambda and mu (shear modulus) constants of the material points.
+     * \brief Compute the Lame lambda and mu (shear modulus) constants of the material regions.
+     *
+     * Throws if the Young modulus or the Poisson's ratio of a region has not been assigned.
+     *
      * \return [void]
      */
     void ComputeLameLambdaMu();
 
 
     /*!
-     * \brief Compute the Bulk modulus of the material points.
+     * \brief Compute the Bulk modulus of the material regions.
+     *
+     * Throws if the Young modulus or the Poisson's ratio of a region has not been assigned.
+     *
      * \return [void]
      */
     void ComputeBulkModulus();
 
 
     /*!
-     * \brief Compute the wave speed of the material points.
+     * \brief Compute the wave speed of the material regions.
+     *
+     * Throws if the Lame constants or the density of a region have not been assigned.
+     *
      * \return [void]
      */
     void ComputeWaveSpeed();
 
 
     /*!
-     * \brief Computes the second Piola-Kirchhoff stress tensor.
-     * \param FT
-     * \param integ_point_id
-     * \return
+     * \brief Computes the second Piola-Kirchhoff stress tensor at a material point.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] integ_point_id The index of the point.
+     * \return [Eigen::Matrix3d] The second Piola-Kirchhoff stress tensor.
      */
-    Eigen::Matrix3d SpkStress(const Eigen::Matrix3d &FT, const int &integ_point_id) const;
+    inline Eigen::Matrix3d SpkStress(const Eigen::Matrix3d &FT, const int &integ_point_id) const;
 
 
-    Eigen::Matrix3d SpkStressOgden(const Eigen::Matrix3d &FT, const int &integ_point_id) const;
+    /*!
+     * \brief Computes the second Piola-Kirchhoff stress tensor for the given material constants.
+     *
+     * Used for uniform materials, where the constants can be fetched once outside the integration points loop.
+     *
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] mu The Lame mu (shear modulus).
+     * \param [in] bulk The Bulk modulus.
+     * \return [Eigen::Matrix3d] The second Piola-Kirchhoff stress tensor.
+     */
+    inline static Eigen::Matrix3d SpkStress(const Eigen::Matrix3d &FT, double mu, double bulk);
 
 
-    std::vector<double> StrainEnergyDensity(const Eigen::MatrixX3d &disps, const Mmls3d &approximants,
-                                                   const std::vector<std::vector<int> > &neigh_list) const;
+    /*!
+     * \brief Computes the strain energy density at a material point.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] integ_point_id The index of the point.
+     * \return [double] The strain energy density.
+     */
+    inline double StrainEnergy(const Eigen::Matrix3d &FT, const int &integ_point_id) const;
 
 
     /*!
-     * \brief Get the number of points associated with the material.
-     * \return [int] The number of points associated with the material.
+     * \brief Computes the strain energy density for the given material constants.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] mu The Lame mu (shear modulus).
+     * \param [in] bulk The Bulk modulus.
+     * \return [double] The strain energy density.
      */
-    inline const int &PointsNumber() const { return this->points_number_; }
+    inline static double StrainEnergy(const Eigen::Matrix3d &FT, double mu, double bulk);
 
 
     /*!
-     * \brief Get the density of the material points.
-     * \return [std::vector<double>] The density of the material points.
+     * \brief Computes the second Piola-Kirchhoff stress tensors of consecutive material points.
+     *
+     * The material constants of uniform materials are fetched once for all the points.
+     *
+     * \param [in] FT The transposed deformation gradients at the points.
+     * \param [in] points_num The number of points.
+     * \param [in] first_point_id The index of the first point.
+     * \param [out] spk_stress The second Piola-Kirchhoff stress tensors at the points.
+     * \return [void]
      */
-    inline const std::vector<double> &Density() const { return this->density_; }
+    inline void SpkStresses(const Eigen::Matrix3d *FT, std::size_t points_num, std::size_t first_point_id, Eigen::Matrix3d *spk_stress) const;
+
+
+    /*!
+     * \brief Compute the strain energy density at the material points from the nodal displacements.
+     *
+     * The strain energy density of each point is evaluated with StrainEnergy, so that it is consistent with the stress evaluation.
+     *
+     * \param [in] disps The nodal displacements.
+     * \param [in] approximants The approximants of the shape function derivatives on the material points.
+     * \param [in] neigh_list The indices of the support nodes of the material points.
+     * \return [std::vector<double>] The strain energy density at the material points.
+     */
+    std::vector<double> StrainEnergyDensity(const Eigen::MatrixX3d &disps, const Mmls3d &approximants,
+                                            const NeighborList &neigh_list) const;
 
 
     /*!
      * \brief Get the Young modulus of the material points.
      * \return [std::vector<double>] The Young modulus of the material points.
      */
-    inline const std::vector<double> &YoungModulus() const { return this->young_modulus_; }
+    inline std::vector<double> YoungModulus() const { return this->PointValues(this->young_modulus_); }
 
 
     /*!
      * \brief Get the Poisson's ratio of the material points.
      * \return [std::vector<double>] The Poisson's ratio of the material points.
      */
-    inline const std::vector<double> &PoissonRatio() const { return this->poisson_ratio_; }
+    inline std::vector<double> PoissonRatio() const { return this->PointValues(this->poisson_ratio_); }
 
 
     /*!
      * \brief Get the Bulk modulus of the material points.
      * \return [std::vector<double>] The Bulk modulus of the material points.
      */
-    inline const std::vector<double> &BulkModulus() const { return this->bulk_modulus_; }
+    inline std::vector<double> BulkModulus() const { return this->PointValues(this->bulk_modulus_); }
 
 
     /*!
      * \brief Get the Lame lambda of the material points.
      * \return [std::vector<double>] The Lame lambda of the material points.
      */
-    inline const std::vector<double> &LameLambda() const { return this->lambda_; }
+    inline std::vector<double> LameLambda() const { return this->PointValues(this->lambda_); }
 
 
     /*!
      * \brief Get the Lame mu of the material points.
      * \return [std::vector<double>] The Lame mu of the material points.
      */
-    inline const std::vector<double> &LameMu() const { return this->mu_; }
+    inline std::vector<double> LameMu() const { return this->PointValues(this->mu_); }
 
 
     /*!
-     * \brief Get the wave speed of the material points.
-     * \return [std::vector<double>] The wave speed of the material points.
+     * \brief Get the Young modulus of the material regions.
+     * \return [std::vector<double>] The Young modulus of the material regions.
      */
-    inline const std::vector<double> &WaveSpeed() const { return this->wave_speed_; }
+    inline const std::vector<double> & RegionYoungModulus() const { return this->young_modulus_; }
 
 
-private:
-    int points_number_;                     /*!< The number of the material points. */
+    /*!
+     * \brief Get the Poisson's ratio of the material regions.
+     * \return [std::vector<double>] The Poisson's ratio of the material regions.
+     */
+    inline const std::vector<double> & RegionPoissonRatio() const { return this->poisson_ratio_; }
+
+
+    /*!
+     * \brief Get the Bulk modulus of the material regions.
+     * \return [std::vector<double>] The Bulk modulus of the material regions.
+     */
+    inline const std::vector<double> & RegionBulkModulus() const { return this->bulk_modulus_; }
+
+
+    /*!
+     * \brief Get the Lame lambda of the material regions.
+     * \return [std::vector<double>] The Lame lambda of the material regions.
+     */
+    inline const std::vector<double> & RegionLameLambda() const { return this->lambda_; }
 
-    std::vector<double> density_;           /*!< The density values of the material points. */
 
-    std::vector<double> young_modulus_;     /*!< The Young modulus value of the material points. */
+    /*!
+     * \brief Get the Lame mu of the material regions.
+     * \return [std::vector<double>] The Lame mu of the material regions.
+     */
+    inline const std::vector<double> & RegionLameMu() const { return this->mu_; }
+
 
-    std::vector<double> poisson_ratio_;     /*!< The Poisson's ratio value of the material points. */
+protected:
+
+    /*!
+     * \brief Get the parameter tables of the material regions.
+     * \return [std::vector<std::vector<double>*>] The parameter tables of the material regions.
+     */
+    virtual std::vector<std::vector<double>*> RegionTables();
+
+
+private:
 
-    std::vector<double> bulk_modulus_;      /*!< The bulk modulus of the material points. */
+    std::vector<double> young_modulus_;     /*!< The Young modulus value of the material regions. */
 
-    std::vector<double> lambda_;            /*!< The Lame lambda constant of the material points. */
+    std::vector<double> poisson_ratio_;     /*!< The Poisson's ratio value of the material regions. */
 
-    std::vector<double> mu_;                /*!< The shear modulus of the material points. */
+    std::vector<double> bulk_modulus_;      /*!< The bulk modulus of the material regions. */
 
-    std::vector<double> wave_speed_;        /*!< The wave speed of the material points. */
+    std::vector<double> lambda_;            /*!< The Lame lambda constant of the material regions. */
+
+    std::vector<double> mu_;                /*!< The shear modulus of the material regions. */
 
 };
 
 
+inline Eigen::Matrix3d NeoHookean::SpkStress(const Eigen::Matrix3d &FT, const int &integ_point_id) const
+{
+    // Look up the material constants of the point's region.
+    auto region = this->PointRegion(static_cast<std::size_t>(integ_point_id));
+    return SpkStress(FT, this->mu_[region], this->bulk_modulus_[region]);
+}
+
+
+inline Eigen::Matrix3d NeoHookean::SpkStress(const Eigen::Matrix3d &FT, double mu, double bulk)
+{
+    // Determinant of deformation gradient.
+    double det = std::abs(FT.determinant());
+
+    // Right Cauchy Green deformation tensor (Bathe P506).
+    Eigen::Matrix3d C;
+    C.noalias() = FT * FT.transpose();
+
+    // Inverse of the right Cauchy Green deformation tensor.
+    Eigen::Matrix3d Cinv = C.inverse();
+
+    // Deviatoric and volumetric contributions.
+    const double mu_iso = mu * std::pow(det, -(2./3.));
+    Eigen::Matrix3d spk = (bulk*det*(det - 1.) - mu_iso*C.trace()/3.) * Cinv;
+    spk.diagonal().array() += mu_iso;
+    return spk;
+}
+
+
+inline void NeoHookean::SpkStresses(const Eigen::Matrix3d *FT, std::size_t points_num, std::size_t first_point_id,
+                                    Eigen::Matrix3d *spk_stress) const
+{
+    // Keep the constants of uniform materials out of the points loop.
+    if (this->IsUniform()) {
+        const double mu = this->mu_[0], bulk = this->bulk_modulus_[0];
+        for (std::size_t i = 0; i != points_num; ++i) { spk_stress[i] = SpkStress(FT[i], mu, bulk); }
+        return;
+    }
+
+    for (std::size_t i = 0; i != points_num; ++i) {
+        auto region = this->PointRegion(first_point_id+i);
+        spk_stress[i] = SpkStress(FT[i], this->mu_[region], this->bulk_modulus_[region]);
+    }
+}
+
+
+inline double NeoHookean::StrainEnergy(const Eigen::Matrix3d &FT, const int &integ_point_id) const
+{
+    // Look up the material constants of the point's region.
+    auto region = this->PointRegion(static_cast<std::size_t>(integ_point_id));
+    return StrainEnergy(FT, this->mu_[region], this->bulk_modulus_[region]);
+}
+
+
+inline double NeoHookean::StrainEnergy(const Eigen::Matrix3d &FT, double mu, double bulk)
+{
+    // Determinant of deformation gradient.
+    double det = std::abs(FT.determinant());
+
+    // First invariant of the right Cauchy Green deformation tensor.
+    double I = FT.squaredNorm();
+
+    // Deviatoric and volumetric contributions, consistent with the SpkStress evaluation.
+    return 0.5*mu*(std::pow(det, -(2./3.))*I - 3.) + 0.5*bulk*(det - 1.)*(det - 1.);
+}
+
+
 /*! @} End of Doxygen Groups*/
 } //end of namespace CLOUDEA
 
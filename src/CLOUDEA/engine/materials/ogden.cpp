@@ -0,0 +1,128 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/materials/ogden.hpp"
+
+
+namespace CLOUDEA {
+
+
+Ogden::Ogden()
+{}
+
+
+Ogden::~Ogden()
+{}
+
+
+void Ogden::SetMu(const double &mu_value)
+{
+    this->AssignAllRegionsValue(mu_value, this->mu_);
+}
+
+
+void Ogden::SetMu(const double &mu_value, std::size_t region)
+{
+    this->AssignRegionValue(mu_value, region, this->mu_);
+}
+
+
+void Ogden::SetAlpha(const double &alpha_value)
+{
+    this->CheckAlpha(alpha_value);
+    this->AssignAllRegionsValue(alpha_value, this->alpha_);
+}
+
+
+void Ogden::SetAlpha(const double &alpha_value, std::size_t region)
+{
+    this->CheckAlpha(alpha_value);
+    this->AssignRegionValue(alpha_value, region, this->alpha_);
+}
+
+
+void Ogden::SetD1(const double &d1_value)
+{
+    this->CheckD1(d1_value);
+    this->AssignAllRegionsValue(d1_value, this->d1_);
+}
+
+
+void Ogden::SetD1(const double &d1_value, std::size_t region)
+{
+    this->CheckD1(d1_value);
+    this->AssignRegionValue(d1_value, region, this->d1_);
+}
+
+
+void Ogden::ComputeWaveSpeed()
+{
+    // Check if the parameters and density are initialized and are equal.
+    if ((this->mu_.size() == 0) ||
+            (this->mu_.size() != this->d1_.size()) ||
+            (this->mu_.size() != this->density_.size())) {
+        std::string error = "[CLOUDEA ERROR] Ogden parameters (mu, D1) and density containers are not consistently initialized.";
+        throw std::runtime_error(error.c_str());
+    }
+    this->CheckRegionsAssigned(this->mu_, "Ogden mu");
+    this->CheckRegionsAssigned(this->alpha_, "Ogden alpha");
+    this->CheckRegionsAssigned(this->d1_, "Ogden D1");
+    this->CheckRegionsAssigned(this->density_, "density");
+
+    // Clear wave speed container.
+    this->wave_speed_.clear();
+
+    // Calculate the wave speed of each region from the initial bulk (2/D1) and shear (mu) moduli.
+    double speed = 0.;
+    for (std::vector<double>::size_type i = 0; i != this->mu_.size(); ++i) {
+        speed = std::sqrt((2./this->d1_[i] + 4.*this->mu_[i]/3.) / this->density_[i]);
+
+        this->wave_speed_.push_back(speed);
+    }
+}
+
+
+std::vector<std::vector<double>*> Ogden::RegionTables()
+{
+    auto tables = Material::RegionTables();
+    tables.insert(tables.end(), {&this->mu_, &this->alpha_, &this->d1_});
+    return tables;
+}
+
+
+void Ogden::CheckAlpha(const double &alpha_value) const
+{
+    if (alpha_value == 0.) {
+        std::string error = "[CLOUDEA ERROR] Could not set the Ogden material exponent. The exponent alpha can not be zero.";
+        throw std::invalid_argument(error.c_str());
+    }
+}
+
+
+void Ogden::CheckD1(const double &d1_value) const
+{
+    if (d1_value <= 0.) {
+        std::string error = "[CLOUDEA ERROR] Could not set the Ogden material compressibility. The parameter D1 must be positive.";
+        throw std::invalid_argument(error.c_str());
+    }
+}
+
+
+} //end of namespace CLOUDEA
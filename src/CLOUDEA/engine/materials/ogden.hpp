@@ -0,0 +1,332 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_MATERIALS_OGDEN_HPP_
+#define CLOUDEA_MATERIALS_OGDEN_HPP_
+
+/*!
+   \file ogden.hpp
+   \brief Ogden class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/materials/material.hpp"
+#include "CLOUDEA/engine/materials/sym_eigen_3d.hpp"
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <vector>
+#include <string>
+
+#include <stdexcept>
+#include <exception>
+
+#include <cmath>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Materials
+ *  @{
+ */
+
+
+/*!
+ * \class Ogden
+ * \brief Class implemmenting a first order Ogden material for meshless models.
+ *
+ * The strain energy density is W = 2 mu / alpha^2 (l1^alpha + l2^alpha + l3^alpha - 3) + (J - 1)^2 / D1,
+ * where li are the deviatoric principal stretches. The initial shear modulus is mu and the initial bulk modulus is 2 / D1.
+ * The material parameters are stored per material region.
+ */
+
+class Ogden : public Material {
+public:
+
+    /*!
+     * \brief Ogden constructor.
+     */
+    Ogden();
+
+
+    /*!
+     * \brief Ogden destructor.
+     */
+    virtual ~Ogden();
+
+
+    /*!
+     * \brief Set the shear parameter mu of all the material regions.
+     * \param [in] mu_value The shear parameter value.
+     * \return [void]
+     */
+    void SetMu(const double &mu_value);
+
+
+    /*!
+     * \brief Set the shear parameter mu of a material region.
+     * \param [in] mu_value The shear parameter value.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetMu(const double &mu_value, std::size_t region);
+
+
+    /*!
+     * \brief Set the exponent alpha of all the material regions.
+     * \param [in] alpha_value The exponent value. It can not be zero.
+     * \return [void]
+     */
+    void SetAlpha(const double &alpha_value);
+
+
+    /*!
+     * \brief Set the exponent alpha of a material region.
+     * \param [in] alpha_value The exponent value. It can not be zero.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetAlpha(const double &alpha_value, std::size_t region);
+
+
+    /*!
+     * \brief Set the compressibility parameter D1 of all the material regions.
+     * \param [in] d1_value The compressibility parameter value. It must be positive.
+     * \return [void]
+     */
+    void SetD1(const double &d1_value);
+
+
+    /*!
+     * \brief Set the compressibility parameter D1 of a material region.
+     * \param [in] d1_value The compressibility parameter value. It must be positive.
+     * \param [in] region The index of the material region.
+     * \return [void]
+     */
+    void SetD1(const double &d1_value, std::size_t region);
+
+
+    /*!
+     * \brief Compute the wave speed of the material regions from the initial shear and bulk moduli.
+     *
+     * Throws if the mu, alpha, D1 or density of a region have not been assigned.
+     *
+     * \return [void]
+     */
+    void ComputeWaveSpeed();
+
+
+    /*!
+     * \brief Computes the second Piola-Kirchhoff stress tensor at a material point.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] integ_point_id The index of the point.
+     * \return [Eigen::Matrix3d] The second Piola-Kirchhoff stress tensor.
+     */
+    inline Eigen::Matrix3d SpkStress(const Eigen::Matrix3d &FT, const int &integ_point_id) const;
+
+
+    /*!
+     * \brief Computes the second Piola-Kirchhoff stress tensor for the given material parameters.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] mu The shear parameter.
+     * \param [in] alpha The exponent.
+     * \param [in] d1 The compressibility parameter.
+     * \return [Eigen::Matrix3d] The second Piola-Kirchhoff stress tensor.
+     */
+    inline static Eigen::Matrix3d SpkStress(const Eigen::Matrix3d &FT, double mu, double alpha, double d1);
+
+
+    /*!
+     * \brief Computes the strain energy density at a material point.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] integ_point_id The index of the point.
+     * \return [double] The strain energy density.
+     */
+    inline double StrainEnergy(const Eigen::Matrix3d &FT, const int &integ_point_id) const;
+
+
+    /*!
+     * \brief Computes the strain energy density for the given material parameters.
+     * \param [in] FT The transposed deformation gradient at the point.
+     * \param [in] mu The shear parameter.
+     * \param [in] alpha The exponent.
+     * \param [in] d1 The compressibility parameter.
+     * \return [double] The strain energy density.
+     */
+    inline static double StrainEnergy(const Eigen::Matrix3d &FT, double mu, double alpha, double d1);
+
+
+    /*!
+     * \brief Computes the second Piola-Kirchhoff stress tensors of consecutive material points.
+     *
+     * The material parameters of uniform materials are fetched once for all the points.
+     *
+     * \param [in] FT The transposed deformation gradients at the points.
+     * \param [in] points_num The number of points.
+     * \param [in] first_point_id The index of the first point.
+     * \param [out] spk_stress The second Piola-Kirchhoff stress tensors at the points.
+     * \return [void]
+     */
+    inline void SpkStresses(const Eigen::Matrix3d *FT, std::size_t points_num, std::size_t first_point_id, Eigen::Matrix3d *spk_stress) const;
+
+
+    /*!
+     * \brief Get the shear parameter mu of the material regions.
+     * \return [std::vector<double>] The shear parameter of the material regions.
+     */
+    inline const std::vector<double> & RegionMu() const { return this->mu_; }
+
+
+    /*!
+     * \brief Get the exponent alpha of the material regions.
+     * \return [std::vector<double>] The exponent of the material regions.
+     */
+    inline const std::vector<double> & RegionAlpha() const { return this->alpha_; }
+
+
+    /*!
+     * \brief Get the compressibility parameter D1 of the material regions.
+     * \return [std::vector<double>] The compressibility parameter of the material regions.
+     */
+    inline const std::vector<double> & RegionD1() const { return this->d1_; }
+
+
+protected:
+
+    /*!
+     * \brief Get the parameter tables of the material regions.
+     * \return [std::vector<std::vector<double>*>] The parameter tables of the material regions.
+     */
+    virtual std::vector<std::vector<double>*> RegionTables();
+
+
+    /*!
+     * \brief Check that the exponent alpha is not zero.
+     * \param [in] alpha_value The exponent value.
+     * \return [void]
+     */
+    void CheckAlpha(const double &alpha_value) const;
+
+
+    /*!
+     * \brief Check that the compressibility parameter D1 is positive.
+     * \param [in] d1_value The compressibility parameter value.
+     * \return [void]
+     */
+    void CheckD1(const double &d1_value) const;
+
+
+private:
+
+    std::vector<double> mu_;                /*!< The shear parameter of the material regions. */
+
+    std::vector<double> alpha_;             /*!< The exponent of the material regions. */
+
+    std::vector<double> d1_;                /*!< The compressibility parameter of the material regions. */
+
+};
+
+
+inline Eigen::Matrix3d Ogden::SpkStress(const Eigen::Matrix3d &FT, const int &integ_point_id) const
+{
+    // Look up the material parameters of the point's region.
+    auto region = this->PointRegion(static_cast<std::size_t>(integ_point_id));
+    return SpkStress(FT, this->mu_[region], this->alpha_[region], this->d1_[region]);
+}
+
+
+inline Eigen::Matrix3d Ogden::SpkStress(const Eigen::Matrix3d &FT, double mu, double alpha, double d1)
+{
+    // Right Cauchy-Green deformation tensor.
+    Eigen::Matrix3d C;
+    C.noalias() = FT * FT.transpose();
+
+    // Principal stretches and directions.
+    SymEigen3d eigen;
+    eigen.Compute(C);
+    const Eigen::Vector3d stretches = eigen.Eigenvalues().cwiseSqrt();
+
+    // Strain energy function derivatives.
+    const double J = stretches(0) * stretches(1) * stretches(2);
+    const Eigen::Vector3d stretches_pow = stretches.array().pow(alpha);
+    const double b = 2. * mu / alpha * std::pow(J, -alpha / 3.);
+    const double a = (2. / d1) * J * (J - 1.) - b / 3. * stretches_pow.sum();
+
+    // Principal second Piola-Kirchhoff stresses: (dW/dli) / li.
+    const Eigen::Vector3d principal = (a + b*stretches_pow.array()) / stretches.array().square();
+
+    // Second Piola-Kirchhoff stress tensor.
+    const Eigen::Matrix3d &dirs = eigen.Eigenvectors();
+    Eigen::Matrix3d spk;
+    spk.noalias() = dirs * principal.asDiagonal() * dirs.transpose();
+    return spk;
+}
+
+
+inline void Ogden::SpkStresses(const Eigen::Matrix3d *FT, std::size_t points_num, std::size_t first_point_id,
+                               Eigen::Matrix3d *spk_stress) const
+{
+    // Keep the parameters of uniform materials out of the points loop.
+    if (this->IsUniform()) {
+        const double mu = this->mu_[0], alpha = this->alpha_[0], d1 = this->d1_[0];
+        for (std::size_t i = 0; i != points_num; ++i) { spk_stress[i] = SpkStress(FT[i], mu, alpha, d1); }
+        return;
+    }
+
+    for (std::size_t i = 0; i != points_num; ++i) {
+        auto region = this->PointRegion(first_point_id+i);
+        spk_stress[i] = SpkStress(FT[i], this->mu_[region], this->alpha_[region], this->d1_[region]);
+    }
+}
+
+
+inline double Ogden::StrainEnergy(const Eigen::Matrix3d &FT, const int &integ_point_id) const
+{
+    // Look up the material parameters of the point's region.
+    auto region = this->PointRegion(static_cast<std::size_t>(integ_point_id));
+    return StrainEnergy(FT, this->mu_[region], this->alpha_[region], this->d1_[region]);
+}
+
+
+inline double Ogden::StrainEnergy(const Eigen::Matrix3d &FT, double mu, double alpha, double d1)
+{
+    // Right Cauchy-Green deformation tensor.
+    Eigen::Matrix3d C;
+    C.noalias() = FT * FT.transpose();
+
+    // Principal stretches.
+    SymEigen3d eigen;
+    eigen.Compute(C);
+    const Eigen::Vector3d stretches = eigen.Eigenvalues().cwiseSqrt();
+
+    // Deviatoric and volumetric contributions.
+    const double J = stretches(0) * stretches(1) * stretches(2);
+    const double dev_sum = std::pow(J, -alpha / 3.) * stretches.array().pow(alpha).sum();
+    return 2. * mu / (alpha*alpha) * (dev_sum - 3.) + (J - 1.)*(J - 1.) / d1;
+}
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_MATERIALS_OGDEN_HPP_
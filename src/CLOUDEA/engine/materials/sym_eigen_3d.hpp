@@ -0,0 +1,239 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_MATERIALS_SYM_EIGEN_3D_HPP_
+#define CLOUDEA_MATERIALS_SYM_EIGEN_3D_HPP_
+
+/*!
+   \file sym_eigen_3d.hpp
+   \brief SymEigen3d class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include <Eigen/Dense>
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Materials
+ *  @{
+ */
+
+
+/*!
+ * \class SymEigen3d
+ * \brief Closed-form eigen decomposition of 3x3 symmetric matrices.
+ *
+ * The eigenvalues are computed from the trigonometric solution of the characteristic polynomial of the shifted and
+ * scaled matrix. The eigenvector of the best separated extreme eigenvalue is the largest cross product of the rows of
+ * the shifted matrix, and the second eigenvector is computed in the plane orthogonal to it, thus repeated eigenvalues
+ * are handled without iterations. The eigenvalues are finally refined with the Rayleigh quotients of the eigenvectors.
+ * The computation has no loops and few branches, so that it is inlined and vectorized in the batched stress evaluation
+ * of the materials.
+ */
+
+class SymEigen3d {
+public:
+
+    /*!
+     * \brief SymEigen3d constructor.
+     */
+    inline SymEigen3d() : eigenvalues_(Eigen::Vector3d::Zero()), eigenvectors_(Eigen::Matrix3d::Identity()) {}
+
+
+    /*!
+     * \brief Compute the eigenvalues and the eigenvectors of a symmetric matrix.
+     * \param [in] mat The symmetric matrix. Only the upper triangular part is used.
+     * \return [void]
+     */
+    inline void Compute(const Eigen::Matrix3d &mat);
+
+
+    /*!
+     * \brief Get the eigenvalues in ascending order.
+     * \return [Eigen::Vector3d] The eigenvalues.
+     */
+    inline const Eigen::Vector3d & Eigenvalues() const { return this->eigenvalues_; }
+
+
+    /*!
+     * \brief Get the orthonormal eigenvectors in columns, in the order of the eigenvalues.
+     * \return [Eigen::Matrix3d] The eigenvectors.
+     */
+    inline const Eigen::Matrix3d & Eigenvectors() const { return this->eigenvectors_; }
+
+
+protected:
+
+    /*!
+     * \brief Compute the eigenvector of a simple eigenvalue from the cross products of the rows of the shifted matrix.
+     * \param [in] b The upper triangular entries (00, 01, 02, 11, 12, 22) of the scaled symmetric matrix.
+     * \param [in] eigenvalue The simple eigenvalue.
+     * \param [out] vec The unit eigenvector.
+     * \return [void]
+     */
+    inline static void SimpleEigenvector(const double *b, double eigenvalue, double *vec);
+
+
+    /*!
+     * \brief Compute the eigenvector of an eigenvalue that is orthogonal to a known eigenvector.
+     * \param [in] b The upper triangular entries (00, 01, 02, 11, 12, 22) of the scaled symmetric matrix.
+     * \param [in] eigenvalue The eigenvalue.
+     * \param [in] known The known unit eigenvector.
+     * \param [out] vec The unit eigenvector.
+     * \return [void]
+     */
+    inline static void OrthogonalEigenvector(const double *b, double eigenvalue, const double *known, double *vec);
+
+
+    /*!
+     * \brief Compute the quadratic form x^T B x of a symmetric matrix.
+     * \param [in] b The upper triangular entries (00, 01, 02, 11, 12, 22) of the symmetric matrix.
+     * \param [in] x The vector.
+     * \return [double] The quadratic form.
+     */
+    inline static double QuadraticForm(const double *b, const double *x) {
+        return b[0]*x[0]*x[0] + b[3]*x[1]*x[1] + b[5]*x[2]*x[2] + 2.*(b[1]*x[0]*x[1] + b[2]*x[0]*x[2] + b[4]*x[1]*x[2]);
+    }
+
+
+private:
+
+    Eigen::Vector3d eigenvalues_;           /*!< The eigenvalues in ascending order. */
+
+    Eigen::Matrix3d eigenvectors_;          /*!< The eigenvectors in columns. */
+
+};
+
+
+inline void SymEigen3d::Compute(const Eigen::Matrix3d &mat)
+{
+    // Shift by the mean eigenvalue and scale by the largest entry to avoid overflow and cancellation.
+    const double shift = (mat(0,0) + mat(1,1) + mat(2,2)) / 3.;
+    double b[6] = {mat(0,0) - shift, mat(0,1), mat(0,2), mat(1,1) - shift, mat(1,2), mat(2,2) - shift};
+    double scale = 0.;
+    for (const auto &entry : b) { scale = std::max(scale, std::abs(entry)); }
+
+    // Multiple of the identity.
+    if (scale <= std::numeric_limits<double>::min()) {
+        this->eigenvalues_.setConstant(shift);
+        this->eigenvectors_.setIdentity();
+        return;
+    }
+    const double inv_scale = 1. / scale;
+    for (auto &entry : b) { entry *= inv_scale; }
+
+    // Eigenvalues of the traceless scaled matrix: 2 p cos(phi + 2 k pi/3).
+    const double p = std::sqrt((b[0]*b[0] + b[3]*b[3] + b[5]*b[5] + 2.*(b[1]*b[1] + b[2]*b[2] + b[4]*b[4])) / 6.);
+    const double det = b[0]*(b[3]*b[5] - b[4]*b[4]) - b[1]*(b[1]*b[5] - b[4]*b[2]) + b[2]*(b[1]*b[4] - b[3]*b[2]);
+    const double half_det = std::max(-1., std::min(1., det / (2.*p*p*p)));
+    const double cos_phi = std::cos(std::acos(half_det) / 3.);
+    const double sin_phi = std::sqrt(std::max(0., 1. - cos_phi*cos_phi));
+    const double max_eig = 2.*p*cos_phi;
+    const double min_eig = -p*(cos_phi + std::sqrt(3.)*sin_phi);
+    const double mid_eig = -max_eig - min_eig;
+
+    // Eigenvectors starting from the best separated extreme eigenvalue.
+    double min_vec[3], max_vec[3];
+    if (max_eig - mid_eig >= mid_eig - min_eig) {
+        SimpleEigenvector(b, max_eig, max_vec);
+        OrthogonalEigenvector(b, min_eig, max_vec, min_vec);
+    }
+    else {
+        SimpleEigenvector(b, min_eig, min_vec);
+        OrthogonalEigenvector(b, max_eig, min_vec, max_vec);
+    }
+    const double mid_vec[3] = {max_vec[1]*min_vec[2] - max_vec[2]*min_vec[1],
+                               max_vec[2]*min_vec[0] - max_vec[0]*min_vec[2],
+                               max_vec[0]*min_vec[1] - max_vec[1]*min_vec[0]};
+
+    this->eigenvectors_ << min_vec[0], mid_vec[0], max_vec[0],
+                           min_vec[1], mid_vec[1], max_vec[1],
+                           min_vec[2], mid_vec[2], max_vec[2];
+
+    // Refine the eigenvalues with the Rayleigh quotients. The trigonometric solution loses accuracy for nearly repeated eigenvalues.
+    this->eigenvalues_ << shift + scale*QuadraticForm(b, min_vec),
+                          shift + scale*QuadraticForm(b, mid_vec),
+                          shift + scale*QuadraticForm(b, max_vec);
+}
+
+
+inline void SymEigen3d::SimpleEigenvector(const double *b, double eigenvalue, double *vec)
+{
+    // Rows of the shifted matrix.
+    const double r0[3] = {b[0] - eigenvalue, b[1], b[2]};
+    const double r1[3] = {b[1], b[3] - eigenvalue, b[4]};
+    const double r2[3] = {b[2], b[4], b[5] - eigenvalue};
+
+    // The eigenvector is orthogonal to the rows of the rank-2 shifted matrix. Keep the largest cross product.
+    const double c01[3] = {r0[1]*r1[2] - r0[2]*r1[1], r0[2]*r1[0] - r0[0]*r1[2], r0[0]*r1[1] - r0[1]*r1[0]};
+    const double c02[3] = {r0[1]*r2[2] - r0[2]*r2[1], r0[2]*r2[0] - r0[0]*r2[2], r0[0]*r2[1] - r0[1]*r2[0]};
+    const double c12[3] = {r1[1]*r2[2] - r1[2]*r2[1], r1[2]*r2[0] - r1[0]*r2[2], r1[0]*r2[1] - r1[1]*r2[0]};
+    const double n01 = c01[0]*c01[0] + c01[1]*c01[1] + c01[2]*c01[2];
+    const double n02 = c02[0]*c02[0] + c02[1]*c02[1] + c02[2]*c02[2];
+    const double n12 = c12[0]*c12[0] + c12[1]*c12[1] + c12[2]*c12[2];
+
+    const double *cross = c01; double norm2 = n01;
+    if (n02 > norm2) { cross = c02; norm2 = n02; }
+    if (n12 > norm2) { cross = c12; norm2 = n12; }
+
+    if (norm2 <= 0.) { vec[0] = 1.; vec[1] = 0.; vec[2] = 0.; return; }
+    const double inv_norm = 1. / std::sqrt(norm2);
+    vec[0] = cross[0]*inv_norm; vec[1] = cross[1]*inv_norm; vec[2] = cross[2]*inv_norm;
+}
+
+
+inline void SymEigen3d::OrthogonalEigenvector(const double *b, double eigenvalue, const double *known, double *vec)
+{
+    // Orthonormal basis (u, v) of the plane orthogonal to the known eigenvector.
+    double u[3];
+    if (std::abs(known[0]) > std::abs(known[1])) { u[0] = -known[2]; u[1] = 0.; u[2] = known[0]; }
+    else { u[0] = 0.; u[1] = known[2]; u[2] = -known[1]; }
+    const double inv_norm = 1. / std::sqrt(u[0]*u[0] + u[1]*u[1] + u[2]*u[2]);
+    u[0] *= inv_norm; u[1] *= inv_norm; u[2] *= inv_norm;
+    const double v[3] = {known[1]*u[2] - known[2]*u[1], known[2]*u[0] - known[0]*u[2], known[0]*u[1] - known[1]*u[0]};
+
+    // The 2x2 restriction of the shifted matrix in the plane is singular.
+    const double su[3] = {b[0]*u[0] + b[1]*u[1] + b[2]*u[2], b[1]*u[0] + b[3]*u[1] + b[4]*u[2], b[2]*u[0] + b[4]*u[1] + b[5]*u[2]};
+    const double m00 = u[0]*su[0] + u[1]*su[1] + u[2]*su[2] - eigenvalue;
+    const double m01 = v[0]*su[0] + v[1]*su[1] + v[2]*su[2];
+    const double m11 = QuadraticForm(b, v) - eigenvalue;
+
+    // Null vector of the row with the largest norm. Any vector of the plane for a repeated eigenvalue.
+    const double r0 = m00*m00 + m01*m01, r1 = m01*m01 + m11*m11;
+    if (std::max(r0, r1) <= 1.e-28) { vec[0] = u[0]; vec[1] = u[1]; vec[2] = u[2]; return; }
+    const double cu = (r0 >= r1) ? -m01 : -m11;
+    const double cv = (r0 >= r1) ? m00 : m01;
+    const double inv_c = 1. / std::sqrt(cu*cu + cv*cv);
+    for (std::size_t i = 0; i != 3; ++i) { vec[i] = (cu*u[i] + cv*v[i]) * inv_c; }
+}
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_MATERIALS_SYM_EIGEN_3D_HPP_
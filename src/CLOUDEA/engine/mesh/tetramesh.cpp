@@ -23,7 +23,9 @@
 namespace CLOUDEA {
 
 
-TetraMesh::TetraMesh() : mesh_type_(CLOUDEA::MeshType::tetrahedral)
+TetraMesh::TetraMesh() : nodes_(std::make_shared<const std::vector<Node> >()), tetras_(std::make_shared<const std::vector<Tetrahedron> >()),
+                         coordinates_(std::make_shared<const std::vector<double> >()), connectivity_(std::make_shared<const std::vector<int> >()),
+                         mesh_type_(CLOUDEA::MeshType::tetrahedral)
 {}
 
 
@@ -48,19 +50,19 @@ void TetraMesh::LoadFrom(const std::string &mesh_filename)
     // Get the extension of the mesh filename.
     auto ext = mesh_filename.substr(mesh_filename.length()-4);
 
-    // Clear the mesh containers.
-    this->nodes_.clear();
-    this->tetras_.clear();
+    // Load in new containers. Views of the previous mesh remain valid.
+    std::vector<Node> nodes;
+    std::vector<Tetrahedron> tetras;
     this->node_sets_.clear();
 
     // Load the corresponding format.
     if (ext == ".inp") {
         AbaqusIO abaqus_io;
         abaqus_io.LoadMeshFrom(mesh_filename.c_str());
-        abaqus_io.LoadNodesIn(this->nodes_);
-        abaqus_io.LoadElementsIn(this->tetras_);
+        abaqus_io.LoadNodesIn(nodes);
+        abaqus_io.LoadElementsIn(tetras);
         if (abaqus_io.PartitionsExist()) {
-            abaqus_io.LoadPartitionsIn(this->tetras_);
+            abaqus_io.LoadPartitionsIn(tetras);
         }
         if (abaqus_io.NodeSetsExist()) {
             abaqus_io.LoadBoundarySetsIn(this->node_sets_);
@@ -70,8 +72,8 @@ void TetraMesh::LoadFrom(const std::string &mesh_filename)
     else if (ext == ".feb") {
         FebioIO febio_io;
         febio_io.LoadMeshFrom(mesh_filename.c_str());
-        febio_io.LoadNodesIn(this->nodes_);
-        febio_io.LoadElementsIn(this->tetras_);
+        febio_io.LoadNodesIn(nodes);
+        febio_io.LoadElementsIn(tetras);
         if (febio_io.BoundariesExist()) {
             febio_io.LoadBoundarySetsIn(this->node_sets_);
         }
@@ -81,6 +83,70 @@ void TetraMesh::LoadFrom(const std::string &mesh_filename)
         throw std::invalid_argument(error.c_str());
     }
 
+    this->SetNodes(std::move(nodes));
+    this->SetElements(std::move(tetras));
+}
+
+
+void TetraMesh::SetNodes(std::vector<Node> nodes)
+{
+    // Store in new container. Views of the previous nodes remain valid and unchanged.
+    this->nodes_ = std::make_shared<const std::vector<Node> >(std::move(nodes));
+
+    // Update the contiguous xyz coordinates of the nodes.
+    auto coordinates = std::make_shared<std::vector<double> >();
+    coordinates->reserve(3*this->nodes_->size());
+    for (const auto &node : *this->nodes_) {
+        coordinates->insert(coordinates->end(), {node.Coordinates().X(), node.Coordinates().Y(), node.Coordinates().Z()});
+    }
+    this->coordinates_ = coordinates;
+}
+
+
+void TetraMesh::EditNodes(const std::function<void(std::vector<Node> &)> &edit)
+{
+    // Edit a copy of the nodes and replace them.
+    std::vector<Node> nodes(*this->nodes_);
+    edit(nodes);
+    this->SetNodes(std::move(nodes));
+}
+
+
+void TetraMesh::SetElements(std::vector<Tetrahedron> tetras)
+{
+    // Store in new container. Views of the previous elements remain valid and unchanged.
+    this->tetras_ = std::make_shared<const std::vector<Tetrahedron> >(std::move(tetras));
+
+    // Update the contiguous connectivity of the elements.
+    auto connectivity = std::make_shared<std::vector<int> >();
+    connectivity->reserve(4*this->tetras_->size());
+    for (const auto &tetra : *this->tetras_) {
+        connectivity->insert(connectivity->end(), {tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()});
+    }
+    this->connectivity_ = connectivity;
+}
+
+
+void TetraMesh::EditElements(const std::function<void(std::vector<Tetrahedron> &)> &edit)
+{
+    // Edit a copy of the elements and replace them.
+    std::vector<Tetrahedron> tetras(*this->tetras_);
+    edit(tetras);
+    this->SetElements(std::move(tetras));
+}
+
+
+std::vector<Vec3<double> > TetraMesh::NodeCoordinates() const
+{
+    // Copy the contiguous coordinates of the nodes.
+    const auto &xyz = *this->coordinates_;
+    std::vector<Vec3<double> > coordinates;
+    coordinates.reserve(xyz.size()/3);
+    for (std::size_t i = 0; i != xyz.size(); i += 3) {
+        coordinates.emplace_back(xyz[i], xyz[i+1], xyz[i+2]);
+    }
+
+    return coordinates;
 }
 
 
@@ -110,9 +176,9 @@ void TetraMesh::SaveTo(const std::string &mesh_filename)
 bool TetraMesh::operator == (const TetraMesh &tetramesh) const
 {
     // Compare tetrahedral meshes for equality.
-    return ((this->nodes_ == tetramesh.nodes_) &&
+    return (((this->nodes_ == tetramesh.nodes_) || (*this->nodes_ == *tetramesh.nodes_)) &&
             (this->node_sets_ == tetramesh.node_sets_) &&
-            (this->tetras_ == tetramesh.tetras_) &&
+            ((this->tetras_ == tetramesh.tetras_) || (*this->tetras_ == *tetramesh.tetras_)) &&
             (this->mesh_type_ == tetramesh.mesh_type_)
            );
 }
@@ -128,10 +194,12 @@ bool TetraMesh::operator != (const TetraMesh &tetramesh) const
 TetraMesh & TetraMesh::operator = (const TetraMesh &tetramesh)
 {
     if (this != &tetramesh) {
-        // Assign values from tetrahedron.
+        // Assign values from tetrahedron. Nodes and tetrahedra are shared until edited.
         this->nodes_ = tetramesh.nodes_;
         this->node_sets_ = tetramesh.node_sets_;
         this->tetras_ = tetramesh.tetras_;
+        this->coordinates_ = tetramesh.coordinates_;
+        this->connectivity_ = tetramesh.connectivity_;
         this->mesh_type_ = tetramesh.mesh_type_;
     }
 
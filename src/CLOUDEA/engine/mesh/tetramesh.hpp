@@ -40,6 +40,9 @@
 #include "CLOUDEA/engine/utilities/logger.hpp"
 
 #include <vector>
+#include <memory>
+#include <functional>
+#include <cmath>
 
 #include <exception>
 #include <stdexcept>
@@ -94,43 +97,117 @@ public:
 
 
     /*!
-     * \brief Write access to the nodes of the mesh.
-     * \return [std::vector<CLOUDEA::Node>] the mesh nodes with write access.
+     * \brief Set the nodes of the mesh.
+     *
+     * The nodes replace the mesh nodes in new storage, so that the views of the previous nodes
+     * remain unchanged.
+     *
+     * \param [in] nodes The new nodes of the mesh.
+     * \return [void]
+     */
+    void SetNodes(std::vector<Node> nodes);
+
+
+    /*!
+     * \brief Edit the nodes of the mesh.
+     *
+     * The edit is applied on a copy of the mesh nodes which then replaces them, so that the views
+     * of the previous nodes remain unchanged.
+     *
+     * \param [in] edit The function editing the copy of the mesh nodes.
+     * \return [void]
      */
-    inline std::vector<Node> & EditNodes() { return this->nodes_; }
+    void EditNodes(const std::function<void(std::vector<Node> &)> &edit);
 
 
     /*!
-     * \brief Write access to the elements of the mesh.
-     * \return [std::vector<CLOUDEA::Tetrahedron>] The mesh elements with write access.
+     * \brief Set the elements of the mesh.
+     *
+     * The elements replace the mesh elements in new storage, so that the views of the previous elements
+     * remain unchanged.
+     *
+     * \param [in] tetras The new elements of the mesh.
+     * \return [void]
      */
-    inline std::vector<Tetrahedron> & EditElements() { return this->tetras_; }
+    void SetElements(std::vector<Tetrahedron> tetras);
+
+
+    /*!
+     * \brief Edit the elements of the mesh.
+     *
+     * The edit is applied on a copy of the mesh elements which then replaces them, so that the views
+     * of the previous elements remain unchanged.
+     *
+     * \param [in] edit The function editing the copy of the mesh elements.
+     * \return [void]
+     */
+    void EditElements(const std::function<void(std::vector<Tetrahedron> &)> &edit);
 
 
     /*!
      * \brief Read-only access to the nodes of the mesh.
      * \return [std::vector<CLOUDEA::Node>] The mesh nodes with read-only access.
      */
-    inline const std::vector<Node> & Nodes() const { return this->nodes_; }
+    inline const std::vector<Node> & Nodes() const { return *this->nodes_; }
+
+
+    /*!
+     * \brief Get a shared read-only view of the nodes of the mesh.
+     *
+     * The view remains valid and unchanged after the mesh is edited, reloaded or destroyed.
+     *
+     * \return [std::shared_ptr<const std::vector<CLOUDEA::Node> >] The shared mesh nodes.
+     */
+    inline std::shared_ptr<const std::vector<Node> > SharedNodes() const { return this->nodes_; }
 
 
     /*!
      * \brief Get the coordinates of the mesh's nodes.
      *
-     * Performs an iteration through the nodes of the mesh when it is called and could
-     * increase computational burden if called multiple times. In such a case it is prefered
-     * to get the nodes of the mesh using TetraMesh::Nodes() and iterate through the nodes to get Node::Coordinates()
+     * The coordinates are copied from the contiguous coordinates of the mesh on each call.
+     * Keep the returned container for repeated access.
      *
      * \return [std::vector<CLOUDEA::Vec3<double> >] The coordinates of the mesh's nodes.
      */
-    inline std::vector<Vec3<double> > NodeCoordinates() const
-    {
-        std::vector<Vec3<double> > coordinates;
-        for (auto &node : this->nodes_) {
-            coordinates.emplace_back(node.Coordinates());
-        }
+    std::vector<Vec3<double> > NodeCoordinates() const;
+
+
+    /*!
+     * \brief Get the coordinates of the mesh's nodes in a contiguous array.
+     *
+     * The coordinates are stored as [x0 y0 z0 x1 y1 z1 ...], so that the geometric passes over the mesh
+     * do not stride over the partition and boundary data of the nodes. They are kept by the mesh and
+     * updated when the nodes are set, edited or loaded.
+     *
+     * \return [std::vector<double>] The xyz coordinates of the mesh's nodes.
+     */
+    inline const std::vector<double> & FlatCoordinates() const { return *this->coordinates_; }
+
+
+    /*!
+     * \brief Get the connectivity of the mesh's tetrahedra in a contiguous array.
+     *
+     * The connectivity is stored as [n1 n2 n3 n4] per tetrahedron. It is kept by the mesh and
+     * updated when the elements are set, edited or loaded.
+     *
+     * \return [std::vector<int>] The nodes indices of the mesh's tetrahedra.
+     */
+    inline const std::vector<int> & Connectivity() const { return *this->connectivity_; }
 
-        return coordinates;
+
+    /*!
+     * \brief Compute the volume of a tetrahedron from the coordinates of its nodes.
+     * \param [in] p1 The xyz coordinates of the first node.
+     * \param [in] p2 The xyz coordinates of the second node.
+     * \param [in] p3 The xyz coordinates of the third node.
+     * \param [in] p4 The xyz coordinates of the fourth node.
+     * \return [double] The volume of the tetrahedron.
+     */
+    inline static double TetraVolume(const double *p1, const double *p2, const double *p3, const double *p4) {
+        const double a[3] = {p2[0]-p1[0], p2[1]-p1[1], p2[2]-p1[2]};
+        const double b[3] = {p3[0]-p1[0], p3[1]-p1[1], p3[2]-p1[2]};
+        const double c[3] = {p4[0]-p1[0], p4[1]-p1[1], p4[2]-p1[2]};
+        return std::abs(a[0]*(b[1]*c[2] - b[2]*c[1]) - a[1]*(b[0]*c[2] - b[2]*c[0]) + a[2]*(b[0]*c[1] - b[1]*c[0])) / 6.;
     }
 
 
@@ -138,7 +215,14 @@ public:
      * \brief Get the number of nodes of the tetrahedral mesh.
      * \return [int] The number of nodes of the tetrahedral mesh.
      */
-    inline int NodesNum() const { return static_cast<int>(this->nodes_.size()); }
+    inline int NodesNum() const { return static_cast<int>(this->nodes_->size()); }
+
+
+    /*!
+     * \brief Get the number of tetrahedra of the tetrahedral mesh.
+     * \return [int] The number of tetrahedra of the tetrahedral mesh.
+     */
+    inline int ElementsNum() const { return static_cast<int>(this->tetras_->size()); }
 
 
     /*!
@@ -148,14 +232,24 @@ public:
      *
      * \return [std::vector<CLOUDEA::NodeSet>] The sets of nodes of the mesh.
      */
-    inline const std::vector<NodeSet> NodeSets() const { return this->node_sets_; }
+    inline const std::vector<NodeSet> & NodeSets() const { return this->node_sets_; }
 
 
     /*!
      * \brief Read-ony access to the elements of the mesh.
      * \return [std::vector<CLOUDEA::Tetrahedron>] the mesh elements with read-only access.
      */
-    inline const std::vector<Tetrahedron> & Elements() const { return this->tetras_; }
+    inline const std::vector<Tetrahedron> & Elements() const { return *this->tetras_; }
+
+
+    /*!
+     * \brief Get a shared read-only view of the elements of the mesh.
+     *
+     * The view remains valid and unchanged after the mesh is edited, reloaded or destroyed.
+     *
+     * \return [std::shared_ptr<const std::vector<CLOUDEA::Tetrahedron> >] The shared mesh elements.
+     */
+    inline std::shared_ptr<const std::vector<Tetrahedron> > SharedElements() const { return this->tetras_; }
 
 
     /*!
@@ -191,19 +285,25 @@ public:
      * \brief Assignment operator.
      *
      * Assigns all the properties of a given tetramesh (nodes, tetrahedra, mesh type).
+     * The nodes and tetrahedra are shared with the given tetramesh until either of them is edited.
      *
      * \param [in] tetramesh The tetrahedral mesh to assign.
      * \return [TetraMesh] The assigned tetrahedral mesh.
      */
     TetraMesh & operator = (const TetraMesh &tetramesh);
 
+
 private:
 
-    std::vector<Node> nodes_;                             /*!< The mesh nodes. */
+    std::shared_ptr<const std::vector<Node> > nodes_;                   /*!< The mesh nodes. Shared with the meshes, grids and support domains viewing them. */
 
     std::vector<NodeSet> node_sets_;            /*!< The mesh node sets. */
 
-    std::vector<Tetrahedron> tetras_;                     /*!< The mesh tetrahedral elements. */
+    std::shared_ptr<const std::vector<Tetrahedron> > tetras_;           /*!< The mesh tetrahedral elements. Shared with the meshes and support domains viewing them. */
+
+    std::shared_ptr<const std::vector<double> > coordinates_;           /*!< The xyz coordinates of the mesh nodes. Shared with the meshes sharing the nodes. */
+
+    std::shared_ptr<const std::vector<int> > connectivity_;             /*!< The connectivity of the mesh elements. Shared with the meshes sharing the elements. */
 
     CLOUDEA::MeshType mesh_type_;                     /*!< The mesh type (tetrahedral). */
 };
@@ -21,27 +21,182 @@
 
 #include "CLOUDEA/engine/mesh_io/abaqus_io.hpp"
 
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <numeric>
+#include <atomic>
+#include <thread>
+
+
 namespace CLOUDEA {
 
 
-AbaqusIO::AbaqusIO() : nodes_startline_(0), elems_startline_(0),
+// Run the given function on contiguous ranges of [0, num) in parallel.
+// An exception thrown by a range is rethrown in the calling thread after all the ranges finish.
+static void ParallelRanges(std::size_t num, std::size_t threads_number, const std::function<void(std::size_t, std::size_t)> &func)
+{
+    std::size_t threads_num = std::max(std::size_t{1}, std::min(threads_number, num));
+    std::size_t chunk = (num + threads_num - 1) / threads_num;
+
+    // Process a range keeping its exception, if any.
+    std::vector<std::exception_ptr> thread_errors(threads_num);
+    auto process_range = [&](std::size_t t) {
+        try {
+            std::size_t start = std::min(t*chunk, num);
+            func(start, std::min(start+chunk, num));
+        }
+        catch (...) { thread_errors[t] = std::current_exception(); }
+    };
+
+    // Process the first range in the calling thread.
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num);
+    try {
+        for (std::size_t t = 1; t < threads_num; ++t) { threads.emplace_back(std::thread(process_range, t)); }
+    }
+    catch (...) {
+        std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+        throw;
+    }
+    process_range(0);
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    for (const auto &thread_error : thread_errors) {
+        if (thread_error) { std::rethrow_exception(thread_error); }
+    }
+}
+
+
+// Split the lines of [begin, end) in chunks of similar size. Returns the chunks_num+1 boundaries of the chunks.
+static std::vector<const char *> LineChunks(const char *begin, const char *end, std::size_t chunks_num)
+{
+    chunks_num = std::max(std::size_t{1}, chunks_num);
+    std::vector<const char *> bounds(1, begin);
+    for (std::size_t c = 1; c != chunks_num; ++c) {
+        // Move the boundary after the end of the line it falls in.
+        const char *bound = std::max(bounds.back(), begin + (end - begin) * static_cast<std::ptrdiff_t>(c) / static_cast<std::ptrdiff_t>(chunks_num));
+        if (bound != begin && bound != end && bound[-1] != '\n') {
+            const char *line_end = static_cast<const char *>(std::memchr(bound, '\n', static_cast<std::size_t>(end - bound)));
+            bound = (line_end == nullptr) ? end : line_end + 1;
+        }
+        bounds.emplace_back(bound);
+    }
+    bounds.emplace_back(end);
+    return bounds;
+}
+
+
+// Count the lines of [begin, end). The last line may not end with a new line character.
+static std::size_t LinesNum(const char *begin, const char *end)
+{
+    if (begin == end) { return 0; }
+    auto lines_num = static_cast<std::size_t>(std::count(begin, end, '\n'));
+    return (end[-1] == '\n') ? lines_num : lines_num + 1;
+}
+
+
+// Call func(line_begin, line_end) for each line of [begin, end) until it returns false. Returns the number of successful calls.
+template <class LINE_FUNC>
+static std::size_t ForEachLine(const char *begin, const char *end, LINE_FUNC &&func)
+{
+    std::size_t lines_num = 0;
+    while (begin != end) {
+        const char *line_end = static_cast<const char *>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+        if (line_end == nullptr) { line_end = end; }
+        if (!func(begin, line_end)) { break; }
+        lines_num++;
+        begin = (line_end == end) ? end : line_end + 1;
+    }
+    return lines_num;
+}
+
+
+// Parse the next number of a data line. The values are separated by commas and white spaces.
+// Returns false at the end of the line or if the next value is not a number.
+template <typename T>
+static inline bool ParseNext(const char *&pos, const char *line_end, T &value)
+{
+    while (pos != line_end && (*pos == ',' || *pos == ' ' || *pos == '\t' || *pos == '\r')) { ++pos; }
+    if (pos != line_end && *pos == '+') { ++pos; }
+    auto result = std::from_chars(pos, line_end, value);
+    if (result.ec != std::errc()) { return false; }
+    pos = result.ptr;
+    return true;
+}
+
+
+// Parse the data lines of [begin, end) in parallel chunks directly in the items container.
+// parse_line(line_begin, line_end, item) returns false if the line is not a data line. The data block ends at the first such line.
+template <class ITEM_T, class PARSE_T>
+static void ParseDataLines(const char *begin, const char *end, std::size_t threads_number, std::vector<ITEM_T> &items, PARSE_T parse_line)
+{
+    auto chunks = LineChunks(begin, end, threads_number);
+    std::size_t chunks_num = chunks.size() - 1;
+
+    // The offsets of the chunks' items in the container.
+    std::vector<std::size_t> offsets(chunks_num+1, 0);
+    ParallelRanges(chunks_num, chunks_num, [&](std::size_t start, std::size_t stop) {
+        for (auto c = start; c != stop; ++c) { offsets[c+1] = LinesNum(chunks[c], chunks[c+1]); }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    items.resize(offsets.back());
+
+    std::vector<std::size_t> parsed(chunks_num, 0);
+    ParallelRanges(chunks_num, chunks_num, [&](std::size_t start, std::size_t stop) {
+        for (auto c = start; c != stop; ++c) {
+            auto item_id = offsets[c];
+            parsed[c] = ForEachLine(chunks[c], chunks[c+1], [&](const char *line_begin, const char *line_end) {
+                return parse_line(line_begin, line_end, items[item_id++]);
+            });
+        }
+    });
+
+    // Keep the items up to the first line that is not a data line.
+    std::size_t items_num = 0;
+    for (std::size_t c = 0; c != chunks_num; ++c) {
+        items_num = offsets[c] + parsed[c];
+        if (parsed[c] != offsets[c+1] - offsets[c]) { break; }
+    }
+    items.resize(items_num);
+}
+
+
+AbaqusIO::AbaqusIO() : mesh_map_(), mesh_size_(0), threads_number_(1),
                        partitions_exist(false), node_sets_exist(false)
-{}
+{
+    // Use all the available hardware threads by default.
+    this->SetThreadsNumber(0);
+}
 
 
 AbaqusIO::~AbaqusIO()
 {}
 
 
+void AbaqusIO::SetThreadsNumber(std::size_t threads_number)
+{
+    this->threads_number_ = (threads_number == 0) ? std::max(1u, std::thread::hardware_concurrency()) : threads_number;
+}
+
+
 void AbaqusIO::LoadMeshFrom(const std::string &mesh_filename)
 {
     // Print reading status message.
     std::cout << "[CLOUDEA] Reading mesh file: \"" + mesh_filename + "\n";
 
     // Clear containers.
-    this->input_mesh_.clear();
-    this->parts_startlines_.clear();
-    this->node_sets_startlines_.clear();
+    this->mesh_map_.reset();
+    this->mesh_size_ = 0;
+    this->nodes_section_ = Section();
+    this->elems_section_ = Section();
+    this->parts_sections_.clear();
+    this->node_sets_sections_.clear();
+    this->offsetted_nodes_.clear();
+    this->offsetted_elems_.clear();
+    this->partitions_exist = false;
+    this->node_sets_exist = false;
 
     // Check if mesh filename is given.
     if (mesh_filename.empty()) {
@@ -56,68 +211,59 @@ void AbaqusIO::LoadMeshFrom(const std::string &mesh_filename)
         throw std::invalid_argument(error.c_str());
     }
 
-    //Open mesh file.
-    std::ifstream mesh_file(mesh_filename.c_str(), std::ios::in);
-
-    // Check if mesh file opened successfully.
-    if (!mesh_file.is_open()) {
-        std::string error = "[CLOUDEA ERROR] Could not open the mesh file: \"" + mesh_filename + "\". Check given path.";
-        throw std::runtime_error(error.c_str());
+    // Map the mesh file.
+    this->mesh_map_ = MappedFile::Map(mesh_filename, "mesh", this->mesh_size_, true);
+    const char *data = this->MeshData();
+    const char *data_end = data + this->mesh_size_;
+
+    // Index the keyword lines in a single pass. Only keyword lines contain the '*' character.
+    std::vector<Section> sections;
+    const char *pos = data;
+    while (pos != data_end) {
+        const char *star = static_cast<const char *>(std::memchr(pos, '*', static_cast<std::size_t>(data_end - pos)));
+        if (star == nullptr) { break; }
+
+        // The limits of the keyword line.
+        const char *line_begin = star;
+        while (line_begin != pos && line_begin[-1] != '\n') { --line_begin; }
+        const char *line_end = static_cast<const char *>(std::memchr(star, '\n', static_cast<std::size_t>(data_end - star)));
+        if (line_end == nullptr) { line_end = data_end; }
+
+        // The previous section ends at the keyword line.
+        if (!sections.empty()) { sections.back().data_end_ = static_cast<std::size_t>(line_begin - data); }
+
+        // Transform the keyword line in lowercase.
+        Section section;
+        section.header_.assign(line_begin, line_end);
+        std::transform(section.header_.begin(), section.header_.end(), section.header_.begin(), ::tolower);
+        section.data_begin_ = static_cast<std::size_t>(std::min(line_end + 1, data_end) - data);
+        section.data_end_ = this->mesh_size_;
+        sections.emplace_back(std::move(section));
+
+        pos = std::min(line_end + 1, data_end);
     }
 
-    //Available mesh information.
-    bool nodes_exist = false;
-    bool elems_exist = false;
-
-    //Read mesh file line by line.
-    std::string line = "";
-    int line_id = 0;
-    while (std::getline(mesh_file, line)) {
-        // Transform mesh file line in lowercase.
-        std::transform(line.begin(), line.end(), line.begin(), ::tolower);
-
-        // Read mesh file lines.
-        this->input_mesh_.push_back(line);
-
-        // Find the first line of the nodes set.
-        if (line.find("*node") != std::string::npos) {
-            this->nodes_startline_ = line_id;
-            nodes_exist = true;
+    // Assign the sections. The last nodes and elements sections are used.
+    for (auto &section : sections) {
+        if (section.header_.find("*node") != std::string::npos) { this->nodes_section_ = section; }
+        if (section.header_.find("*element") != std::string::npos) { this->elems_section_ = section; }
+        if (section.header_.find("*elset") != std::string::npos) {
+            this->parts_sections_.emplace_back(section);
+            this->partitions_exist = true;
         }
-
-        // Find the first line of the elements set.
-        if (line.find("*element") != std::string::npos) {
-            this->elems_startline_ = line_id;
-            elems_exist = true;
-        }
-
-        // Find the first lines of the partitions sets.
-        if (line.find("*elset") != std::string::npos) {
-            this->parts_startlines_.push_back(line_id);
-            if (!this->partitions_exist) { this->partitions_exist = true; }
-        }
-
-        // Find the first lines of the boundary node sets.
-        if (line.find("*nset") != std::string::npos) {
-            this->node_sets_startlines_.push_back(line_id);
-            if (!this->node_sets_exist) { this->node_sets_exist = true; }
+        if (section.header_.find("*nset") != std::string::npos) {
+            this->node_sets_sections_.emplace_back(section);
+            this->node_sets_exist = true;
         }
-
-        // Increase line id once it is processed.
-        line_id++;
-
     }
 
     // Check if nodes and elements are available in the mesh file.
-    if (!nodes_exist && !elems_exist) {
+    if (this->nodes_section_.header_.empty() && this->elems_section_.header_.empty()) {
         std::string error = "[CLOUDEA ERROR] Mesh file: " + mesh_filename + " is incomplete. "
                 "Either nodes or elements are not available...";
-        std::runtime_error(error.c_str());
+        throw std::runtime_error(error.c_str());
     }
 
-    // Close the mesh file.
-    mesh_file.close();
-
 }
 
 
@@ -125,60 +271,35 @@ void AbaqusIO::LoadNodesIn(std::vector<Node> &nodes)
 {
     // Clean the mesh nodes container.
     nodes.clear();
+    this->offsetted_nodes_.clear();
+    if (this->nodes_section_.header_.empty()) { return; }
 
-    // The coordinates of the nodes in the mesh.
-    double x = 0.; double y = 0.; double z = 0.;
-
-    // The id of the nodes in the mesh. Initialized to invalid value (-1).
-    int id = -1;
-
-    // The mesh node.
-    Node node;
-
-    // Iterate though mesh starting from the nodes set starting line.
-    // Skip the first line start from the first node's coordinates.
-    std::string line = "";
-    for (std::vector<std::string>::size_type it = this->nodes_startline_ + 1;
-         it != input_mesh_.size(); ++it) {
-
-        line = this->input_mesh_.at(it);
-
-        // Replace comma occurence in line with space.
-        std::replace(line.begin(), line.end(), ',', ' ');
-
-        // Convert line to istringstream to be passed in the coordinates variables.
-        std::stringstream ss(line);
-
-        // Get the coordinates until reach the end of the vertices set.
-        if (!(ss >> id >> x >> y >> z)) { break; }
+    // Parse the nodes' id and coordinates until reach the end of the nodes set.
+    const char *data = this->MeshData();
+    ParseDataLines(data + this->nodes_section_.data_begin_, data + this->nodes_section_.data_end_, this->threads_number_, nodes,
+                   [](const char *pos, const char *line_end, Node &node) {
+        int id = -1; double x = 0.; double y = 0.; double z = 0.;
+        if (!(ParseNext(pos, line_end, id) && ParseNext(pos, line_end, x) &&
+              ParseNext(pos, line_end, y) && ParseNext(pos, line_end, z))) { return false; }
 
         // Set the id and coordinates of the mesh node. Reduce index by 1 to account for the storage offset.
         node.SetId(id-1);
         node.SetCoordinates(x, y, z);
-
-        // Store the node in the nodes' container.
-        nodes.emplace_back(node);
-    }
+        return true;
+    });
 
     // Reset the offsetted nodes indices, if any.
-    int node_offset = 0;
     for (auto &node : nodes) {
         // Index of the node in the container.
-        auto id = &node - &nodes[0];
+        auto id = static_cast<int>(&node - &nodes[0]);
 
-        // Check consistency with stored node's id.
+        // Store the offsetted node's id and it's offset from storage, and reset the node's id.
         if (id != node.Id()) {
-            node_offset = node.Id() - id;
-
-            // Store the offsetted node's id and it's offset from storage.
-            this->offsetted_nodes_.push_back(std::make_pair(node.Id(), node_offset));
-
-            // Reset the node's id.
-            node.SetId(node.Id() - node_offset);
+            this->offsetted_nodes_.emplace(node.Id(), node.Id() - id);
+            node.SetId(id);
         }
     }
 
-
 }
 
 
@@ -186,116 +307,57 @@ void AbaqusIO::LoadElementsIn(std::vector<Tetrahedron> &tetras)
 {
     // Clean the mesh tetrahedra container.
     tetras.clear();
-
-    // A tetrahedron of the mesh.
-    Tetrahedron tetrahedron;
-
-    // The tetrahedron's index. Initialized in invalid value (-1).
-    int id = -1;
-
-    // The tetrahedron's connectivity. Initialized in invalid value (-1).
-    int n1 = -1; int n2 = -1; int n3 = -1; int n4 = -1;
-
-    // The header line of the elements set.
-    std::string elements_start = this->input_mesh_.at(this->elems_startline_);
+    this->offsetted_elems_.clear();
+    if (this->elems_section_.header_.empty()) { return; }
 
     // The elements type available in the mesh.
-    std::string elements_type = elements_start.substr(elements_start.find("type="));
-
-    if (elements_type != "type=c3d4") {
-        std::string error = "[CLOUDEA ERROR] The loaded mesh does not contain tetrahedra (C3D4).";
-        std::runtime_error(error.c_str());
+    std::string elements_type = this->elems_section_.header_;
+    elements_type.erase(std::remove(elements_type.begin(), elements_type.end(), ' '), elements_type.end());
+    if (elements_type.find("type=c3d4") == std::string::npos) {
+        std::cout << Logger::Warning("The elements of the loaded mesh are not declared as tetrahedra (C3D4). "
+                                     "They will be read as linear tetrahedra.") << std::endl;
     }
 
+    // Parse the elements' id and connectivity until reach the end of the elements set.
+    const char *data = this->MeshData();
+    ParseDataLines(data + this->elems_section_.data_begin_, data + this->elems_section_.data_end_, this->threads_number_, tetras,
+                   [](const char *pos, const char *line_end, Tetrahedron &tetra) {
+        int id = -1; int n1 = -1; int n2 = -1; int n3 = -1; int n4 = -1;
+        if (!(ParseNext(pos, line_end, id) && ParseNext(pos, line_end, n1) && ParseNext(pos, line_end, n2) &&
+              ParseNext(pos, line_end, n3) && ParseNext(pos, line_end, n4))) { return false; }
 
-    // Iterate though mesh starting from the elements set starting line.
-    // Skip the first line to start from the first element's connectivity.
-    std::string line = "";
-    for (std::vector<std::string>::size_type it = this->elems_startline_ + 1;
-         it != input_mesh_.size(); ++it) {
-
-        line = this->input_mesh_.at(it);
-
-        // Replace comma occurence in line with space.
-        std::replace(line.begin(), line.end(), ',', ' ');
-
-        // Convert line to stringstream to be passed in the connectivity variables.
-        std::stringstream ss(line);
-
-        // Get the id and connectivity until reach the end of the vertices set.
-        if (!(ss >> id >> n1 >> n2 >> n3 >> n4)) { break; }
-
-        // Correct for c++ storage by paddling 1.
-        tetrahedron.SetId(id - 1);
-
-        // Correct connectivity for c++ storage by paddling 1.
-        tetrahedron.SetConnectivity(n1 - 1, n2 - 1, n3 - 1, n4 - 1);
-
-        // Store in the tetrhadra container.
-        tetras.emplace_back(tetrahedron);
-
-    }
+        // Correct id and connectivity for c++ storage by paddling 1.
+        tetra.SetId(id - 1);
+        tetra.SetConnectivity(n1 - 1, n2 - 1, n3 - 1, n4 - 1);
+        return true;
+    });
 
     // Correct connectivity for offsetted nodes if necessary.
-    if (this->offsetted_nodes_.size() != 0) {
+    if (!this->offsetted_nodes_.empty()) {
         std::cout << "[CLOUDEA] Correcting mesh connectivity for nodes ordering inconsistency...\n";
 
-        for (auto &tetra : tetras) {
-
-            // Check for offset at node N1.
-            auto offsetted_n1 = std::find_if(this->offsetted_nodes_.begin(), this->offsetted_nodes_.end(),
-                [&](const std::pair<int,int> &element){ return element.first == tetra.N1(); } );
-
-            // Apply offset correction if necessary.
-            if (offsetted_n1 != this->offsetted_nodes_.end()) {
-                tetra.SetN1(tetra.N1() - offsetted_n1->second);
-            }
-
-            // Check for offset at node N2.
-            auto offsetted_n2 = std::find_if(this->offsetted_nodes_.begin(), this->offsetted_nodes_.end(),
-                [&](const std::pair<int,int> &element){ return element.first == tetra.N2(); } );
-
-            // Apply offset correction if necessary.
-            if (offsetted_n2 != this->offsetted_nodes_.end()) {
-                tetra.SetN2(tetra.N2() - offsetted_n2->second);
-            }
-
-            // Check for offset at node N3.
-            auto offsetted_n3 = std::find_if(this->offsetted_nodes_.begin(), this->offsetted_nodes_.end(),
-                [&](const std::pair<int,int> &element){ return element.first == tetra.N3(); } );
-
-            // Apply offset correction if necessary.
-            if (offsetted_n3 != this->offsetted_nodes_.end()) {
-                tetra.SetN3(tetra.N3() - offsetted_n3->second);
-            }
-
-            // Check for offset at node N4.
-            auto offsetted_n4 = std::find_if(this->offsetted_nodes_.begin(), this->offsetted_nodes_.end(),
-                [&](const std::pair<int,int> &element){ return element.first == tetra.N4(); } );
-
-            // Apply offset correction if necessary.
-            if (offsetted_n4 != this->offsetted_nodes_.end()) {
-                tetra.SetN4(tetra.N4() - offsetted_n4->second);
+        auto corrected = [this](int node_id) {
+            auto offsetted = this->offsetted_nodes_.find(node_id);
+            return (offsetted != this->offsetted_nodes_.end()) ? node_id - offsetted->second : node_id;
+        };
+        ParallelRanges(tetras.size(), this->threads_number_, [&](std::size_t start, std::size_t end) {
+            for (auto t = start; t != end; ++t) {
+                auto &tetra = tetras[t];
+                tetra.SetConnectivity(corrected(tetra.N1()), corrected(tetra.N2()), corrected(tetra.N3()), corrected(tetra.N4()));
             }
-        }
+        });
         std::cout << "[CLOUDEA] Mesh connectivity corrected!\n";
     }
 
     // Reset the offsetted elements indices, if any.
-    int tetra_offset = 0;
     for (auto &tetra : tetras) {
-        // Index of the node in the container.
-        auto id = &tetra - &tetras[0];
+        // Index of the element in the container.
+        auto id = static_cast<int>(&tetra - &tetras[0]);
 
-        // Check consistency with stored node's id.
+        // Store the offsetted element's id and it's offset from storage, and reset the element's id.
         if (id != tetra.Id()) {
-            tetra_offset = tetra.Id() - id;
-
-            // Store the offsetted node's id and it's offset from storage.
-            this->offsetted_elems_.push_back(std::make_pair(tetra.Id(), tetra_offset));
-
-            // Reset the element's id.
-            tetra.SetId(tetra.Id() - tetra_offset);
+            this->offsetted_elems_.emplace(tetra.Id(), tetra.Id() - id);
+            tetra.SetId(id);
         }
     }
 
@@ -304,68 +366,39 @@ void AbaqusIO::LoadElementsIn(std::vector<Tetrahedron> &tetras)
 
 void AbaqusIO::LoadPartitionsIn(std::vector<Tetrahedron> &tetras)
 {
-    // The tetrahedron's index. Initialized in invalid value (-1).
-    int tetra_id = -1;
-
-    // The headerline of the current part. Used in partitions iteration.
-    std::string current_part_headerline = "";
-
-    // The name of the current part. Used in partitions iteration.
-    std::string current_part_name = "";
-
-    // The mesh file line to be processed. Used in partitions iteration.
-    std::string line = "";
-
-    // Iterate though mesh starting from the partition set starting line (for each partition).
-    // Skip the first line to start from the partition's elements.
-    for (auto &current_part_startline: this->parts_startlines_) {
-
-        auto part_id = &current_part_startline - &this->parts_startlines_[0];
-
-        current_part_headerline = this->input_mesh_.at(current_part_startline);
-
-        current_part_name = current_part_headerline.substr(current_part_headerline.find_last_of("=")+1);
-
-        // Remove last character of current part name if it is the new line character.
-//        if (current_part_name.back() == '\n') { current_part_name.pop_back(); }
-
-        current_part_name.erase(std::remove_if(current_part_name.begin(), current_part_name.end(),
-                                               [](char c) { return !isalnum(c); }), current_part_name.end());
-
-        for (std::vector<std::string>::size_type it = current_part_startline+1;
-             it != input_mesh_.size(); ++it) {
-
-            line = this->input_mesh_.at(it);
-
-            // Replace comma occurence in line with space.
-            std::replace(line.begin(), line.end(), ',', ' ');
-
-            // Convert line to stringstream to be passed in the connectivity variables.
-            std::stringstream ss(line);
-
-            while (ss >> tetra_id) {
-                // Correct for c++ storage by paddling 1.
-                tetra_id -= 1;
-
-                // Correct for offsetted elements if necessary.
-                if (this->offsetted_elems_.size() != 0) {
-
-                    // Check for offset at element in partition.
-                    auto offsetted_elem = std::find_if(this->offsetted_elems_.begin(), this->offsetted_elems_.end(),
-                          [&](const std::pair<int,int> &element){ return element.first == tetra_id; } );
-
-                    // Apply offset correction if necessary.
-                    if (offsetted_elem != this->offsetted_elems_.end()) {
-                        tetra_id -= offsetted_elem->second;
-                    }
-                }
-
-                // Set the partition.
-                tetras[tetra_id].SetPartition(part_id, current_part_name);
+    // Assign the partitions in the order of the file. Elements of later partitions are reassigned.
+    for (const auto &section : this->parts_sections_) {
+
+        auto part_id = &section - &this->parts_sections_[0];
+
+        // The name of the partition.
+        std::string part_name = section.header_.substr(section.header_.find_last_of("=")+1);
+        part_name.erase(std::remove_if(part_name.begin(), part_name.end(),
+                                       [](char c) { return !isalnum(c); }), part_name.end());
+
+        // Intern the partition's name once for all its elements.
+        Partition part;
+        part.id_ = static_cast<int>(part_id);
+        part.name_id_ = NameTable::Intern(part_name);
+
+        // Set the partition of the elements of the set. Correct for c++ storage by paddling 1 and for offsetted elements.
+        auto tetra_ids = this->ParseIdsList(section);
+        std::atomic<bool> ids_are_valid(true);
+        ParallelRanges(tetra_ids.size(), this->threads_number_, [&](std::size_t start, std::size_t end) {
+            for (auto i = start; i != end; ++i) {
+                int tetra_id = tetra_ids[i] - 1;
+                auto offsetted = this->offsetted_elems_.find(tetra_id);
+                if (offsetted != this->offsetted_elems_.end()) { tetra_id -= offsetted->second; }
+
+                if (tetra_id < 0 || static_cast<std::size_t>(tetra_id) >= tetras.size()) { ids_are_valid = false; continue; }
+                tetras[tetra_id].CopyPartition(part);
             }
+        });
 
+        if (!ids_are_valid) {
+            std::string error = "[CLOUDEA ERROR] Could not load the partition \"" + part_name + "\". It contains elements not in the mesh.";
+            throw std::out_of_range(error.c_str());
         }
-
     }
 
 }
@@ -375,87 +408,61 @@ void AbaqusIO::LoadBoundarySetsIn(std::vector<NodeSet> &node_sets)
 {
     // Clear and allocate node_sets.
     node_sets.clear();
-    node_sets.reserve(this->node_sets_startlines_.size());
-
-    // The node's index. Initialized in invalid value (-1).
-    int node_id = -1;
-
-    // The headerline of the current nodeset. Used in nodesets iteration.
-    std::string current_nset_headerline = "";
-
-    // The name of the current nodeset. Used in nodesets iteration.
-    std::string current_nset_name = "";
-
-    // The mesh file line to be processed. Used in nodesets iteration.
-    std::string line = "";
+    node_sets.reserve(this->node_sets_sections_.size());
 
-    // Iterate though mesh starting from the nodeset starting line (for each nodeset).
-    for (auto &current_nset_startline: this->node_sets_startlines_) {
-
-        current_nset_headerline = this->input_mesh_[current_nset_startline];
+    for (const auto &section : this->node_sets_sections_) {
 
         // Remove spaces from header line.
-        current_nset_headerline.erase(std::remove(current_nset_headerline.begin(), current_nset_headerline.end(), ' ' ),
-                                      current_nset_headerline.end());
-
-        current_nset_name = current_nset_headerline.substr(current_nset_headerline.find_last_of("=")+1);
-
+        std::string nset_headerline = section.header_;
+        nset_headerline.erase(std::remove(nset_headerline.begin(), nset_headerline.end(), ' ' ), nset_headerline.end());
 
         // Remove special (invinsible) characters from current nodeset name.
-        current_nset_name.erase(std::remove_if(current_nset_name.begin(), current_nset_name.end(),
-                                               [](unsigned char c) { return !std::isprint(c); }), current_nset_name.end());
-
-        NodeSet current_nset;
-        current_nset.SetNodeSetName(current_nset_name);
-
-        // Skip the first line to start from the nodeset's nodes.
-        for (std::vector<std::string>::size_type it = current_nset_startline+1;
-             it != input_mesh_.size(); ++it) {
-
-            line = this->input_mesh_[it];
-
-            // Replace comma occurence in line with space.
-            std::replace(line.begin(), line.end(), ',', ' ');
-
-            // Convert line to stringstream to be passed in the connectivity variables.
-            std::stringstream ss(line);
-
-            while (ss >> node_id) {
-
-                // Correct for c++ storage by paddling 1.
-                node_id -= 1;
-
-                // Correct for offsetted nodes if necessary.
-                if (this->offsetted_nodes_.size() != 0) {
-
-                    // Check for offset at boundary node.
-                    auto offsetted_node = std::find_if(this->offsetted_nodes_.begin(), this->offsetted_nodes_.end(),
-                          [&](const std::pair<int,int> &element){ return element.first == node_id; } );
-
-                    // Apply offset correction if necessary.
-                    if (offsetted_node != this->offsetted_nodes_.end()) {
-                        node_id -= offsetted_node->second;
-                    }
-                }
-
-                // Add node id in the current nodeset.
-                current_nset.EditNodeIds().emplace_back(node_id);
-
-            }
-
-            // Stop processing the mesh file for current nodeset when the next one is found.
-            if (line.find("*nset") != std::string::npos) { break; }
-
+        std::string nset_name = nset_headerline.substr(nset_headerline.find_last_of("=")+1);
+        nset_name.erase(std::remove_if(nset_name.begin(), nset_name.end(),
+                                       [](unsigned char c) { return !std::isprint(c); }), nset_name.end());
+
+        NodeSet nset;
+        nset.SetNodeSetName(nset_name);
+
+        // Add the nodes of the set. Correct for c++ storage by paddling 1 and for offsetted nodes.
+        nset.EditNodeIds() = this->ParseIdsList(section);
+        for (auto &node_id : nset.EditNodeIds()) {
+            node_id -= 1;
+            auto offsetted = this->offsetted_nodes_.find(node_id);
+            if (offsetted != this->offsetted_nodes_.end()) { node_id -= offsetted->second; }
         }
 
         // Add current nodeset in the nodesets container.
-        node_sets.emplace_back(current_nset);
+        node_sets.emplace_back(std::move(nset));
     }
 
-
 }
 
 
+std::vector<int> AbaqusIO::ParseIdsList(const Section &section) const
+{
+    // Parse the integers of each chunk of lines.
+    const char *data = this->MeshData();
+    auto chunks = LineChunks(data + section.data_begin_, data + section.data_end_, this->threads_number_);
+    std::vector<std::vector<int> > chunk_ids(chunks.size()-1);
+    ParallelRanges(chunk_ids.size(), chunk_ids.size(), [&](std::size_t start, std::size_t end) {
+        for (auto c = start; c != end; ++c) {
+            ForEachLine(chunks[c], chunks[c+1], [&](const char *pos, const char *line_end) {
+                int id = 0;
+                while (ParseNext(pos, line_end, id)) { chunk_ids[c].emplace_back(id); }
+                return true;
+            });
+        }
+    });
+
+    // Concatenate the chunks in the order of the file.
+    std::vector<int> ids;
+    std::size_t ids_num = 0;
+    for (const auto &c_ids : chunk_ids) { ids_num += c_ids.size(); }
+    ids.reserve(ids_num);
+    for (const auto &c_ids : chunk_ids) { ids.insert(ids.end(), c_ids.begin(), c_ids.end()); }
+    return ids;
+}
 
 
 } // end of namespace CLOUDEA
@@ -37,8 +37,14 @@
 #include "CLOUDEA/engine/sets/node_set.hpp"
 #include "CLOUDEA/engine/mesh/mesh_properties.hpp"
 
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/mapped_file.hpp"
+
+#include <cstddef>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <memory>
 
 #include <utility>
 #include <cctype>
@@ -64,6 +70,9 @@ namespace CLOUDEA {
  * \class AbaqusIO
  * \brief Class implemmenting input/output functionality for mesh in Abaqus format (.inp).
  *
+ * The mesh file is memory mapped and its keyword lines are indexed in a single pass, without copying the file in memory.
+ * The data lines of the node, element, elset and nset sections are parsed with std::from_chars in parallel chunks
+ * and are written directly in the given mesh containers. Keywords and set names are case insensitive.
  */
 class AbaqusIO{
 public:
@@ -79,10 +88,19 @@ public:
     virtual ~AbaqusIO();
 
 
+    /*!
+     * \brief Set the number of threads used to parse the mesh sections.
+     * \param [in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    void SetThreadsNumber(std::size_t threads_number);
+
+
     /*!
      * \brief Load an abaqus mesh.
      *
-     * The mesh to be loaded should be in abaqus format (.inp).
+     * The mesh to be loaded should be in abaqus format (.inp). The file is memory mapped and only the
+     * keyword lines are indexed. The sections are parsed by the Load*In functions.
      *
      * \param [in] mesh_filename The filename (full path) of the mesh to be loaded.
      * \return [void]
@@ -148,25 +166,55 @@ public:
 
 
 private:
-    std::vector<std::string> input_mesh_;                    /*!< The parsed mesh with an index per line for easy access. */
 
-    //CLOUDEA::MeshType input_mesh_type_;                  /*!< The type of the parsed mesh. */
+    /*!
+     * \brief A keyword section of the mesh file.
+     */
+    struct Section {
+        std::string header_;                 /*!< The lower case keyword line of the section. */
+        std::size_t data_begin_;             /*!< The offset of the section's first data line in the mesh file. */
+        std::size_t data_end_;               /*!< The offset of the next keyword line in the mesh file. */
+
+        Section() : header_(""), data_begin_(0), data_end_(0) {}
+    };
+
+
+    /*!
+     * \brief Parse the integer lists of the data lines of a set section in parallel chunks.
+     * \param [in] section The set section.
+     * \return [std::vector<int>] The integers of the section in the order of the file.
+     */
+    std::vector<int> ParseIdsList(const Section &section) const;
+
+
+    /*!
+     * \brief Get the first character of the mesh file.
+     * \return [const char*] The first character of the mesh file.
+     */
+    inline const char * MeshData() const { return static_cast<const char *>(this->mesh_map_.get()); }
+
+
+    std::shared_ptr<const void> mesh_map_;                   /*!< The memory mapped mesh file. */
+
+    std::size_t mesh_size_;                                  /*!< The size of the mesh file in bytes. */
+
+    std::size_t threads_number_;                             /*!< The number of threads used to parse the mesh sections. */
 
-    int nodes_startline_;                                /*!< The index of the starting line of the nodes set in the mesh file. */
+    Section nodes_section_;                                  /*!< The nodes section of the mesh file. */
 
-    int elems_startline_;                                  /*!< The index of the starting line of the elements set in the mesh file. */
+    Section elems_section_;                                  /*!< The elements section of the mesh file. */
 
-    std::vector<std::pair<int,int> > offsetted_nodes_;       /*!< The indices of the offsetted nodes from the storage order and their offsets. */
+    std::unordered_map<int,int> offsetted_nodes_;            /*!< The indices of the offsetted nodes from the storage order and their offsets. */
 
-    std::vector<std::pair<int,int> > offsetted_elems_;       /*!< The indices of the offsetted elements from the storage order and their offsets. */
+    std::unordered_map<int,int> offsetted_elems_;            /*!< The indices of the offsetted elements from the storage order and their offsets. */
 
     bool partitions_exist;                                   /*!< The conditional of the mesh partitions' existence. */
 
     bool node_sets_exist;                                    /*!< The conditional of the mesh boundaries' existence */
 
-    std::vector<int> parts_startlines_;                      /*!< The indices of the starting line of the partition sets in the mesh filie. */
+    std::vector<Section> parts_sections_;                    /*!< The partition (elset) sections of the mesh file. */
 
-    std::vector<int> node_sets_startlines_;                    /*!< The indices of the starting line of the boundary sets in the mesh filie. */
+    std::vector<Section> node_sets_sections_;                /*!< The boundary node set (nset) sections of the mesh file. */
 };
 
 
@@ -223,6 +223,9 @@ void FebioIO::LoadElementsIn(std::vector<Tetrahedron> &tetras)
         std::string elem_set_name(elem_set->Attribute("elset"));
         std::transform(elem_set_name.begin(), elem_set_name.end(), elem_set_name.begin(), ::tolower);
 
+        // Set partition name with dummy id to the set's elements. Id will be deprecated.
+        tetrahedron.SetPartition(-1, elem_set_name);
+
         // Get the first element's information.
         elem_info = elem_set->FirstChildElement("elem");
 
@@ -248,9 +251,6 @@ void FebioIO::LoadElementsIn(std::vector<Tetrahedron> &tetras)
             // Correct connectivity for c++ storage by paddling 1.
             tetrahedron.SetConnectivity(n1 - 1, n2 - 1, n3 - 1, n4 - 1);
 
-            // Set partition name with dummy id. Id will be deprecated.
-            tetrahedron.SetPartition(-1, elem_set_name);
-
             // Store in the tetrhadra container.
             tetras.emplace_back(tetrahedron);
 
@@ -22,7 +22,8 @@
 
 namespace CLOUDEA {
 
-WeakModel3D::WeakModel3D() : is_mass_scaled_(false), min_mass_scale_factor_(0.), max_mass_scale_factor_(0.)
+WeakModel3D::WeakModel3D() : is_mass_scaled_(false), min_mass_scale_factor_(0.), max_mass_scale_factor_(0.),
+                             mass_scaling_time_step_(0.)
 {}
 
 
@@ -45,9 +46,8 @@ void WeakModel3D::CreateGridRepresentation()
         throw std::runtime_error(error.c_str());
     }
 
-    //Copy mesh nodes to the grid.
-    this->grid_.EditNodes().clear();
-    this->grid_.EditNodes() = this->tetramesh_.Nodes();
+    // Share the mesh nodes with the grid.
+    this->grid_.CopyNodesFromMesh(this->tetramesh_);
 }
 
 
@@ -72,7 +72,22 @@ void WeakModel3D::CreateIntegrationPoints2(short num_per_elem)
 
 
 void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vector<double> &time_steps, const double &max_time_step,
-                              const std::vector< std::vector<int> > &support_nodes_ids, bool scaling)
+                              const NeighborList &support_nodes_ids, bool scaling)
+{
+    this->ComputeMassFrom(density, time_steps, max_time_step, support_nodes_ids, scaling);
+}
+
+
+void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vector<double> &time_steps, const double &max_time_step,
+                              const CompressedNeighborList &support_nodes_ids, bool scaling)
+{
+    this->ComputeMassFrom(density, time_steps, max_time_step, support_nodes_ids, scaling);
+}
+
+
+template <typename NEIGHBORS_T>
+void WeakModel3D::ComputeMassFrom(const std::vector<double> &density, const std::vector<double> &time_steps, const double &max_time_step,
+                                  const NEIGHBORS_T &support_nodes_ids, bool scaling)
 {
     // Check if integration points weights are available.
     if (this->integ_points_.Weights().size() == 0) {
@@ -82,7 +97,7 @@ void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vec
 
     // Check if the given containers are size-consistent.
     if ((density.size() != time_steps.size()) ||
-        (density.size() != support_nodes_ids.size()) ||
+        (density.size() != support_nodes_ids.ListsNum()) ||
         (density.size() != this->integ_points_.Weights().size())) {
         throw std::invalid_argument(Logger::Error("Cannot compute 3d weak model's mass. The given variables "
                                                   "are not consistent in size with the integration points' weights container.").c_str());
@@ -94,6 +109,15 @@ void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vec
         throw std::runtime_error(error.c_str());
     }
 
+    // Check if the nodal integration points coincide with the model's grid nodes.
+    const bool is_nodal = this->integ_points_.IsNodal();
+    if (is_nodal && static_cast<std::size_t>(this->integ_points_.NodalPointsNum()) != this->grid_.Nodes().size()) {
+        throw std::invalid_argument(Logger::Error("Cannot compute 3d weak model's mass. The nodal integration points "
+                                                  "are not consistent in size with the model's grid nodes.").c_str());
+    }
+    const auto nodal_points_num = static_cast<std::size_t>(this->integ_points_.NodalPointsNum());
+    const auto &nodal_volumes = this->integ_points_.NodalVolumes();
+
     // Initialize the distributed mass to the model's grid points.
     this->mass_.clear();
     this->mass_.assign(this->grid_.Nodes().size(), 0.);
@@ -106,6 +130,7 @@ void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vec
 
         // Set mass scaling conditional to true.
         this->is_mass_scaled_ = true;
+        this->mass_scaling_time_step_ = max_time_step;
         std::cout << "[CLOUDEA] Mass scaling: ON\n";
 
         // Initialize mass scaling factor.
@@ -122,14 +147,20 @@ void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vec
 
             // Set the maximum mass scaling factor for information output.
             if (scale_factor > max_scale_factor) { max_scale_factor = scale_factor; }
-            
-            auto num_nodes = support_nodes_ids[i].size();
+
+            // Lump the mass of nodal integration points with the full nodal volume. Stress points carry no mass.
+            if (is_nodal) {
+                if (static_cast<std::size_t>(i) < nodal_points_num) { this->mass_[i] += density[i] * scale_factor * nodal_volumes[i]; }
+                continue;
+            }
+
+            auto num_nodes = support_nodes_ids.ListSize(i);
 
             // Iterate over the support domain nodes of the ith integration point.
-            for (auto &support_id : support_nodes_ids[i]) {
+            support_nodes_ids.ForEach(i, [&](std::size_t, int support_id) {
                 // Compute mass with scaling.
                 this->mass_[support_id] += density[i] * scale_factor * weight / num_nodes;
-            }
+            });
         } // End iteration over model's integration points.
 
         // Output the maximum mass scaling factor.
@@ -143,14 +174,20 @@ void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vec
         for (auto &weight : this->integ_points_.Weights()) {
             // Get the ith integration point index.
             auto i = &weight - &this->integ_points_.Weights()[0];
+
+            // Lump the mass of nodal integration points with the full nodal volume. Stress points carry no mass.
+            if (is_nodal) {
+                if (static_cast<std::size_t>(i) < nodal_points_num) { this->mass_[i] += density[i] * nodal_volumes[i]; }
+                continue;
+            }
             
-            auto num_nodes = support_nodes_ids[i].size();
+            auto num_nodes = support_nodes_ids.ListSize(i);
 
             // Iterate over the support domain nodes of the ith integration point.
-            for (auto &support_id : support_nodes_ids[i]) {
+            support_nodes_ids.ForEach(i, [&](std::size_t, int support_id) {
                 // Compute mass with no scaling.
                 this->mass_[support_id] += density[i] * weight / num_nodes;
-            }
+            });
         } // End iteration over model's integration points.
 
     }
@@ -166,4 +203,95 @@ void WeakModel3D::ComputeMass(const std::vector<double> &density, const std::vec
 }
 
 
+void WeakModel3D::UpdateMass(const std::vector<double> &density, const std::vector<double> &prev_density,
+                             const std::vector<double> &prev_weights, const std::vector<double> &prev_time_steps,
+                             const NeighborList &prev_support_nodes_ids, const std::vector<double> &time_steps,
+                             const double &max_time_step, const NeighborList &support_nodes_ids,
+                             const std::vector<int> &updated_ids)
+{
+    // Check if the mass has been already computed.
+    if (this->mass_.size() == 0) {
+        throw std::runtime_error(Logger::Error("Cannot update 3d weak model's mass. Compute the mass first.").c_str());
+    }
+
+    // Check if the given containers are size-consistent.
+    if ((prev_density.size() != updated_ids.size()) ||
+        (prev_weights.size() != updated_ids.size()) ||
+        (prev_time_steps.size() != updated_ids.size()) ||
+        (prev_support_nodes_ids.ListsNum() != updated_ids.size()) ||
+        (density.size() != time_steps.size()) ||
+        (density.size() != support_nodes_ids.ListsNum()) ||
+        (density.size() != this->integ_points_.Weights().size())) {
+        throw std::invalid_argument(Logger::Error("Cannot update 3d weak model's mass. The given variables "
+                                                  "are not consistent in size.").c_str());
+    }
+
+    // Recompute from scratch if the scaling reference time step has changed or for the lumped mass of nodal integration.
+    if ((this->is_mass_scaled_ && max_time_step != this->mass_scaling_time_step_) || this->integ_points_.IsNodal()) {
+        this->ComputeMass(density, time_steps, max_time_step, support_nodes_ids, this->is_mass_scaled_);
+        return;
+    }
+
+    // Check the indices of the updated integration points and of their previous support nodes.
+    for (const auto &i : updated_ids) {
+        auto id = &i - &updated_ids[0];
+        if (i < 0 || static_cast<std::size_t>(i) >= density.size()) {
+            throw std::out_of_range(Logger::Error("Cannot update 3d weak model's mass. Updated integration point index is out of range.").c_str());
+        }
+        for (const auto &support_id : prev_support_nodes_ids[id]) {
+            if (support_id < 0 || static_cast<std::size_t>(support_id) >= this->mass_.size()) {
+                throw std::out_of_range(Logger::Error("Cannot update 3d weak model's mass. Previous support node index is out of range.").c_str());
+            }
+        }
+    }
+
+    // Extend the distributed mass for appended grid nodes.
+    std::size_t prev_nodes_num = this->mass_.size();
+    this->mass_.resize(this->grid_.Nodes().size(), 0.);
+
+    // Iterate over the updated integration points.
+    for (const auto &i : updated_ids) {
+        // Get the index of the ith integration point in the updated container.
+        auto id = &i - &updated_ids[0];
+
+        // The integration point's weight.
+        const auto &weight = this->integ_points_.Weights()[i];
+
+        // Set scaling factors to (maximum time step/integration point's time step)^2.
+        double prev_scale_factor = 1.; double scale_factor = 1.;
+        if (this->is_mass_scaled_) {
+            if (!prev_support_nodes_ids[id].empty()) {
+                prev_scale_factor = (max_time_step / prev_time_steps[id]) * (max_time_step / prev_time_steps[id]);
+            }
+            scale_factor = (max_time_step / time_steps[i]) * (max_time_step / time_steps[i]);
+            if (scale_factor > this->max_mass_scale_factor_) { this->max_mass_scale_factor_ = scale_factor; }
+        }
+
+        // Remove the previous contribution of the integration point.
+        auto prev_num_nodes = prev_support_nodes_ids[id].size();
+        for (const auto &support_id : prev_support_nodes_ids[id]) {
+            this->mass_[support_id] -= prev_density[id] * prev_scale_factor * prev_weights[id] / prev_num_nodes;
+        }
+
+        // Add the current contribution of the integration point.
+        auto num_nodes = support_nodes_ids[i].size();
+        for (const auto &support_id : support_nodes_ids[i]) {
+            this->mass_[support_id] += density[i] * scale_factor * weight / num_nodes;
+        }
+    }
+
+    // Regenerate the distributed mass 3d matrix representation.
+    if (prev_nodes_num != this->mass_.size()) {
+        this->mass_matrix_.conservativeResize(static_cast<Eigen::Index>(this->mass_.size()), 3);
+    }
+    for (auto &mass : this->mass_) {
+        auto id = &mass - &this->mass_[0];
+        this->mass_matrix_.coeffRef(id, 0) = mass;
+        this->mass_matrix_.coeffRef(id, 1) = mass;
+        this->mass_matrix_.coeffRef(id, 2) = mass;
+    }
+
+}
+
+
 } //end of namespace CLOUDEA
@@ -32,6 +32,7 @@
 #include "CLOUDEA/engine/integration/integ_options.hpp"
 #include "CLOUDEA/engine/integration/integ_points.hpp"
 #include "CLOUDEA/engine/support_domain/inf_support_domain.hpp"
+#include "CLOUDEA/engine/support_domain/compressed_neighbor_list.hpp"
 #include "CLOUDEA/engine/utilities/logger.hpp"
 #include "CLOUDEA/engine/grid/grid_3d.hpp"
 #include "CLOUDEA/engine/mesh/mesh_properties.hpp"
@@ -118,7 +119,47 @@ public:
      * \param [in] scaling The conditional determining if mass scaling will be applied. [Default: No scaling].
      */
     void ComputeMass(const std::vector<double> &density, const std::vector<double> &time_steps, const double &max_time_step,
-                     const std::vector<std::vector<int> > &support_nodes_ids, bool scaling=false);
+                     const NeighborList &support_nodes_ids, bool scaling=false);
+
+
+    /*!
+     * \brief Compute the distributed mass on the model's grid points decoding compressed support domain nodes on the fly.
+     * \param [in] density The density values associated to the model's grid points.
+     * \param [in] time_steps The time steps associated to the model's integration points.
+     * \param [in] support_nodes_ids The compressed indices of the nodes belonging in the support domain of its evaluation node.
+     * \param [in] scaling The conditional determining if mass scaling will be applied. [Default: No scaling].
+     */
+    void ComputeMass(const std::vector<double> &density, const std::vector<double> &time_steps, const double &max_time_step,
+                     const CompressedNeighborList &support_nodes_ids, bool scaling=false);
+
+
+    /*!
+     * \brief Update the distributed mass on the model's grid points only for the given integration points.
+     *
+     * The contribution of each updated integration point with its previous density, weight, time step and support domain
+     * is removed and the contribution with its current values is added. The mass scaling mode of the last ComputeMass call
+     * is retained. If the maximum time step of a scaled mass has changed, the mass is computed from scratch.
+     *
+     * Integration points appended after the last mass computation must be included in the updated points with an empty
+     * previous support domain. Every integration point whose weight has changed (e.g. the points of elements with moved
+     * nodes) must be included in the updated points. Removal of integration points requires a full mass computation.
+     *
+     * \param [in] density The density values associated to the model's integration points.
+     * \param [in] prev_density The previous density values of the updated integration points in the order of updated_ids.
+     * \param [in] prev_weights The previous weights of the updated integration points in the order of updated_ids.
+     * \param [in] prev_time_steps The previous time steps of the updated integration points in the order of updated_ids.
+     * \param [in] prev_support_nodes_ids The previous support domain nodes of the updated integration points in the order of updated_ids.
+     * \param [in] time_steps The time steps associated to the model's integration points.
+     * \param [in] max_time_step The maximum time step of the model's integration points.
+     * \param [in] support_nodes_ids The indices of the nodes belonging in the support domain of its evaluation node.
+     * \param [in] updated_ids The indices of the updated integration points.
+     * \return [void]
+     */
+    void UpdateMass(const std::vector<double> &density, const std::vector<double> &prev_density,
+                    const std::vector<double> &prev_weights, const std::vector<double> &prev_time_steps,
+                    const NeighborList &prev_support_nodes_ids, const std::vector<double> &time_steps,
+                    const double &max_time_step, const NeighborList &support_nodes_ids,
+                    const std::vector<int> &updated_ids);
 
 
     /*!
@@ -190,6 +231,20 @@ public:
     inline const double & MaxMassScaleFactor() const { return this->max_mass_scale_factor_; }
 
 
+protected:
+
+    /*!
+     * \brief Compute the distributed mass on the model's grid points for any neighbor list storage.
+     * \param [in] density The density values associated to the model's grid points.
+     * \param [in] time_steps The time steps associated to the model's integration points.
+     * \param [in] support_nodes_ids The indices of the nodes belonging in the support domain of its evaluation node. NeighborList or CompressedNeighborList.
+     * \param [in] scaling The conditional determining if mass scaling will be applied.
+     */
+    template <typename NEIGHBORS_T>
+    void ComputeMassFrom(const std::vector<double> &density, const std::vector<double> &time_steps, const double &max_time_step,
+                         const NEIGHBORS_T &support_nodes_ids, bool scaling);
+
+
 
 private:
     TetraMesh tetramesh_;             /*!< The tetrahedral mesh representation of the model. */
@@ -208,6 +263,8 @@ private:
 
     double max_mass_scale_factor_;         /*!< The maximum mass scaling factor. */
 
+    double mass_scaling_time_step_;        /*!< The maximum time step used for the mass scaling. */
+
 };
 
 
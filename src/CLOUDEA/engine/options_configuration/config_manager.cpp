@@ -43,6 +43,10 @@ ConfigManager::ConfigManager()
              "Number of tetrahedron division. Used in adaptive integration.")
             ("IntegrationOptions.IntegPointsPerTetrahedron", boost_po::value<int>()->default_value(4),
              "Number of integration points per tetrahedron. Used in standard integration.")
+            ("IntegrationOptions.Nodal", boost_po::value<bool>()->default_value(false),
+             "Stabilized nodal integration option.")
+            ("IntegrationOptions.StressPointsFraction", boost_po::value<double>()->default_value(0.25),
+             "Fraction of the tetrahedra volume assigned to stress points. Used in nodal integration.")
 
             ("Material.Type", boost_po::value<std::string>()->default_value("neohookean"),
              "Type of the model's material.")
@@ -52,6 +56,12 @@ ConfigManager::ConfigManager()
              "Value of the material's Young modulus.")
             ("Material.PoissonRatio", boost_po::value<double>()->default_value(0.49),
              "Value of the material's Poisson's ratio.")
+            ("Material.OgdenMu", boost_po::value<double>()->default_value(643.6),
+             "Value of the Ogden material's shear parameter mu. Used for ogden material.")
+            ("Material.OgdenAlpha", boost_po::value<double>()->default_value(-1.1),
+             "Value of the Ogden material's exponent alpha. Used for ogden material.")
+            ("Material.OgdenD1", boost_po::value<double>()->default_value(0.00012598),
+             "Value of the Ogden material's compressibility parameter D1. Used for ogden material.")
 
             ("ShapeFunction.Type", boost_po::value<std::string>()->default_value("mmls"),
              "Type of the used shape function.")
@@ -75,6 +85,14 @@ ConfigManager::ConfigManager()
              "Triplet to set loading application on the x, y, z axes. Values: [1 | 0]")
             ("Loading.MaxDisplacement", boost_po::value<double>(),
              "Maximum displacement to applied due to the loading. Measure unit: [m]")
+            ("Loading.CurveShape", boost_po::value<std::string>()->default_value("smoothstep"),
+             "Shape of the load curve. Values: [smoothstep | linear | tabulated | sinusoidal]")
+            ("Loading.CurveFrequency", boost_po::value<double>()->default_value(0.),
+             "Frequency of the sinusoidal load curve. If zero, the quarter period equals to the load time. Measure unit: [Hz]")
+            ("Loading.CurveTimes", boost_po::value<std::string>(),
+             "Times of the tabulated load curve in increasing order. Measure unit: [s]")
+            ("Loading.CurveAmplitudes", boost_po::value<std::string>(),
+             "Amplitudes of the tabulated load curve scaled by the maximum displacement. Measure unit: [none]")
 
             ("EBCIEM.UseEBCIEM", boost_po::value<bool>()->default_value(false),
              "Use EBCIEM method for imposition of essential boundary conditions.")
@@ -207,13 +225,20 @@ std::string ConfigManager::PrintSampleFile()
             "\n"
             "IntegPointsPerTetrahedron = 4                           # Number of integration points per tetrahedron. Used in\n"
             "                                                        # standard integration. Values: [1] [4] [5]\n"
+            "\n"
+            "Nodal = false                                           # Perform stabilized nodal integration on the\n"
+            "                                                        # mesh nodes. Values: [true | 1]  [false | 0]\n"
+            "\n"
+            "StressPointsFraction = 0.25                             # Fraction of the tetrahedra volume assigned to stress\n"
+            "                                                        # points at their centroids. Used in nodal integration.\n"
+            "                                                        # Values: [0, 1). Zero disables the stress points.\n"
             "\n\n"
             "[Material]                                              # Section: Material\n"
             "                                                        # -----------------\n"
             "\n"
             "Type = neohookean                                       # Type of the model's material. Currently\n"
             "                                                        # only homogeneous models with material of\n"
-            "                                                        # type [neohookean] are supported.\n"
+            "                                                        # type [neohookean] [ogden] are supported.\n"
             "\n"
             "Density = 1000                                          # Value of the material's density.\n"
             "                                                        # Measure unit: [kg/m3]\n"
@@ -223,6 +248,15 @@ std::string ConfigManager::PrintSampleFile()
             "\n"
             "PoissonRatio = 0.49                                     # Value of the material's Poisson's ratio.\n"
             "                                                        # Measure unit: [none]\n"
+            "\n"
+            "OgdenMu = 643.6                                         # Value of the Ogden shear parameter mu.\n"
+            "                                                        # Used for ogden material. Measure unit: [Pa]\n"
+            "\n"
+            "OgdenAlpha = -1.1                                       # Value of the Ogden exponent alpha.\n"
+            "                                                        # Used for ogden material. Measure unit: [none]\n"
+            "\n"
+            "OgdenD1 = 0.00012598                                    # Value of the Ogden compressibility parameter D1.\n"
+            "                                                        # Used for ogden material. Measure unit: [1/Pa]\n"
             "\n\n"
             "[ShapeFunction]                                         # Section: Shape Function\n"
             "                                                        # ------------------------\n"
@@ -263,6 +297,19 @@ std::string ConfigManager::PrintSampleFile()
             "MaxDisplacement = -0.02                                 # Maximum displacement to applied due to the loading.\n"
             "                                                        # Measure unit: [m]\n"
             "                                                        # Positive sign -> extension | Negative sign -> compression.\n"
+            "\n"
+            "CurveShape = smoothstep                                 # Shape of the load curve.\n"
+            "                                                        # Values: [smoothstep | linear | tabulated | sinusoidal]\n"
+            "\n"
+            "CurveFrequency = 0                                      # Frequency of the sinusoidal load curve.\n"
+            "                                                        # If zero, the quarter period equals to the load time.\n"
+            "                                                        # Measure unit: [Hz]\n"
+            "\n"
+            "CurveTimes = 0 0.5 1.0                                  # Times of the tabulated load curve in increasing order.\n"
+            "                                                        # Measure unit: [s]\n"
+            "\n"
+            "CurveAmplitudes = 0 0.8 1.0                             # Amplitudes of the tabulated load curve scaled by the\n"
+            "                                                        # maximum displacement. Expects one value per time.\n"
             "\n\n"
             "[EBCIEM]                                                # Section: EBCIEM method\n"
             "                                                        # ----------------------\n"
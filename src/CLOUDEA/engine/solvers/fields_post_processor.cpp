@@ -0,0 +1,86 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/solvers/fields_post_processor.hpp"
+
+
+namespace CLOUDEA {
+
+
+FieldsPostProcessor::FieldsPostProcessor()
+{}
+
+
+FieldsPostProcessor::~FieldsPostProcessor()
+{}
+
+
+void FieldsPostProcessor::Clear()
+{
+    this->point_strains_.clear();
+    this->point_stresses_.clear();
+    this->point_von_mises_.clear();
+    this->point_strain_energy_.clear();
+    this->nodal_strains_.clear();
+    this->nodal_stresses_.clear();
+    this->nodal_von_mises_.clear();
+    this->nodal_strain_energy_.clear();
+}
+
+
+void FieldsPostProcessor::AverageNodalFieldsThreadCallback(std::size_t thread_id, const NeighborList &node_points,
+                                                           const std::vector<double> &weights)
+{
+    for (auto node_id = this->thread_loop_manager_.LoopStartId(thread_id);
+              node_id < this->thread_loop_manager_.LoopEndId(thread_id); ++node_id) {
+
+        // Total absolute weight of the integration points whose support domain contains the node.
+        // Absolute weights keep the average convex for quadrature rules with negative weights.
+        double weight_sum = 0.;
+        for (const auto &ipoint_id : node_points[node_id]) { weight_sum += std::abs(weights[ipoint_id]); }
+
+        // Nodes outside the support domains keep zero fields.
+        if (weight_sum == 0.) { continue; }
+
+        for (std::size_t s = 0; s != this->point_strains_.size(); ++s) {
+            for (const auto &ipoint_id : node_points[node_id]) {
+                const double factor = std::abs(weights[ipoint_id]) / weight_sum;
+                this->nodal_strains_[s].row(node_id) += factor * this->point_strains_[s].row(ipoint_id);
+                this->nodal_stresses_[s].row(node_id) += factor * this->point_stresses_[s].row(ipoint_id);
+                this->nodal_von_mises_[s](node_id) += factor * this->point_von_mises_[s](ipoint_id);
+                this->nodal_strain_energy_[s](node_id) += factor * this->point_strain_energy_[s](ipoint_id);
+            }
+        }
+    }
+}
+
+
+void FieldsPostProcessor::RunThreads(const std::function<void(std::size_t)> &callback) const
+{
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != this->thread_loop_manager_.LoopsNum(); ++t) {
+        threads.emplace_back(std::thread(callback, t));
+    }
+    // Join threads.
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+}
+
+
+} //end of namespace CLOUDEA
@@ -0,0 +1,248 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_SOLVERS_FIELDS_POST_PROCESSOR_HPP_
+#define CLOUDEA_SOLVERS_FIELDS_POST_PROCESSOR_HPP_
+
+/*!
+   \file fields_post_processor.hpp
+   \brief FieldsPostProcessor class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+
+#include "CLOUDEA/engine/models/weak_model_3d.hpp"
+#include "CLOUDEA/engine/solvers/mtled.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/thread_loop_manager.hpp"
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include <stdexcept>
+#include <exception>
+
+#include <thread>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Solvers
+ *  @{
+ */
+
+
+/*!
+ * \class FieldsPostProcessor
+ * \brief Class implemmenting the parallel post-processing of the strain, stress and strain energy fields of the MTLED solution.
+ *
+ * The fields of all the saved snapshots of the solution are computed in a single pass over the integration points,
+ * reusing the derivatives matrices packed by the Mtled solver and its number of threads. The integration point fields
+ * are averaged on the nodes with the absolute integration weights of the integration points whose support domain contains
+ * the node, so that the negative weights of some quadrature rules do not bias the average.
+ *
+ * The tensor fields are stored as [n x 6] matrices in Voigt order (xx, yy, zz, xy, yz, xz).
+ */
+
+class FieldsPostProcessor {
+public:
+
+    /*!
+     * \brief FieldsPostProcessor constructor.
+     */
+    FieldsPostProcessor();
+
+
+    /*!
+     * \brief FieldsPostProcessor destructor.
+     */
+    virtual ~FieldsPostProcessor();
+
+
+    /*!
+     * \brief Compute the integration point and nodal fields of the saved snapshots of the MTLED solution.
+     * \param [in] mtled The Mtled solver after the solution. Its packed derivatives, saved displacements and number of threads are used.
+     * \param [in] weak_model_3d The 3D weak model of the solution.
+     * \param [in] neighbor_ids The indices of the support nodes of the integration points.
+     * \param [in] material The material policy of the solution (e.g. NeoHookean, Ogden).
+     * \return [void]
+     */
+    template <class MATERIAL_T>
+    void Compute(const Mtled &mtled, const WeakModel3D &weak_model_3d, const NeighborList &neighbor_ids, const MATERIAL_T &material);
+
+
+    /*!
+     * \brief Clear the computed fields.
+     * \return [void]
+     */
+    void Clear();
+
+
+    /*!
+     * \brief Compute the von Mises equivalent stress of a stress tensor.
+     * \param [in] stress The stress tensor in Voigt order (xx, yy, zz, xy, yz, xz).
+     * \return [double] The von Mises equivalent stress.
+     */
+    inline static double VonMises(const Eigen::Matrix<double, 1, 6> &stress) {
+        return std::sqrt(0.5*((stress(0)-stress(1))*(stress(0)-stress(1)) + (stress(1)-stress(2))*(stress(1)-stress(2)) +
+                              (stress(2)-stress(0))*(stress(2)-stress(0))) +
+                         3.*(stress(3)*stress(3) + stress(4)*stress(4) + stress(5)*stress(5)));
+    }
+
+
+    /*!
+     * \brief Get the number of the post-processed snapshots.
+     * \return [std::size_t] The number of the post-processed snapshots.
+     */
+    inline std::size_t SnapshotsNum() const { return this->point_strains_.size(); }
+
+
+    /*!
+     * \brief Get the Green-Lagrange strain at the integration points of each snapshot.
+     * \return [std::vector<Eigen::MatrixXd>] The [integration points x 6] Green-Lagrange strain of each snapshot.
+     */
+    inline const std::vector<Eigen::MatrixXd> & PointStrains() const { return this->point_strains_; }
+
+
+    /*!
+     * \brief Get the Cauchy stress at the integration points of each snapshot.
+     * \return [std::vector<Eigen::MatrixXd>] The [integration points x 6] Cauchy stress of each snapshot.
+     */
+    inline const std::vector<Eigen::MatrixXd> & PointStresses() const { return this->point_stresses_; }
+
+
+    /*!
+     * \brief Get the von Mises stress at the integration points of each snapshot.
+     * \return [std::vector<Eigen::VectorXd>] The von Mises stress of each snapshot.
+     */
+    inline const std::vector<Eigen::VectorXd> & PointVonMises() const { return this->point_von_mises_; }
+
+
+    /*!
+     * \brief Get the strain energy density at the integration points of each snapshot.
+     * \return [std::vector<Eigen::VectorXd>] The strain energy density of each snapshot.
+     */
+    inline const std::vector<Eigen::VectorXd> & PointStrainEnergy() const { return this->point_strain_energy_; }
+
+
+    /*!
+     * \brief Get the nodal averaged Green-Lagrange strain of each snapshot.
+     * \return [std::vector<Eigen::MatrixXd>] The [nodes x 6] Green-Lagrange strain of each snapshot.
+     */
+    inline const std::vector<Eigen::MatrixXd> & NodalStrains() const { return this->nodal_strains_; }
+
+
+    /*!
+     * \brief Get the nodal averaged Cauchy stress of each snapshot.
+     * \return [std::vector<Eigen::MatrixXd>] The [nodes x 6] Cauchy stress of each snapshot.
+     */
+    inline const std::vector<Eigen::MatrixXd> & NodalStresses() const { return this->nodal_stresses_; }
+
+
+    /*!
+     * \brief Get the nodal averaged von Mises stress of each snapshot.
+     * \return [std::vector<Eigen::VectorXd>] The von Mises stress of each snapshot.
+     */
+    inline const std::vector<Eigen::VectorXd> & NodalVonMises() const { return this->nodal_von_mises_; }
+
+
+    /*!
+     * \brief Get the nodal averaged strain energy density of each snapshot.
+     * \return [std::vector<Eigen::VectorXd>] The strain energy density of each snapshot.
+     */
+    inline const std::vector<Eigen::VectorXd> & NodalStrainEnergy() const { return this->nodal_strain_energy_; }
+
+
+protected:
+
+    /*!
+     * \brief Compute the fields at the integration points of a thread's loop range for all the snapshots.
+     * \param [in] thread_id The index of the thread.
+     * \param [in] deriv_mats The packed derivatives matrices of the integration points.
+     * \param [in] neighbor_ids The indices of the support nodes of the integration points.
+     * \param [in] material The material policy of the solution.
+     * \param [in] saved_disps The displacements of the snapshots.
+     * \return [void]
+     */
+    template <class MATERIAL_T, typename DERIV_T>
+    void ComputePointFieldsThreadCallback(std::size_t thread_id,
+                                          const std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats,
+                                          const NeighborList &neighbor_ids, const MATERIAL_T &material,
+                                          const std::vector<Eigen::MatrixXd> &saved_disps);
+
+
+    /*!
+     * \brief Average the integration point fields on the nodes of a thread's loop range for all the snapshots.
+     * \param [in] thread_id The index of the thread.
+     * \param [in] node_points The indices of the integration points whose support domain contains each node.
+     * \param [in] weights The weights of the integration points. Their absolute values are used as averaging weights.
+     * \return [void]
+     */
+    void AverageNodalFieldsThreadCallback(std::size_t thread_id, const NeighborList &node_points, const std::vector<double> &weights);
+
+
+    /*!
+     * \brief Run a callback on the loop ranges of the threads and join the threads.
+     * \param [in] callback The callback called with the index of the thread.
+     * \return [void]
+     */
+    void RunThreads(const std::function<void(std::size_t)> &callback) const;
+
+
+private:
+
+    std::vector<Eigen::MatrixXd> point_strains_;            /*!< The Green-Lagrange strain at the integration points of each snapshot. */
+
+    std::vector<Eigen::MatrixXd> point_stresses_;           /*!< The Cauchy stress at the integration points of each snapshot. */
+
+    std::vector<Eigen::VectorXd> point_von_mises_;          /*!< The von Mises stress at the integration points of each snapshot. */
+
+    std::vector<Eigen::VectorXd> point_strain_energy_;      /*!< The strain energy density at the integration points of each snapshot. */
+
+    std::vector<Eigen::MatrixXd> nodal_strains_;            /*!< The nodal averaged Green-Lagrange strain of each snapshot. */
+
+    std::vector<Eigen::MatrixXd> nodal_stresses_;           /*!< The nodal averaged Cauchy stress of each snapshot. */
+
+    std::vector<Eigen::VectorXd> nodal_von_mises_;          /*!< The nodal averaged von Mises stress of each snapshot. */
+
+    std::vector<Eigen::VectorXd> nodal_strain_energy_;      /*!< The nodal averaged strain energy density of each snapshot. */
+
+    ThreadLoopManager thread_loop_manager_;                 /*!< The manager of the threads' loop ranges. */
+
+};
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+
+#include "CLOUDEA/engine/solvers/fields_post_processor.tpp"
+
+#endif //CLOUDEA_SOLVERS_FIELDS_POST_PROCESSOR_HPP_
@@ -0,0 +1,168 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_SOLVERS_FIELDS_POST_PROCESSOR_TPP_
+#define CLOUDEA_SOLVERS_FIELDS_POST_PROCESSOR_TPP_
+
+#include "CLOUDEA/engine/solvers/fields_post_processor.hpp"
+
+namespace CLOUDEA {
+
+
+template <class MATERIAL_T>
+void FieldsPostProcessor::Compute(const Mtled &mtled, const WeakModel3D &weak_model_3d, const NeighborList &neighbor_ids,
+                                  const MATERIAL_T &material)
+{
+    const auto &saved_disps = mtled.SavedDisplacements();
+    auto points_num = static_cast<std::size_t>(weak_model_3d.IntegrationPoints().PointsNum());
+    auto nodes_num = static_cast<std::size_t>(weak_model_3d.Grid().NodesNum());
+
+    // Check if the solution has been computed for the given integration points.
+    if (saved_disps.empty()) {
+        std::string error = "[CLOUDEA ERROR] Could not post-process the MTLED solution. No snapshots have been saved.";
+        throw std::runtime_error(error.c_str());
+    }
+    if (neighbor_ids.ListsNum() != points_num ||
+            (mtled.PackedDerivatives().size() != points_num && mtled.PackedDerivativesSingle().size() != points_num)) {
+        std::string error = "[CLOUDEA ERROR] Could not post-process the MTLED solution. The packed derivatives or the neighbor "
+                            "indices do not correspond to the integration points of the model.";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Allocate the fields of the snapshots.
+    this->Clear();
+    auto snapshots_num = saved_disps.size();
+    this->point_strains_.assign(snapshots_num, Eigen::MatrixXd::Zero(points_num, 6));
+    this->point_stresses_.assign(snapshots_num, Eigen::MatrixXd::Zero(points_num, 6));
+    this->point_von_mises_.assign(snapshots_num, Eigen::VectorXd::Zero(points_num));
+    this->point_strain_energy_.assign(snapshots_num, Eigen::VectorXd::Zero(points_num));
+    this->nodal_strains_.assign(snapshots_num, Eigen::MatrixXd::Zero(nodes_num, 6));
+    this->nodal_stresses_.assign(snapshots_num, Eigen::MatrixXd::Zero(nodes_num, 6));
+    this->nodal_von_mises_.assign(snapshots_num, Eigen::VectorXd::Zero(nodes_num));
+    this->nodal_strain_energy_.assign(snapshots_num, Eigen::VectorXd::Zero(nodes_num));
+
+    // Compute the integration point fields of all the snapshots in the packed derivatives precision.
+    Eigen::initParallel();
+    this->thread_loop_manager_.SetLoopRanges(points_num, mtled.ThreadsNumber());
+    if (mtled.PackedDerivatives().size() == points_num) {
+        this->RunThreads([&](std::size_t t) {
+            this->ComputePointFieldsThreadCallback(t, mtled.PackedDerivatives(), neighbor_ids, material, saved_disps);
+        });
+    }
+    else {
+        this->RunThreads([&](std::size_t t) {
+            this->ComputePointFieldsThreadCallback(t, mtled.PackedDerivativesSingle(), neighbor_ids, material, saved_disps);
+        });
+    }
+
+    // Average the integration point fields on the nodes.
+    const auto node_points = neighbor_ids.Transposed(nodes_num);
+    const auto &weights = weak_model_3d.IntegrationPoints().Weights();
+    this->thread_loop_manager_.SetLoopRanges(nodes_num, mtled.ThreadsNumber());
+    this->RunThreads([&](std::size_t t) { this->AverageNodalFieldsThreadCallback(t, node_points, weights); });
+}
+
+
+template <class MATERIAL_T, typename DERIV_T>
+void FieldsPostProcessor::ComputePointFieldsThreadCallback(std::size_t thread_id,
+                                                           const std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats,
+                                                           const NeighborList &neighbor_ids, const MATERIAL_T &material,
+                                                           const std::vector<Eigen::MatrixXd> &saved_disps)
+{
+    // Symmetric tensor in Voigt order.
+    auto to_voigt = [](const Eigen::Matrix3d &tensor) {
+        Eigen::Matrix<double, 1, 6> voigt;
+        voigt << tensor(0,0), tensor(1,1), tensor(2,2), tensor(0,1), tensor(1,2), tensor(0,2);
+        return voigt;
+    };
+
+    // Deformation gradients and 2nd Piola-Kirchhoff stress tensors of a batch of integration points.
+    const std::size_t batch_size = 32;
+    std::array<Eigen::Matrix3d, batch_size> FT, spk_stress;
+
+    // The derivatives of a batch of integration points in double precision. Single precision
+    // derivatives are converted once for all the snapshots, double precision derivatives are used in place.
+    std::array<Eigen::MatrixXd, batch_size> derivs_converted;
+    std::array<const Eigen::MatrixXd *, batch_size> derivs;
+    Eigen::MatrixXd disp_local;
+
+    // Iterate over batches of integration points.
+    const auto loop_start = this->thread_loop_manager_.LoopStartId(thread_id);
+    const auto loop_end = this->thread_loop_manager_.LoopEndId(thread_id);
+    for (auto batch_start = loop_start; batch_start < loop_end; batch_start += batch_size) {
+        const std::size_t batch_points = std::min(batch_size, static_cast<std::size_t>(loop_end - batch_start));
+
+        for (std::size_t b = 0; b != batch_points; ++b) {
+            if constexpr (std::is_same<DERIV_T, double>::value) {
+                derivs[b] = &deriv_mats[batch_start + b];
+            }
+            else {
+                derivs_converted[b] = deriv_mats[batch_start + b].template cast<double>();
+                derivs[b] = &derivs_converted[b];
+            }
+        }
+
+        for (std::size_t s = 0; s != saved_disps.size(); ++s) {
+
+            // Compute the transposed deformation gradients of the batch.
+            for (std::size_t b = 0; b != batch_points; ++b) {
+                const auto ipoint_id = batch_start + b;
+
+                // Local displacements at integration point's support domain.
+                disp_local.resize(static_cast<Eigen::Index>(neighbor_ids.ListSize(ipoint_id)), 3);
+                neighbor_ids.ForEach(ipoint_id, [&](std::size_t id, int neigh_id) {
+                    disp_local.row(id) = saved_disps[s].row(neigh_id);
+                });
+
+                FT[b].noalias() = derivs[b]->transpose() * disp_local;
+                FT[b].diagonal().array() += 1.;
+            }
+
+            // Compute the 2nd Piola-Kirchhoff stress tensors of the batch.
+            material.SpkStresses(FT.data(), batch_points, static_cast<std::size_t>(batch_start), spk_stress.data());
+
+            for (std::size_t b = 0; b != batch_points; ++b) {
+                const auto ipoint_id = batch_start + b;
+
+                // Green-Lagrange strain.
+                Eigen::Matrix3d strain;
+                strain.noalias() = 0.5 * FT[b] * FT[b].transpose();
+                strain.diagonal().array() -= 0.5;
+
+                // Cauchy stress from the 2nd Piola-Kirchhoff stress.
+                Eigen::Matrix3d stress;
+                stress.noalias() = FT[b].transpose() * spk_stress[b] * FT[b] / std::abs(FT[b].determinant());
+
+                const auto stress_voigt = to_voigt(stress);
+                this->point_strains_[s].row(ipoint_id) = to_voigt(strain);
+                this->point_stresses_[s].row(ipoint_id) = stress_voigt;
+                this->point_von_mises_[s](ipoint_id) = VonMises(stress_voigt);
+                this->point_strain_energy_[s](ipoint_id) = material.StrainEnergy(FT[b], static_cast<int>(ipoint_id));
+            }
+        }
+    }
+}
+
+
+}  // End of namespace CLOUDEA
+
+
+
+#endif //CLOUDEA_SOLVERS_FIELDS_POST_PROCESSOR_TPP_
@@ -23,7 +23,9 @@
 
 namespace CLOUDEA {
 
-Mtled::Mtled() : min_step_(0.), max_step_(0.), stable_step_(0.), total_time_steps_num(0), save_progress_steps_(1)
+Mtled::Mtled() : min_step_(0.), max_step_(0.), stable_step_(0.), total_time_steps_num(0), save_progress_steps_(1),
+                 derivs_precision_(StoragePrecision::double_precision), fields_precision_(StoragePrecision::double_precision),
+                 compress_neighbors_(false), compressed_ids_(), operators_updated_(false)
 {
     // Get the number of parallel threads.
     const std::size_t available_threads = std::thread::hardware_concurrency();
@@ -36,11 +38,11 @@ Mtled::~Mtled()
 
 
 void Mtled::ComputeTimeSteps(const std::vector<double> &wave_speed,
-                             const std::vector< std::vector<int> > &neighbors_ids,
+                             const NeighborList &neighbors_ids,
                              const Mmls3d &model_approximant)
 {
     // Check that size of containers is consistent.
-    if ( (wave_speed.size() != neighbors_ids.size()) ||
+    if ( (wave_speed.size() != neighbors_ids.ListsNum()) ||
          (static_cast<int>(wave_speed.size()) != model_approximant.ShapeFunctionDx().cols()) ||
          (static_cast<int>(wave_speed.size()) != model_approximant.ShapeFunctionDy().cols()) ||
          (static_cast<int>(wave_speed.size()) != model_approximant.ShapeFunctionDz().cols()) ) {
@@ -53,54 +55,104 @@ void Mtled::ComputeTimeSteps(const std::vector<double> &wave_speed,
     this->time_steps_.clear();
 
     // Compute time step for each evaluation point.
-    double step = 0.;
+    this->time_steps_.reserve(wave_speed.size());
     for (auto &point_speed : wave_speed) {
 
         // The index of the ith evaluation point.
         auto i = &point_speed - &wave_speed[0];
 
-        // Gather x, y, z derivatives in single matrix.
-        Eigen::MatrixXd derivs_mat(neighbors_ids[i].size(), 3);
+        // Store the time step for the ith evaluation point.
+        this->time_steps_.emplace_back(this->PointTimeStep(point_speed, i, neighbors_ids[static_cast<std::size_t>(i)].size(),
+                                                           model_approximant));
 
-        int row_id = 0;
-        for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDx(),i); it; ++it) {
-            derivs_mat(row_id, 0) = it.value();
-            row_id++;
-        }
+    }
 
-        row_id = 0;
-        for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDy(),i); it; ++it) {
-            derivs_mat(row_id, 1) = it.value();
-            row_id++;
-        }
+    // Get the value of the minimum time step.
+    this->min_step_ = *std::min_element(this->time_steps_.begin(), this->time_steps_.end());
 
-        row_id = 0;
-        for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDz(),i); it; ++it) {
-            derivs_mat(row_id, 2) = it.value();
-            row_id++;
-        }
+    // Get the value of the maximum time step.
+    this->max_step_ = *std::max_element(this->time_steps_.begin(), this->time_steps_.end());
+
+}
 
-        // Square the elements of the derivatives matrix.
-        derivs_mat = derivs_mat.cwiseProduct(derivs_mat);
 
-        // Compute the time step for the ith evaluation point.
-        step = point_speed * std::sqrt(neighbors_ids[static_cast<std::size_t>(i)].size() * derivs_mat.sum());
-        step = 2. / step;
+void Mtled::UpdateTimeSteps(const std::vector<double> &wave_speed,
+                            const NeighborList &neighbors_ids,
+                            const Mmls3d &model_approximant, const std::vector<int> &updated_ids)
+{
+    // Check that time steps have been already computed for all the evaluation points except the appended ones.
+    if ( (this->time_steps_.empty()) ||
+         (this->time_steps_.size() > wave_speed.size()) ||
+         (wave_speed.size() != neighbors_ids.ListsNum()) ||
+         (static_cast<int>(wave_speed.size()) != model_approximant.ShapeFunctionDx().cols()) ) {
+
+        throw std::invalid_argument(Logger::Error("Could not update time steps. Compute time steps first "
+                                                  "and check the size consistency of the input variables.").c_str());
+    }
 
-        // Store the time step for the ith evaluation point.
-        this->time_steps_.emplace_back(step);
+    // Check that the appended evaluation points are updated.
+    std::vector<char> is_updated(wave_speed.size(), 0);
+    for (const auto &i : updated_ids) {
+        if (i < 0 || static_cast<std::size_t>(i) >= wave_speed.size()) {
+            throw std::out_of_range(Logger::Error("Could not update time steps. Updated evaluation point index is out of range.").c_str());
+        }
+        is_updated[static_cast<std::size_t>(i)] = 1;
+    }
+    if (std::find(is_updated.begin() + static_cast<std::ptrdiff_t>(this->time_steps_.size()), is_updated.end(), 0) != is_updated.end()) {
+        throw std::invalid_argument(Logger::Error("Could not update time steps. The appended evaluation points must be updated.").c_str());
+    }
+    this->time_steps_.resize(wave_speed.size(), 0.);
 
+    // Recompute the time step of the updated evaluation points.
+    for (const auto &i : updated_ids) {
+        this->time_steps_[static_cast<std::size_t>(i)] = this->PointTimeStep(wave_speed[static_cast<std::size_t>(i)], i,
+                                                                             neighbors_ids[static_cast<std::size_t>(i)].size(),
+                                                                             model_approximant);
     }
 
-    // Get the value of the minimum time step.
+    // Reset the values of the minimum and maximum time step.
     this->min_step_ = *std::min_element(this->time_steps_.begin(), this->time_steps_.end());
-
-    // Get the value of the maximum time step.
     this->max_step_ = *std::max_element(this->time_steps_.begin(), this->time_steps_.end());
 
 }
 
 
+void Mtled::UpdateOperators(const NeighborList &neighbor_ids, const Mmls3d &model_approximant, const std::vector<int> &updated_ids)
+{
+    // Check that the operators of a previous solution are available for all the integration points except the appended ones.
+    std::size_t packed_num = (this->derivs_precision_ == StoragePrecision::single_precision) ?
+                                 this->deriv_mats_single_.size() : this->deriv_mats_.size();
+    if (packed_num == 0 || packed_num > neighbor_ids.ListsNum() ||
+            (this->compress_neighbors_ && this->compressed_ids_.ListsNum() != packed_num)) {
+        throw std::invalid_argument(Logger::Error("Could not update the operators. Solve the model with the current storage "
+                                                  "settings first and check the size consistency of the input variables.").c_str());
+    }
+
+    // Check that the appended integration points are updated.
+    std::vector<char> is_updated(neighbor_ids.ListsNum(), 0);
+    for (const auto &i : updated_ids) {
+        if (i < 0 || static_cast<std::size_t>(i) >= neighbor_ids.ListsNum()) {
+            throw std::out_of_range(Logger::Error("Could not update the operators. Updated integration point index is out of range.").c_str());
+        }
+        is_updated[static_cast<std::size_t>(i)] = 1;
+    }
+    if (std::find(is_updated.begin() + static_cast<std::ptrdiff_t>(packed_num), is_updated.end(), 0) != is_updated.end()) {
+        throw std::invalid_argument(Logger::Error("Could not update the operators. The appended integration points must be updated.").c_str());
+    }
+
+    // Patch the packed derivatives and the compressed neighbor indices of the updated integration points.
+    if (this->derivs_precision_ == StoragePrecision::single_precision) {
+        this->UpdatePackedDerivatives(neighbor_ids, model_approximant, updated_ids, this->deriv_mats_single_);
+    }
+    else {
+        this->UpdatePackedDerivatives(neighbor_ids, model_approximant, updated_ids, this->deriv_mats_);
+    }
+    if (this->compress_neighbors_) { this->compressed_ids_.Update(neighbor_ids, updated_ids); }
+
+    this->operators_updated_ = true;
+}
+
+
 void Mtled::ComputeStableStep(const std::vector<double> &mass, const bool &is_mass_scaled, double safety_factor)
 {
     // Check if mass has been computed.
@@ -142,320 +194,6 @@ void Mtled::ComputeTotalTimeStepsNum(const int &load_steps_num, const int &equil
 }
 
 
-void Mtled::Solve(const WeakModel3D &weak_model_3d, const std::vector<std::vector<int> > &neighbor_ids, const ConditionsHandler &cond_handler,
-                  const Mmls3d &model_approximant, const NeoHookean &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem)
-{
-
-    // Check if the dynamic relaxation properties have been initialized.
-    if (!dyn_relax_prop.IsInitialized()) {
-        std::string error = "[CLOUDEA ERROR] Cannot generate the explicit dynamics solution. "
-                            "One or more dynamic relaxation properties have not been initialized.";
-        throw std::invalid_argument(error.c_str());
-    }
-
-    // Displacements and forces matrices initialization.
-    Eigen::MatrixXd disp = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
-    Eigen::MatrixXd disp_new = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
-    Eigen::MatrixXd disp_old = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
-    Eigen::MatrixXd disp_saved = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
-    Eigen::MatrixXd forces = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
-    Eigen::MatrixXd forces_saved = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
-
-
-    // Set the integration points number to be treated by each thread.
-    double ipoints_number = static_cast<double>(weak_model_3d.IntegrationPoints().PointsNum());
-    std::size_t ipoints_per_thread = static_cast<std::size_t>(std::ceil(ipoints_number / this->threads_number_));
-
-    // Iterate over threads.
-    std::size_t loop_start = 0; std::size_t loop_end = 0;
-    for (std::size_t t = 0; t != this->threads_number_; ++t) {
-
-        // Set first and last integration point ids for current thread.
-        loop_start = t*ipoints_per_thread;
-        loop_end = loop_start + ipoints_per_thread;
-
-        // Set last id to the last integration point if larger value was assigned.
-        if (loop_end >= static_cast<std::size_t>(ipoints_number)) { loop_end = static_cast<std::size_t>(ipoints_number); }
-
-        // Set as active threads that the first id is smaller than the number of available integration points.
-        if (loop_start >= static_cast<std::size_t>(ipoints_number)) {
-            this->thread_loop_manager_.AppendLoopInfo(loop_start, loop_end);
-        }
-        else {
-            this->thread_loop_manager_.AppendLoopInfo(loop_start, loop_end);
-        }
-    } // End Iterate over threads.
-
-    // Clear saved disps and forces.
-    this->saved_disps_.clear();
-    this->saved_forces_.clear();
-
-    // Reserve memory for the states to be recorded
-    if (this->save_progress_steps_ != 0) {
-        this->saved_disps_.reserve(static_cast<std::size_t>(this->total_time_steps_num/this->save_progress_steps_));
-        this->saved_forces_.reserve(static_cast<std::size_t>(this->total_time_steps_num/this->save_progress_steps_));
-    }
-    else {  // only for initial and final state.
-        this->saved_disps_.reserve(2);
-        this->saved_forces_.reserve(2);
-    }
-
-    // Store initial disps and forces.
-    this->saved_disps_.emplace_back(disp);
-    this->saved_forces_.emplace_back(forces);
-
-    // Retrieve the load steps number from the total steps and the equilibrium steps difference.
-    int step_num_load = this->total_time_steps_num - dyn_relax_prop.EquilibriumStepsNum();
-
-    // Dynamic Relaxation variables.
-    bool stabilized_conv_rate = false;
-    bool conv_disp_updated = false;
-
-    double conv_rate = dyn_relax_prop.LoadConvRate();
-    double old_conv_rate = dyn_relax_prop.LoadConvRate();
-
-    int termination_count = 0;
-    int samples_num = 0;
-    int no_update_steps_num = 0;
-
-    // Apply load condition at first time step (0) on new displacements.
-    //cond_handler.ApplyLoadingConditions(0, disp_new);
-
-    // Iterate over integration points to collect xyz derivatives matrices.
-    std::vector<Eigen::MatrixXd> deriv_mats;
-    deriv_mats.reserve(static_cast<std::size_t>(weak_model_3d.IntegrationPoints().PointsNum()));
-    for (int ip = 0; ip != weak_model_3d.IntegrationPoints().PointsNum(); ++ip) {
-
-        // Gather x, y, z derivatives in single matrix.
-        Eigen::MatrixXd xyz_derivs(neighbor_ids[static_cast<std::size_t>(ip)].size(), 3);
-
-        int row_id = 0;
-        for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDx(),ip); it; ++it) {
-            xyz_derivs(row_id, 0) = it.value();
-            row_id++;
-        }
-
-        row_id = 0;
-        for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDy(),ip); it; ++it) {
-            xyz_derivs(row_id, 1) = it.value();
-            row_id++;
-        }
-
-        row_id = 0;
-        for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDz(),ip); it; ++it) {
-            xyz_derivs(row_id, 2) = it.value();
-            row_id++;
-        }
-
-        // Store the derivatives matrix for each integration point in the container.
-        deriv_mats.emplace_back(xyz_derivs);
-
-    }
-
-    // Iterate over the total number of time steps.
-    int steps_counter = 0;
-    // std::cout << Logger::Warning("******  USING  OGDEN  MODEL  ******") << std::endl;
-    for (auto step = 0; step != this->total_time_steps_num; ++step) {
-        // Increase steps_counter to count the performing steps.
-        steps_counter++;
-
-        // Update displacements and make force zero (note the order).
-        disp_old = disp;
-        disp = disp_new;
-        forces.setZero(weak_model_3d.Grid().NodesNum(), 3);
-
-        // Compute the forces at each time step.
-        this->ComputeForces(weak_model_3d, neighbor_ids, deriv_mats, material, disp, forces);
-
-        // Update saved displacements, forces and convergence rates.
-        if (steps_counter == step_num_load) {
-            disp_saved = disp;
-            forces_saved = forces;
-            conv_rate = dyn_relax_prop.AfterLoadConvRate();
-            old_conv_rate = dyn_relax_prop.AfterLoadConvRate();
-        }
-
-        // Use forces to update displacements using explicit integration and
-        // mass proportional damping (Dynamic Relaxation)
-        double f8x = (conv_rate + 1.) * (this->stable_step_/2.);
-
-        // Compute new displacements.
-        disp_new = -f8x*f8x*(forces.array() / weak_model_3d.MassMatrix().array()).matrix() -
-                    conv_rate*conv_rate*disp_old + (1. + conv_rate*conv_rate)*disp;
-
-        // Apply boundary conditions.
-        if (use_ebciem) { // EBCIEM imposition of boundary conditions.
-
-            // Apply EBCIEM for suitable loading step.
-            if (steps_counter < step_num_load) { cond_handler.ApplyEbciem(steps_counter, disp_new); }
-            else { cond_handler.ApplyEbciem(step_num_load-1, disp_new); }
-
-        }
-        else { // Direct imposition of boundary conditions.
-
-            // Apply load conditions on the new displacements for suitable loading step.
-            if (steps_counter < step_num_load) { cond_handler.ApplyLoadingConditions(steps_counter, disp_new); }
-            else { cond_handler.ApplyLoadingConditions(step_num_load-1, disp_new); }
-
-            // Apply dirichlet conditions on the new displacements.
-            cond_handler.ApplyDirichletConditions(disp_new);
-
-        } // End Apply boundary conditions.
-
-
-        // Check for divergence.
-        double max_current_disp = disp_new.cwiseAbs().col(0).maxCoeff();
-        // double max_load_disp = 1.5 * cond_handler.LoadingConds()[0].Curve().MaxDisplacement();
-        double max_load_disp = 15. * cond_handler.LoadingConds()[0].Curve().MaxDisplacement();
-
-
-        // Use squared values to avoid using absolute.
-        if (max_current_disp*max_current_disp > max_load_disp*max_load_disp) {
-            std::cout << Logger::Warning("MTLED solution has become unbounded at step: ") <<
-                                std::to_string(step) << ". Reduce used time step!\n";
-            std::cout << Logger::Warning("Max current displacement: ") << max_current_disp << " | Max load displacement: " << std::abs(max_load_disp) << std::endl;
-            // Stop solution if become unstable and return.
-            return;
-        }
-
-        // Termination criteria and convergence rate.
-        if (steps_counter > step_num_load) {
-            // Estimate the lower oscilation frequency.
-            Eigen::MatrixXd disp_diff = std::move(disp - disp_saved);
-            Eigen::MatrixXd force_diff = std::move(forces - forces_saved);
-
-            // Apply loading conditions to force difference matrix.
-            cond_handler.ResetLoadingConditionsForces(force_diff);
-            cond_handler.ApplyDirichletConditions(force_diff);
-
-            double k_sum = (disp_diff.array() * force_diff.array()).sum();
-            double m_sum = (disp_diff.array() * disp_diff.array() * weak_model_3d.MassMatrix().array()).sum();
-
-            // Update convergence rate adaptively.
-            if (steps_counter < (step_num_load + dyn_relax_prop.StopUpdateConvRateStepsNum()) ) {
-                // Ensure k_sum is possitive.
-                k_sum = std::abs(k_sum);
-
-                // Updates in convergence rates.
-                if ((m_sum > 1.e-13) && (k_sum > 1.e-13)) {
-                    // Reset no update steps number.
-                    no_update_steps_num = 0;
-
-                    // Minimum frequency.
-                    double min_freq = std::sqrt(k_sum / m_sum);
-
-                    // Kmat condition number (square root).
-                    double k_cond_number_root = 2. / (min_freq * this->stable_step_);
-
-                    double temp_conv_rate = (k_cond_number_root - 1.) / (k_cond_number_root + 1.);
-
-                    if (std::abs(temp_conv_rate - old_conv_rate) < dyn_relax_prop.ConvRateDeviation()) {
-                        samples_num++;
-                        if (samples_num >= dyn_relax_prop.StableConvRateStepsNum()) {
-                            if (conv_disp_updated) {
-                                conv_disp_updated = false;
-
-                                // Update stabilized state if convergence rate deviation criterion is satisfied.
-                                if (std::abs(temp_conv_rate - conv_rate) < dyn_relax_prop.ConvRateStopDeviation()) { stabilized_conv_rate = true; }
-
-                                // Update convergence rate.
-                                conv_rate = temp_conv_rate;
-                            }
-                        }
-                    }
-                    else {
-                        // Reset number of samples to zero.
-                        samples_num = 0;
-                    }
-
-                    // Update old convergence rate.
-                    old_conv_rate = temp_conv_rate;
-
-                } // End of Updates in convergence rates.
-
-            }
-            else {
-                no_update_steps_num++;
-                if (no_update_steps_num >= 10*dyn_relax_prop.StableConvRateStepsNum()) { stabilized_conv_rate = true; }
-            }
-
-
-            // Check termination criteria.
-            if (stabilized_conv_rate) {
-
-                // Compute maximum displacement variation.
-                double max_disp_var = (disp_new - disp).cwiseAbs().maxCoeff();
-
-                // Adjust convergence rate value.
-                double estim_conv_rate = conv_rate + dyn_relax_prop.StopConvRateError()*(1. - conv_rate);
-                double estim_error = max_disp_var * estim_conv_rate / (1. - estim_conv_rate);
-
-                if (estim_error < dyn_relax_prop.StopAbsError()) {
-                    termination_count++;
-                    if (termination_count >= dyn_relax_prop.StopStepsNum()) {
-                        std::cout << "[CLOUDEA] MTLED solution tolerance has been satisfied at step: " << step+1 << "\n";
-                        break;
-                    }
-                }
-                else { termination_count = 0; }
-
-            } //End of check termination criteria.
-
-            // Update saved forces and displacements.
-            if ( (steps_counter - step_num_load) % dyn_relax_prop.ForceDispUpdateStepsNum() == 0 ) {
-                disp_saved = disp;
-                forces_saved = forces;
-                conv_disp_updated = true;
-            }
-
-        } // End of Termination criteria and convergence rate.
-
-        // Output MTLED progress.
-        if (this->save_progress_steps_ != 0) {
-            if(steps_counter % this->save_progress_steps_ == 0) {
-                this->saved_disps_.emplace_back(disp);
-                this->saved_forces_.emplace_back(forces);
-                std::cout << Logger::Message("MTLED solver completed: ") << steps_counter
-                          << " / " << this->total_time_steps_num << " steps.\n";
-            }
-        }
-
-    } //End of time steps iteration.
-
-    // Check for convergence satisfaction.
-    if (steps_counter == this->total_time_steps_num) {
-        std::string error = "[CLOUDEA ERROR] MTLED solution convergence rate at the end of the simulation: "
-                + std::to_string(conv_rate) + ".\n Solution tolerance has not been satisfied. Reduce the size of the stable time step.";
-        std::cout << error << std::endl;
-        //throw std::runtime_error(error.c_str());
-    }
-    else {
-        std::cout << Logger::Message("Convergence rate of MTLED solution at termination: ") << conv_rate << std::endl;
-    }
-
-
-    // Store final disps and forces if they haven't been stored during progress storing.
-    if (this->save_progress_steps_ != 0) {
-        if (steps_counter % this->save_progress_steps_ != 0) {
-            this->saved_disps_.emplace_back(disp);
-            this->saved_forces_.emplace_back(forces);
-        }
-    }
-    else {  // Store final state
-        this->saved_disps_.emplace_back(disp);
-        this->saved_forces_.emplace_back(forces);
-    }
-
-    // Check size consistency between displacements and forces containers.
-    if (this->saved_disps_.size() != this->saved_forces_.size()) {
-        std::string error = "[CLOUDEA ERROR] The saved displacements and saved forces do not correspond to the same number of steps.";
-        throw std::runtime_error(error.c_str());
-    }
-
-
-}
-
-
 void Mtled::ApplyShapeFuncToDisplacements(const WeakModel3D &weak_model_3d, const Mmls3d &nodal_approximant, 
                                           const ConditionsHandler &cond_handler, bool has_kronecker)
 {
@@ -515,86 +253,81 @@ void Mtled::ApplyShapeFuncToDisplacements(const WeakModel3D &weak_model_3d, cons
 }
 
 
-void Mtled::ComputeForces(const WeakModel3D &weak_model_3d, const std::vector<std::vector<int> > &neighbor_ids,
-                          const std::vector<Eigen::MatrixXd> &deriv_mats, const NeoHookean &material,
-                          const Eigen::MatrixXd &displacements, Eigen::MatrixXd &forces)
+void Mtled::CheckApproximantPoints(const NeighborList &neighbor_ids, const Mmls3d &model_approximant) const
 {
-
-    Eigen::initParallel();
-
-    // Multithreaded Forces computation.
-    std::vector<std::thread> threads;
-    for (std::size_t t = 0; t != this->threads_number_; ++t) {
-        threads.emplace_back(std::thread(&Mtled::ComputeForcesThreadCallback, this, t, std::cref(weak_model_3d),
-                                         std::cref(neighbor_ids), std::cref(deriv_mats), std::cref(material),
-                                         std::cref(displacements), std::ref(forces) ));
+    const auto &dx = model_approximant.ShapeFunctionDx();
+    const auto &dy = model_approximant.ShapeFunctionDy();
+    const auto &dz = model_approximant.ShapeFunctionDz();
+    const auto lists_num = static_cast<Eigen::Index>(neighbor_ids.ListsNum());
+    if (dx.cols() != lists_num || dy.cols() != lists_num || dz.cols() != lists_num) {
+        std::string error = "[CLOUDEA ERROR] Could not gather the shape function derivatives. The approximant is evaluated on " +
+                            std::to_string(dx.cols()) + " points but the neighbor lists correspond to " +
+                            std::to_string(lists_num) + " integration points.";
+        throw std::invalid_argument(error.c_str());
     }
-    // Join threads.
-    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
 }
 
 
-void Mtled::ComputeForcesThreadCallback(std::size_t thread_id, const WeakModel3D &weak_model_3d,
-                                        const std::vector<std::vector<int> > &neighbor_ids,
-                                        const std::vector<Eigen::MatrixXd> &deriv_mats, const NeoHookean &material,
-                                        const Eigen::MatrixXd &displacements, Eigen::MatrixXd &forces)
+void Mtled::CheckOperatorsMatch(const NeighborList &neighbor_ids) const
 {
+    // The packed derivatives and the compressed neighbor indices must have the support size of each neighbor list.
+    bool match = true;
+    if (this->derivs_precision_ == StoragePrecision::single_precision) {
+        match = this->deriv_mats_single_.size() == neighbor_ids.ListsNum();
+        for (std::size_t ip = 0; match && ip != neighbor_ids.ListsNum(); ++ip) {
+            match = static_cast<std::size_t>(this->deriv_mats_single_[ip].rows()) == neighbor_ids.ListSize(ip);
+        }
+    }
+    else {
+        match = this->deriv_mats_.size() == neighbor_ids.ListsNum();
+        for (std::size_t ip = 0; match && ip != neighbor_ids.ListsNum(); ++ip) {
+            match = static_cast<std::size_t>(this->deriv_mats_[ip].rows()) == neighbor_ids.ListSize(ip);
+        }
+    }
+    if (match && this->compress_neighbors_) {
+        match = this->compressed_ids_.ListsNum() == neighbor_ids.ListsNum();
+        for (std::size_t ip = 0; match && ip != neighbor_ids.ListsNum(); ++ip) {
+            match = this->compressed_ids_.ListSize(ip) == neighbor_ids.ListSize(ip);
+        }
+    }
 
-    // Compute forces in active thread.
-
-        // Initialize thread forces.
-        Eigen::MatrixXd forces_thread = Eigen::MatrixXd::Zero(weak_model_3d.TetrahedralMesh().NodesNum(), 3);
-
-        // Iterate over integration points for force generation.
-        for (auto ipoint_id = this->thread_loop_manager_.LoopStartId(thread_id);
-             ipoint_id != this->thread_loop_manager_.LoopEndId(thread_id); ++ipoint_id) {
-
-            // Initialize deformation gradient and 2nd Piola-Kirchhoff stress tensor.
-            Eigen::Matrix3d FT = Eigen::Matrix3d::Zero(3, 3);
-            Eigen::Matrix3d spk_stress = Eigen::Matrix3d::Zero(3, 3);
-
-            // The integration point's weight.
-            auto ipoint_weight = weak_model_3d.IntegrationPoints().Weights()[ipoint_id];
-
-            // Local displacements and forces at integration point's support domain.
-            Eigen::MatrixXd disp_local = Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(neighbor_ids[ipoint_id].size()), 3);
-            Eigen::MatrixXd forces_local = Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(neighbor_ids[ipoint_id].size()), 3);
-
-            // Iterate over neighbor nodes indices.
-            for (auto &neigh_id : neighbor_ids[ipoint_id]) {
-                // The neighbors index in the container.
-                auto id = &neigh_id - &neighbor_ids[ipoint_id][0];
-
-                // Populate disp_local.
-                disp_local.row(id) = displacements.row(neigh_id);
-            }
-
-            // Compute deformation gradient.
-            FT.noalias() = deriv_mats[ipoint_id].transpose() * disp_local;
-            // Add identity matrix contribution to diagonal elements of the deformation gradient tensor.
-            FT.coeffRef(0,0) += 1.; FT.coeffRef(1,1) += 1.; FT.coeffRef(2,2) += 1.;
+    if (!match) {
+        std::string error = "[CLOUDEA ERROR] Cannot generate the explicit dynamics solution. The operators updated in place "
+                            "do not match the given neighbor lists.";
+        throw std::invalid_argument(error.c_str());
+    }
+}
 
-            // Compute the 2nd Piola-Kirchhoff stress tensor.
-            spk_stress.noalias() = std::move(material.SpkStress(FT, static_cast<int>(ipoint_id)));
 
-            // Compute the force contribution of the current integration point.
-            forces_local = deriv_mats[ipoint_id] * spk_stress.transpose() * FT * ipoint_weight;
+double Mtled::PointTimeStep(double point_speed, Eigen::Index point_id, std::size_t support_size, const Mmls3d &model_approximant) const
+{
+    // Gather x, y, z derivatives in single matrix.
+    Eigen::MatrixXd derivs_mat(support_size, 3);
 
-            // Update total force.
-            for (auto &neigh_id : neighbor_ids[ipoint_id]) {
-                // The neighbors index in the container.
-                auto id = &neigh_id - &neighbor_ids[ipoint_id][0];
+    int row_id = 0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDx(),point_id); it; ++it) {
+        derivs_mat(row_id, 0) = it.value();
+        row_id++;
+    }
 
-                // Add integration point's contribution in force matrix.
-                forces_thread.row(neigh_id) += forces_local.row(id);
-            }
+    row_id = 0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDy(),point_id); it; ++it) {
+        derivs_mat(row_id, 1) = it.value();
+        row_id++;
+    }
 
-        } // End iteration over integration points.
+    row_id = 0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(model_approximant.ShapeFunctionDz(),point_id); it; ++it) {
+        derivs_mat(row_id, 2) = it.value();
+        row_id++;
+    }
 
-        // Thread-safe addition of thread forces to the forces matrix.
-        std::lock_guard<std::mutex> guarding(this->mtled_mutex_);
-        forces += forces_thread;
+    // Square the elements of the derivatives matrix.
+    derivs_mat = derivs_mat.cwiseProduct(derivs_mat);
 
+    // Compute the time step for the evaluation point.
+    double step = point_speed * std::sqrt(support_size * derivs_mat.sum());
+    return 2. / step;
 }
 
 } //end of namespace CLOUDEA
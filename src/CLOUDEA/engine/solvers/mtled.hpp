@@ -35,19 +35,24 @@
 #include "CLOUDEA/engine/integration/integ_options.hpp"
 #include "CLOUDEA/engine/integration/integ_points.hpp"
 #include "CLOUDEA/engine/materials/neo_hookean.hpp"
+#include "CLOUDEA/engine/materials/ogden.hpp"
 #include "CLOUDEA/engine/solvers/dyn_relax_prop.hpp"
+#include "CLOUDEA/engine/solvers/solver_properties.hpp"
 #include "CLOUDEA/engine/conditions/conditions_handler.hpp"
+#include "CLOUDEA/engine/support_domain/compressed_neighbor_list.hpp"
 #include "CLOUDEA/engine/utilities/thread_loop_manager.hpp"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
+#include <array>
 #include <string>
 #include <cmath>
 #include <algorithm>
 #include <fstream>
 #include <utility>
 #include <functional>
+#include <type_traits>
 
 #include <stdexcept>
 #include <exception>
@@ -91,10 +96,25 @@ public:
      * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
      * \return [void]
      */
-    void ComputeTimeSteps(const std::vector<double> &wave_speed, const std::vector< std::vector<int> > &neighbors_ids,
+    void ComputeTimeSteps(const std::vector<double> &wave_speed, const NeighborList &neighbors_ids,
                           const Mmls3d &model_approximant);
 
 
+    /*!
+     * \brief Update the time steps only for the given evaluation points and reset the minimum and maximum time step.
+     *
+     * Evaluation points appended after the last time steps computation must be included in the updated points.
+     *
+     * \param [in] wave_speed The wave_speed of the evaluation points.
+     * \param [in] neighbors_ids The indices of the neighbor points to the evaluation points.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \param [in] updated_ids The indices of the evaluation points with updated support domain.
+     * \return [void]
+     */
+    void UpdateTimeSteps(const std::vector<double> &wave_speed, const NeighborList &neighbors_ids,
+                         const Mmls3d &model_approximant, const std::vector<int> &updated_ids);
+
+
     /*!
      * \brief Set the stable step.
      * \param [in] stable_step The stable step to be setted.
@@ -133,6 +153,44 @@ public:
     inline void SetSaveProgressSteps(const int &save_progress_steps) { this->save_progress_steps_ = save_progress_steps; }
 
 
+    /*!
+     * \brief Set the storage precision of the shape function derivatives used in the forces computation.
+     *
+     * Single precision storage halves the memory traffic of the derivatives in the forces computation.
+     * The deformation gradient, the stress and the forces are always computed in double precision. [Default: double]
+     *
+     * \param [in] precision The storage precision of the shape function derivatives.
+     * \return [void]
+     */
+    inline void SetDerivativesPrecision(const StoragePrecision &precision) { this->derivs_precision_ = precision; this->operators_updated_ = false; }
+
+
+    /*!
+     * \brief Set the storage precision of the displacement and force fields used in the forces computation.
+     *
+     * Single precision storage applies to the gathered displacements and the per-thread forces of the forces computation.
+     * The summation of the total forces, the time integration, the convergence sums and the mass remain in double precision.
+     * [Default: double]
+     *
+     * \param [in] precision The storage precision of the displacement and force fields.
+     * \return [void]
+     */
+    inline void SetFieldsPrecision(const StoragePrecision &precision) { this->fields_precision_ = precision; }
+
+
+    /*!
+     * \brief Set the compressed storage of the neighbor indices used in the forces computation.
+     *
+     * The neighbor indices of each integration point are stored as a base index and 16-bit offsets
+     * (see CompressedNeighborList) and decoded on the fly. Reduces the memory traffic of bandwidth-limited
+     * runs with spatially ordered nodes. The solution is identical to the uncompressed storage. [Default: false]
+     *
+     * \param [in] compress_neighbors The conditional to compress the neighbor indices.
+     * \return [void]
+     */
+    inline void SetNeighborsCompression(bool compress_neighbors) { this->compress_neighbors_ = compress_neighbors; this->operators_updated_ = false; }
+
+
     /*!
      * \brief Solve the displacement & forces fields explicitly using the MTLED with dynamic relaxation.
      *
@@ -143,13 +201,58 @@ public:
      * \param [in] neighbor_ids The indices of neighbor nodes (support domain) to each node of the 3D model.
      * \param [in] cond_handler The handler of conditions imposition.
      * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
-     * \param [in] material The assigned material to the 3D model. [Only uniform neohookean material is supported for now.]
+     * \param [in] material The assigned material to the 3D model. A material policy (e.g. NeoHookean, Ogden) providing the batched SpkStresses evaluation.
      * \param [in] dyn_relax_prop The dynamic relaxation properties to be used by the MTLED.
      * \return [void]
      * \note Applying loading conditions at the first timestep looks not necessary and has been commented out for now.
      */
-    void Solve(const WeakModel3D &weak_model_3d, const std::vector<std::vector<int> > &neighbor_ids, const ConditionsHandler &cond_handler,
-               const Mmls3d &model_approximant, const NeoHookean &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem);
+    template <class MATERIAL_T>
+    void Solve(const WeakModel3D &weak_model_3d, const NeighborList &neighbor_ids, const ConditionsHandler &cond_handler,
+               const Mmls3d &model_approximant, const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem);
+
+
+    /*!
+     * \brief Solve the displacement & forces fields explicitly using the MTLED with dynamic relaxation, taking over the neighbor list.
+     *
+     * With compressed neighbor indices (see SetNeighborsCompression) the handed over neighbor list is released
+     * once the derivatives are packed and the indices are compressed, so that the plain and the compressed
+     * neighbor indices are not both kept during the time integration. The neighbor list is left empty in that case.
+     * Use the constant reference overload to keep the neighbor list for incremental updates (see UpdateOperators).
+     *
+     * \param [in] weak_model_3d The weak formulation 3D model to be solved.
+     * \param [in,out] neighbor_ids The indices of neighbor nodes (support domain) to each node of the 3D model. Released if compressed.
+     * \param [in] cond_handler The handler of conditions imposition.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \param [in] material The assigned material to the 3D model.
+     * \param [in] dyn_relax_prop The dynamic relaxation properties to be used by the MTLED.
+     * \param [in] use_ebciem The conditional to use EBCIEM for the imposition of boundary conditions.
+     * \return [void]
+     */
+    template <class MATERIAL_T>
+    void Solve(const WeakModel3D &weak_model_3d, NeighborList &&neighbor_ids, const ConditionsHandler &cond_handler,
+               const Mmls3d &model_approximant, const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem);
+
+
+    /*!
+     * \brief Validate the reduced storage precision against the double precision solution.
+     *
+     * The model is solved with double precision storage and with the storage precisions set by
+     * SetDerivativesPrecision and SetFieldsPrecision. The saved displacements and forces of the reduced
+     * precision solution are kept.
+     *
+     * \param [in] weak_model_3d The weak formulation 3D model to be solved.
+     * \param [in] neighbor_ids The indices of neighbor nodes (support domain) to each node of the 3D model.
+     * \param [in] cond_handler The handler of conditions imposition.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \param [in] material The assigned material to the 3D model.
+     * \param [in] dyn_relax_prop The dynamic relaxation properties to be used by the MTLED.
+     * \param [in] use_ebciem The conditional to use EBCIEM for the imposition of boundary conditions.
+     * \return [double] The maximum absolute difference of the equilibrium displacements relative to the maximum absolute double precision displacement.
+     */
+    template <class MATERIAL_T>
+    double ValidateStoragePrecision(const WeakModel3D &weak_model_3d, const NeighborList &neighbor_ids,
+                                    const ConditionsHandler &cond_handler, const Mmls3d &model_approximant,
+                                    const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem);
 
 
     /*!
@@ -209,28 +312,165 @@ public:
     inline const std::vector<Eigen::MatrixXd> & SavedForces() const { return this->saved_forces_; }
 
 
+    /*!
+     * \brief Get the x, y, z derivatives matrices of the model's integration points packed in double precision by the last solution.
+     * \return [std::vector<Eigen::MatrixXd>] The derivatives matrices. Empty if the solution used single precision derivatives.
+     */
+    inline const std::vector<Eigen::MatrixXd> & PackedDerivatives() const { return this->deriv_mats_; }
+
+
+    /*!
+     * \brief Get the x, y, z derivatives matrices of the model's integration points packed in single precision by the last solution.
+     * \return [std::vector<Eigen::MatrixXf>] The derivatives matrices. Empty if the solution used double precision derivatives.
+     */
+    inline const std::vector<Eigen::MatrixXf> & PackedDerivativesSingle() const { return this->deriv_mats_single_; }
+
+
+    /*!
+     * \brief Update the packed derivatives and the compressed neighbor indices of the last solution only for the given integration points.
+     *
+     * To be called after the incremental update of the support domains and the shape functions of a solved model
+     * (see InfSupportDomain::UpdateClosestNodesIds and Mmls3d::UpdateShFuncAndDerivs). The next Solve uses the operators
+     * patched in place instead of packing and compressing them for all the integration points. Integration points
+     * appended after the last solution must be included in the updated points.
+     *
+     * \param [in] neighbor_ids The updated indices of neighbor nodes (support domain) to each integration point.
+     * \param [in] model_approximant The updated approximant of the shape function and derivatives on the model's integration points.
+     * \param [in] updated_ids The indices of the integration points with updated support domain.
+     * \return [void]
+     */
+    void UpdateOperators(const NeighborList &neighbor_ids, const Mmls3d &model_approximant, const std::vector<int> &updated_ids);
+
+
     inline const std::size_t & ThreadsNumber() const { return this->threads_number_; }
 
 protected:
 
+    /*!
+     * \brief Solve the displacement & forces fields explicitly using the MTLED with dynamic relaxation.
+     *
+     * A non-const neighbor list is released after the compression of the neighbor indices, if compressed.
+     *
+     * \tparam NEIGHBOR_LIST_T The neighbor list type. Either const NeighborList or NeighborList.
+     * \return [void]
+     */
+    template <class MATERIAL_T, class NEIGHBOR_LIST_T>
+    void SolveDynamicRelaxation(const WeakModel3D &weak_model_3d, NEIGHBOR_LIST_T &neighbor_ids, const ConditionsHandler &cond_handler,
+                                const Mmls3d &model_approximant, const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop,
+                                const bool &use_ebciem);
+
+
+    /*!
+     * \brief Compute the time step of an evaluation point.
+     * \param [in] point_speed The wave speed of the evaluation point.
+     * \param [in] point_id The index of the evaluation point.
+     * \param [in] support_size The number of support nodes of the evaluation point.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \return [double] The time step of the evaluation point.
+     */
+    double PointTimeStep(double point_speed, Eigen::Index point_id, std::size_t support_size, const Mmls3d &model_approximant) const;
+
+
+    /*!
+     * \brief Check that the approximant has been computed on the integration points of the neighbor lists.
+     *
+     * E.g. the approximant must be recomputed after the integration points have been compressed.
+     *
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \return [void]
+     */
+    void CheckApproximantPoints(const NeighborList &neighbor_ids, const Mmls3d &model_approximant) const;
+
+
+    /*!
+     * \brief Check that the operators patched in place by UpdateOperators match the neighbor lists to be solved.
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points.
+     * \return [void]
+     */
+    void CheckOperatorsMatch(const NeighborList &neighbor_ids) const;
+
+
+    /*!
+     * \brief Gather the x, y, z shape function derivatives of an integration point in a matrix.
+     * \param [in] ip The index of the integration point.
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \param [out] xyz_derivs The first derivatives (x, y, z) matrix of the integration point.
+     * \return [void]
+     */
+    template <typename DERIV_T>
+    void PackPointDerivatives(std::size_t ip, const NeighborList &neighbor_ids, const Mmls3d &model_approximant,
+                              Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> &xyz_derivs) const;
+
+
+    /*!
+     * \brief Gather the x, y, z shape function derivatives of the model's integration points in matrices.
+     *
+     * The approximant must be computed on the same integration points as the neighbor lists.
+     * An exception is thrown if the number of points or the support size of a point do not match.
+     *
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \param [out] deriv_mats The list of first derivatives (x, y, z) matrices for the model's integration points.
+     * \return [void]
+     */
+    template <typename DERIV_T>
+    void PackDerivatives(const NeighborList &neighbor_ids, const Mmls3d &model_approximant,
+                         std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats) const;
+
+
+    /*!
+     * \brief Gather the x, y, z shape function derivatives only for the given integration points in the packed matrices.
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points.
+     * \param [in] model_approximant The approximant of the shape function and derivatives on the model's integration points.
+     * \param [in] updated_ids The indices of the integration points to be repacked. Appended points must be included.
+     * \param [in,out] deriv_mats The list of first derivatives (x, y, z) matrices for the model's integration points. Updated in place.
+     * \return [void]
+     */
+    template <typename DERIV_T>
+    void UpdatePackedDerivatives(const NeighborList &neighbor_ids, const Mmls3d &model_approximant, const std::vector<int> &updated_ids,
+                                 std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats) const;
+
+
+    /*!
+     * \brief Compute the acting forces on the nodes of a weak formulation 3D model in the requested storage precisions.
+     * \param [in] weak_model_3d The weak formulation 3D model.
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points. NeighborList or CompressedNeighborList.
+     * \param [in] deriv_mats The list of first derivatives matrices in double precision storage.
+     * \param [in] deriv_mats_single The list of first derivatives matrices in single precision storage.
+     * \param [in] material The material of the model.
+     * \param [in] displacements The displacements of the model's nodes.
+     * \param [out] forces The computed acting forces on the model's nodes.
+     */
+    template <class MATERIAL_T, typename NEIGHBORS_T>
+    void ComputeStepForces(const WeakModel3D &weak_model_3d, const NEIGHBORS_T &neighbor_ids,
+                           const std::vector<Eigen::MatrixXd> &deriv_mats, const std::vector<Eigen::MatrixXf> &deriv_mats_single,
+                           const MATERIAL_T &material, const Eigen::MatrixXd &displacements, Eigen::MatrixXd &forces);
+
+
     /*!
      * \brief Compute the acting forces on the nodes of a weak formulation 3D model.
      * \param [in] weak_model_3d The weak formulation 3D model.
-     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points.
+     * \param [in] neighbor_ids The list of neighbor nodes' indices to the model's integration points. NeighborList or CompressedNeighborList.
      * \param [in] deriv_mats The list of first derivatives (x, y, z) matrices for the model's integration points.
      * \param [in] material The material of the model.
      * \param [in] displacements The displacements of the model's nodes.
      * \param [out] forces The computed acting forces on the model's nodes.
      */
-    void ComputeForces(const WeakModel3D &weak_model_3d, const std::vector<std::vector<int> > &neighbor_ids,
-                       const std::vector<Eigen::MatrixXd> &deriv_mats, const NeoHookean &material,
-                       const Eigen::MatrixXd &displacements, Eigen::MatrixXd &forces);
+    template <class MATERIAL_T, typename NEIGHBORS_T, typename DERIV_T, typename FIELD_T>
+    void ComputeForces(const WeakModel3D &weak_model_3d, const NEIGHBORS_T &neighbor_ids,
+                       const std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats,
+                       const MATERIAL_T &material, const Eigen::Matrix<FIELD_T, Eigen::Dynamic, Eigen::Dynamic> &displacements,
+                       Eigen::MatrixXd &forces);
 
 
+    template <class MATERIAL_T, typename NEIGHBORS_T, typename DERIV_T, typename FIELD_T>
     void ComputeForcesThreadCallback(std::size_t thread_id, const WeakModel3D &weak_model_3d,
-                                     const std::vector<std::vector<int> > &neighbor_ids,
-                                     const std::vector<Eigen::MatrixXd> &deriv_mats, const NeoHookean &material,
-                                     const Eigen::MatrixXd &displacements, Eigen::MatrixXd &forces);
+                                     const NEIGHBORS_T &neighbor_ids,
+                                     const std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats,
+                                     const MATERIAL_T &material, const Eigen::Matrix<FIELD_T, Eigen::Dynamic, Eigen::Dynamic> &displacements,
+                                     Eigen::MatrixXd &forces);
 
 
 private:
@@ -250,6 +490,20 @@ private:
 
     std::vector<Eigen::MatrixXd> saved_forces_;         /*!< The saved forces at pre-defined step intervals. */
 
+    std::vector<Eigen::MatrixXd> deriv_mats_;           /*!< The packed derivatives matrices of the integration points in double precision. */
+
+    std::vector<Eigen::MatrixXf> deriv_mats_single_;    /*!< The packed derivatives matrices of the integration points in single precision. */
+
+    StoragePrecision derivs_precision_;                 /*!< The storage precision of the shape function derivatives in the forces computation. */
+
+    StoragePrecision fields_precision_;                 /*!< The storage precision of the displacement and force fields in the forces computation. */
+
+    bool compress_neighbors_;                           /*!< Conditional to store compressed the neighbor indices in the forces computation. */
+
+    CompressedNeighborList compressed_ids_;             /*!< The compressed neighbor indices of the integration points of the last solution. */
+
+    bool operators_updated_;                            /*!< Conditional declaring that the packed operators have been patched in place for the next solution. */
+
     std::size_t threads_number_;
 
     ThreadLoopManager thread_loop_manager_;
@@ -262,4 +516,7 @@ private:
 /*! @} End of Doxygen Groups*/
 } //end of namespace CLOUDEA
 
+
+#include "CLOUDEA/engine/solvers/mtled.tpp"
+
 #endif //CLOUDEA_SOLVERS_MTLED_HPP_
@@ -0,0 +1,593 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CLOUDEA_SOLVERS_MTLED_TPP_
+#define CLOUDEA_SOLVERS_MTLED_TPP_
+
+#include "CLOUDEA/engine/solvers/mtled.hpp"
+
+namespace CLOUDEA {
+
+
+template <class MATERIAL_T>
+void Mtled::Solve(const WeakModel3D &weak_model_3d, const NeighborList &neighbor_ids, const ConditionsHandler &cond_handler,
+                  const Mmls3d &model_approximant, const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem)
+{
+    this->SolveDynamicRelaxation(weak_model_3d, neighbor_ids, cond_handler, model_approximant, material, dyn_relax_prop, use_ebciem);
+}
+
+
+template <class MATERIAL_T>
+void Mtled::Solve(const WeakModel3D &weak_model_3d, NeighborList &&neighbor_ids, const ConditionsHandler &cond_handler,
+                  const Mmls3d &model_approximant, const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem)
+{
+    this->SolveDynamicRelaxation(weak_model_3d, neighbor_ids, cond_handler, model_approximant, material, dyn_relax_prop, use_ebciem);
+}
+
+
+template <class MATERIAL_T, class NEIGHBOR_LIST_T>
+void Mtled::SolveDynamicRelaxation(const WeakModel3D &weak_model_3d, NEIGHBOR_LIST_T &neighbor_ids, const ConditionsHandler &cond_handler,
+                                   const Mmls3d &model_approximant, const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop,
+                                   const bool &use_ebciem)
+{
+
+    // Check if the dynamic relaxation properties have been initialized.
+    if (!dyn_relax_prop.IsInitialized()) {
+        std::string error = "[CLOUDEA ERROR] Cannot generate the explicit dynamics solution. "
+                            "One or more dynamic relaxation properties have not been initialized.";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Displacements and forces matrices initialization.
+    Eigen::MatrixXd disp = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
+    Eigen::MatrixXd disp_new = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
+    Eigen::MatrixXd disp_old = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
+    Eigen::MatrixXd disp_saved = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
+    Eigen::MatrixXd forces = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
+    Eigen::MatrixXd forces_saved = Eigen::MatrixXd::Zero(weak_model_3d.Grid().NodesNum(), 3);
+
+
+    // Set the integration points number to be treated by each thread.
+    double ipoints_number = static_cast<double>(weak_model_3d.IntegrationPoints().PointsNum());
+    std::size_t ipoints_per_thread = static_cast<std::size_t>(std::ceil(ipoints_number / this->threads_number_));
+
+    // Iterate over threads.
+    this->thread_loop_manager_.Reset();
+    std::size_t loop_start = 0; std::size_t loop_end = 0;
+    for (std::size_t t = 0; t != this->threads_number_; ++t) {
+
+        // Set first and last integration point ids for current thread.
+        loop_start = t*ipoints_per_thread;
+        loop_end = loop_start + ipoints_per_thread;
+
+        // Set last id to the last integration point if larger value was assigned.
+        if (loop_end >= static_cast<std::size_t>(ipoints_number)) { loop_end = static_cast<std::size_t>(ipoints_number); }
+
+        // Set as active threads that the first id is smaller than the number of available integration points.
+        if (loop_start >= static_cast<std::size_t>(ipoints_number)) {
+            this->thread_loop_manager_.AppendLoopInfo(loop_start, loop_end);
+        }
+        else {
+            this->thread_loop_manager_.AppendLoopInfo(loop_start, loop_end);
+        }
+    } // End Iterate over threads.
+
+    // Clear saved disps and forces.
+    this->saved_disps_.clear();
+    this->saved_forces_.clear();
+
+    // Reserve memory for the states to be recorded
+    if (this->save_progress_steps_ != 0) {
+        this->saved_disps_.reserve(static_cast<std::size_t>(this->total_time_steps_num/this->save_progress_steps_));
+        this->saved_forces_.reserve(static_cast<std::size_t>(this->total_time_steps_num/this->save_progress_steps_));
+    }
+    else {  // only for initial and final state.
+        this->saved_disps_.reserve(2);
+        this->saved_forces_.reserve(2);
+    }
+
+    // Store initial disps and forces.
+    this->saved_disps_.emplace_back(disp);
+    this->saved_forces_.emplace_back(forces);
+
+    // Retrieve the load steps number from the total steps and the equilibrium steps difference.
+    int step_num_load = this->total_time_steps_num - dyn_relax_prop.EquilibriumStepsNum();
+
+    // Dynamic Relaxation variables.
+    bool stabilized_conv_rate = false;
+    bool conv_disp_updated = false;
+
+    double conv_rate = dyn_relax_prop.LoadConvRate();
+    double old_conv_rate = dyn_relax_prop.LoadConvRate();
+
+    int termination_count = 0;
+    int samples_num = 0;
+    int no_update_steps_num = 0;
+
+    // Apply load condition at first time step (0) on new displacements.
+    //cond_handler.ApplyLoadingConditions(0, disp_new);
+
+    // Collect xyz derivatives matrices of the integration points in the requested storage precision and compress
+    // the neighbor indices if requested, unless the operators of the previous solution have been patched in place
+    // by UpdateOperators. They are kept after the solution for the post-processing of the saved snapshots.
+    if (this->operators_updated_) {
+        this->CheckOperatorsMatch(neighbor_ids);
+    }
+    else {
+        this->deriv_mats_.clear();
+        this->deriv_mats_single_.clear();
+        if (this->derivs_precision_ == StoragePrecision::single_precision) {
+            this->PackDerivatives(neighbor_ids, model_approximant, this->deriv_mats_single_);
+        }
+        else {
+            this->PackDerivatives(neighbor_ids, model_approximant, this->deriv_mats_);
+        }
+
+        this->compressed_ids_ = CompressedNeighborList();
+        if (this->compress_neighbors_) { this->compressed_ids_.Compress(neighbor_ids); }
+    }
+    this->operators_updated_ = false;
+
+    // Release a handed over neighbor list. Only the compressed neighbor indices are used from here on.
+    if constexpr (!std::is_const<NEIGHBOR_LIST_T>::value) {
+        if (this->compress_neighbors_) { neighbor_ids.Release(); }
+    }
+
+    // Iterate over the total number of time steps.
+    int steps_counter = 0;
+    // std::cout << Logger::Warning("******  USING  OGDEN  MODEL  ******") << std::endl;
+    for (auto step = 0; step != this->total_time_steps_num; ++step) {
+        // Increase steps_counter to count the performing steps.
+        steps_counter++;
+
+        // Update displacements and make force zero (note the order).
+        disp_old = disp;
+        disp = disp_new;
+        forces.setZero(weak_model_3d.Grid().NodesNum(), 3);
+
+        // Compute the forces at each time step with the requested neighbor indices storage.
+        if (this->compress_neighbors_) {
+            this->ComputeStepForces(weak_model_3d, this->compressed_ids_, this->deriv_mats_, this->deriv_mats_single_, material, disp, forces);
+        }
+        else { this->ComputeStepForces(weak_model_3d, neighbor_ids, this->deriv_mats_, this->deriv_mats_single_, material, disp, forces); }
+
+        // Update saved displacements, forces and convergence rates.
+        if (steps_counter == step_num_load) {
+            disp_saved = disp;
+            forces_saved = forces;
+            conv_rate = dyn_relax_prop.AfterLoadConvRate();
+            old_conv_rate = dyn_relax_prop.AfterLoadConvRate();
+        }
+
+        // Use forces to update displacements using explicit integration and
+        // mass proportional damping (Dynamic Relaxation)
+        double f8x = (conv_rate + 1.) * (this->stable_step_/2.);
+
+        // Compute new displacements.
+        disp_new = -f8x*f8x*(forces.array() / weak_model_3d.MassMatrix().array()).matrix() -
+                    conv_rate*conv_rate*disp_old + (1. + conv_rate*conv_rate)*disp;
+
+        // Apply boundary conditions.
+        if (use_ebciem) { // EBCIEM imposition of boundary conditions.
+
+            // Apply EBCIEM for suitable loading step.
+            if (steps_counter < step_num_load) { cond_handler.ApplyEbciem(steps_counter, disp_new); }
+            else { cond_handler.ApplyEbciem(step_num_load-1, disp_new); }
+
+        }
+        else { // Direct imposition of boundary conditions.
+
+            // Apply load and dirichlet conditions on the new displacements for suitable loading step.
+            if (steps_counter < step_num_load) { cond_handler.ApplyConstraints(steps_counter, disp_new); }
+            else { cond_handler.ApplyConstraints(step_num_load-1, disp_new); }
+
+        } // End Apply boundary conditions.
+
+
+        // Check for divergence.
+        double max_current_disp = disp_new.cwiseAbs().col(0).maxCoeff();
+        // double max_load_disp = 1.5 * cond_handler.LoadingConds()[0].Curve().MaxDisplacement();
+        double max_load_disp = 15. * cond_handler.LoadingConds()[0].Curve().MaxDisplacement();
+
+
+        // Use squared values to avoid using absolute.
+        if (max_current_disp*max_current_disp > max_load_disp*max_load_disp) {
+            std::cout << Logger::Warning("MTLED solution has become unbounded at step: ") <<
+                                std::to_string(step) << ". Reduce used time step!\n";
+            std::cout << Logger::Warning("Max current displacement: ") << max_current_disp << " | Max load displacement: " << std::abs(max_load_disp) << std::endl;
+            // Stop solution if become unstable and return.
+            return;
+        }
+
+        // Termination criteria and convergence rate.
+        if (steps_counter > step_num_load) {
+            // Estimate the lower oscilation frequency.
+            Eigen::MatrixXd disp_diff = std::move(disp - disp_saved);
+            Eigen::MatrixXd force_diff = std::move(forces - forces_saved);
+
+            // Reset the forces of the constrained nodes in the force difference matrix.
+            cond_handler.ResetConstrainedForces(force_diff);
+
+            double k_sum = (disp_diff.array() * force_diff.array()).sum();
+            double m_sum = (disp_diff.array() * disp_diff.array() * weak_model_3d.MassMatrix().array()).sum();
+
+            // Update convergence rate adaptively.
+            if (steps_counter < (step_num_load + dyn_relax_prop.StopUpdateConvRateStepsNum()) ) {
+                // Ensure k_sum is possitive.
+                k_sum = std::abs(k_sum);
+
+                // Updates in convergence rates.
+                if ((m_sum > 1.e-13) && (k_sum > 1.e-13)) {
+                    // Reset no update steps number.
+                    no_update_steps_num = 0;
+
+                    // Minimum frequency.
+                    double min_freq = std::sqrt(k_sum / m_sum);
+
+                    // Kmat condition number (square root).
+                    double k_cond_number_root = 2. / (min_freq * this->stable_step_);
+
+                    double temp_conv_rate = (k_cond_number_root - 1.) / (k_cond_number_root + 1.);
+
+                    if (std::abs(temp_conv_rate - old_conv_rate) < dyn_relax_prop.ConvRateDeviation()) {
+                        samples_num++;
+                        if (samples_num >= dyn_relax_prop.StableConvRateStepsNum()) {
+                            if (conv_disp_updated) {
+                                conv_disp_updated = false;
+
+                                // Update stabilized state if convergence rate deviation criterion is satisfied.
+                                if (std::abs(temp_conv_rate - conv_rate) < dyn_relax_prop.ConvRateStopDeviation()) { stabilized_conv_rate = true; }
+
+                                // Update convergence rate.
+                                conv_rate = temp_conv_rate;
+                            }
+                        }
+                    }
+                    else {
+                        // Reset number of samples to zero.
+                        samples_num = 0;
+                    }
+
+                    // Update old convergence rate.
+                    old_conv_rate = temp_conv_rate;
+
+                } // End of Updates in convergence rates.
+
+            }
+            else {
+                no_update_steps_num++;
+                if (no_update_steps_num >= 10*dyn_relax_prop.StableConvRateStepsNum()) { stabilized_conv_rate = true; }
+            }
+
+
+            // Check termination criteria.
+            if (stabilized_conv_rate) {
+
+                // Compute maximum displacement variation.
+                double max_disp_var = (disp_new - disp).cwiseAbs().maxCoeff();
+
+                // Adjust convergence rate value.
+                double estim_conv_rate = conv_rate + dyn_relax_prop.StopConvRateError()*(1. - conv_rate);
+                double estim_error = max_disp_var * estim_conv_rate / (1. - estim_conv_rate);
+
+                if (estim_error < dyn_relax_prop.StopAbsError()) {
+                    termination_count++;
+                    if (termination_count >= dyn_relax_prop.StopStepsNum()) {
+                        std::cout << "[CLOUDEA] MTLED solution tolerance has been satisfied at step: " << step+1 << "\n";
+                        break;
+                    }
+                }
+                else { termination_count = 0; }
+
+            } //End of check termination criteria.
+
+            // Update saved forces and displacements.
+            if ( (steps_counter - step_num_load) % dyn_relax_prop.ForceDispUpdateStepsNum() == 0 ) {
+                disp_saved = disp;
+                forces_saved = forces;
+                conv_disp_updated = true;
+            }
+
+        } // End of Termination criteria and convergence rate.
+
+        // Output MTLED progress.
+        if (this->save_progress_steps_ != 0) {
+            if(steps_counter % this->save_progress_steps_ == 0) {
+                this->saved_disps_.emplace_back(disp);
+                this->saved_forces_.emplace_back(forces);
+                std::cout << Logger::Message("MTLED solver completed: ") << steps_counter
+                          << " / " << this->total_time_steps_num << " steps.\n";
+            }
+        }
+
+    } //End of time steps iteration.
+
+    // Check for convergence satisfaction.
+    if (steps_counter == this->total_time_steps_num) {
+        std::string error = "[CLOUDEA ERROR] MTLED solution convergence rate at the end of the simulation: "
+                + std::to_string(conv_rate) + ".\n Solution tolerance has not been satisfied. Reduce the size of the stable time step.";
+        std::cout << error << std::endl;
+        //throw std::runtime_error(error.c_str());
+    }
+    else {
+        std::cout << Logger::Message("Convergence rate of MTLED solution at termination: ") << conv_rate << std::endl;
+    }
+
+
+    // Store final disps and forces if they haven't been stored during progress storing.
+    if (this->save_progress_steps_ != 0) {
+        if (steps_counter % this->save_progress_steps_ != 0) {
+            this->saved_disps_.emplace_back(disp);
+            this->saved_forces_.emplace_back(forces);
+        }
+    }
+    else {  // Store final state
+        this->saved_disps_.emplace_back(disp);
+        this->saved_forces_.emplace_back(forces);
+    }
+
+    // Check size consistency between displacements and forces containers.
+    if (this->saved_disps_.size() != this->saved_forces_.size()) {
+        std::string error = "[CLOUDEA ERROR] The saved displacements and saved forces do not correspond to the same number of steps.";
+        throw std::runtime_error(error.c_str());
+    }
+
+
+}
+
+
+template <class MATERIAL_T>
+double Mtled::ValidateStoragePrecision(const WeakModel3D &weak_model_3d, const NeighborList &neighbor_ids,
+                                       const ConditionsHandler &cond_handler, const Mmls3d &model_approximant,
+                                       const MATERIAL_T &material, const DynRelaxProp &dyn_relax_prop, const bool &use_ebciem)
+{
+    // Keep the requested storage precisions.
+    auto derivs_precision = this->derivs_precision_;
+    auto fields_precision = this->fields_precision_;
+
+    // Solve with double precision storage.
+    this->derivs_precision_ = StoragePrecision::double_precision;
+    this->fields_precision_ = StoragePrecision::double_precision;
+    this->Solve(weak_model_3d, neighbor_ids, cond_handler, model_approximant, material, dyn_relax_prop, use_ebciem);
+    Eigen::MatrixXd disp_double = this->saved_disps_.back();
+
+    // Solve with the requested storage precisions.
+    this->derivs_precision_ = derivs_precision;
+    this->fields_precision_ = fields_precision;
+    this->Solve(weak_model_3d, neighbor_ids, cond_handler, model_approximant, material, dyn_relax_prop, use_ebciem);
+
+    // Compute the displacements error at equilibrium.
+    double max_abs_error = (this->saved_disps_.back() - disp_double).cwiseAbs().maxCoeff();
+    double max_abs_disp = disp_double.cwiseAbs().maxCoeff();
+    double rel_error = (max_abs_disp > 0.) ? max_abs_error / max_abs_disp : max_abs_error;
+
+    std::cout << Logger::Message("Storage precision validation - max absolute displacement error: ") << max_abs_error
+              << " | relative to max displacement: " << rel_error << std::endl;
+
+    return rel_error;
+}
+
+
+template <typename DERIV_T>
+void Mtled::PackPointDerivatives(std::size_t ip, const NeighborList &neighbor_ids, const Mmls3d &model_approximant,
+                                 Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> &xyz_derivs) const
+{
+    const auto &dx = model_approximant.ShapeFunctionDx();
+    const auto &dy = model_approximant.ShapeFunctionDy();
+    const auto &dz = model_approximant.ShapeFunctionDz();
+
+    // Check that the derivatives of the integration point match its support nodes.
+    const auto col = static_cast<Eigen::Index>(ip);
+    const auto support_size = static_cast<Eigen::Index>(neighbor_ids[ip].size());
+    if (dx.innerVector(col).nonZeros() != support_size || dy.innerVector(col).nonZeros() != support_size ||
+            dz.innerVector(col).nonZeros() != support_size) {
+        std::string error = "[CLOUDEA ERROR] Could not gather the shape function derivatives. The derivatives of the integration point " +
+                            std::to_string(ip) + " do not match the number of its support nodes.";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Gather x, y, z derivatives in single matrix.
+    xyz_derivs.resize(support_size, 3);
+
+    int row_id = 0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(dx,col); it; ++it) {
+        xyz_derivs(row_id, 0) = static_cast<DERIV_T>(it.value());
+        row_id++;
+    }
+
+    row_id = 0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(dy,col); it; ++it) {
+        xyz_derivs(row_id, 1) = static_cast<DERIV_T>(it.value());
+        row_id++;
+    }
+
+    row_id = 0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(dz,col); it; ++it) {
+        xyz_derivs(row_id, 2) = static_cast<DERIV_T>(it.value());
+        row_id++;
+    }
+}
+
+
+template <typename DERIV_T>
+void Mtled::PackDerivatives(const NeighborList &neighbor_ids, const Mmls3d &model_approximant,
+                            std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats) const
+{
+    // Check that the approximant has been computed on the integration points of the neighbor lists.
+    this->CheckApproximantPoints(neighbor_ids, model_approximant);
+
+    // Iterate over integration points to collect xyz derivatives matrices.
+    deriv_mats.clear();
+    deriv_mats.resize(neighbor_ids.ListsNum());
+    for (std::size_t ip = 0; ip != neighbor_ids.ListsNum(); ++ip) {
+        this->PackPointDerivatives(ip, neighbor_ids, model_approximant, deriv_mats[ip]);
+    }
+}
+
+
+template <typename DERIV_T>
+void Mtled::UpdatePackedDerivatives(const NeighborList &neighbor_ids, const Mmls3d &model_approximant, const std::vector<int> &updated_ids,
+                                    std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats) const
+{
+    // Check that the approximant has been computed on the integration points of the neighbor lists.
+    this->CheckApproximantPoints(neighbor_ids, model_approximant);
+
+    // Repack the xyz derivatives matrices of the updated integration points only. Appended points are packed at the end.
+    deriv_mats.resize(neighbor_ids.ListsNum());
+    for (const auto &ip : updated_ids) {
+        this->PackPointDerivatives(static_cast<std::size_t>(ip), neighbor_ids, model_approximant, deriv_mats[static_cast<std::size_t>(ip)]);
+    }
+}
+
+
+template <class MATERIAL_T, typename NEIGHBORS_T>
+void Mtled::ComputeStepForces(const WeakModel3D &weak_model_3d, const NEIGHBORS_T &neighbor_ids,
+                              const std::vector<Eigen::MatrixXd> &deriv_mats, const std::vector<Eigen::MatrixXf> &deriv_mats_single,
+                              const MATERIAL_T &material, const Eigen::MatrixXd &displacements, Eigen::MatrixXd &forces)
+{
+    // Compute the forces in the requested storage precision.
+    if (this->fields_precision_ == StoragePrecision::single_precision) {
+        Eigen::MatrixXf disp_single = displacements.cast<float>();
+        if (this->derivs_precision_ == StoragePrecision::single_precision) {
+            this->ComputeForces(weak_model_3d, neighbor_ids, deriv_mats_single, material, disp_single, forces);
+        }
+        else { this->ComputeForces(weak_model_3d, neighbor_ids, deriv_mats, material, disp_single, forces); }
+    }
+    else {
+        if (this->derivs_precision_ == StoragePrecision::single_precision) {
+            this->ComputeForces(weak_model_3d, neighbor_ids, deriv_mats_single, material, displacements, forces);
+        }
+        else { this->ComputeForces(weak_model_3d, neighbor_ids, deriv_mats, material, displacements, forces); }
+    }
+}
+
+
+template <class MATERIAL_T, typename NEIGHBORS_T, typename DERIV_T, typename FIELD_T>
+void Mtled::ComputeForces(const WeakModel3D &weak_model_3d, const NEIGHBORS_T &neighbor_ids,
+                          const std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats,
+                          const MATERIAL_T &material, const Eigen::Matrix<FIELD_T, Eigen::Dynamic, Eigen::Dynamic> &displacements,
+                          Eigen::MatrixXd &forces)
+{
+
+    Eigen::initParallel();
+
+    // Multithreaded Forces computation.
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != this->threads_number_; ++t) {
+        threads.emplace_back(std::thread(&Mtled::ComputeForcesThreadCallback<MATERIAL_T, NEIGHBORS_T, DERIV_T, FIELD_T>, this, t, std::cref(weak_model_3d),
+                                         std::cref(neighbor_ids), std::cref(deriv_mats), std::cref(material),
+                                         std::cref(displacements), std::ref(forces) ));
+    }
+    // Join threads.
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+}
+
+
+template <class MATERIAL_T, typename NEIGHBORS_T, typename DERIV_T, typename FIELD_T>
+void Mtled::ComputeForcesThreadCallback(std::size_t thread_id, const WeakModel3D &weak_model_3d,
+                                        const NEIGHBORS_T &neighbor_ids,
+                                        const std::vector<Eigen::Matrix<DERIV_T, Eigen::Dynamic, Eigen::Dynamic> > &deriv_mats,
+                                        const MATERIAL_T &material, const Eigen::Matrix<FIELD_T, Eigen::Dynamic, Eigen::Dynamic> &displacements,
+                                        Eigen::MatrixXd &forces)
+{
+
+    // Compute forces in active thread.
+
+        // Initialize thread forces. They are accumulated in double precision for any storage precision.
+        Eigen::MatrixXd forces_thread = Eigen::MatrixXd::Zero(weak_model_3d.TetrahedralMesh().NodesNum(), 3);
+
+        // Deformation gradients and 2nd Piola-Kirchhoff stress tensors of a batch of integration points.
+        const std::size_t batch_size = 32;
+        std::array<Eigen::Matrix3d, batch_size> FT, spk_stress;
+
+        // The derivatives of a batch of integration points in double precision. Single precision
+        // derivatives are converted once per point, double precision derivatives are used in place.
+        std::array<Eigen::MatrixXd, batch_size> derivs_converted;
+        std::array<const Eigen::MatrixXd *, batch_size> derivs;
+        Eigen::MatrixXd disp_local, forces_local;
+
+        // Iterate over batches of integration points for force generation.
+        const auto loop_start = this->thread_loop_manager_.LoopStartId(thread_id);
+        const auto loop_end = this->thread_loop_manager_.LoopEndId(thread_id);
+        for (auto batch_start = loop_start; batch_start < loop_end; batch_start += batch_size) {
+            const std::size_t batch_points = std::min(batch_size, static_cast<std::size_t>(loop_end - batch_start));
+
+            // Compute the deformation gradients of the batch.
+            for (std::size_t b = 0; b != batch_points; ++b) {
+                const auto ipoint_id = batch_start + b;
+
+                // The integration point's derivatives in double precision.
+                if constexpr (std::is_same<DERIV_T, double>::value) {
+                    derivs[b] = &deriv_mats[ipoint_id];
+                }
+                else {
+                    derivs_converted[b] = deriv_mats[ipoint_id].template cast<double>();
+                    derivs[b] = &derivs_converted[b];
+                }
+
+                // Local displacements at integration point's support domain.
+                auto support_size = static_cast<Eigen::Index>(neighbor_ids.ListSize(ipoint_id));
+                disp_local.resize(support_size, 3);
+
+                // Populate disp_local iterating over neighbor nodes indices.
+                neighbor_ids.ForEach(ipoint_id, [&](std::size_t id, int neigh_id) {
+                    disp_local.row(id) = displacements.row(neigh_id).template cast<double>();
+                });
+
+                // Compute deformation gradient.
+                FT[b].noalias() = derivs[b]->transpose() * disp_local;
+                // Add identity matrix contribution to diagonal elements of the deformation gradient tensor.
+                FT[b].coeffRef(0,0) += 1.; FT[b].coeffRef(1,1) += 1.; FT[b].coeffRef(2,2) += 1.;
+            }
+
+            // Compute the 2nd Piola-Kirchhoff stress tensors of the batch.
+            material.SpkStresses(FT.data(), batch_points, static_cast<std::size_t>(batch_start), spk_stress.data());
+
+            for (std::size_t b = 0; b != batch_points; ++b) {
+                const auto ipoint_id = batch_start + b;
+
+                // The integration point's weight.
+                auto ipoint_weight = weak_model_3d.IntegrationPoints().Weights()[ipoint_id];
+
+                // Compute the force contribution of the current integration point.
+                Eigen::Matrix3d stress_ft;
+                stress_ft.noalias() = spk_stress[b].transpose() * FT[b] * ipoint_weight;
+                forces_local.noalias() = *derivs[b] * stress_ft;
+
+                // Update total force adding integration point's contribution in force matrix.
+                neighbor_ids.ForEach(ipoint_id, [&](std::size_t id, int neigh_id) {
+                    forces_thread.row(neigh_id) += forces_local.row(id);
+                });
+            }
+
+        } // End iteration over integration points.
+
+        // Thread-safe addition of thread forces to the forces matrix.
+        std::lock_guard<std::mutex> guarding(this->mtled_mutex_);
+        forces += forces_thread;
+
+}
+
+
+}  // End of namespace CLOUDEA
+
+
+
+#endif //CLOUDEA_SOLVERS_MTLED_TPP_
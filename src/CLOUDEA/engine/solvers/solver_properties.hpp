@@ -0,0 +1,52 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file solver_properties.hpp
+   \brief Collection of solver properties header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_SOLVERS_SOLVER_PROPERTIES_HPP_
+#define CLOUDEA_SOLVERS_SOLVER_PROPERTIES_HPP_
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Solvers
+ *  @{
+ */
+
+
+/*!
+ * \enum StoragePrecision
+ * \brief The floating point precision used to store solver data.
+ */
+enum struct StoragePrecision: int {double_precision = 1,     /*!< Storage in double precision (64-bit). */
+                                   single_precision = 2,     /*!< Storage in single precision (32-bit). */
+                                  };
+
+
+
+/*! @} End of Doxygen Groups*/
+
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SOLVERS_SOLVER_PROPERTIES_HPP_
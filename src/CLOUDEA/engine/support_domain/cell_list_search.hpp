@@ -0,0 +1,212 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file cell_list_search.hpp
+   \brief CellListSearch class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_SUPPORT_DOMAIN_CELL_LIST_SEARCH_HPP_
+#define CLOUDEA_SUPPORT_DOMAIN_CELL_LIST_SEARCH_HPP_
+
+
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/thread_loop_manager.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <exception>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+
+namespace CLOUDEA {
+
+/** \addtogroup Meshfree \{ */
+
+
+/**
+ * \class CellListSearch
+ * \author Konstantinos A. Mountris
+ * \brief Dependency-free range search of points in spheres of variable radius using a uniform cell list.
+ *
+ * Each sphere is registered in all the cells of a uniform grid that overlap with its bounding box.
+ * A query point is tested only against the spheres registered in the cell containing it.
+ * The spheres are registered in increasing index order, so the indices of the spheres containing
+ * a query point are returned in increasing order. A point is contained in a sphere if its squared
+ * distance from the sphere's center is not larger than the squared radius, as in the CGAL Fuzzy_sphere search.
+ *
+ * \tparam DIM The spatial dimensions of the search.
+ */
+template <short DIM>
+class CellListSearch
+{
+private:
+
+    std::vector<std::array<double, DIM>> centers_;         /**< The centers of the spheres */
+
+    std::vector<double> radiuses_;                         /**< The radiuses of the spheres */
+
+    std::array<double, DIM> grid_min_;                     /**< The minimum corner of the cell grid */
+
+    std::array<std::size_t, DIM> cells_num_;               /**< The number of cells of the cell grid in each dimension */
+
+    double cell_size_;                                     /**< The edge length of the cells */
+
+    std::vector<std::size_t> cell_offsets_;                /**< The offsets of the spheres list of each cell in the cell_sphere_ids_ container */
+
+    std::vector<int> cell_sphere_ids_;                     /**< The indices of the spheres registered in each cell stored contiguously */
+
+    std::size_t threads_number_;                           /**< The number of threads used in the search */
+
+
+protected:
+
+    /**
+     * \brief Get the range of cell indices in each dimension overlapping with an axis-aligned box.
+     * \param [in] box_min The minimum corner of the box.
+     * \param [in] box_max The maximum corner of the box.
+     * \param [out] first The first cell index in each dimension.
+     * \param [out] last The last cell index in each dimension.
+     * \return [bool] False if the box does not overlap with the cell grid, true otherwise.
+     */
+    inline bool CellRange(const std::array<double, DIM> &box_min, const std::array<double, DIM> &box_max,
+                          std::array<std::size_t, DIM> &first, std::array<std::size_t, DIM> &last) const;
+
+
+    /**
+     * \brief Get the linear index of a cell from its indices in each dimension.
+     * \param [in] cell The indices of the cell in each dimension.
+     * \return [std::size_t] The linear index of the cell.
+     */
+    inline std::size_t LinearCellId(const std::array<std::size_t, DIM> &cell) const;
+
+
+    /**
+     * \brief Call a function for the linear index of every cell in the given range.
+     * \param [in] first The first cell index in each dimension.
+     * \param [in] last The last cell index in each dimension.
+     * \param [in] func The function to be called with the linear index of each cell.
+     * \return [void]
+     */
+    template <typename FUNC>
+    inline void ForEachCell(const std::array<std::size_t, DIM> &first, const std::array<std::size_t, DIM> &last, FUNC func) const;
+
+
+public:
+
+    /**
+     * \brief CellListSearch constructor.
+     */
+    CellListSearch();
+
+
+    /**
+     * \brief CellListSearch destructor.
+     */
+    virtual ~CellListSearch();
+
+
+    /**
+     * \brief Set the number of threads used in the search.
+     * \param [in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    inline void SetThreadsNumber(std::size_t threads_number);
+
+
+    /**
+     * \brief Set the spheres and build the cell list.
+     *
+     * The cell size is set to the mean radius of the spheres and it is increased if the number of cells
+     * grows larger than a multiple of the number of spheres.
+     *
+     * \tparam POINT The type of the centers. It must provide access to the coordinates with operator[].
+     * \param [in] centers The centers of the spheres.
+     * \param [in] radiuses The radiuses of the spheres.
+     * \return [void]
+     */
+    template <typename POINT>
+    inline void SetSpheres(const std::vector<POINT> &centers, const std::vector<double> &radiuses);
+
+
+    /**
+     * \brief Get the indices of the spheres containing a single query point.
+     *
+     * Serial and allocation-free if the output container has enough capacity. Safe to call concurrently.
+     *
+     * \tparam POINT The type of the query point. It must provide access to the coordinates with operator[].
+     * \param [in] query_point The query point.
+     * \param [out] spheres_ids The increasing indices of the spheres containing the query point.
+     * \return [void]
+     */
+    template <typename POINT>
+    inline void ContainingSpheresIds(const POINT &query_point, std::vector<int> &spheres_ids) const;
+
+
+    /**
+     * \brief Get the indices of the spheres containing each of the given query points.
+     *
+     * The query points are processed in parallel.
+     *
+     * \tparam POINT The type of the query points. It must provide access to the coordinates with operator[].
+     * \param [in] query_points The query points.
+     * \return [NeighborList] The increasing indices of the spheres containing each query point.
+     */
+    template <typename POINT>
+    inline NeighborList ContainingSpheresIds(const std::vector<POINT> &query_points) const;
+
+
+    /**
+     * \brief Get the number of spheres in the cell list.
+     * \return [std::size_t] The number of spheres in the cell list.
+     */
+    inline std::size_t SpheresNum() const { return this->radiuses_.size(); }
+
+
+    /**
+     * \brief Get the edge length of the cells.
+     * \return [double] The edge length of the cells.
+     */
+    inline double CellSize() const { return this->cell_size_; }
+
+
+    /**
+     * \brief Get the number of threads used in the search.
+     * \return [std::size_t] The number of threads used in the search.
+     */
+    inline std::size_t ThreadsNumber() const { return this->threads_number_; }
+
+};
+
+
+/*! \} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SUPPORT_DOMAIN_CELL_LIST_SEARCH_HPP_
+
+#include "CLOUDEA/engine/support_domain/cell_list_search.tpp"
@@ -0,0 +1,285 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CLOUDEA_SUPPORT_DOMAIN_CELL_LIST_SEARCH_TPP_
+#define CLOUDEA_SUPPORT_DOMAIN_CELL_LIST_SEARCH_TPP_
+
+
+#include "CLOUDEA/engine/support_domain/cell_list_search.hpp"
+
+namespace CLOUDEA {
+
+
+template<short DIM>
+CellListSearch<DIM>::CellListSearch() : centers_(), radiuses_(), grid_min_(), cells_num_(), cell_size_(0.),
+    cell_offsets_(), cell_sphere_ids_(), threads_number_(1)
+{
+    this->grid_min_.fill(0.);
+    this->cells_num_.fill(0);
+    this->SetThreadsNumber(0);
+}
+
+
+template<short DIM>
+CellListSearch<DIM>::~CellListSearch()
+{}
+
+
+template<short DIM>
+void CellListSearch<DIM>::SetThreadsNumber(std::size_t threads_number)
+{
+    this->threads_number_ = threads_number;
+    if (this->threads_number_ == 0) {
+        this->threads_number_ = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    }
+    if (this->threads_number_ == 0) { this->threads_number_ = 1; }
+}
+
+
+template<short DIM>
+bool CellListSearch<DIM>::CellRange(const std::array<double, DIM> &box_min, const std::array<double, DIM> &box_max,
+                                    std::array<std::size_t, DIM> &first, std::array<std::size_t, DIM> &last) const
+{
+    for (short d = 0; d != DIM; ++d) {
+        double lo = std::floor((box_min[d] - this->grid_min_[d]) / this->cell_size_);
+        double hi = std::floor((box_max[d] - this->grid_min_[d]) / this->cell_size_);
+
+        // Check if the box lies outside the grid in this dimension.
+        if (hi < 0. || lo >= static_cast<double>(this->cells_num_[d])) { return false; }
+
+        // Clamp the range to the grid limits.
+        first[d] = lo < 0. ? 0 : static_cast<std::size_t>(lo);
+        last[d] = std::min(static_cast<std::size_t>(hi), this->cells_num_[d]-1);
+    }
+    return true;
+}
+
+
+template<short DIM>
+std::size_t CellListSearch<DIM>::LinearCellId(const std::array<std::size_t, DIM> &cell) const
+{
+    std::size_t id = cell[DIM-1];
+    for (short d = DIM-2; d >= 0; --d) {
+        id = id*this->cells_num_[d] + cell[d];
+    }
+    return id;
+}
+
+
+template<short DIM>
+template<typename FUNC>
+void CellListSearch<DIM>::ForEachCell(const std::array<std::size_t, DIM> &first, const std::array<std::size_t, DIM> &last, FUNC func) const
+{
+    std::array<std::size_t, DIM> cell = first;
+    while (true) {
+        func(this->LinearCellId(cell));
+
+        // Advance the cell indices with the first dimension varying fastest.
+        short d = 0;
+        while (d != DIM && cell[d] == last[d]) { cell[d] = first[d]; ++d; }
+        if (d == DIM) { break; }
+        cell[d]++;
+    }
+}
+
+
+template<short DIM>
+template<typename POINT>
+void CellListSearch<DIM>::SetSpheres(const std::vector<POINT> &centers, const std::vector<double> &radiuses)
+{
+    // Check consistency of the spheres data.
+    if (centers.size() != radiuses.size()) {
+        throw std::invalid_argument(Logger::Error("Could not set spheres in cell list search. "
+                                                  "The number of centers and radiuses is not equal.").c_str());
+    }
+    if (centers.empty()) {
+        throw std::invalid_argument(Logger::Error("Could not set spheres in cell list search. No spheres were given.").c_str());
+    }
+
+    auto spheres_num = centers.size();
+    this->centers_.clear();
+    this->centers_.resize(spheres_num);
+    this->radiuses_ = radiuses;
+
+    // Compute the bounding box of the spheres and their mean radius.
+    std::array<double, DIM> grid_max;
+    this->grid_min_.fill(std::numeric_limits<double>::max());
+    grid_max.fill(std::numeric_limits<double>::lowest());
+    double mean_radius = 0.;
+    for (std::size_t i = 0; i != spheres_num; ++i) {
+        if (radiuses[i] < 0.) {
+            throw std::invalid_argument(Logger::Error("Could not set spheres in cell list search. "
+                                                      "A negative radius was given.").c_str());
+        }
+        for (short d = 0; d != DIM; ++d) {
+            this->centers_[i][d] = centers[i][d];
+            this->grid_min_[d] = std::min(this->grid_min_[d], centers[i][d] - radiuses[i]);
+            grid_max[d] = std::max(grid_max[d], centers[i][d] + radiuses[i]);
+        }
+        mean_radius += radiuses[i];
+    }
+    mean_radius /= static_cast<double>(spheres_num);
+
+    // Use the mean radius as cell size. Increase it if the grid is too fine for the number of spheres.
+    double extent = 0.;
+    for (short d = 0; d != DIM; ++d) { extent = std::max(extent, grid_max[d] - this->grid_min_[d]); }
+    this->cell_size_ = mean_radius > 0. ? mean_radius : extent;
+    if (this->cell_size_ <= 0.) { this->cell_size_ = 1.; }
+
+    const double max_cells_num = 8.*static_cast<double>(spheres_num) + 64.;
+    while (true) {
+        double cells_num = 1.;
+        for (short d = 0; d != DIM; ++d) {
+            cells_num *= std::floor((grid_max[d] - this->grid_min_[d]) / this->cell_size_) + 1.;
+        }
+        if (cells_num <= max_cells_num) { break; }
+        this->cell_size_ *= 1.5;
+    }
+
+    std::size_t total_cells_num = 1;
+    for (short d = 0; d != DIM; ++d) {
+        this->cells_num_[d] = static_cast<std::size_t>(std::floor((grid_max[d] - this->grid_min_[d]) / this->cell_size_)) + 1;
+        total_cells_num *= this->cells_num_[d];
+    }
+
+    // Compute the range of cells overlapping with each sphere's bounding box.
+    // A small margin is added to avoid missing cells due to floating point rounding.
+    std::vector<std::array<std::size_t, DIM>> first_cells(spheres_num), last_cells(spheres_num);
+    std::vector<char> sphere_in_grid(spheres_num, 0);
+    std::array<double, DIM> box_min, box_max;
+    for (std::size_t i = 0; i != spheres_num; ++i) {
+        for (short d = 0; d != DIM; ++d) {
+            double margin = 1.e-12*(std::abs(this->centers_[i][d]) + radiuses[i]);
+            box_min[d] = this->centers_[i][d] - radiuses[i] - margin;
+            box_max[d] = this->centers_[i][d] + radiuses[i] + margin;
+        }
+        sphere_in_grid[i] = this->CellRange(box_min, box_max, first_cells[i], last_cells[i]);
+    }
+
+    // Count the spheres registered in each cell.
+    this->cell_offsets_.assign(total_cells_num+1, 0);
+    for (std::size_t i = 0; i != spheres_num; ++i) {
+        if (!sphere_in_grid[i]) { continue; }
+        this->ForEachCell(first_cells[i], last_cells[i], [this](std::size_t cell_id) { this->cell_offsets_[cell_id+1]++; });
+    }
+    for (std::size_t c = 0; c != total_cells_num; ++c) {
+        this->cell_offsets_[c+1] += this->cell_offsets_[c];
+    }
+
+    // Register the spheres in the cells in increasing index order.
+    this->cell_sphere_ids_.clear();
+    this->cell_sphere_ids_.resize(this->cell_offsets_.back());
+    std::vector<std::size_t> fill_pos(this->cell_offsets_.begin(), this->cell_offsets_.end()-1);
+    for (std::size_t i = 0; i != spheres_num; ++i) {
+        if (!sphere_in_grid[i]) { continue; }
+        this->ForEachCell(first_cells[i], last_cells[i], [this, &fill_pos, i](std::size_t cell_id) {
+            this->cell_sphere_ids_[fill_pos[cell_id]++] = static_cast<int>(i);
+        });
+    }
+}
+
+
+template<short DIM>
+template<typename POINT>
+void CellListSearch<DIM>::ContainingSpheresIds(const POINT &query_point, std::vector<int> &spheres_ids) const
+{
+    if (this->cell_offsets_.empty()) {
+        throw std::runtime_error(Logger::Error("Could not search for containing spheres in cell list search. "
+                                               "Set the spheres first.").c_str());
+    }
+
+    std::array<double, DIM> point;
+    std::array<std::size_t, DIM> cell;
+    for (short d = 0; d != DIM; ++d) { point[d] = query_point[d]; }
+
+    // Points outside the cell grid are not contained in any sphere.
+    spheres_ids.clear();
+    if (!this->CellRange(point, point, cell, cell)) { return; }
+
+    auto cell_id = this->LinearCellId(cell);
+    for (auto k = this->cell_offsets_[cell_id]; k != this->cell_offsets_[cell_id+1]; ++k) {
+        const auto &sphere_id = this->cell_sphere_ids_[k];
+        double dist2 = 0.;
+        for (short d = 0; d != DIM; ++d) {
+            double diff = point[d] - this->centers_[sphere_id][d];
+            dist2 += diff*diff;
+        }
+        if (dist2 <= this->radiuses_[sphere_id]*this->radiuses_[sphere_id]) {
+            spheres_ids.emplace_back(sphere_id);
+        }
+    }
+}
+
+
+template<short DIM>
+template<typename POINT>
+NeighborList CellListSearch<DIM>::ContainingSpheresIds(const std::vector<POINT> &query_points) const
+{
+    if (this->cell_offsets_.empty()) {
+        throw std::runtime_error(Logger::Error("Could not search for containing spheres in cell list search. "
+                                               "Set the spheres first.").c_str());
+    }
+
+    // Search the spheres containing the query points in the given range.
+    auto search_range = [&](std::size_t start_id, std::size_t end_id, NeighborList &spheres_ids) {
+        std::vector<int> point_spheres_ids;
+        spheres_ids.Clear();
+        spheres_ids.Reserve(end_id-start_id, 0);
+        for (std::size_t p = start_id; p != end_id; ++p) {
+            this->ContainingSpheresIds(query_points[p], point_spheres_ids);
+            spheres_ids.Append(point_spheres_ids.begin(), point_spheres_ids.end());
+        }
+    };
+
+    // Search in a single thread if multithreading is not beneficial.
+    NeighborList spheres_ids;
+    if (this->threads_number_ <= 1 || this->threads_number_ >= query_points.size()) {
+        search_range(0, query_points.size(), spheres_ids);
+        return spheres_ids;
+    }
+
+    ThreadLoopManager loop_manager;
+    loop_manager.SetLoopRanges(query_points.size(), this->threads_number_);
+
+    // Search in contiguous ranges of query points, one per thread.
+    std::vector<NeighborList> thread_spheres_ids(this->threads_number_);
+    std::vector<std::thread> threads;
+    threads.reserve(this->threads_number_);
+    for (std::size_t t = 0; t != this->threads_number_; ++t) {
+        threads.emplace_back(std::thread(search_range, loop_manager.LoopStartId(t), loop_manager.LoopEndId(t),
+                                         std::ref(thread_spheres_ids[t])));
+    }
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    // Concatenate the thread results in thread order.
+    std::size_t ids_num = 0;
+    for (const auto &ids : thread_spheres_ids) { ids_num += ids.IdsNum(); }
+    spheres_ids.Reserve(query_points.size(), ids_num);
+    for (auto &ids : thread_spheres_ids) {
+        spheres_ids.AppendLists(ids);
+        ids.Release();
+    }
+
+    return spheres_ids;
+}
+
+
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SUPPORT_DOMAIN_CELL_LIST_SEARCH_TPP_
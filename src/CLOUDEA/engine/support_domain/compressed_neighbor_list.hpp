@@ -0,0 +1,361 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file compressed_neighbor_list.hpp
+   \brief CompressedNeighborList class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_SUPPORT_DOMAIN_COMPRESSED_NEIGHBOR_LIST_HPP_
+#define CLOUDEA_SUPPORT_DOMAIN_COMPRESSED_NEIGHBOR_LIST_HPP_
+
+
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/** \addtogroup Meshfree \{ */
+
+
+/**
+ * \class CompressedNeighborList
+ * \author Konstantinos A. Mountris
+ * \brief Read-only compressed storage of the neighbor indices of a set of points.
+ *
+ * The neighbor indices of each point are stored as a 32-bit base index (the smallest neighbor index of the point)
+ * and 16-bit offsets from the base. Points with neighbor indices spanning more than 65535 are stored uncompressed
+ * as pairs of 16-bit words. After a spatial reordering of the nodes almost all points are compressed, halving the
+ * memory traffic of the neighbor indices. The order of the neighbor indices of each point is preserved.
+ * The offsets of the points in the words container are 32-bit, limiting the list to 2^32-1 words.
+ */
+class CompressedNeighborList
+{
+private:
+
+    std::vector<std::uint32_t> offsets_;                   /**< The offsets of the 16-bit words of each point in the words container */
+
+    std::vector<std::uint16_t> words_;                     /**< The 16-bit offsets or split 32-bit neighbor indices of all the points */
+
+    std::vector<std::int32_t> bases_;                      /**< The base neighbor index of each point. Negative for uncompressed points */
+
+
+    /**
+     * \brief Encode the neighbor indices of a point at the end of a words container.
+     * \param [in] ids The neighbor indices of the point.
+     * \param [in,out] words The words container where the encoded neighbor indices are appended.
+     * \return [std::int32_t] The base neighbor index of the point. Negative if the neighbor indices are stored uncompressed.
+     */
+    static inline std::int32_t EncodeList(const NeighborSpan &ids, std::vector<std::uint16_t> &words)
+    {
+        // Get the span of the neighbor indices of the point.
+        int min_id = 0, max_id = 0;
+        if (!ids.empty()) {
+            auto min_max = std::minmax_element(ids.begin(), ids.end());
+            min_id = *min_max.first;
+            max_id = *min_max.second;
+        }
+
+        if (min_id < 0) {
+            throw std::invalid_argument(Logger::Error("Could not compress neighbor list. Negative neighbor index found.").c_str());
+        }
+
+        if (static_cast<std::int64_t>(max_id) - min_id <= std::numeric_limits<std::uint16_t>::max()) {
+            // Store the offsets from the base index.
+            for (const auto &id : ids) { words.emplace_back(static_cast<std::uint16_t>(id - min_id)); }
+            return min_id;
+        }
+
+        // Store the neighbor indices uncompressed in low and high 16-bit words.
+        for (const auto &id : ids) {
+            auto value = static_cast<std::uint32_t>(id);
+            words.emplace_back(static_cast<std::uint16_t>(value & 0xFFFF));
+            words.emplace_back(static_cast<std::uint16_t>(value >> 16));
+        }
+        return -1;
+    }
+
+
+    /**
+     * \brief Append the offset of the end of the words container after the words of a point.
+     * \return [void]
+     */
+    inline void AppendOffset()
+    {
+        if (this->words_.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error(Logger::Error("Could not compress neighbor list. Too many neighbor indices for 32-bit offsets.").c_str());
+        }
+        this->offsets_.emplace_back(static_cast<std::uint32_t>(this->words_.size()));
+    }
+
+
+public:
+
+    /**
+     * \brief CompressedNeighborList default constructor.
+     */
+    inline CompressedNeighborList() : offsets_(1, 0), words_(), bases_() {}
+
+
+    /**
+     * \brief CompressedNeighborList constructor compressing a neighbor list.
+     * \param [in] neighbor_ids The neighbor list to be compressed.
+     */
+    inline explicit CompressedNeighborList(const NeighborList &neighbor_ids) : CompressedNeighborList()
+    {
+        this->Compress(neighbor_ids);
+    }
+
+
+    /**
+     * \brief Compress a neighbor list. Previously stored neighbor indices are discarded.
+     * \param [in] neighbor_ids The neighbor list to be compressed.
+     * \return [void]
+     */
+    inline void Compress(const NeighborList &neighbor_ids)
+    {
+        this->offsets_.clear();
+        this->words_.clear();
+        this->bases_.clear();
+
+        this->offsets_.reserve(neighbor_ids.ListsNum()+1);
+        this->bases_.reserve(neighbor_ids.ListsNum());
+        this->words_.reserve(neighbor_ids.IdsNum());
+        this->offsets_.emplace_back(0);
+
+        for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+            this->bases_.emplace_back(EncodeList(neighbor_ids[i], this->words_));
+            this->AppendOffset();
+        }
+
+        this->words_.shrink_to_fit();
+    }
+
+
+    /**
+     * \brief Update the compressed neighbor indices of some points.
+     *
+     * Only the updated points are encoded. Their words are overwritten in place if the number of words of each
+     * updated point is unchanged. Otherwise the words container is rebuilt, copying the encoded words of the other points.
+     * Points appended to the neighbor list after the compression must be included in the updated points.
+     *
+     * \param [in] neighbor_ids The neighbor list after the update.
+     * \param [in] lists_ids The indices of the updated points.
+     * \return [void]
+     */
+    inline void Update(const NeighborList &neighbor_ids, const std::vector<int> &lists_ids)
+    {
+        const std::size_t prev_lists_num = this->ListsNum();
+        if (neighbor_ids.ListsNum() < prev_lists_num) {
+            throw std::invalid_argument(Logger::Error("Could not update compressed neighbor list. Points can not be removed.").c_str());
+        }
+
+        // Map each point to its index in the updated points.
+        std::vector<int> replacement(neighbor_ids.ListsNum(), -1);
+        for (std::size_t k = 0; k != lists_ids.size(); ++k) {
+            if (lists_ids[k] < 0 || static_cast<std::size_t>(lists_ids[k]) >= neighbor_ids.ListsNum()) {
+                throw std::out_of_range(Logger::Error("Could not update compressed neighbor list. Point index is out of range.").c_str());
+            }
+            replacement[lists_ids[k]] = static_cast<int>(k);
+        }
+        if (std::find(replacement.begin() + static_cast<std::ptrdiff_t>(prev_lists_num), replacement.end(), -1) != replacement.end()) {
+            throw std::invalid_argument(Logger::Error("Could not update compressed neighbor list. The appended points must be updated.").c_str());
+        }
+
+        // Encode the updated points.
+        std::vector<std::uint16_t> new_words;
+        std::vector<std::size_t> new_offsets(1, 0);
+        std::vector<std::int32_t> new_bases;
+        new_bases.reserve(lists_ids.size());
+        bool in_place = neighbor_ids.ListsNum() == prev_lists_num;
+        for (const auto &i : lists_ids) {
+            new_bases.emplace_back(EncodeList(neighbor_ids[static_cast<std::size_t>(i)], new_words));
+            new_offsets.emplace_back(new_words.size());
+            in_place = in_place && (new_offsets.back() - new_offsets[new_offsets.size()-2] == this->offsets_[i+1] - this->offsets_[i]);
+        }
+
+        // Overwrite the words of the updated points if their number is unchanged.
+        if (in_place) {
+            for (std::size_t k = 0; k != lists_ids.size(); ++k) {
+                std::copy(new_words.begin() + static_cast<std::ptrdiff_t>(new_offsets[k]),
+                          new_words.begin() + static_cast<std::ptrdiff_t>(new_offsets[k+1]), this->words_.begin() + this->offsets_[lists_ids[k]]);
+                this->bases_[lists_ids[k]] = new_bases[k];
+            }
+            return;
+        }
+
+        // Rebuild the words container with the encoded words of the other points.
+        CompressedNeighborList updated;
+        updated.offsets_.reserve(neighbor_ids.ListsNum()+1);
+        updated.bases_.reserve(neighbor_ids.ListsNum());
+        updated.words_.reserve(this->words_.size() + new_words.size());
+        for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+            auto k = replacement[i];
+            if (k == -1) {
+                updated.words_.insert(updated.words_.end(), this->words_.begin() + this->offsets_[i], this->words_.begin() + this->offsets_[i+1]);
+                updated.bases_.emplace_back(this->bases_[i]);
+            }
+            else {
+                updated.words_.insert(updated.words_.end(), new_words.begin() + static_cast<std::ptrdiff_t>(new_offsets[k]),
+                                      new_words.begin() + static_cast<std::ptrdiff_t>(new_offsets[k+1]));
+                updated.bases_.emplace_back(new_bases[k]);
+            }
+            updated.AppendOffset();
+        }
+        updated.words_.shrink_to_fit();
+        *this = std::move(updated);
+    }
+
+
+    /**
+     * \brief Decompress the neighbor indices of all the points.
+     * \return [NeighborList] The decompressed neighbor list.
+     */
+    inline NeighborList Decompress() const
+    {
+        std::vector<std::size_t> sizes(this->ListsNum());
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) { sizes[i] = this->ListSize(i); }
+
+        NeighborList neighbor_ids;
+        neighbor_ids.Allocate(sizes);
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) { this->Decode(i, neighbor_ids.Data(i)); }
+        return neighbor_ids;
+    }
+
+
+    /**
+     * \brief Apply a function on the neighbor indices of a point, decoding them on the fly.
+     * \param [in] i The index of the point.
+     * \param [in] func The function called as func(k, id) for the k-th neighbor index id of the point.
+     * \return [void]
+     */
+    template <typename FUNC>
+    inline void ForEach(std::size_t i, FUNC &&func) const
+    {
+        const std::uint16_t *words = this->words_.data()+this->offsets_[i];
+        std::size_t words_num = this->offsets_[i+1] - this->offsets_[i];
+        std::int32_t base = this->bases_[i];
+
+        if (base >= 0) {
+            for (std::size_t k = 0; k != words_num; ++k) { func(k, static_cast<int>(base + words[k])); }
+        }
+        else {
+            for (std::size_t k = 0; k != words_num/2; ++k) {
+                auto value = static_cast<std::uint32_t>(words[2*k]) | (static_cast<std::uint32_t>(words[2*k+1]) << 16);
+                func(k, static_cast<int>(value));
+            }
+        }
+    }
+
+
+    /**
+     * \brief Decode the neighbor indices of a point.
+     * \param [in] i The index of the point.
+     * \param [out] ids Pointer to storage for ListSize(i) neighbor indices.
+     * \return [void]
+     */
+    inline void Decode(std::size_t i, int *ids) const
+    {
+        this->ForEach(i, [ids](std::size_t k, int id) { ids[k] = id; });
+    }
+
+
+    /**
+     * \brief Get the number of neighbor indices of a point.
+     * \param [in] i The index of the point.
+     * \return [std::size_t] The number of neighbor indices of the point.
+     */
+    inline std::size_t ListSize(std::size_t i) const
+    {
+        std::size_t words_num = this->offsets_[i+1] - this->offsets_[i];
+        return this->bases_[i] >= 0 ? words_num : words_num/2;
+    }
+
+
+    /**
+     * \brief Check if the neighbor indices of a point are stored compressed.
+     * \param [in] i The index of the point.
+     * \return [bool] True if the neighbor indices of the point are stored as 16-bit offsets, false otherwise.
+     */
+    inline bool IsCompressed(std::size_t i) const { return this->bases_[i] >= 0; }
+
+
+    /**
+     * \brief Get the number of points in the list.
+     * \return [std::size_t] The number of points in the list.
+     */
+    inline std::size_t ListsNum() const { return this->bases_.size(); }
+
+
+    /**
+     * \brief Get the total number of neighbor indices in the list.
+     * \return [std::size_t] The total number of neighbor indices in the list.
+     */
+    inline std::size_t IdsNum() const
+    {
+        std::size_t ids_num = 0;
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) { ids_num += this->ListSize(i); }
+        return ids_num;
+    }
+
+
+    /**
+     * \brief Get the number of points with neighbor indices stored as 16-bit offsets.
+     * \return [std::size_t] The number of compressed points.
+     */
+    inline std::size_t CompressedListsNum() const
+    {
+        return static_cast<std::size_t>(std::count_if(this->bases_.begin(), this->bases_.end(), [](std::int32_t base) { return base >= 0; }));
+    }
+
+
+    /**
+     * \brief Check if the list contains no points.
+     * \return [bool] True if the list contains no points, false otherwise.
+     */
+    inline bool Empty() const { return this->bases_.empty(); }
+
+
+    /**
+     * \brief Get the memory owned by the list.
+     * \return [std::size_t] The memory in bytes.
+     */
+    inline std::size_t MemoryBytes() const
+    {
+        return this->offsets_.capacity()*sizeof(std::uint32_t) + this->words_.capacity()*sizeof(std::uint16_t) +
+               this->bases_.capacity()*sizeof(std::int32_t);
+    }
+
+};
+
+
+/*! \} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SUPPORT_DOMAIN_COMPRESSED_NEIGHBOR_LIST_HPP_
@@ -22,8 +22,26 @@
 
 namespace CLOUDEA {
 
-InfSupportDomain::InfSupportDomain()
-{}
+
+// FNV-1a hash over the bytes of the given value.
+static const std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+static void HashBytes(std::uint64_t &hash, const void *value, std::size_t bytes)
+{
+    const unsigned char *data = static_cast<const unsigned char *>(value);
+    for (std::size_t i = 0; i != bytes; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+
+InfSupportDomain::InfSupportDomain() : influence_nodes_(std::make_shared<const std::vector<Node> >()),
+    influence_tetras_(std::make_shared<const std::vector<Tetrahedron> >()), dilatation_coeff_(std::numeric_limits<double>::min()),
+    radius_mode_(SupportRadiusMode::dilatation), min_neighs_num_(0), max_neighs_num_(0), support_margin_(0.)
+{
+    // Use all the available hardware threads by default.
+    this->SetThreadsNumber(0);
+}
 
 
 InfSupportDomain::~InfSupportDomain()
@@ -32,117 +50,324 @@ InfSupportDomain::~InfSupportDomain()
 
 void InfSupportDomain::SetInfluenceNodes(const std::vector<Node> &nodes)
 {
-    // Clear the current influence nodes.
-    this->influence_nodes_.clear();
+    // Set a copy of the influence nodes.
+    this->influence_nodes_ = std::make_shared<const std::vector<Node> >(nodes);
+}
 
-    // Set the influence nodes.
+
+void InfSupportDomain::SetInfluenceNodes(const std::shared_ptr<const std::vector<Node> > &nodes)
+{
+    // Check if the nodes view is valid.
+    if (!nodes) {
+        throw std::invalid_argument(Logger::Error("Could not set the influence nodes. The given nodes view is empty.").c_str());
+    }
+
+    // Share the influence nodes.
     this->influence_nodes_ = nodes;
 }
 
 
 void InfSupportDomain::SetInfluenceTetrahedra(const std::vector<Tetrahedron> &tetras)
 {
-    // Clear the current influence tetrahedra.
-    this->influence_tetras_.clear();
+    // Set a copy of the influence tetrahedra.
+    this->influence_tetras_ = std::make_shared<const std::vector<Tetrahedron> >(tetras);
+}
+
+
+void InfSupportDomain::SetInfluenceTetrahedra(const std::shared_ptr<const std::vector<Tetrahedron> > &tetras)
+{
+    // Check if the tetrahedra view is valid.
+    if (!tetras) {
+        throw std::invalid_argument(Logger::Error("Could not set the influence tetrahedra. The given tetrahedra view is empty.").c_str());
+    }
 
-    // Set the influence tetrahedra.
+    // Share the influence tetrahedra.
     this->influence_tetras_ = tetras;
 }
 
 
+void InfSupportDomain::SetThreadsNumber(std::size_t threads_number)
+{
+    // Get the number of available hardware threads if not given.
+    if (threads_number == 0) {
+        const std::size_t available_threads = std::thread::hardware_concurrency();
+        threads_number = std::max(available_threads, std::size_t{1});
+    }
+
+    this->threads_number_ = threads_number;
+}
+
+
 void InfSupportDomain::ComputeInfluenceNodesRadiuses(double dilatation_coeff)
 {
     // Check for initialized influence nodes and elements.
-    if (this->influence_nodes_.empty() || this->influence_tetras_.empty()) {
+    if (this->influence_nodes_->empty() || this->influence_tetras_->empty()) {
         std::string error = "[CLOUDEA ERROR] Either influence nodes or influence tetrahedra were not initialized."
                             " Can't compute infuence radius.";
         throw std::runtime_error(error.c_str());
     }
 
-    // Clear the influence radiuses container.
-    this->influence_radiuses_.clear();
-
-    // Initialize the influence radiuses container.
-    this->influence_radiuses_.assign(this->influence_nodes_.size(), 0.);
+    // Store the dilatation coefficient to identify the support size of stored neighbor lists.
+    this->dilatation_coeff_ = dilatation_coeff;
+    this->radius_mode_ = SupportRadiusMode::dilatation;
+    this->min_neighs_num_ = 0;
+    this->max_neighs_num_ = 0;
+    this->support_margin_ = 0.;
+
+    // Extract the unique edges of the influence tetrahedra.
+    MeshEdges mesh_edges;
+    mesh_edges.SetThreadsNumber(this->threads_number_);
+    const auto &tetras = *this->influence_tetras_;
+    mesh_edges.Extract(this->influence_nodes_->size(), tetras.size(), MeshEdges::CellLocalEdges(4, true), 4,
+                       [&tetras](std::size_t tet_id, std::size_t local_id) {
+                           const auto &tetra = tetras[tet_id];
+                           return local_id == 0 ? tetra.N1() : (local_id == 1 ? tetra.N2() : (local_id == 2 ? tetra.N3() : tetra.N4()));
+                       });
+
+    // Store the coordinates of the influence nodes contiguously.
+    std::vector<double> coords(3*this->influence_nodes_->size());
+    for (const auto &node : *this->influence_nodes_) {
+        auto id = 3*static_cast<std::size_t>(&node - &(*this->influence_nodes_)[0]);
+        coords[id] = node.Coordinates().X();
+        coords[id+1] = node.Coordinates().Y();
+        coords[id+2] = node.Coordinates().Z();
+    }
 
-    // The number of connected nodes to each influence node.
-    std::vector<int> connected_nodes_number(this->influence_nodes_.size(), 0);
+    // Compute the length of each unique edge once.
+    mesh_edges.ComputeLengths([&coords](int n1, int n2) {
+        const double *c1 = &coords[3*static_cast<std::size_t>(n1)];
+        const double *c2 = &coords[3*static_cast<std::size_t>(n2)];
+        return std::sqrt( ( (c1[0]-c2[0]) * (c1[0]-c2[0]) ) +
+                          ( (c1[1]-c2[1]) * (c1[1]-c2[1]) ) +
+                          ( (c1[2]-c2[2]) * (c1[2]-c2[2]) ) );
+    });
 
+    // Set the influence radiuses to the mean length of the connected edges over all the elements of each influence node.
+    mesh_edges.MeanIncidentLengths(this->influence_radiuses_, true);
 
-    // The coordinates of the nodes of an influence element.
-    Vec3<double> n1(0., 0., 0.); Vec3<double> n2(0., 0., 0.);
-    Vec3<double> n3(0., 0., 0.); Vec3<double> n4(0., 0., 0.);
+    // Apply dilatation coefficient if given and is positive.
+    if (dilatation_coeff > 0.) {
+        std::transform(this->influence_radiuses_.begin(), this->influence_radiuses_.end(),
+                       this->influence_radiuses_.begin(), std::bind1st(std::multiplies<double>(), dilatation_coeff));
+    }
 
-    // The inter-node distances.
-    double d12 = 0.; double d13 = 0.; double d14 = 0.;
-    double d23 = 0.; double d24 = 0.; double d34 = 0.;
+}
 
-    // Iterate over the influence elements.
-    for (auto &tetra : this->influence_tetras_) {
-        // Extract element nodes coordinates.
-        n1.Set(this->influence_nodes_[tetra.N1()].Coordinates());
-        n2.Set(this->influence_nodes_[tetra.N2()].Coordinates());
-        n3.Set(this->influence_nodes_[tetra.N3()].Coordinates());
-        n4.Set(this->influence_nodes_[tetra.N4()].Coordinates());
 
-        // Calculate distances between element nodes.
-        d12 = std::sqrt( ( (n1.X()-n2.X()) * (n1.X()-n2.X()) ) +
-                         ( (n1.Y()-n2.Y()) * (n1.Y()-n2.Y()) ) +
-                         ( (n1.Z()-n2.Z()) * (n1.Z()-n2.Z()) ) );
+void InfSupportDomain::ComputeAdaptiveInfluenceNodesRadiuses(const std::vector<Vec3<double> > &eval_nodes_coords, int basis_size,
+                                                             int min_neighs_num, int max_neighs_num, double support_margin)
+{
+    typedef CGAL::Simple_cartesian<double> K;
+    typedef K::Point_3 Point_3d;
+    typedef boost::tuple<Point_3d,int> Point_and_int;
+    typedef CGAL::Search_traits_3<K> Traits_base;
+    typedef CGAL::Search_traits_adapter<Point_and_int,
+                                            CGAL::Nth_of_tuple_property_map<0, Point_and_int>, Traits_base> Traits;
+    typedef CGAL::Orthogonal_k_neighbor_search<Traits> K_neighbor_search;
+    typedef K_neighbor_search::Tree Tree;
+    typedef K_neighbor_search::Distance Distance;
 
-        d13 = std::sqrt( ( (n1.X()-n3.X()) * (n1.X()-n3.X()) ) +
-                         ( (n1.Y()-n3.Y()) * (n1.Y()-n3.Y()) ) +
-                         ( (n1.Z()-n3.Z()) * (n1.Z()-n3.Z()) ) );
+    // Check for valid evaluation nodes and target support nodes number.
+    if (eval_nodes_coords.empty()) {
+        throw std::invalid_argument(Logger::Error("Can not compute adaptive influence radiuses. No evaluation nodes were given.").c_str());
+    }
+    if (basis_size < 4) {
+        std::string error = Logger::Error("Can not compute adaptive influence radiuses. The basis size must be at least 4. Given: " +
+                                          std::to_string(basis_size));
+        throw std::invalid_argument(error.c_str());
+    }
+    if (min_neighs_num < basis_size || static_cast<std::size_t>(min_neighs_num) > this->influence_nodes_->size()) {
+        std::string error = Logger::Error("Can not compute adaptive influence radiuses. The minimum number of support nodes"
+                                          " must be at least the basis size (" + std::to_string(basis_size) +
+                                          ") and not larger than the number of influence nodes. Given: " + std::to_string(min_neighs_num));
+        throw std::invalid_argument(error.c_str());
+    }
+    if (max_neighs_num != 0 && max_neighs_num < min_neighs_num) {
+        std::string error = Logger::Error("Can not compute adaptive influence radiuses. The maximum number of support nodes"
+                                          " must be zero or not smaller than the minimum number of support nodes.");
+        throw std::invalid_argument(error.c_str());
+    }
+    if (support_margin <= 1.) {
+        throw std::invalid_argument(Logger::Error("Can not compute adaptive influence radiuses. The support margin must be larger than 1.").c_str());
+    }
 
-        d14 = std::sqrt( ( (n1.X()-n4.X()) * (n1.X()-n4.X()) ) +
-                         ( (n1.Y()-n4.Y()) * (n1.Y()-n4.Y()) ) +
-                         ( (n1.Z()-n4.Z()) * (n1.Z()-n4.Z()) ) );
+    // Compute the mesh-based influence radiuses without dilatation. Checks for initialized influence nodes and elements.
+    this->ComputeInfluenceNodesRadiuses(1.);
+    std::vector<double> mesh_radiuses = this->influence_radiuses_;
+
+    // Search trees of the influence nodes and the evaluation nodes.
+    std::vector<Point_3d> node_points, eval_points;
+    std::vector<int> node_ids, eval_ids;
+    node_points.reserve(this->influence_nodes_->size());
+    node_ids.reserve(this->influence_nodes_->size());
+    for (const auto &node : *this->influence_nodes_) {
+        node_points.emplace_back(Point_3d(node.Coordinates().X(), node.Coordinates().Y(), node.Coordinates().Z()));
+        node_ids.emplace_back(static_cast<int>(node_ids.size()));
+    }
+    eval_points.reserve(eval_nodes_coords.size());
+    eval_ids.reserve(eval_nodes_coords.size());
+    for (const auto &eval_node : eval_nodes_coords) {
+        eval_points.emplace_back(Point_3d(eval_node.X(), eval_node.Y(), eval_node.Z()));
+        eval_ids.emplace_back(static_cast<int>(eval_ids.size()));
+    }
 
-        d23 = std::sqrt( ( (n2.X()-n3.X()) * (n2.X()-n3.X()) ) +
-                         ( (n2.Y()-n3.Y()) * (n2.Y()-n3.Y()) ) +
-                         ( (n2.Z()-n3.Z()) * (n2.Z()-n3.Z()) ) );
+    Tree node_tree(boost::make_zip_iterator(boost::make_tuple(node_points.begin(), node_ids.begin())),
+                   boost::make_zip_iterator(boost::make_tuple(node_points.end(), node_ids.end())) );
+    Tree eval_tree(boost::make_zip_iterator(boost::make_tuple(eval_points.begin(), eval_ids.begin())),
+                   boost::make_zip_iterator(boost::make_tuple(eval_points.end(), eval_ids.end())) );
+
+    // Build the trees before the concurrent queries. The trees are built lazily otherwise.
+    node_tree.build();
+    eval_tree.build();
+
+    // Run the given loop in contiguous ranges, one per thread.
+    auto parallel_for = [this](std::size_t entries_num, const std::function<void(std::size_t, std::size_t, std::size_t)> &func) {
+        ThreadLoopManager loop_manager;
+        loop_manager.SetLoopRanges(entries_num, this->threads_number_);
+        std::size_t active_threads = this->threads_number_;
+        if (this->threads_number_ <= 1 || this->threads_number_ >= entries_num) { active_threads = 1; }
+
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1; t < active_threads; ++t) {
+            threads.emplace_back(std::thread(func, t, loop_manager.LoopStartId(t), loop_manager.LoopEndId(t)));
+        }
+        func(0, loop_manager.LoopStartId(0), loop_manager.LoopEndId(0));
+        std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+        return active_threads;
+    };
+
+    // Per-thread required influence radiuses to contain the min_neighs_num nearest influence nodes of each evaluation node.
+    std::size_t max_threads = std::max(this->threads_number_, std::size_t{1});
+    std::vector<std::vector<double> > thread_required(max_threads);
+    auto used_threads = parallel_for(eval_nodes_coords.size(), [&](std::size_t t, std::size_t start, std::size_t end) {
+        auto &required = thread_required[t];
+        required.assign(this->influence_nodes_->size(), 0.);
+
+        Distance tr_dist;
+        for (auto i = start; i != end; ++i) {
+            K_neighbor_search search(node_tree, eval_points[i], static_cast<unsigned int>(min_neighs_num));
+            for (K_neighbor_search::iterator it = search.begin(); it != search.end(); it++) {
+                auto nid = boost::get<1>(it->first);
+                double dist = support_margin * tr_dist.inverse_of_transformed_distance(it->second);
+                if (dist > required[nid]) { required[nid] = dist; }
+            }
+        }
+    });
 
-        d24 = std::sqrt( ( (n2.X()-n4.X()) * (n2.X()-n4.X()) ) +
-                         ( (n2.Y()-n4.Y()) * (n2.Y()-n4.Y()) ) +
-                         ( (n2.Z()-n4.Z()) * (n2.Z()-n4.Z()) ) );
+    // Reduce the per-thread required radiuses. The maximum is independent of the threads number.
+    std::vector<double> required_radiuses = std::move(thread_required[0]);
+    for (std::size_t t = 1; t < used_threads; ++t) {
+        for (std::size_t nid = 0; nid != required_radiuses.size(); ++nid) {
+            required_radiuses[nid] = std::max(required_radiuses[nid], thread_required[t][nid]);
+        }
+        thread_required[t].clear();
+        thread_required[t].shrink_to_fit();
+    }
 
-        d34 = std::sqrt( ( (n3.X()-n4.X()) * (n3.X()-n4.X()) ) +
-                         ( (n3.Y()-n4.Y()) * (n3.Y()-n4.Y()) ) +
-                         ( (n3.Z()-n4.Z()) * (n3.Z()-n4.Z()) ) );
+    // Each influence node must support at least its nearest evaluation node.
+    parallel_for(this->influence_nodes_->size(), [&](std::size_t, std::size_t start, std::size_t end) {
+        Distance tr_dist;
+        for (auto nid = start; nid != end; ++nid) {
+            K_neighbor_search search(eval_tree, node_points[nid], 1);
+            double dist = support_margin * tr_dist.inverse_of_transformed_distance(search.begin()->second);
+            if (dist > required_radiuses[nid]) { required_radiuses[nid] = dist; }
+        }
+    });
 
-        // Accumulate contribution in influence radiuses of the influence nodes of the element.
-        this->influence_radiuses_[tetra.N1()] += (d12 + d13 + d14);
-        this->influence_radiuses_[tetra.N2()] += (d12 + d23 + d24);
-        this->influence_radiuses_[tetra.N3()] += (d13 + d23 + d34);
-        this->influence_radiuses_[tetra.N4()] += (d14 + d24 + d34);
+    // Influence nodes not required by the evaluation nodes keep their mesh-based influence radius.
+    for (std::size_t nid = 0; nid != this->influence_radiuses_.size(); ++nid) {
+        this->influence_radiuses_[nid] = std::max(mesh_radiuses[nid], required_radiuses[nid]);
+    }
 
-        // Accumulate number of connected nodes to the influence nodes of the element.
-        connected_nodes_number[tetra.N1()] += 3;
-        connected_nodes_number[tetra.N2()] += 3;
-        connected_nodes_number[tetra.N3()] += 3;
-        connected_nodes_number[tetra.N4()] += 3;
+    // Shrink to the required radius the influence nodes of evaluation nodes with too many support nodes.
+    if (max_neighs_num != 0) {
+        auto neighbor_ids = this->CellListClosestNodesIdsTo(eval_nodes_coords);
+        std::vector<char> shrink(this->influence_nodes_->size(), 0);
+        for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+            if (neighbor_ids.ListSize(i) <= static_cast<std::size_t>(max_neighs_num)) { continue; }
+            for (const auto &nid : neighbor_ids[i]) { shrink[nid] = 1; }
+        }
+        for (std::size_t nid = 0; nid != shrink.size(); ++nid) {
+            if (shrink[nid]) { this->influence_radiuses_[nid] = required_radiuses[nid]; }
+        }
     }
 
-    // Normalize the influence radiuses with the number of connected nodes for each influence node.
-    for (auto &radius : this->influence_radiuses_) {
-        // Index of the current influence node.
-        auto id = &radius - &this->influence_radiuses_[0];
+    // Record the support parameters to identify stored neighbor lists.
+    this->radius_mode_ = SupportRadiusMode::target_count;
+    this->min_neighs_num_ = min_neighs_num;
+    this->max_neighs_num_ = max_neighs_num;
+    this->support_margin_ = support_margin;
+
+}
 
-        // Normalize the influence radius of the current influence node.
-        radius /= connected_nodes_number[id];
 
+void InfSupportDomain::PrintSupportSizes(const NeighborList &neighbor_ids, const NeighborList &reference_ids, int basis_size) const
+{
+    // Check for non-empty neighbor lists.
+    if (neighbor_ids.Empty()) {
+        throw std::invalid_argument(Logger::Error("Can not print support sizes. The given neighbor lists are empty.").c_str());
     }
 
-    // Apply dilatation coefficient if given and is positive.
-    if (dilatation_coeff > 0.) {
-        std::transform(this->influence_radiuses_.begin(), this->influence_radiuses_.end(),
-                       this->influence_radiuses_.begin(), std::bind1st(std::multiplies<double>(), dilatation_coeff));
+    // Estimated flops of an evaluation node with the given support nodes number.
+    // MMLS construction: moment matrix and its three derivatives (2m^2 n each), B matrix and its
+    // three derivatives (m n each), shape function and derivatives (2m n each), and factorization (m^3).
+    // MTLED step: deformation gradient (18n) and nodal forces (18n).
+    const double m = static_cast<double>(basis_size);
+    auto mmls_flops = [m](std::size_t n) { return 4.*(2.*m*m + 3.*m)*static_cast<double>(n) + m*m*m; };
+    auto step_flops = [](std::size_t n) { return 36.*static_cast<double>(n); };
+
+    // Total estimated flops of the given neighbor lists.
+    auto total_flops = [&](const NeighborList &ids, double &mmls, double &step) {
+        mmls = 0.; step = 0.;
+        for (std::size_t i = 0; i != ids.ListsNum(); ++i) {
+            mmls += mmls_flops(ids.ListSize(i));
+            step += step_flops(ids.ListSize(i));
+        }
+    };
+
+    // Support nodes number statistics.
+    int min_num = this->MinSupportNodesIn(neighbor_ids);
+    int max_num = this->MaxSupportNodesIn(neighbor_ids);
+    double mean_num = static_cast<double>(neighbor_ids.IdsNum()) / static_cast<double>(neighbor_ids.ListsNum());
+
+    // Histogram of the support nodes number in at most 10 bins.
+    int bin_width = std::max(1, (max_num - min_num + 10) / 10);
+    std::vector<std::size_t> histogram((max_num - min_num) / bin_width + 1, 0);
+    for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+        histogram[(static_cast<int>(neighbor_ids.ListSize(i)) - min_num) / bin_width]++;
     }
 
+    std::cout << Logger::Message("Support nodes number of ") << neighbor_ids.ListsNum() << " evaluation nodes - min: "
+              << min_num << " / mean: " << std::fixed << std::setprecision(2) << mean_num << " / max: " << max_num << "\n";
+    for (const auto &bin : histogram) {
+        int bin_start = min_num + static_cast<int>(&bin - &histogram[0])*bin_width;
+        std::cout << "    [" << std::setw(5) << bin_start << " - " << std::setw(5) << bin_start + bin_width - 1 << "]: "
+                  << std::setw(10) << bin << "  (" << std::setw(6) << 100.*bin/neighbor_ids.ListsNum() << "%)\n";
+    }
+
+    // Estimated flops.
+    double mmls = 0., step = 0.;
+    total_flops(neighbor_ids, mmls, step);
+    std::cout << Logger::Message("Estimated MMLS construction flops: ") << std::scientific << std::setprecision(3) << mmls
+              << " / MTLED step flops: " << step << "\n";
+
+    // Change of the estimated flops with respect to the reference neighbor lists.
+    if (!reference_ids.Empty()) {
+        double ref_mmls = 0., ref_step = 0.;
+        total_flops(reference_ids, ref_mmls, ref_step);
+        std::cout << Logger::Message("Reference support nodes number - min: ") << this->MinSupportNodesIn(reference_ids)
+                  << " / max: " << this->MaxSupportNodesIn(reference_ids) << "\n";
+        std::cout << Logger::Message("Estimated flops change - MMLS construction: ") << std::fixed << std::setprecision(2)
+                  << 100.*(mmls - ref_mmls)/ref_mmls << "% / MTLED step: " << 100.*(step - ref_step)/ref_step << "%\n";
+    }
+
+    // Restore the default stream format.
+    std::cout << std::defaultfloat << std::setprecision(6);
+
 }
 
 
-const std::vector<std::vector<int> > InfSupportDomain::ClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const
+const NeighborList InfSupportDomain::ClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const
 {
     //Check if influence radiuses have been initialized.
     if (this->influence_radiuses_.empty()) {
@@ -152,7 +377,8 @@ const std::vector<std::vector<int> > InfSupportDomain::ClosestNodesIdsTo(const s
     }
 
     // Container with lists of closest nodes indices to the given nodes.
-    std::vector<std::vector<int> > closest_nodes_ids;
+    NeighborList closest_nodes_ids;
+    closest_nodes_ids.Reserve(eval_nodes_coords.size(), 0);
 
     // Neighbors indices of a node.
     std::vector<int> neighbors_indices;
@@ -164,8 +390,8 @@ const std::vector<std::vector<int> > InfSupportDomain::ClosestNodesIdsTo(const s
     for (auto &eval_node : eval_nodes_coords) {
 
         // Exhaustive check over all influence nodes.
-        for (auto &neighbor : this->influence_nodes_) {
-            auto neighbor_id = &neighbor - &this->influence_nodes_[0];
+        for (auto &neighbor : *this->influence_nodes_) {
+            auto neighbor_id = &neighbor - &(*this->influence_nodes_)[0];
 
             // Set squared distance between node and neighbor.
             squared_dist.SetX((neighbor.Coordinates().X() - eval_node.X()) *
@@ -186,7 +412,7 @@ const std::vector<std::vector<int> > InfSupportDomain::ClosestNodesIdsTo(const s
         }
 
         // Store the list of neighbors.
-        closest_nodes_ids.push_back(neighbors_indices);
+        closest_nodes_ids.Append(neighbors_indices.begin(), neighbors_indices.end());
 
         // Clear neighbors container to prepare for next evaluation node.
         neighbors_indices.clear();
@@ -199,7 +425,7 @@ const std::vector<std::vector<int> > InfSupportDomain::ClosestNodesIdsTo(const s
 }
 
 
-const std::vector<std::vector<int> > InfSupportDomain::CgalClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const
+const NeighborList InfSupportDomain::CgalClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const
 {
     typedef CGAL::Simple_cartesian<double> K;
     typedef K::Point_3 Point_3d;
@@ -218,13 +444,11 @@ const std::vector<std::vector<int> > InfSupportDomain::CgalClosestNodesIdsTo(con
         throw std::runtime_error(error.c_str());
     }
 
-    // Container with lists of closest nodes indices to the given nodes.
-    std::vector<std::vector<int> > closest_nodes_ids;
-    closest_nodes_ids.resize(eval_nodes_coords.size());
-
     //Vectors to store coordinates and ids of point to be passed in tree tuples.
     std::vector<Point_3d> points;
     std::vector<int> id;
+    points.reserve(eval_nodes_coords.size());
+    id.reserve(eval_nodes_coords.size());
 
     for(auto &eval_node : eval_nodes_coords) {
         auto idx = &eval_node - &eval_nodes_coords[0];
@@ -237,40 +461,101 @@ const std::vector<std::vector<int> > InfSupportDomain::CgalClosestNodesIdsTo(con
     Tree tree(boost::make_zip_iterator(boost::make_tuple(points.begin(), id.begin() )),
               boost::make_zip_iterator(boost::make_tuple(points.end(), id.end() )) );
 
-    //Vector containing the domain nodes for a given grid node.
-    std::vector<Point_and_int> domain_nodes;
+    // Build the tree before the concurrent queries. The tree is built lazily otherwise.
+    tree.build();
+
+    // Split the influence nodes in contiguous ranges, one per thread.
+    ThreadLoopManager loop_manager;
+    loop_manager.SetLoopRanges(this->influence_nodes_->size(), this->threads_number_);
+    std::size_t active_threads = this->threads_number_;
+    if (this->threads_number_ <= 1 || this->threads_number_ >= this->influence_nodes_->size()) { active_threads = 1; }
+
+    // Per-thread lists of the evaluation nodes found in the sphere of each influence node in the thread's range.
+    std::vector<NeighborList> thread_found_ids(active_threads);
 
-    //Search domain_nodes for each grid node.
-    for(auto &node : this->influence_nodes_) {
-        auto i = &node - &this->influence_nodes_[0];
+    // Search the evaluation nodes in the influence sphere of each influence node of the thread's range.
+    auto search_range = [&](std::size_t t) {
+        //Vector containing the domain nodes for a given grid node.
+        std::vector<Point_and_int> domain_nodes;
+        std::vector<int> domain_nodes_ids;
 
-        Point_3d center(node.Coordinates().X(), node.Coordinates().Y(), node.Coordinates().Z());
+        auto &found_ids = thread_found_ids[t];
+        found_ids.Reserve(loop_manager.LoopEndId(t) - loop_manager.LoopStartId(t), 0);
 
-        // Searching sphere.
-        Fuzzy_sphere fs(center, this->influence_radiuses_[i]);
+        for (auto i = loop_manager.LoopStartId(t); i != loop_manager.LoopEndId(t); ++i) {
+            const auto &node = (*this->influence_nodes_)[i];
+            Point_3d center(node.Coordinates().X(), node.Coordinates().Y(), node.Coordinates().Z());
 
-        //Neighbors search
-        tree.search( std::back_inserter(domain_nodes), fs);
+            // Searching sphere.
+            Fuzzy_sphere fs(center, this->influence_radiuses_[i]);
+
+            //Neighbors search
+            tree.search( std::back_inserter(domain_nodes), fs);
 
-        //Iterate over domain nodes.
-        for (auto &domain_node : domain_nodes) {
             //Store domain nodes indices.
-            closest_nodes_ids[boost::get<1>(domain_node)].emplace_back(i);
+            for (auto &domain_node : domain_nodes) { domain_nodes_ids.emplace_back(boost::get<1>(domain_node)); }
+            found_ids.Append(domain_nodes_ids.begin(), domain_nodes_ids.end());
 
-            // std::cout << boost::get<1>(domain_node) << " ";
+            // Empty domain_nodes vectors for next iteration.
+            domain_nodes.clear();
+            domain_nodes_ids.clear();
         }
-        
-        // Empty domain_nodes vector for next iteration.
-        domain_nodes.clear();
+    };
+
+    // Run the search in parallel.
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < active_threads; ++t) { threads.emplace_back(std::thread(search_range, t)); }
+    search_range(0);
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    // Concatenate the thread results in thread order to get the evaluation nodes in the sphere of each influence node.
+    NeighborList found_eval_ids;
+    std::size_t found_num = 0;
+    for (const auto &found_ids : thread_found_ids) { found_num += found_ids.IdsNum(); }
+    found_eval_ids.Reserve(this->influence_nodes_->size(), found_num);
+    for (auto &found_ids : thread_found_ids) {
+        found_eval_ids.AppendLists(found_ids);
+
+        // Release the thread results once merged.
+        found_ids.Release();
     }
 
+    // Transpose to get the closest nodes of each evaluation node.
+    // The influence nodes are traversed in increasing order, thus the closest nodes indices are stored in increasing order.
+    NeighborList closest_nodes_ids = found_eval_ids.Transposed(eval_nodes_coords.size());
+
     // Return the indices of the closest nodes to each evaluation point.
     return closest_nodes_ids;
 
 }
 
 
-const std::vector<std::vector<int> > InfSupportDomain::LoadClosestNodesFrom(const std::string &closest_nodes_file) const
+const NeighborList InfSupportDomain::CellListClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const
+{
+    //Check if influence radiuses have been initialized.
+    if (this->influence_radiuses_.empty()) {
+        std::string error = "[CLOUDEA ERROR] Can not find closest nodes without knowing the influence radiuses."
+                            " Compute influence radiuses first";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Collect the centers of the influence spheres.
+    std::vector<Vec3<double> > centers;
+    centers.reserve(this->influence_nodes_->size());
+    for (const auto &node : *this->influence_nodes_) { centers.emplace_back(node.Coordinates()); }
+
+    // Search the influence spheres containing each evaluation node.
+    CellListSearch<3> cell_list;
+    cell_list.SetThreadsNumber(this->threads_number_);
+    cell_list.SetSpheres(centers, this->influence_radiuses_);
+
+    return cell_list.ContainingSpheresIds(eval_nodes_coords);
+
+}
+
+
+const NeighborList InfSupportDomain::LoadClosestNodesFrom(const std::string &closest_nodes_file,
+                                                          const std::vector<Vec3<double> > &eval_nodes_coords) const
 {
     // Print reading status message.
     std::cout << Logger::Message("Reading neighbors list file: ") << closest_nodes_file << "\n";
@@ -280,10 +565,17 @@ const std::vector<std::vector<int> > InfSupportDomain::LoadClosestNodesFrom(cons
         throw std::invalid_argument(Logger::Error("No filename was given to read neighbors").c_str());
     }
 
+    // Load binary neighbors list files for the current mesh, evaluation nodes and dilatation coefficient.
+    auto ext_pos = closest_nodes_file.find_last_of('.');
+    std::string ext = (ext_pos == std::string::npos) ? "" : closest_nodes_file.substr(ext_pos);
+    if (ext == ".nbl") {
+        NeighborListIO nbl_io;
+        return nbl_io.Load(closest_nodes_file, this->ClosestNodesKey(eval_nodes_coords));
+    }
+
     // Check if file has .txt extension.
-    std::string ext = closest_nodes_file.substr(closest_nodes_file.length()-4);
     if (ext != ".txt") {
-        std::string error = Logger::Error("The neighbors list file \"") + closest_nodes_file + "\" is not in .txt format";
+        std::string error = Logger::Error("The neighbors list file \"") + closest_nodes_file + "\" is not in .txt or .nbl format";
         throw std::invalid_argument(error.c_str());
     }
 
@@ -297,45 +589,356 @@ const std::vector<std::vector<int> > InfSupportDomain::LoadClosestNodesFrom(cons
     }
 
     // Make neighbors list container
-    std::vector<std::vector<int> > neighbors_ids;
+    NeighborList neighbors_ids;
 
     // Process file
     std::string line("");
+    std::vector<int> indices;
     while (std::getline(neigh_list, line)) {
 
         // Skip empty lines and comment lines starting with "*".
         if (!line.empty() && line.find("*") == std::string::npos) {
 
-            // Convert line to stringstream
-            std::stringstream ss(line);
-
             // Get neighbor indices for this line
-            int id;
-            std::vector<int> indices;
-            while(ss >> id) { indices.emplace_back(id-1); }
+            indices.clear();
+            const char *pos = line.c_str();
+            char *end = nullptr;
+            for (long id = std::strtol(pos, &end, 10); end != pos; id = std::strtol(pos, &end, 10)) {
+                indices.emplace_back(static_cast<int>(id-1));
+                pos = end;
+            }
 
             // Store neighbors to the neighbors list
-            neighbors_ids.emplace_back(indices);
+            neighbors_ids.Append(indices.begin(), indices.end());
         }
 
     } // End Process file
 
     neigh_list.close();
 
+    // Check that the neighbors list matches the evaluation nodes and the influence nodes.
+    if (neighbors_ids.ListsNum() != eval_nodes_coords.size()) {
+        std::string error = Logger::Error("The neighbors list file \"") + closest_nodes_file + "\" has " +
+                            std::to_string(neighbors_ids.ListsNum()) + " lists for " + std::to_string(eval_nodes_coords.size()) + " evaluation nodes";
+        throw std::runtime_error(error.c_str());
+    }
+    auto nodes_num = static_cast<int>(this->influence_nodes_->size());
+    for (std::size_t k = 0; k != neighbors_ids.IdsNum(); ++k) {
+        if (neighbors_ids.IdsData()[k] < 0 || neighbors_ids.IdsData()[k] >= nodes_num) {
+            std::string error = Logger::Error("The neighbors list file \"") + closest_nodes_file + "\" stores the index " +
+                                std::to_string(neighbors_ids.IdsData()[k]+1) + " outside the " + std::to_string(nodes_num) + " influence nodes";
+            throw std::runtime_error(error.c_str());
+        }
+    }
+
     return neighbors_ids;
 
 }
 
 
-int InfSupportDomain::MinSupportNodesIn(const std::vector<std::vector<int> > &neighbor_ids) const
+void InfSupportDomain::SaveClosestNodesTo(const std::string &closest_nodes_file, const std::vector<Vec3<double> > &eval_nodes_coords,
+                                          const NeighborList &neighbor_ids, bool compress) const
+{
+    // Check if file has .nbl extension.
+    auto ext_pos = closest_nodes_file.find_last_of('.');
+    if (ext_pos == std::string::npos || closest_nodes_file.substr(ext_pos) != ".nbl") {
+        std::string error = Logger::Error("The binary neighbors list file \"") + closest_nodes_file + "\" is not in .nbl format";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    NeighborListIO nbl_io;
+    nbl_io.Save(closest_nodes_file, neighbor_ids, this->ClosestNodesKey(eval_nodes_coords), compress);
+}
+
+
+std::uint64_t InfSupportDomain::MeshHash() const
+{
+    std::uint64_t hash = fnv_offset_basis;
+
+    // Hash the coordinates of the influence nodes.
+    std::uint64_t nodes_num = this->influence_nodes_->size();
+    HashBytes(hash, &nodes_num, sizeof(nodes_num));
+    for (const auto &node : *this->influence_nodes_) {
+        double coords[3] = {node.Coordinates().X(), node.Coordinates().Y(), node.Coordinates().Z()};
+        HashBytes(hash, coords, sizeof(coords));
+    }
+
+    // Hash the connectivity of the influence tetrahedra.
+    std::uint64_t tetras_num = this->influence_tetras_->size();
+    HashBytes(hash, &tetras_num, sizeof(tetras_num));
+    for (const auto &tetra : *this->influence_tetras_) {
+        std::int32_t conn[4] = {tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()};
+        HashBytes(hash, conn, sizeof(conn));
+    }
+
+    return hash;
+}
+
+
+NeighborListKey InfSupportDomain::ClosestNodesKey(const std::vector<Vec3<double> > &eval_nodes_coords) const
+{
+    // Hash the coordinates of the evaluation nodes.
+    std::uint64_t points_hash = fnv_offset_basis;
+    for (const auto &coords : eval_nodes_coords) {
+        double values[3] = {coords.X(), coords.Y(), coords.Z()};
+        HashBytes(points_hash, values, sizeof(values));
+    }
+
+    NeighborListKey key;
+    key.mesh_hash = this->MeshHash();
+    key.nodes_num = this->influence_nodes_->size();
+    key.points_num = eval_nodes_coords.size();
+    key.points_hash = points_hash;
+    key.dilatation_coeff = this->dilatation_coeff_;
+    key.radius_mode = this->radius_mode_;
+    key.min_neighs_num = static_cast<std::uint32_t>(this->min_neighs_num_);
+    key.max_neighs_num = static_cast<std::uint32_t>(this->max_neighs_num_);
+    key.support_margin = this->support_margin_;
+    return key;
+}
+
+
+std::vector<int> InfSupportDomain::UpdateInfluenceNodes(const std::vector<Node> &nodes, const std::vector<Tetrahedron> &tetras,
+                                                        const std::vector<int> &edited_nodes_ids, double dilatation_coeff)
+{
+    // Check if influence radiuses have been initialized.
+    if (this->influence_radiuses_.size() != this->influence_nodes_->size() || this->influence_radiuses_.empty()) {
+        std::string error = Logger::Error("Can not update influence nodes without knowing the influence radiuses."
+                                          " Compute influence radiuses first");
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Check that no influence nodes have been removed.
+    if (nodes.size() < this->influence_nodes_->size()) {
+        std::string error = Logger::Error("Can not update influence nodes incrementally after node removal."
+                                          " Compute influence radiuses from scratch");
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Keep the previous nodes number and influence radiuses to detect the modified nodes.
+    std::size_t prev_nodes_num = this->influence_nodes_->size();
+    std::vector<double> prev_radiuses = this->influence_radiuses_;
+    prev_radiuses.resize(nodes.size(), 0.);
+
+    // Keep the previous influence tetrahedra to detect the added and removed elements.
+    auto prev_tetras = this->influence_tetras_;
+
+    // Set the edited influence nodes and tetrahedra. The updated radiuses are mesh-based.
+    this->dilatation_coeff_ = dilatation_coeff;
+    this->radius_mode_ = SupportRadiusMode::dilatation;
+    this->min_neighs_num_ = 0;
+    this->max_neighs_num_ = 0;
+    this->support_margin_ = 0.;
+    this->influence_nodes_ = std::make_shared<const std::vector<Node> >(nodes);
+    this->influence_tetras_ = std::make_shared<const std::vector<Tetrahedron> >(tetras);
+    this->influence_radiuses_.resize(this->influence_nodes_->size(), 0.);
+
+    // Flag the edited nodes.
+    std::vector<char> is_edited(this->influence_nodes_->size(), 0);
+    for (const auto &node_id : edited_nodes_ids) {
+        if (node_id < 0 || node_id >= static_cast<int>(is_edited.size())) {
+            std::string error = Logger::Error("Can not update influence nodes. Edited node index is out of range.");
+            throw std::out_of_range(error.c_str());
+        }
+        is_edited[node_id] = 1;
+    }
+
+    // Appended nodes are always considered edited.
+    for (std::size_t id = prev_nodes_num; id != is_edited.size(); ++id) { is_edited[id] = 1; }
+
+    // Flag the nodes sharing an element with an edited node. Their influence radius has to be recomputed.
+    std::vector<char> is_affected(is_edited);
+    for (const auto &tetra : *this->influence_tetras_) {
+        if (is_edited[tetra.N1()] || is_edited[tetra.N2()] || is_edited[tetra.N3()] || is_edited[tetra.N4()]) {
+            is_affected[tetra.N1()] = 1; is_affected[tetra.N2()] = 1;
+            is_affected[tetra.N3()] = 1; is_affected[tetra.N4()] = 1;
+        }
+    }
+
+    // Flag the nodes of the added or removed elements, e.g. after a local refinement. Their connected nodes have changed.
+    auto sorted_tetras = [](const std::vector<Tetrahedron> &tetras_list) {
+        std::vector<std::array<int, 4> > sorted_conn;
+        sorted_conn.reserve(tetras_list.size());
+        for (const auto &tetra : tetras_list) {
+            std::array<int, 4> conn = {tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()};
+            std::sort(conn.begin(), conn.end());
+            sorted_conn.emplace_back(conn);
+        }
+        std::sort(sorted_conn.begin(), sorted_conn.end());
+        return sorted_conn;
+    };
+    std::vector<std::array<int, 4> > changed_tetras;
+    if (prev_tetras) {
+        auto prev_conn = sorted_tetras(*prev_tetras);
+        auto conn = sorted_tetras(*this->influence_tetras_);
+        std::set_symmetric_difference(prev_conn.begin(), prev_conn.end(), conn.begin(), conn.end(), std::back_inserter(changed_tetras));
+    }
+    for (const auto &conn : changed_tetras) {
+        for (const auto &node_id : conn) { is_affected[node_id] = 1; }
+    }
+
+    // Reset the influence radiuses of the affected nodes.
+    std::vector<int> connected_nodes_number(this->influence_nodes_->size(), 0);
+    for (std::size_t id = 0; id != is_affected.size(); ++id) {
+        if (is_affected[id]) { this->influence_radiuses_[id] = 0.; }
+    }
+
+    // Distance between two influence nodes.
+    auto distance = [this](int n1, int n2) {
+        const auto &c1 = (*this->influence_nodes_)[n1].Coordinates();
+        const auto &c2 = (*this->influence_nodes_)[n2].Coordinates();
+        return std::sqrt( (c1.X()-c2.X())*(c1.X()-c2.X()) + (c1.Y()-c2.Y())*(c1.Y()-c2.Y()) + (c1.Z()-c2.Z())*(c1.Z()-c2.Z()) );
+    };
+
+    // Accumulate the contribution of the elements connected to affected nodes.
+    for (const auto &tetra : *this->influence_tetras_) {
+        if (!(is_affected[tetra.N1()] || is_affected[tetra.N2()] || is_affected[tetra.N3()] || is_affected[tetra.N4()])) { continue; }
+
+        // Calculate distances between element nodes.
+        double d12 = distance(tetra.N1(), tetra.N2()); double d13 = distance(tetra.N1(), tetra.N3());
+        double d14 = distance(tetra.N1(), tetra.N4()); double d23 = distance(tetra.N2(), tetra.N3());
+        double d24 = distance(tetra.N2(), tetra.N4()); double d34 = distance(tetra.N3(), tetra.N4());
+
+        // Accumulate contribution only for the affected nodes of the element.
+        if (is_affected[tetra.N1()]) { this->influence_radiuses_[tetra.N1()] += (d12 + d13 + d14); connected_nodes_number[tetra.N1()] += 3; }
+        if (is_affected[tetra.N2()]) { this->influence_radiuses_[tetra.N2()] += (d12 + d23 + d24); connected_nodes_number[tetra.N2()] += 3; }
+        if (is_affected[tetra.N3()]) { this->influence_radiuses_[tetra.N3()] += (d13 + d23 + d34); connected_nodes_number[tetra.N3()] += 3; }
+        if (is_affected[tetra.N4()]) { this->influence_radiuses_[tetra.N4()] += (d14 + d24 + d34); connected_nodes_number[tetra.N4()] += 3; }
+    }
+
+    // Normalize the recomputed influence radiuses and collect the modified nodes.
+    std::vector<int> modified_nodes_ids;
+    for (std::size_t id = 0; id != is_affected.size(); ++id) {
+        if (!is_affected[id]) { continue; }
+
+        if (connected_nodes_number[id] != 0) { this->influence_radiuses_[id] /= connected_nodes_number[id]; }
+
+        // Apply dilatation coefficient if given and is positive.
+        if (dilatation_coeff > 0.) { this->influence_radiuses_[id] *= dilatation_coeff; }
+
+        // Store the node if it has been edited or its influence radius has changed.
+        if (is_edited[id] || this->influence_radiuses_[id] != prev_radiuses[id]) {
+            modified_nodes_ids.emplace_back(static_cast<int>(id));
+        }
+    }
+
+    return modified_nodes_ids;
+
+}
+
+
+std::vector<int> InfSupportDomain::AffectedEvalNodesIds(const std::vector<int> &modified_nodes_ids,
+                                                        const std::vector<Vec3<double> > &eval_nodes_coords,
+                                                        const NeighborList &neighbor_ids) const
+{
+    // Check size consistency of the evaluation nodes containers.
+    if (eval_nodes_coords.size() < neighbor_ids.ListsNum()) {
+        std::string error = Logger::Error("Can not find affected evaluation nodes. The given containers are not consistent in size.");
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Flag the modified influence nodes.
+    std::vector<char> is_modified(this->influence_nodes_->size(), 0);
+    for (const auto &node_id : modified_nodes_ids) { is_modified[node_id] = 1; }
+
+    // The flags of the affected evaluation nodes. The appended evaluation nodes are always affected.
+    std::vector<char> is_affected(eval_nodes_coords.size(), 0);
+    std::fill(is_affected.begin() + static_cast<std::ptrdiff_t>(neighbor_ids.ListsNum()), is_affected.end(), 1);
+
+    // Evaluation nodes with a modified influence node in their current support domain.
+    for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+        for (const auto &neigh_id : neighbor_ids[i]) {
+            if (neigh_id < static_cast<int>(is_modified.size()) && is_modified[neigh_id]) { is_affected[i] = 1; break; }
+        }
+    }
+
+    // Bounding box of the updated influence spheres of the modified nodes to skip distant evaluation nodes.
+    Vec3<double> box_min(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+    Vec3<double> box_max(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+    for (const auto &node_id : modified_nodes_ids) {
+        const auto &c = (*this->influence_nodes_)[node_id].Coordinates();
+        const auto &r = this->influence_radiuses_[node_id];
+        box_min.Set(std::min(box_min.X(), c.X()-r), std::min(box_min.Y(), c.Y()-r), std::min(box_min.Z(), c.Z()-r));
+        box_max.Set(std::max(box_max.X(), c.X()+r), std::max(box_max.Y(), c.Y()+r), std::max(box_max.Z(), c.Z()+r));
+    }
+
+    // Evaluation nodes lying within the updated influence sphere of a modified node.
+    for (std::size_t i = 0; i != eval_nodes_coords.size(); ++i) {
+        const auto &p = eval_nodes_coords[i];
+        if (is_affected[i] || p.X() < box_min.X() || p.Y() < box_min.Y() || p.Z() < box_min.Z() ||
+                p.X() > box_max.X() || p.Y() > box_max.Y() || p.Z() > box_max.Z()) { continue; }
+
+        for (const auto &node_id : modified_nodes_ids) {
+            const auto &c = (*this->influence_nodes_)[node_id].Coordinates();
+            double squared_dist = (c.X()-p.X())*(c.X()-p.X()) + (c.Y()-p.Y())*(c.Y()-p.Y()) + (c.Z()-p.Z())*(c.Z()-p.Z());
+            if (squared_dist <= this->influence_radiuses_[node_id]*this->influence_radiuses_[node_id]) { is_affected[i] = 1; break; }
+        }
+    }
+
+    // Collect the affected evaluation nodes indices.
+    std::vector<int> affected_ids;
+    for (std::size_t i = 0; i != is_affected.size(); ++i) {
+        if (is_affected[i]) { affected_ids.emplace_back(static_cast<int>(i)); }
+    }
+
+    return affected_ids;
+
+}
+
+
+void InfSupportDomain::UpdateClosestNodesIds(const std::vector<int> &eval_nodes_ids, const std::vector<Vec3<double> > &eval_nodes_coords,
+                                             NeighborList &neighbor_ids) const
+{
+    // Check size consistency of the evaluation nodes containers.
+    if (eval_nodes_coords.size() < neighbor_ids.ListsNum()) {
+        std::string error = Logger::Error("Can not update closest nodes. The given containers are not consistent in size.");
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Check that the appended evaluation nodes are updated.
+    std::vector<char> is_updated(eval_nodes_coords.size(), 0);
+    for (const auto &id : eval_nodes_ids) {
+        if (id < 0 || static_cast<std::size_t>(id) >= eval_nodes_coords.size()) {
+            std::string error = Logger::Error("Can not update closest nodes. Evaluation node index is out of range.");
+            throw std::out_of_range(error.c_str());
+        }
+        is_updated[id] = 1;
+    }
+    if (std::find(is_updated.begin() + static_cast<std::ptrdiff_t>(neighbor_ids.ListsNum()), is_updated.end(), 0) != is_updated.end()) {
+        std::string error = Logger::Error("Can not update closest nodes. The appended evaluation nodes must be updated.");
+        throw std::invalid_argument(error.c_str());
+    }
+
+    // Nothing to update.
+    if (eval_nodes_ids.empty()) { return; }
+
+    // Append empty lists for the appended evaluation nodes to be replaced.
+    const int *no_ids = nullptr;
+    while (neighbor_ids.ListsNum() != eval_nodes_coords.size()) { neighbor_ids.Append(no_ids, no_ids); }
+
+    // Gather the coordinates of the evaluation nodes to be updated.
+    std::vector<Vec3<double> > updated_coords;
+    updated_coords.reserve(eval_nodes_ids.size());
+    for (const auto &id : eval_nodes_ids) { updated_coords.emplace_back(eval_nodes_coords[id]); }
+
+    // Search the closest nodes only for the updated evaluation nodes with the cell list search.
+    auto updated_neighbor_ids = this->CellListClosestNodesIdsTo(updated_coords);
+
+    // Replace the neighbor lists of the updated evaluation nodes.
+    neighbor_ids.Replace(eval_nodes_ids, updated_neighbor_ids);
+
+}
+
+
+int InfSupportDomain::MinSupportNodesIn(const NeighborList &neighbor_ids) const
 {
     // Initialize minimum number of support nodes.
     int min_support_nodes_ = std::numeric_limits<int>::max();
 
     // Compute the minimum number of support nodes.
-    for (auto &neighs : neighbor_ids) {
-        if (static_cast<int>(neighs.size()) < min_support_nodes_) {
-            min_support_nodes_ = static_cast<int>(neighs.size());
+    for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+        if (static_cast<int>(neighbor_ids.ListSize(i)) < min_support_nodes_) {
+            min_support_nodes_ = static_cast<int>(neighbor_ids.ListSize(i));
         }
     }
 
@@ -343,15 +946,15 @@ int InfSupportDomain::MinSupportNodesIn(const std::vector<std::vector<int> > &ne
 }
 
 
-int InfSupportDomain::MaxSupportNodesIn(const std::vector<std::vector<int> > &neighbor_ids) const
+int InfSupportDomain::MaxSupportNodesIn(const NeighborList &neighbor_ids) const
 {
     // Initialize maximum number of support nodes.
     int max_support_nodes_ = 0;
 
     // Compute the maximum number of support nodes.
-    for (auto &neighs : neighbor_ids) {
-        if (static_cast<int>(neighs.size()) > max_support_nodes_) {
-            max_support_nodes_ = static_cast<int>(neighs.size());
+    for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+        if (static_cast<int>(neighbor_ids.ListSize(i)) > max_support_nodes_) {
+            max_support_nodes_ = static_cast<int>(neighbor_ids.ListSize(i));
         }
     }
 
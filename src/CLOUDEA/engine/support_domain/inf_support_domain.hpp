@@ -32,25 +32,41 @@
 #include "CLOUDEA/engine/elements/node.hpp"
 #include "CLOUDEA/engine/elements/tetrahedron.hpp"
 #include "CLOUDEA/engine/vectors/vec3.hpp"
+#include "CLOUDEA/engine/support_domain/cell_list_search.hpp"
+#include "CLOUDEA/engine/support_domain/mesh_edges.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list_io.hpp"
 #include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/thread_loop_manager.hpp"
 
 #include <CGAL/Fuzzy_sphere.h>
 #include <CGAL/Simple_cartesian.h>
 #include <CGAL/Kd_tree.h>
 #include <CGAL/algorithm.h>
 #include <CGAL/Fuzzy_iso_box.h>
+#include <CGAL/Orthogonal_k_neighbor_search.h>
 #include <CGAL/Search_traits_3.h>
 #include <CGAL/Search_traits_adapter.h>
 #include <CGAL/property_map.h>
 #include <boost/iterator/zip_iterator.hpp>
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
 #include <vector>
+#include <memory>
+#include <algorithm>
 #include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
 #include <stdexcept>
 #include <exception>
 #include <limits>
+#include <thread>
+#include <functional>
 
 
 namespace CLOUDEA {
@@ -87,20 +103,44 @@ public:
 
     /*!
      * \brief Set the influence nodes of the support domain.
-     * \param[in] nodes The influence nodes of the support domain.
+     * \param[in] nodes The influence nodes of the support domain. They are copied.
      * \return [void]
      */
     void SetInfluenceNodes(const std::vector<Node> &nodes);
 
 
+    /*!
+     * \brief Set the influence nodes of the support domain from a shared read-only view, e.g. TetraMesh::SharedNodes().
+     * \param[in] nodes The shared influence nodes of the support domain. They are not copied.
+     * \return [void]
+     */
+    void SetInfluenceNodes(const std::shared_ptr<const std::vector<Node> > &nodes);
+
+
     /*!
      * \brief Set the influence tetrahedra of the support domain.
-     * \param[in] tetras The influence tetrahedra of the support domain.
+     * \param[in] tetras The influence tetrahedra of the support domain. They are copied.
      * \return [void]
      */
     void SetInfluenceTetrahedra(const std::vector<Tetrahedron> &tetras);
 
 
+    /*!
+     * \brief Set the influence tetrahedra of the support domain from a shared read-only view, e.g. TetraMesh::SharedElements().
+     * \param[in] tetras The shared influence tetrahedra of the support domain. They are not copied.
+     * \return [void]
+     */
+    void SetInfluenceTetrahedra(const std::shared_ptr<const std::vector<Tetrahedron> > &tetras);
+
+
+    /*!
+     * \brief Set the number of threads used in the closest nodes search.
+     * \param[in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    void SetThreadsNumber(std::size_t threads_number);
+
+
     /*!
      * \brief Compute the radiuses of influence of the influence nodes in the support domain.
      * \param[in] dilation_coeff A dilatation coefficient to increase the influence radiuses of the nodes.
@@ -109,18 +149,56 @@ public:
     void ComputeInfluenceNodesRadiuses(double dilatation_coeff = std::numeric_limits<double>::min());
 
 
+    /*!
+     * \brief Compute the radiuses of influence of the influence nodes to bound the support size of the evaluation nodes.
+     *
+     * Instead of a uniform dilatation of the mesh-based radiuses, the radius of each influence node is tuned
+     * so that every evaluation node has at least min_neighs_num support nodes. The influence radius of a node is
+     * set to the support margin times the distance to the furthest evaluation node having it among its
+     * min_neighs_num nearest influence nodes, so that all the required support nodes have non-vanishing weight
+     * and the moment matrix remains well conditioned. Every influence node supports at least its nearest evaluation node.
+     * Influence nodes not required by any evaluation node keep their mesh-based radius, unless they belong
+     * in the support domain of an evaluation node with more than max_neighs_num support nodes.
+     * The lower bound is guaranteed. The upper bound is met wherever isotropic support domains allow it.
+     *
+     * \param[in] eval_nodes_coords The coordinates of the evaluation nodes.
+     * \param[in] basis_size The number of monomials in the MMLS basis. 4 for linear and 10 for quadratic basis.
+     * \param[in] min_neighs_num The minimum number of support nodes of each evaluation node. Not smaller than the basis size.
+     * \param[in] max_neighs_num The maximum number of support nodes of each evaluation node. Not bounded if zero.
+     * \param[in] support_margin The ratio of the influence radius over the distance of the furthest required evaluation node. Must be larger than 1.
+     * \return [void]
+     */
+    void ComputeAdaptiveInfluenceNodesRadiuses(const std::vector<Vec3<double> > &eval_nodes_coords, int basis_size, int min_neighs_num,
+                                               int max_neighs_num = 0, double support_margin = 1.25);
+
+
+    /*!
+     * \brief Print the histogram of the support nodes number of the evaluation nodes and an estimation of the required flops.
+     *
+     * The flops are estimated for the construction of the MMLS shape function and derivatives
+     * and for the internal forces computation of a MTLED time step. If reference neighbor lists are given,
+     * e.g. computed with a uniform dilatation coefficient, the change of the estimated flops is printed too.
+     *
+     * \param[in] neighbor_ids The indices of the closest influence nodes to each evaluation node.
+     * \param[in] reference_ids The reference indices of the closest influence nodes to each evaluation node to compare with.
+     * \param[in] basis_size The number of monomials in the MMLS basis. 4 for linear and 10 for quadratic basis.
+     * \return [void]
+     */
+    void PrintSupportSizes(const NeighborList &neighbor_ids, const NeighborList &reference_ids = NeighborList(), int basis_size = 10) const;
+
+
     /*!
      * \brief Get the influence nodes of the support domain.
      * \return [std::vector<CLOUDEA::Node>] The influence nodes of the support domain.
      */
-    inline const std::vector<Node> & InfluenceNodes() const { return this->influence_nodes_; }
+    inline const std::vector<Node> & InfluenceNodes() const { return *this->influence_nodes_; }
 
 
     /*!
      * \brief Get the influence tetrahedra of the support domain.
      * \return [std::vector<CLOUDEA::Tetrahedron>] The influence tetrahedra of the support domain.
      */
-    inline const std::vector<Tetrahedron> & InfluenceTetrahedra() const { return this->influence_tetras_; }
+    inline const std::vector<Tetrahedron> & InfluenceTetrahedra() const { return *this->influence_tetras_; }
 
 
     /*!
@@ -130,51 +208,200 @@ public:
     inline const std::vector<double> & InfluenceNodesRadiuses() const { return this->influence_radiuses_; }
 
 
+    /*!
+     * \brief Get the number of threads used in the closest nodes search.
+     * \return [std::size_t] The number of threads used in the closest nodes search.
+     */
+    inline const std::size_t & ThreadsNumber() const { return this->threads_number_; }
+
+
+    /*!
+     * \brief Get the dilatation coefficient used in the last computation of the influence radiuses.
+     *
+     * For target-count adaptive influence radiuses the dilatation coefficient of the underlying mesh-based radiuses (1) is returned.
+     *
+     * \return [double] The dilatation coefficient of the influence radiuses.
+     */
+    inline double DilatationCoeff() const { return this->dilatation_coeff_; }
+
+
+    /*!
+     * \brief Get the computation mode used in the last computation of the influence radiuses.
+     * \return [SupportRadiusMode] The computation mode of the influence radiuses.
+     */
+    inline SupportRadiusMode RadiusMode() const { return this->radius_mode_; }
+
+
+    /*!
+     * \brief Get a hash of the coordinates of the influence nodes and the connectivity of the influence tetrahedra.
+     *
+     * Used to identify stale neighbor list files computed for a different geometry.
+     *
+     * \return [std::uint64_t] The FNV-1a hash of the influence nodes and tetrahedra.
+     */
+    std::uint64_t MeshHash() const;
+
+
+    /*!
+     * \brief Get the key identifying the neighbor lists of the given evaluation nodes in binary neighbor list files.
+     *
+     * The key records the mesh hash, the number of influence nodes, the number and a hash of the coordinates
+     * of the evaluation nodes and the computation mode and parameters of the influence radiuses.
+     *
+     * \param[in] eval_nodes_coords The coordinates of the evaluation nodes of the neighbor lists.
+     * \return [NeighborListKey] The key of the neighbor lists of the evaluation nodes.
+     */
+    NeighborListKey ClosestNodesKey(const std::vector<Vec3<double> > &eval_nodes_coords) const;
+
+
     /*!
      * \brief Get the indices of the closest influence nodes to each of the given evaluation nodes using exhaustive search.
      * \param[in] eval_nodes_coords The coordinates of the evaluation nodes for which the closest influence nodes indices will be returned.
-     * \return [std::vector<std::vector<int> >] The indices of the influence nodes closest to each of the given evaluation node.
+     * \return [NeighborList] The indices of the influence nodes closest to each of the given evaluation node.
      */
-    const std::vector<std::vector<int> > ClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const;
+    const NeighborList ClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const;
 
 
     /*!
      * \brief Get the indices of the closest influence nodes to each of the given evaluation nodes using CGAL kNN search in sphere.
+     *
+     * The influence nodes are queried in parallel. The indices of the closest influence nodes
+     * are stored in increasing order for each evaluation node independently of the number of threads.
+     *
      * \param[in] eval_nodes_coords The coordinates of the evaluation nodes for which the closest influence nodes indices will be returned.
-     * \return [std::vector<std::vector<int> >] The indices of the influence nodes closest to each of the given evaluation node.
+     * \return [NeighborList] The indices of the influence nodes closest to each of the given evaluation node.
      */
-    const std::vector<std::vector<int> > CgalClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const;
+    const NeighborList CgalClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const;
+
+
+    /*!
+     * \brief Get the indices of the closest influence nodes to each of the given evaluation nodes using cell list search.
+     *
+     * Dependency-free alternative to CgalClosestNodesIdsTo returning identical neighbor lists.
+     * The evaluation nodes are queried in parallel and the indices of the closest influence nodes
+     * are stored in increasing order for each evaluation node.
+     *
+     * \param[in] eval_nodes_coords The coordinates of the evaluation nodes for which the closest influence nodes indices will be returned.
+     * \return [NeighborList] The indices of the influence nodes closest to each of the given evaluation node.
+     */
+    const NeighborList CellListClosestNodesIdsTo(const std::vector<Vec3<double> > &eval_nodes_coords) const;
 
 
     /*!
      * \brief Get the indices of the closest influence nodes to each of the given evaluation nodes loaded from a file.
+     *
+     * Text (.txt) files store the one-based neighbor indices of each evaluation node per line.
+     * Binary (.nbl) files are memory mapped and rejected if computed for a different mesh, evaluation nodes or
+     * dilatation coefficient. Files of both formats are rejected if their number of lists differs from the number
+     * of evaluation nodes or if they store indices outside the influence nodes.
+     *
      * \param[in] closest_nodes_file The file with the neighbor nodes list for each evaluation node.
-     * \return [std::vector<std::vector<int> >] The indices of the influence nodes closest to each of the given evaluation node.
+     * \param[in] eval_nodes_coords The coordinates of the evaluation nodes of the neighbor lists.
+     * \return [NeighborList] The indices of the influence nodes closest to each of the given evaluation node.
      */
-    const std::vector<std::vector<int> > LoadClosestNodesFrom(const std::string &closest_nodes_file) const;
+    const NeighborList LoadClosestNodesFrom(const std::string &closest_nodes_file, const std::vector<Vec3<double> > &eval_nodes_coords) const;
 
 
     /*!
-     * \brief Get the number of support nodes contained in the smallest support domain.
-     * \return [int] The number of support nodes contained in the smallest support domain.
+     * \brief Save the indices of the closest influence nodes to each evaluation node in a binary neighbor list file.
+     *
+     * The file stores the key of the evaluation nodes returned by ClosestNodesKey so that loading it
+     * for a different geometry, evaluation nodes or support size fails.
+     *
+     * \param[in] closest_nodes_file The binary neighbor list file (.nbl).
+     * \param[in] eval_nodes_coords The coordinates of the evaluation nodes of the neighbor lists.
+     * \param[in] neighbor_ids The indices of the closest influence nodes to each evaluation node.
+     * \param[in] compress Compress the neighbor indices with delta and varint encoding.
+     * \return [void]
+     */
+    void SaveClosestNodesTo(const std::string &closest_nodes_file, const std::vector<Vec3<double> > &eval_nodes_coords,
+                            const NeighborList &neighbor_ids, bool compress = false) const;
+
+
+    /*!
+     * \brief Update the influence nodes and tetrahedra after a local edit of the geometry.
+     *
+     * Only the influence radiuses of the edited nodes, of the nodes sharing an element with them and of the
+     * nodes of added or removed elements are recomputed. Edited nodes may be moved or appended at the end of
+     * the nodes container, and the elements may be locally refined. Node removal is not supported and requires
+     * a full recomputation.
+     *
+     * \param[in] nodes The influence nodes of the support domain after the edit.
+     * \param[in] tetras The influence tetrahedra of the support domain after the edit.
+     * \param[in] edited_nodes_ids The indices of the moved or appended influence nodes.
+     * \param[in] dilatation_coeff The dilatation coefficient used for the computation of the influence radiuses.
+     * \return [std::vector<int>] The sorted indices of the influence nodes whose position or influence radius has been modified.
      */
-    int MinSupportNodesIn(const std::vector<std::vector<int> > &neighbor_ids) const;
+    std::vector<int> UpdateInfluenceNodes(const std::vector<Node> &nodes, const std::vector<Tetrahedron> &tetras,
+                                          const std::vector<int> &edited_nodes_ids,
+                                          double dilatation_coeff = std::numeric_limits<double>::min());
+
+
+    /*!
+     * \brief Get the indices of the evaluation nodes with support domain affected by modified influence nodes.
+     *
+     * An evaluation node is affected if a modified influence node belongs in its current support domain
+     * or if it lies within the updated influence radius of a modified influence node. Evaluation nodes
+     * appended after the neighbor lists (e.g. the integration points of refined elements) are always affected.
+     *
+     * \param[in] modified_nodes_ids The indices of the modified influence nodes.
+     * \param[in] eval_nodes_coords The coordinates of the evaluation nodes.
+     * \param[in] neighbor_ids The current indices of the closest influence nodes to each evaluation node, except the appended ones.
+     * \return [std::vector<int>] The sorted indices of the affected evaluation nodes.
+     */
+    std::vector<int> AffectedEvalNodesIds(const std::vector<int> &modified_nodes_ids,
+                                          const std::vector<Vec3<double> > &eval_nodes_coords,
+                                          const NeighborList &neighbor_ids) const;
+
+
+    /*!
+     * \brief Update the indices of the closest influence nodes only for the given evaluation nodes.
+     *
+     * The closest nodes are searched with CellListClosestNodesIdsTo. Evaluation nodes appended at the end of the
+     * coordinates container are appended in the neighbor lists and must be included in the updated evaluation nodes.
+     *
+     * \param[in] eval_nodes_ids The indices of the evaluation nodes to be updated.
+     * \param[in] eval_nodes_coords The coordinates of all the evaluation nodes.
+     * \param[out] neighbor_ids The indices of the closest influence nodes to each evaluation node. Updated in place.
+     * \return [void]
+     */
+    void UpdateClosestNodesIds(const std::vector<int> &eval_nodes_ids, const std::vector<Vec3<double> > &eval_nodes_coords,
+                               NeighborList &neighbor_ids) const;
 
 
     /*!
      * \brief Get the number of support nodes contained in the smallest support domain.
      * \return [int] The number of support nodes contained in the smallest support domain.
      */
-    int MaxSupportNodesIn(const std::vector<std::vector<int> > &neighbor_ids) const;
+    int MinSupportNodesIn(const NeighborList &neighbor_ids) const;
+
+
+    /*!
+     * \brief Get the number of support nodes contained in the largest support domain.
+     * \return [int] The number of support nodes contained in the largest support domain.
+     */
+    int MaxSupportNodesIn(const NeighborList &neighbor_ids) const;
 
 
 private:
-    std::vector<Node> influence_nodes_;                /*!< The influence nodes of the support domain. */
+    std::shared_ptr<const std::vector<Node> > influence_nodes_;             /*!< The influence nodes of the support domain. Shared with the mesh they were set from. */
 
-    std::vector<Tetrahedron> influence_tetras_;        /*!< The influence tetrahedra of the support domain. */
+    std::shared_ptr<const std::vector<Tetrahedron> > influence_tetras_;     /*!< The influence tetrahedra of the support domain. Shared with the mesh they were set from. */
 
     std::vector<double> influence_radiuses_;           /*!< The influence radiuses of the influence nodes of the support domain. */
 
+    std::size_t threads_number_;                       /*!< The number of threads used in the closest nodes search. */
+
+    double dilatation_coeff_;                          /*!< The dilatation coefficient of the influence radiuses. */
+
+    SupportRadiusMode radius_mode_;                    /*!< The computation mode of the influence radiuses. */
+
+    int min_neighs_num_;                               /*!< The minimum number of support nodes of target-count influence radiuses. */
+
+    int max_neighs_num_;                               /*!< The maximum number of support nodes of target-count influence radiuses. */
+
+    double support_margin_;                            /*!< The support margin of target-count influence radiuses. */
+
 };
 
 
@@ -0,0 +1,361 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file mesh_edges.hpp
+   \brief MeshEdges class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_SUPPORT_DOMAIN_MESH_EDGES_HPP_
+#define CLOUDEA_SUPPORT_DOMAIN_MESH_EDGES_HPP_
+
+
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/thread_loop_manager.hpp"
+
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/** \addtogroup Meshfree \{ */
+
+
+/**
+ * \class MeshEdges
+ * \author Konstantinos A. Mountris
+ * \brief Unique edges of a mesh and their incidence to the mesh nodes for the computation of nodal support radiuses.
+ *
+ * The unique edges are extracted once and their lengths are evaluated once per edge in parallel. The mean length
+ * of the edges incident to each node is accumulated in parallel over the nodes, visiting the cells of each node in
+ * increasing order. This reproduces exactly the summation order of a serial loop over the cells.
+ */
+class MeshEdges
+{
+private:
+
+    std::size_t nodes_num_;                                /**< The number of nodes of the mesh */
+
+    std::size_t cell_nodes_num_;                           /**< The number of nodes of each cell */
+
+    std::vector<std::array<short, 2>> local_edges_;        /**< The edges of a cell in local node indices */
+
+    std::vector<int> cell_nodes_;                          /**< The connectivity of the cells stored contiguously */
+
+    std::vector<std::size_t> node_offsets_;                /**< The offsets of the cell corners list of each node in the node_corners_ container */
+
+    std::vector<std::size_t> node_corners_;                /**< The cell corners (cell_id*cell_nodes_num + local_id) of each node in increasing cell order */
+
+    std::vector<std::size_t> edge_offsets_;                /**< The offsets of the edges starting at each node in the edges_ container */
+
+    std::vector<std::array<int, 2>> edges_;                /**< The unique edges sorted by their first and second node. First node is smaller */
+
+    std::vector<std::size_t> cell_edges_;                  /**< The unique edge index of each local edge of each cell */
+
+    std::vector<double> lengths_;                          /**< The length of each unique edge */
+
+    std::size_t threads_number_;                           /**< The number of threads */
+
+
+protected:
+
+    /**
+     * \brief Call a function for contiguous ranges of indices in parallel.
+     * \param [in] entries_num The number of indices.
+     * \param [in] func The function called as func(start, end) for each range of indices.
+     * \return [void]
+     */
+    template <typename FUNC>
+    inline void ParallelFor(std::size_t entries_num, FUNC func) const
+    {
+        if (this->threads_number_ <= 1 || this->threads_number_ >= entries_num) {
+            func(std::size_t{0}, entries_num);
+            return;
+        }
+
+        ThreadLoopManager loop_manager;
+        loop_manager.SetLoopRanges(entries_num, this->threads_number_);
+
+        std::vector<std::thread> threads;
+        threads.reserve(this->threads_number_);
+        for (std::size_t t = 0; t != this->threads_number_; ++t) {
+            threads.emplace_back(std::thread(func, loop_manager.LoopStartId(t), loop_manager.LoopEndId(t)));
+        }
+        std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+    }
+
+
+    /**
+     * \brief Collect the nodes with larger index connected to a node with an edge.
+     * \param [in] node_id The index of the node.
+     * \param [out] connected_ids The sorted unique indices of the connected nodes with larger index.
+     * \return [void]
+     */
+    inline void UpperConnectedNodes(std::size_t node_id, std::vector<int> &connected_ids) const
+    {
+        connected_ids.clear();
+        for (auto k = this->node_offsets_[node_id]; k != this->node_offsets_[node_id+1]; ++k) {
+            auto corner = this->node_corners_[k];
+            auto cell_start = corner - corner % this->cell_nodes_num_;
+            auto local_id = static_cast<short>(corner % this->cell_nodes_num_);
+
+            for (const auto &edge : this->local_edges_) {
+                short other = -1;
+                if (edge[0] == local_id) { other = edge[1]; }
+                else if (edge[1] == local_id) { other = edge[0]; }
+
+                if (other != -1 && this->cell_nodes_[cell_start+other] > static_cast<int>(node_id)) {
+                    connected_ids.emplace_back(this->cell_nodes_[cell_start+other]);
+                }
+            }
+        }
+        std::sort(connected_ids.begin(), connected_ids.end());
+        connected_ids.erase(std::unique(connected_ids.begin(), connected_ids.end()), connected_ids.end());
+    }
+
+
+public:
+
+    /**
+     * \brief MeshEdges constructor.
+     */
+    inline MeshEdges() : nodes_num_(0), cell_nodes_num_(0), local_edges_(), cell_nodes_(), node_offsets_(), node_corners_(),
+        edge_offsets_(), edges_(), cell_edges_(), lengths_(), threads_number_(1)
+    {}
+
+
+    /**
+     * \brief Set the number of threads.
+     * \param [in] threads_number The number of threads. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    inline void SetThreadsNumber(std::size_t threads_number)
+    {
+        this->threads_number_ = threads_number;
+        if (this->threads_number_ == 0) {
+            this->threads_number_ = static_cast<std::size_t>(std::thread::hardware_concurrency());
+        }
+        if (this->threads_number_ == 0) { this->threads_number_ = 1; }
+    }
+
+
+    /**
+     * \brief Get the edges of a cell in local node indices.
+     * \param [in] cell_nodes_num The number of nodes of the cell. Two for line, three for triangle, four for quadrilateral or tetrahedron.
+     * \param [in] is_tetrahedron True to get the edges of a tetrahedron for four-node cells, false to get the edges of a quadrilateral.
+     * \return [std::vector<std::array<short, 2>>] The local edges of the cell.
+     */
+    inline static std::vector<std::array<short, 2>> CellLocalEdges(short cell_nodes_num, bool is_tetrahedron)
+    {
+        std::vector<std::array<short, 2>> local_edges;
+        if (cell_nodes_num == 2) {
+            local_edges.push_back({0, 1});
+        }
+        else if (cell_nodes_num == 4 && is_tetrahedron) {
+            for (short i = 0; i != 3; ++i) {
+                for (short j = i+1; j != 4; ++j) { local_edges.push_back({i, j}); }
+            }
+        }
+        else {
+            for (short i = 0; i != cell_nodes_num-1; ++i) { local_edges.push_back({i, static_cast<short>(i+1)}); }
+            local_edges.push_back({static_cast<short>(cell_nodes_num-1), 0});
+        }
+        return local_edges;
+    }
+
+
+    /**
+     * \brief Extract the unique edges of a mesh.
+     * \param [in] nodes_num The number of nodes of the mesh.
+     * \param [in] cells_num The number of cells of the mesh.
+     * \param [in] local_edges The edges of a cell in local node indices. See CellLocalEdges.
+     * \param [in] cell_nodes_num The number of nodes of each cell.
+     * \param [in] cell_node The function returning the index of a cell's node as cell_node(cell_id, local_id).
+     * \return [void]
+     */
+    template <typename CELL_NODE_FUNC>
+    inline void Extract(std::size_t nodes_num, std::size_t cells_num, const std::vector<std::array<short, 2>> &local_edges,
+                        std::size_t cell_nodes_num, CELL_NODE_FUNC cell_node)
+    {
+        this->nodes_num_ = nodes_num;
+        this->cell_nodes_num_ = cell_nodes_num;
+        this->local_edges_ = local_edges;
+        this->lengths_.clear();
+
+        // Store the connectivity of the cells.
+        this->cell_nodes_.resize(cells_num*cell_nodes_num);
+        for (std::size_t c = 0; c != cells_num; ++c) {
+            for (std::size_t i = 0; i != cell_nodes_num; ++i) {
+                int node_id = cell_node(c, i);
+                if (node_id < 0 || static_cast<std::size_t>(node_id) >= nodes_num) {
+                    throw std::out_of_range(Logger::Error("Could not extract mesh edges. Cell node index is out of range.").c_str());
+                }
+                this->cell_nodes_[c*cell_nodes_num+i] = node_id;
+            }
+        }
+
+        // Store the cell corners of each node in increasing cell order.
+        this->node_offsets_.assign(nodes_num+1, 0);
+        for (const auto &node_id : this->cell_nodes_) { this->node_offsets_[node_id+1]++; }
+        for (std::size_t n = 0; n != nodes_num; ++n) { this->node_offsets_[n+1] += this->node_offsets_[n]; }
+
+        this->node_corners_.resize(this->cell_nodes_.size());
+        std::vector<std::size_t> fill_pos(this->node_offsets_.begin(), this->node_offsets_.end()-1);
+        for (std::size_t corner = 0; corner != this->cell_nodes_.size(); ++corner) {
+            this->node_corners_[fill_pos[this->cell_nodes_[corner]]++] = corner;
+        }
+
+        // Count the unique edges starting at each node.
+        this->edge_offsets_.assign(nodes_num+1, 0);
+        this->ParallelFor(nodes_num, [this](std::size_t start, std::size_t end) {
+            std::vector<int> connected_ids;
+            for (auto n = start; n != end; ++n) {
+                this->UpperConnectedNodes(n, connected_ids);
+                this->edge_offsets_[n+1] = connected_ids.size();
+            }
+        });
+        for (std::size_t n = 0; n != nodes_num; ++n) { this->edge_offsets_[n+1] += this->edge_offsets_[n]; }
+
+        // Store the unique edges sorted by their first and second node.
+        this->edges_.resize(this->edge_offsets_[nodes_num]);
+        this->ParallelFor(nodes_num, [this](std::size_t start, std::size_t end) {
+            std::vector<int> connected_ids;
+            for (auto n = start; n != end; ++n) {
+                this->UpperConnectedNodes(n, connected_ids);
+                auto pos = this->edge_offsets_[n];
+                for (const auto &other : connected_ids) { this->edges_[pos++] = {static_cast<int>(n), other}; }
+            }
+        });
+
+        // Map the local edges of each cell to the unique edges.
+        auto local_edges_num = this->local_edges_.size();
+        this->cell_edges_.resize(cells_num*local_edges_num);
+        this->ParallelFor(cells_num, [this, local_edges_num](std::size_t start, std::size_t end) {
+            for (auto c = start; c != end; ++c) {
+                for (std::size_t e = 0; e != local_edges_num; ++e) {
+                    int n0 = this->cell_nodes_[c*this->cell_nodes_num_ + this->local_edges_[e][0]];
+                    int n1 = this->cell_nodes_[c*this->cell_nodes_num_ + this->local_edges_[e][1]];
+                    if (n0 > n1) { std::swap(n0, n1); }
+
+                    // Degenerate edges are mapped past the unique edges and have zero length.
+                    if (n0 == n1) { this->cell_edges_[c*local_edges_num+e] = this->edges_.size(); continue; }
+
+                    auto first = this->edges_.begin() + static_cast<std::ptrdiff_t>(this->edge_offsets_[n0]);
+                    auto last = this->edges_.begin() + static_cast<std::ptrdiff_t>(this->edge_offsets_[n0+1]);
+                    auto it = std::lower_bound(first, last, n1, [](const std::array<int, 2> &edge, int id) { return edge[1] < id; });
+                    this->cell_edges_[c*local_edges_num+e] = static_cast<std::size_t>(it - this->edges_.begin());
+                }
+            }
+        });
+    }
+
+
+    /**
+     * \brief Compute the length of each unique edge.
+     * \param [in] edge_length The function returning the length of an edge as edge_length(first_node_id, second_node_id).
+     * \return [void]
+     */
+    template <typename EDGE_LENGTH_FUNC>
+    inline void ComputeLengths(EDGE_LENGTH_FUNC edge_length)
+    {
+        // The last entry is the zero length of degenerate edges.
+        this->lengths_.assign(this->edges_.size()+1, 0.);
+        this->ParallelFor(this->edges_.size(), [this, &edge_length](std::size_t start, std::size_t end) {
+            for (auto e = start; e != end; ++e) { this->lengths_[e] = edge_length(this->edges_[e][0], this->edges_[e][1]); }
+        });
+    }
+
+
+    /**
+     * \brief Compute the mean length of the edges incident to each node over all the cells containing the node.
+     *
+     * Edges shared by several cells contribute once per cell, as in a loop over the edges of every cell.
+     *
+     * \param [out] mean_lengths The mean incident edge length of each node.
+     * \param [in] sum_per_cell If true, the incident edge lengths of each cell are summed before being accumulated to the node.
+     * \return [void]
+     */
+    inline void MeanIncidentLengths(std::vector<double> &mean_lengths, bool sum_per_cell) const
+    {
+        if (this->lengths_.size() != this->edges_.size()+1) {
+            throw std::runtime_error(Logger::Error("Could not compute the mean incident edge lengths. Compute the edge lengths first.").c_str());
+        }
+
+        mean_lengths.assign(this->nodes_num_, 0.);
+        this->ParallelFor(this->nodes_num_, [this, &mean_lengths, sum_per_cell](std::size_t start, std::size_t end) {
+            auto local_edges_num = this->local_edges_.size();
+            for (auto n = start; n != end; ++n) {
+                double length_sum = 0.;
+                int edges_num = 0;
+                for (auto k = this->node_offsets_[n]; k != this->node_offsets_[n+1]; ++k) {
+                    auto corner = this->node_corners_[k];
+                    auto cell_id = corner / this->cell_nodes_num_;
+                    auto local_id = static_cast<short>(corner % this->cell_nodes_num_);
+
+                    double cell_sum = 0.;
+                    for (std::size_t e = 0; e != local_edges_num; ++e) {
+                        if (this->local_edges_[e][0] != local_id && this->local_edges_[e][1] != local_id) { continue; }
+                        double length = this->lengths_[this->cell_edges_[cell_id*local_edges_num+e]];
+                        if (sum_per_cell) { cell_sum += length; }
+                        else { length_sum += length; }
+                        edges_num++;
+                    }
+                    if (sum_per_cell) { length_sum += cell_sum; }
+                }
+                mean_lengths[n] = length_sum / edges_num;
+            }
+        });
+    }
+
+
+    /**
+     * \brief Get the unique edges sorted by their first and second node. The first node of each edge has the smaller index.
+     * \return [const std::vector<std::array<int, 2>>&] The unique edges.
+     */
+    inline const std::vector<std::array<int, 2>> & Edges() const { return this->edges_; }
+
+
+    /**
+     * \brief Get the length of each unique edge.
+     * \return [const std::vector<double>&] The unique edges' lengths followed by a zero length for degenerate edges.
+     */
+    inline const std::vector<double> & Lengths() const { return this->lengths_; }
+
+
+    /**
+     * \brief Get the number of threads.
+     * \return [std::size_t] The number of threads.
+     */
+    inline std::size_t ThreadsNumber() const { return this->threads_number_; }
+
+};
+
+
+/*! \} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SUPPORT_DOMAIN_MESH_EDGES_HPP_
@@ -0,0 +1,632 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file neighbor_list.hpp
+   \brief NeighborList class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_SUPPORT_DOMAIN_NEIGHBOR_LIST_HPP_
+#define CLOUDEA_SUPPORT_DOMAIN_NEIGHBOR_LIST_HPP_
+
+
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <exception>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+
+namespace CLOUDEA {
+
+/** \addtogroup Meshfree \{ */
+
+
+/**
+ * \class NeighborSpan
+ * \author Konstantinos A. Mountris
+ * \brief Non-owning read-only view of the neighbor indices of a single point stored in a NeighborList.
+ */
+class NeighborSpan
+{
+private:
+
+    const int *begin_;                                     /**< Pointer to the first neighbor index */
+
+    const int *end_;                                       /**< Pointer past the last neighbor index */
+
+public:
+
+    /**
+     * \brief NeighborSpan default constructor. Constructs an empty view.
+     */
+    NeighborSpan() : begin_(nullptr), end_(nullptr) {}
+
+
+    /**
+     * \brief NeighborSpan constructor from a range of neighbor indices.
+     * \param [in] begin Pointer to the first neighbor index.
+     * \param [in] end Pointer past the last neighbor index.
+     */
+    NeighborSpan(const int *begin, const int *end) : begin_(begin), end_(end) {}
+
+
+    /**
+     * \brief NeighborSpan constructor from a vector of neighbor indices.
+     * \param [in] ids The vector of neighbor indices. It must outlive the view.
+     */
+    NeighborSpan(const std::vector<int> &ids) : begin_(ids.data()), end_(ids.data()+ids.size()) {}
+
+
+    inline const int * begin() const { return this->begin_; }
+
+
+    inline const int * end() const { return this->end_; }
+
+
+    inline const int * data() const { return this->begin_; }
+
+
+    inline std::size_t size() const { return static_cast<std::size_t>(this->end_ - this->begin_); }
+
+
+    inline bool empty() const { return this->begin_ == this->end_; }
+
+
+    inline const int & operator [] (std::size_t i) const { return this->begin_[i]; }
+
+
+    inline const int & front() const { return *this->begin_; }
+
+
+    inline const int & back() const { return *(this->end_-1); }
+
+
+    /**
+     * \brief Copy the neighbor indices of the view in a vector.
+     * \return [std::vector<int>] The neighbor indices of the view.
+     */
+    inline std::vector<int> ToVector() const { return std::vector<int>(this->begin_, this->end_); }
+
+};
+
+
+/**
+ * \class NeighborList
+ * \author Konstantinos A. Mountris
+ * \brief Neighbor indices lists of a set of points in compressed sparse row storage.
+ *
+ * The neighbor indices of all the points are stored contiguously in a single container
+ * and the offsets container stores the position of the first neighbor index of each point.
+ * The neighbor indices of a point are accessed as a NeighborSpan view.
+ *
+ * The list may also refer to offsets and indices stored externally, e.g. in a memory mapped file,
+ * without copying them. The external storage is kept alive as long as the list refers to it.
+ * An external list is copied in owned storage the first time it is modified.
+ */
+class NeighborList
+{
+private:
+
+    std::vector<std::size_t> offsets_;                     /**< The offsets of the neighbor indices of each point. The last offset is the total number of indices */
+
+    std::vector<int> ids_;                                 /**< The neighbor indices of all the points stored contiguously */
+
+    std::shared_ptr<const void> external_storage_;         /**< The external storage of the offsets and neighbor indices, if any */
+
+    const std::size_t *offsets_data_;                      /**< Pointer to the offsets in owned or external storage */
+
+    const int *ids_data_;                                  /**< Pointer to the neighbor indices in owned or external storage */
+
+    std::size_t lists_num_;                                /**< The number of points in the list */
+
+
+    /**
+     * \brief Point the data pointers to the owned storage. Does nothing for external lists.
+     * \return [void]
+     */
+    inline void SyncData()
+    {
+        if (this->external_storage_) { return; }
+        this->offsets_data_ = this->offsets_.data();
+        this->ids_data_ = this->ids_.data();
+        this->lists_num_ = this->offsets_.size()-1;
+    }
+
+
+    /**
+     * \brief Copy the offsets and neighbor indices of an external list in owned storage.
+     * \return [void]
+     */
+    inline void MakeOwned()
+    {
+        if (!this->external_storage_) { return; }
+        this->offsets_.assign(this->offsets_data_, this->offsets_data_+this->lists_num_+1);
+        this->ids_.assign(this->ids_data_, this->ids_data_+this->offsets_data_[this->lists_num_]);
+        this->external_storage_.reset();
+        this->SyncData();
+    }
+
+
+public:
+
+    /**
+     * \brief NeighborList constructor. Constructs an empty list.
+     */
+    NeighborList() : offsets_(1, 0), ids_(), external_storage_(), offsets_data_(nullptr), ids_data_(nullptr), lists_num_(0)
+    {
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief NeighborList constructor from nested neighbor indices lists.
+     * \param [in] nested_ids The neighbor indices lists of the points.
+     */
+    explicit NeighborList(const std::vector<std::vector<int> > &nested_ids) : NeighborList()
+    {
+        std::size_t ids_num = 0;
+        for (const auto &ids : nested_ids) { ids_num += ids.size(); }
+
+        this->Reserve(nested_ids.size(), ids_num);
+        for (const auto &ids : nested_ids) { this->Append(ids.begin(), ids.end()); }
+    }
+
+
+    /**
+     * \brief NeighborList constructor from given offsets and neighbor indices.
+     * \param [in] offsets The offsets of the neighbor indices of each point. The first offset must be zero and the last equal to the number of indices.
+     * \param [in] ids The neighbor indices of all the points stored contiguously.
+     */
+    NeighborList(std::vector<std::size_t> offsets, std::vector<int> ids) : NeighborList()
+    {
+        if (offsets.empty() || offsets.front() != 0 || offsets.back() != ids.size() ||
+                !std::is_sorted(offsets.begin(), offsets.end())) {
+            throw std::invalid_argument(Logger::Error("Could not create neighbor list. Invalid offsets were given.").c_str());
+        }
+        this->offsets_ = std::move(offsets);
+        this->ids_ = std::move(ids);
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief NeighborList copy constructor.
+     * \param [in] other The list to be copied. An external list shares the external storage.
+     */
+    NeighborList(const NeighborList &other) : offsets_(other.offsets_), ids_(other.ids_), external_storage_(other.external_storage_),
+        offsets_data_(other.offsets_data_), ids_data_(other.ids_data_), lists_num_(other.lists_num_)
+    {
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief NeighborList move constructor.
+     * \param [in] other The list to be moved.
+     */
+    NeighborList(NeighborList &&other) noexcept : offsets_(std::move(other.offsets_)), ids_(std::move(other.ids_)),
+        external_storage_(std::move(other.external_storage_)), offsets_data_(other.offsets_data_), ids_data_(other.ids_data_),
+        lists_num_(other.lists_num_)
+    {
+        this->SyncData();
+        other.Release();
+    }
+
+
+    /**
+     * \brief NeighborList copy assignment operator.
+     * \param [in] other The list to be copied. An external list shares the external storage.
+     * \return [NeighborList&] The assigned list.
+     */
+    NeighborList & operator = (const NeighborList &other)
+    {
+        if (this != &other) {
+            this->offsets_ = other.offsets_;
+            this->ids_ = other.ids_;
+            this->external_storage_ = other.external_storage_;
+            this->offsets_data_ = other.offsets_data_;
+            this->ids_data_ = other.ids_data_;
+            this->lists_num_ = other.lists_num_;
+            this->SyncData();
+        }
+        return *this;
+    }
+
+
+    /**
+     * \brief NeighborList move assignment operator.
+     * \param [in] other The list to be moved.
+     * \return [NeighborList&] The assigned list.
+     */
+    NeighborList & operator = (NeighborList &&other) noexcept
+    {
+        if (this != &other) {
+            this->offsets_ = std::move(other.offsets_);
+            this->ids_ = std::move(other.ids_);
+            this->external_storage_ = std::move(other.external_storage_);
+            this->offsets_data_ = other.offsets_data_;
+            this->ids_data_ = other.ids_data_;
+            this->lists_num_ = other.lists_num_;
+            this->SyncData();
+            other.Release();
+        }
+        return *this;
+    }
+
+
+    /**
+     * \brief Create a list referring to offsets and neighbor indices in external storage without copying them.
+     * \param [in] storage The external storage. It is kept alive as long as the list refers to it.
+     * \param [in] offsets Pointer to the lists_num+1 offsets in the external storage. The first offset must be zero.
+     * \param [in] ids Pointer to the neighbor indices in the external storage.
+     * \param [in] lists_num The number of points in the list.
+     * \return [NeighborList] The list referring to the external storage.
+     */
+    inline static NeighborList FromExternal(std::shared_ptr<const void> storage, const std::size_t *offsets,
+                                            const int *ids, std::size_t lists_num)
+    {
+        if (!storage || offsets == nullptr || offsets[0] != 0 || (ids == nullptr && offsets[lists_num] != 0)) {
+            throw std::invalid_argument(Logger::Error("Could not create neighbor list from external storage. Invalid storage was given.").c_str());
+        }
+
+        NeighborList list;
+        list.offsets_.clear();
+        list.external_storage_ = std::move(storage);
+        list.offsets_data_ = offsets;
+        list.ids_data_ = ids;
+        list.lists_num_ = lists_num;
+        return list;
+    }
+
+
+    /**
+     * \brief Remove all the points and neighbor indices from the list.
+     * \return [void]
+     */
+    inline void Clear()
+    {
+        this->external_storage_.reset();
+        this->offsets_.assign(1, 0);
+        this->ids_.clear();
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief Release the memory of the list.
+     * \return [void]
+     */
+    inline void Release()
+    {
+        this->external_storage_.reset();
+        std::vector<std::size_t>(1, 0).swap(this->offsets_);
+        std::vector<int>().swap(this->ids_);
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief Reserve memory for the given number of points and neighbor indices.
+     * \param [in] lists_num The number of points.
+     * \param [in] ids_num The total number of neighbor indices.
+     * \return [void]
+     */
+    inline void Reserve(std::size_t lists_num, std::size_t ids_num)
+    {
+        this->MakeOwned();
+        this->offsets_.reserve(lists_num+1);
+        this->ids_.reserve(ids_num);
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief Allocate the list for points with the given number of neighbor indices.
+     * The neighbor indices are zero initialized and can be assigned via the Data function.
+     * \param [in] lists_sizes The number of neighbor indices of each point.
+     * \return [void]
+     */
+    inline void Allocate(const std::vector<std::size_t> &lists_sizes)
+    {
+        this->external_storage_.reset();
+        this->offsets_.resize(lists_sizes.size()+1);
+        this->offsets_[0] = 0;
+        for (std::size_t i = 0; i != lists_sizes.size(); ++i) {
+            this->offsets_[i+1] = this->offsets_[i] + lists_sizes[i];
+        }
+        this->ids_.assign(this->offsets_.back(), 0);
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief Append the neighbor indices of a new point at the end of the list.
+     * \param [in] first Iterator to the first neighbor index.
+     * \param [in] last Iterator past the last neighbor index.
+     * \return [void]
+     */
+    template <typename ITERATOR>
+    inline void Append(ITERATOR first, ITERATOR last)
+    {
+        this->MakeOwned();
+        this->ids_.insert(this->ids_.end(), first, last);
+        this->offsets_.emplace_back(this->ids_.size());
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief Append the neighbor indices of a new point at the end of the list.
+     * \param [in] ids The neighbor indices of the new point.
+     * \return [void]
+     */
+    inline void Append(NeighborSpan ids) { this->Append(ids.begin(), ids.end()); }
+
+
+    /**
+     * \brief Append all the neighbor indices lists of another list at the end of the list.
+     * \param [in] other The list to be appended.
+     * \return [void]
+     */
+    inline void AppendLists(const NeighborList &other)
+    {
+        this->MakeOwned();
+        auto shift = this->ids_.size();
+        this->ids_.insert(this->ids_.end(), other.ids_data_, other.ids_data_+other.IdsNum());
+        for (std::size_t i = 1; i <= other.lists_num_; ++i) {
+            this->offsets_.emplace_back(other.offsets_data_[i] + shift);
+        }
+        this->SyncData();
+    }
+
+
+    /**
+     * \brief Replace the neighbor indices of some points.
+     * \param [in] lists_ids The indices of the points with replaced neighbor indices.
+     * \param [in] new_lists The new neighbor indices of the points, in the order of lists_ids.
+     * \return [void]
+     */
+    inline void Replace(const std::vector<int> &lists_ids, const NeighborList &new_lists)
+    {
+        if (lists_ids.size() != new_lists.ListsNum()) {
+            throw std::invalid_argument(Logger::Error("Could not replace neighbor indices lists. "
+                                                      "The number of lists ids and new lists is not equal.").c_str());
+        }
+
+        // Map each point to its replacement list.
+        std::vector<int> replacement(this->ListsNum(), -1);
+        for (std::size_t k = 0; k != lists_ids.size(); ++k) {
+            replacement.at(lists_ids[k]) = static_cast<int>(k);
+        }
+
+        // Rebuild the list with the replaced neighbor indices.
+        NeighborList replaced;
+        replaced.Reserve(this->ListsNum(), this->IdsNum());
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) {
+            if (replacement[i] == -1) { replaced.Append((*this)[i]); }
+            else { replaced.Append(new_lists[replacement[i]]); }
+        }
+        *this = std::move(replaced);
+    }
+
+
+    /**
+     * \brief Get the transposed list. The transposed list of target j contains the indices of the lists containing j in increasing order.
+     * \param [in] targets_num The number of lists of the transposed list. All neighbor indices must be smaller than it.
+     * \return [NeighborList] The transposed list.
+     */
+    inline NeighborList Transposed(std::size_t targets_num) const
+    {
+        // Count the lists containing each target.
+        std::vector<std::size_t> lists_sizes(targets_num, 0);
+        for (std::size_t k = 0; k != this->IdsNum(); ++k) { lists_sizes.at(this->ids_data_[k])++; }
+
+        NeighborList transposed;
+        transposed.Allocate(lists_sizes);
+
+        // Scatter the list indices in increasing order.
+        std::vector<std::size_t> fill_pos(transposed.offsets_.begin(), transposed.offsets_.end()-1);
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) {
+            for (auto k = this->offsets_data_[i]; k != this->offsets_data_[i+1]; ++k) {
+                transposed.ids_[fill_pos[this->ids_data_[k]]++] = static_cast<int>(i);
+            }
+        }
+        return transposed;
+    }
+
+
+    /**
+     * \brief Get the neighbor indices of a point. Fast access with no range check.
+     * \param [in] i The index of the point.
+     * \return [NeighborSpan] The neighbor indices of the point.
+     */
+    inline NeighborSpan operator [] (std::size_t i) const
+    {
+        return NeighborSpan(this->ids_data_+this->offsets_data_[i], this->ids_data_+this->offsets_data_[i+1]);
+    }
+
+
+    /**
+     * \brief Get the neighbor indices of a point. Slower access with range check.
+     * \param [in] i The index of the point.
+     * \return [NeighborSpan] The neighbor indices of the point.
+     */
+    inline NeighborSpan At(std::size_t i) const
+    {
+        if (i >= this->ListsNum()) {
+            throw std::out_of_range(Logger::Error("Could not access neighbor indices. The point index is out of range.").c_str());
+        }
+        return (*this)[i];
+    }
+
+
+    /**
+     * \brief Apply a function on the neighbor indices of a point.
+     *
+     * Shares the interface of CompressedNeighborList::ForEach to write kernels generic on the neighbor list storage.
+     *
+     * \param [in] i The index of the point.
+     * \param [in] func The function called as func(k, id) for the k-th neighbor index id of the point.
+     * \return [void]
+     */
+    template <typename FUNC>
+    inline void ForEach(std::size_t i, FUNC &&func) const
+    {
+        const int *ids = this->ids_data_+this->offsets_data_[i];
+        std::size_t size = this->ListSize(i);
+        for (std::size_t k = 0; k != size; ++k) { func(k, ids[k]); }
+    }
+
+
+    /**
+     * \brief Get writable access to the neighbor indices of a point.
+     * \param [in] i The index of the point.
+     * \return [int*] Pointer to the first neighbor index of the point.
+     */
+    inline int * Data(std::size_t i)
+    {
+        this->MakeOwned();
+        return this->ids_.data()+this->offsets_[i];
+    }
+
+
+    /**
+     * \brief Get the number of neighbor indices of a point.
+     * \param [in] i The index of the point.
+     * \return [std::size_t] The number of neighbor indices of the point.
+     */
+    inline std::size_t ListSize(std::size_t i) const { return this->offsets_data_[i+1] - this->offsets_data_[i]; }
+
+
+    /**
+     * \brief Get the number of points in the list.
+     * \return [std::size_t] The number of points in the list.
+     */
+    inline std::size_t ListsNum() const { return this->lists_num_; }
+
+
+    /**
+     * \brief Get the total number of neighbor indices in the list.
+     * \return [std::size_t] The total number of neighbor indices in the list.
+     */
+    inline std::size_t IdsNum() const { return this->offsets_data_[this->lists_num_]; }
+
+
+    /**
+     * \brief Check if the list contains no points.
+     * \return [bool] True if the list contains no points, false otherwise.
+     */
+    inline bool Empty() const { return this->lists_num_ == 0; }
+
+
+    /**
+     * \brief Check if the list refers to external storage.
+     * \return [bool] True if the list refers to external storage, false otherwise.
+     */
+    inline bool IsExternal() const { return static_cast<bool>(this->external_storage_); }
+
+
+    /**
+     * \brief Get the smallest number of neighbor indices of a point in the list.
+     * \return [std::size_t] The smallest number of neighbor indices. Zero for an empty list.
+     */
+    inline std::size_t MinListSize() const
+    {
+        if (this->Empty()) { return 0; }
+        std::size_t min_size = std::numeric_limits<std::size_t>::max();
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) { min_size = std::min(min_size, this->ListSize(i)); }
+        return min_size;
+    }
+
+
+    /**
+     * \brief Get the largest number of neighbor indices of a point in the list.
+     * \return [std::size_t] The largest number of neighbor indices. Zero for an empty list.
+     */
+    inline std::size_t MaxListSize() const
+    {
+        std::size_t max_size = 0;
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) { max_size = std::max(max_size, this->ListSize(i)); }
+        return max_size;
+    }
+
+
+    /**
+     * \brief Get the memory owned by the list for the offsets and neighbor indices. External storage is not included.
+     * \return [std::size_t] The memory in bytes.
+     */
+    inline std::size_t MemoryBytes() const
+    {
+        return this->offsets_.capacity()*sizeof(std::size_t) + this->ids_.capacity()*sizeof(int);
+    }
+
+
+    /**
+     * \brief Copy the neighbor indices lists in nested vectors.
+     * \return [std::vector<std::vector<int> >] The neighbor indices lists of the points.
+     */
+    inline std::vector<std::vector<int> > ToNested() const
+    {
+        std::vector<std::vector<int> > nested_ids;
+        nested_ids.reserve(this->ListsNum());
+        for (std::size_t i = 0; i != this->ListsNum(); ++i) { nested_ids.emplace_back((*this)[i].ToVector()); }
+        return nested_ids;
+    }
+
+
+    /**
+     * \brief Get the offsets of the neighbor indices of each point.
+     * \return [const std::size_t*] Pointer to the ListsNum()+1 offsets of the neighbor indices of each point.
+     */
+    inline const std::size_t * OffsetsData() const { return this->offsets_data_; }
+
+
+    /**
+     * \brief Get the neighbor indices of all the points stored contiguously.
+     * \return [const int*] Pointer to the IdsNum() neighbor indices of all the points.
+     */
+    inline const int * IdsData() const { return this->ids_data_; }
+
+
+    inline bool operator == (const NeighborList &other) const
+    {
+        return this->lists_num_ == other.lists_num_ &&
+               std::equal(this->offsets_data_, this->offsets_data_+this->lists_num_+1, other.offsets_data_) &&
+               std::equal(this->ids_data_, this->ids_data_+this->IdsNum(), other.ids_data_);
+    }
+
+
+    inline bool operator != (const NeighborList &other) const { return !(*this == other); }
+
+};
+
+
+/*! \} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SUPPORT_DOMAIN_NEIGHBOR_LIST_HPP_
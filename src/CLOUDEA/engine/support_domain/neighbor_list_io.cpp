@@ -0,0 +1,316 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CLOUDEA/engine/support_domain/neighbor_list_io.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+
+namespace CLOUDEA {
+
+
+// The identifier and layout of the binary neighbor list files.
+static const char nbl_magic[8] = {'C', 'L', 'D', 'N', 'B', 'L', 'S', 'T'};
+static const std::uint32_t nbl_version = 2;
+static const std::size_t nbl_header_bytes = 96;
+
+
+NeighborListHeader NeighborListIO::ParseHeader(const char *data, std::size_t file_size, const std::string &filename)
+{
+    if (file_size < nbl_header_bytes || std::memcmp(data, nbl_magic, sizeof(nbl_magic)) != 0) {
+        std::string error = Logger::Error("The file \"") + filename + "\" is not a binary neighbor list file";
+        throw std::runtime_error(error.c_str());
+    }
+
+    NeighborListHeader header;
+    std::memcpy(&header.version, data+8, sizeof(std::uint32_t));
+    std::memcpy(&header.flags, data+12, sizeof(std::uint32_t));
+    std::memcpy(&header.lists_num, data+16, sizeof(std::uint64_t));
+    std::memcpy(&header.ids_num, data+24, sizeof(std::uint64_t));
+    std::memcpy(&header.mesh_hash, data+32, sizeof(std::uint64_t));
+    std::memcpy(&header.dilatation_coeff, data+40, sizeof(double));
+    std::memcpy(&header.payload_bytes, data+48, sizeof(std::uint64_t));
+    std::memcpy(&header.nodes_num, data+56, sizeof(std::uint64_t));
+    std::memcpy(&header.points_hash, data+64, sizeof(std::uint64_t));
+    std::memcpy(&header.radius_mode, data+72, sizeof(std::uint32_t));
+    std::memcpy(&header.min_neighs_num, data+76, sizeof(std::uint32_t));
+    std::memcpy(&header.max_neighs_num, data+80, sizeof(std::uint32_t));
+    std::memcpy(&header.support_margin, data+88, sizeof(double));
+
+    if (header.version != nbl_version) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" has unsupported version " +
+                            std::to_string(header.version);
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Check that the file contains the offsets and the neighbor indices.
+    std::uint64_t expected_size = nbl_header_bytes + (header.lists_num+1)*sizeof(std::uint64_t) + header.payload_bytes;
+    if (header.lists_num > file_size || header.payload_bytes > file_size || expected_size != file_size ||
+            (!(header.flags & compressed_flag) && header.payload_bytes != header.ids_num*sizeof(std::int32_t))) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" is corrupted";
+        throw std::runtime_error(error.c_str());
+    }
+
+    return header;
+}
+
+
+void NeighborListIO::EncodeIds(const NeighborList &neighbor_ids, std::vector<unsigned char> &payload)
+{
+    payload.clear();
+    payload.reserve(neighbor_ids.IdsNum()*2);
+
+    for (std::size_t i = 0; i != neighbor_ids.ListsNum(); ++i) {
+        std::int64_t prev_id = 0;
+        for (const auto &id : neighbor_ids[i]) {
+            // Zigzag encode the difference from the previous index to support unsorted indices.
+            std::int64_t diff = static_cast<std::int64_t>(id) - prev_id;
+            std::uint64_t value = (static_cast<std::uint64_t>(diff) << 1) ^ static_cast<std::uint64_t>(diff >> 63);
+            prev_id = id;
+
+            // Store 7 bits per byte. The high bit marks that more bytes follow.
+            while (value >= 0x80) {
+                payload.emplace_back(static_cast<unsigned char>(value | 0x80));
+                value >>= 7;
+            }
+            payload.emplace_back(static_cast<unsigned char>(value));
+        }
+    }
+}
+
+
+NeighborList NeighborListIO::DecodeIds(const std::uint64_t *offsets, std::size_t lists_num,
+                                       const unsigned char *payload, std::size_t payload_bytes, std::uint64_t nodes_num)
+{
+    std::vector<std::size_t> lists_sizes(lists_num);
+    for (std::size_t i = 0; i != lists_num; ++i) {
+        if (offsets[i+1] < offsets[i]) {
+            throw std::runtime_error(Logger::Error("Could not decode neighbor list. Invalid offsets were found.").c_str());
+        }
+        lists_sizes[i] = static_cast<std::size_t>(offsets[i+1] - offsets[i]);
+    }
+
+    NeighborList neighbor_ids;
+    neighbor_ids.Allocate(lists_sizes);
+
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i != lists_num; ++i) {
+        int *ids = neighbor_ids.Data(i);
+        std::int64_t prev_id = 0;
+        for (std::size_t k = 0; k != lists_sizes[i]; ++k) {
+            std::uint64_t value = 0;
+            int shift = 0;
+            while (true) {
+                if (pos == payload_bytes || shift > 63) {
+                    throw std::runtime_error(Logger::Error("Could not decode neighbor list. The compressed indices are corrupted.").c_str());
+                }
+                auto byte = payload[pos++];
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) { break; }
+                shift += 7;
+            }
+            std::int64_t diff = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+            prev_id += diff;
+            if (prev_id < 0 || static_cast<std::uint64_t>(prev_id) >= nodes_num) {
+                throw std::runtime_error(Logger::Error("Could not decode neighbor list. An index outside the influence nodes was found.").c_str());
+            }
+            ids[k] = static_cast<int>(prev_id);
+        }
+    }
+
+    return neighbor_ids;
+}
+
+
+NeighborListIO::NeighborListIO()
+{}
+
+
+NeighborListIO::~NeighborListIO()
+{}
+
+
+void NeighborListIO::Save(const std::string &filename, const NeighborList &neighbor_ids, const NeighborListKey &key, bool compress) const
+{
+    // Check if filename is not empty.
+    if (filename.empty()) {
+        throw std::invalid_argument(Logger::Error("No filename was given to save the binary neighbor list").c_str());
+    }
+
+    // Check that the neighbor list has one list per evaluation point.
+    if (neighbor_ids.ListsNum() != key.points_num) {
+        std::string error = Logger::Error("Could not save the binary neighbor list file \"") + filename + "\". It has " +
+                            std::to_string(neighbor_ids.ListsNum()) + " lists for " + std::to_string(key.points_num) + " evaluation points";
+        throw std::invalid_argument(error.c_str());
+    }
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::string error = Logger::Error("Could not open the binary neighbor list file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Encode the neighbor indices if requested.
+    std::vector<unsigned char> payload;
+    if (compress) { EncodeIds(neighbor_ids, payload); }
+
+    // Write the header.
+    NeighborListHeader header;
+    header.version = nbl_version;
+    header.flags = compress ? compressed_flag : 0;
+    header.lists_num = neighbor_ids.ListsNum();
+    header.ids_num = neighbor_ids.IdsNum();
+    header.mesh_hash = key.mesh_hash;
+    header.dilatation_coeff = key.dilatation_coeff;
+    header.payload_bytes = compress ? payload.size() : neighbor_ids.IdsNum()*sizeof(std::int32_t);
+    header.nodes_num = key.nodes_num;
+    header.points_hash = key.points_hash;
+    header.radius_mode = static_cast<std::uint32_t>(key.radius_mode);
+    header.min_neighs_num = key.min_neighs_num;
+    header.max_neighs_num = key.max_neighs_num;
+    header.support_margin = key.support_margin;
+
+    char header_bytes[nbl_header_bytes] = {};
+    std::memcpy(header_bytes, nbl_magic, sizeof(nbl_magic));
+    std::memcpy(header_bytes+8, &header.version, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+12, &header.flags, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+16, &header.lists_num, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+24, &header.ids_num, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+32, &header.mesh_hash, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+40, &header.dilatation_coeff, sizeof(double));
+    std::memcpy(header_bytes+48, &header.payload_bytes, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+56, &header.nodes_num, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+64, &header.points_hash, sizeof(std::uint64_t));
+    std::memcpy(header_bytes+72, &header.radius_mode, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+76, &header.min_neighs_num, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+80, &header.max_neighs_num, sizeof(std::uint32_t));
+    std::memcpy(header_bytes+88, &header.support_margin, sizeof(double));
+    file.write(header_bytes, nbl_header_bytes);
+
+    // Write the offsets as 64-bit integers.
+    std::vector<std::uint64_t> offsets(neighbor_ids.OffsetsData(), neighbor_ids.OffsetsData()+neighbor_ids.ListsNum()+1);
+    file.write(reinterpret_cast<const char *>(offsets.data()), static_cast<std::streamsize>(offsets.size()*sizeof(std::uint64_t)));
+
+    // Write the neighbor indices.
+    if (compress) {
+        file.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    } else {
+        static_assert(sizeof(int) == sizeof(std::int32_t), "Binary neighbor lists require 32-bit int indices.");
+        file.write(reinterpret_cast<const char *>(neighbor_ids.IdsData()), static_cast<std::streamsize>(header.payload_bytes));
+    }
+
+    if (!file) {
+        std::string error = Logger::Error("Could not write the binary neighbor list file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+}
+
+
+NeighborList NeighborListIO::Load(const std::string &filename, const NeighborListKey &key) const
+{
+    // Check if filename is not empty.
+    if (filename.empty()) {
+        throw std::invalid_argument(Logger::Error("No filename was given to load the binary neighbor list").c_str());
+    }
+
+    std::size_t file_size = 0;
+    auto storage = MappedFile::Map(filename, "binary neighbor list", file_size);
+    const char *data = static_cast<const char *>(storage.get());
+    auto header = ParseHeader(data, file_size, filename);
+
+    // Reject neighbor lists computed for a different mesh, evaluation points or influence radiuses.
+    if (header.mesh_hash != key.mesh_hash || header.nodes_num != key.nodes_num) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" was computed for a different mesh";
+        throw std::runtime_error(error.c_str());
+    }
+    if (header.lists_num != key.points_num || header.points_hash != key.points_hash) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" was computed for " +
+                            std::to_string(header.lists_num) + " different evaluation points instead of the given " +
+                            std::to_string(key.points_num);
+        throw std::runtime_error(error.c_str());
+    }
+    if (header.dilatation_coeff != key.dilatation_coeff) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" was computed with dilatation coefficient " +
+                            std::to_string(header.dilatation_coeff) + " instead of " + std::to_string(key.dilatation_coeff);
+        throw std::runtime_error(error.c_str());
+    }
+    if (header.radius_mode != static_cast<std::uint32_t>(key.radius_mode) || header.min_neighs_num != key.min_neighs_num ||
+            header.max_neighs_num != key.max_neighs_num || header.support_margin != key.support_margin) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" was computed with different"
+                            " influence radiuses mode or support nodes number bounds";
+        throw std::runtime_error(error.c_str());
+    }
+
+    auto lists_num = static_cast<std::size_t>(header.lists_num);
+    const auto *offsets = reinterpret_cast<const std::uint64_t *>(data + nbl_header_bytes);
+    const char *payload = data + nbl_header_bytes + (lists_num+1)*sizeof(std::uint64_t);
+
+    // Check the consistency of the offsets.
+    if (offsets[0] != 0 || offsets[lists_num] != header.ids_num) {
+        std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" is corrupted";
+        throw std::runtime_error(error.c_str());
+    }
+
+    // Decode compressed neighbor indices.
+    if (header.flags & compressed_flag) {
+        return DecodeIds(offsets, lists_num, reinterpret_cast<const unsigned char *>(payload),
+                         static_cast<std::size_t>(header.payload_bytes), header.nodes_num);
+    }
+
+    // Check that offsets are non-decreasing.
+    for (std::size_t i = 0; i != lists_num; ++i) {
+        if (offsets[i+1] < offsets[i]) {
+            std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" is corrupted";
+            throw std::runtime_error(error.c_str());
+        }
+    }
+
+    // Check that the neighbor indices refer to influence nodes.
+    const auto *ids = reinterpret_cast<const int *>(payload);
+    for (std::uint64_t k = 0; k != header.ids_num; ++k) {
+        if (ids[k] < 0 || static_cast<std::uint64_t>(ids[k]) >= header.nodes_num) {
+            std::string error = Logger::Error("The binary neighbor list file \"") + filename + "\" stores the index " +
+                                std::to_string(ids[k]) + " outside the " + std::to_string(header.nodes_num) + " influence nodes";
+            throw std::runtime_error(error.c_str());
+        }
+    }
+
+    // Refer to the mapped file without copying when the offsets storage matches.
+    if (sizeof(std::size_t) == sizeof(std::uint64_t)) {
+        return NeighborList::FromExternal(storage, reinterpret_cast<const std::size_t *>(offsets), ids, lists_num);
+    }
+
+    std::vector<std::size_t> owned_offsets(offsets, offsets+lists_num+1);
+    std::vector<int> owned_ids(ids, ids+header.ids_num);
+    return NeighborList(std::move(owned_offsets), std::move(owned_ids));
+}
+
+
+NeighborListHeader NeighborListIO::ReadHeader(const std::string &filename) const
+{
+    char header_bytes[nbl_header_bytes] = {};
+    auto file_size = MappedFile::ReadPrefix(filename, "binary neighbor list", header_bytes, nbl_header_bytes);
+
+    return ParseHeader(header_bytes, file_size, filename);
+}
+
+
+} //end of namespace CLOUDEA
@@ -0,0 +1,222 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file neighbor_list_io.hpp
+   \brief NeighborListIO class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_SUPPORT_DOMAIN_NEIGHBOR_LIST_IO_HPP_
+#define CLOUDEA_SUPPORT_DOMAIN_NEIGHBOR_LIST_IO_HPP_
+
+
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/utilities/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/** \addtogroup Meshfree \{ */
+
+
+/**
+ * \enum SupportRadiusMode
+ * \author Konstantinos A. Mountris
+ * \brief Computation modes of the influence radiuses of a support domain.
+ */
+enum class SupportRadiusMode : std::uint32_t { dilatation = 0,      /**< Mesh-based influence radiuses scaled by a dilatation coefficient */
+                                               target_count = 1     /**< Influence radiuses tuned to a target number of support nodes */
+                                             };
+
+
+/**
+ * \struct NeighborListHeader
+ * \author Konstantinos A. Mountris
+ * \brief Header of a binary neighbor list file.
+ */
+struct NeighborListHeader
+{
+    std::uint32_t version;                                 /**< The version of the binary format */
+
+    std::uint32_t flags;                                   /**< The storage flags of the neighbor indices */
+
+    std::uint64_t lists_num;                               /**< The number of points in the neighbor list */
+
+    std::uint64_t ids_num;                                 /**< The total number of neighbor indices */
+
+    std::uint64_t mesh_hash;                               /**< The hash of the mesh used to compute the neighbor list */
+
+    double dilatation_coeff;                               /**< The dilatation coefficient of the influence radiuses used to compute the neighbor list */
+
+    std::uint64_t payload_bytes;                           /**< The size in bytes of the stored neighbor indices */
+
+    std::uint64_t nodes_num;                               /**< The number of influence nodes the neighbor indices refer to */
+
+    std::uint64_t points_hash;                             /**< The hash of the evaluation points of the neighbor list */
+
+    std::uint32_t radius_mode;                             /**< The computation mode of the influence radiuses used to compute the neighbor list */
+
+    std::uint32_t min_neighs_num;                          /**< The minimum number of support nodes of target-count influence radiuses */
+
+    std::uint32_t max_neighs_num;                          /**< The maximum number of support nodes of target-count influence radiuses */
+
+    double support_margin;                                 /**< The support margin of target-count influence radiuses */
+};
+
+
+/**
+ * \struct NeighborListKey
+ * \author Konstantinos A. Mountris
+ * \brief The geometry and support parameters a binary neighbor list file is valid for.
+ */
+struct NeighborListKey
+{
+    std::uint64_t mesh_hash;                               /**< The hash of the mesh of the influence nodes */
+
+    std::uint64_t nodes_num;                               /**< The number of influence nodes */
+
+    std::uint64_t points_num;                              /**< The number of evaluation points */
+
+    std::uint64_t points_hash;                             /**< The hash of the coordinates of the evaluation points */
+
+    double dilatation_coeff;                               /**< The dilatation coefficient of the influence radiuses */
+
+    SupportRadiusMode radius_mode;                         /**< The computation mode of the influence radiuses */
+
+    std::uint32_t min_neighs_num;                          /**< The minimum number of support nodes. Zero for dilatation mode */
+
+    std::uint32_t max_neighs_num;                          /**< The maximum number of support nodes. Zero if not bounded or for dilatation mode */
+
+    double support_margin;                                 /**< The support margin. Zero for dilatation mode */
+};
+
+
+/**
+ * \class NeighborListIO
+ * \author Konstantinos A. Mountris
+ * \brief Binary input/output of neighbor lists.
+ *
+ * The binary file stores a 96 byte header followed by the offsets of the neighbor list as 64-bit integers
+ * and the neighbor indices either as 32-bit integers or delta + varint compressed. The header records
+ * the mesh, the evaluation points and the influence radiuses mode and parameters used to compute the neighbor
+ * list so that stale files are rejected.
+ * Uncompressed files are memory mapped where supported and the loaded neighbor list refers to the mapped
+ * file without copying.
+ */
+class NeighborListIO
+{
+protected:
+
+    /**
+     * \brief Parse and validate the header of a binary neighbor list file.
+     * \param [in] data The contents of the file.
+     * \param [in] file_size The size of the file in bytes.
+     * \param [in] filename The file name used in the error messages.
+     * \return [NeighborListHeader] The header of the file.
+     */
+    static NeighborListHeader ParseHeader(const char *data, std::size_t file_size, const std::string &filename);
+
+
+    /**
+     * \brief Encode the neighbor indices of each point as varint encoded zigzag differences of consecutive indices.
+     * \param [in] neighbor_ids The neighbor list to be encoded.
+     * \param [out] payload The encoded neighbor indices.
+     * \return [void]
+     */
+    static void EncodeIds(const NeighborList &neighbor_ids, std::vector<unsigned char> &payload);
+
+
+    /**
+     * \brief Decode the varint encoded neighbor indices of each point.
+     * \param [in] offsets The lists_num+1 offsets of the neighbor indices of each point.
+     * \param [in] lists_num The number of points.
+     * \param [in] payload The encoded neighbor indices.
+     * \param [in] payload_bytes The size of the encoded neighbor indices in bytes.
+     * \param [in] nodes_num The number of influence nodes. Decoded indices outside [0, nodes_num) are rejected.
+     * \return [NeighborList] The decoded neighbor list.
+     */
+    static NeighborList DecodeIds(const std::uint64_t *offsets, std::size_t lists_num,
+                                  const unsigned char *payload, std::size_t payload_bytes, std::uint64_t nodes_num);
+
+
+public:
+
+    /**
+     * \brief Flag of delta + varint compressed neighbor indices.
+     */
+    static const std::uint32_t compressed_flag = 1;
+
+
+    /**
+     * \brief NeighborListIO constructor.
+     */
+    NeighborListIO();
+
+
+    /**
+     * \brief NeighborListIO destructor.
+     */
+    virtual ~NeighborListIO();
+
+
+    /**
+     * \brief Save a neighbor list in a binary file.
+     * \param [in] filename The binary file where the neighbor list will be saved.
+     * \param [in] neighbor_ids The neighbor list to be saved. It must have one list per evaluation point of the key.
+     * \param [in] key The mesh, evaluation points and influence radiuses parameters used to compute the neighbor list.
+     * \param [in] compress Conditional to store the neighbor indices delta + varint compressed.
+     * \return [void]
+     */
+    void Save(const std::string &filename, const NeighborList &neighbor_ids, const NeighborListKey &key, bool compress = false) const;
+
+
+    /**
+     * \brief Load a neighbor list from a binary file.
+     * \param [in] filename The binary file where the neighbor list will be loaded from.
+     * \param [in] key The current mesh, evaluation points and influence radiuses parameters. The file is rejected if it
+     *                 was computed for a different key or if it stores indices outside the influence nodes.
+     * \return [NeighborList] The loaded neighbor list. It refers to the memory mapped file if the neighbor indices are not compressed.
+     */
+    NeighborList Load(const std::string &filename, const NeighborListKey &key) const;
+
+
+    /**
+     * \brief Read the header of a binary neighbor list file.
+     * \param [in] filename The binary neighbor list file.
+     * \return [NeighborListHeader] The header of the file.
+     */
+    NeighborListHeader ReadHeader(const std::string &filename) const;
+
+};
+
+
+/*! \} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_SUPPORT_DOMAIN_NEIGHBOR_LIST_IO_HPP_
@@ -29,6 +29,10 @@
 
 
 #include "CLOUDEA/engine/utilities/logger.hpp"
+#include "CLOUDEA/engine/support_domain/cell_list_search.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/support_domain/mesh_edges.hpp"
+#include "CLOUDEA/engine/utilities/thread_loop_manager.hpp"
 
 #include <IMP/Vectors>
 #include <IMP/Tesselations>
@@ -59,6 +63,8 @@
 #include <unordered_set>
 #include <algorithm>
 #include <utility>
+#include <thread>
+#include <functional>
 
 namespace CLOUDEA {
 
@@ -77,7 +83,7 @@ class SupportDomain
 
 private:
 
-    std::vector<std::vector<int>> influence_node_ids_;     /**< The indices of the support nodes for each field node */
+    NeighborList influence_node_ids_;                      /**< The indices of the support nodes for each field node */
 
     std::vector<double> radius_;                           /**< The radius of the support domain for each field node */
     
@@ -89,6 +95,10 @@ private:
 
     int max_influence_nodes_num_;                          /**< The number of support nodes in the largest support domain */
 
+    bool use_cell_list_search_;                            /**< Conditional to use the cell list search instead of the CGAL kd-tree search */
+
+    std::size_t search_threads_num_;                       /**< The number of threads used in the support nodes search and the support radius computation */
+
 
 protected:
 
@@ -101,28 +111,65 @@ protected:
     //#ifdef CLOUDEA_WITH_CGAL
 
     /**
-     * @brief 
-     * 
-     * @param nodes 
+     * \brief Search the support nodes of the points with range queries of the field nodes' support domains on a 2D CGAL kd-tree.
+     * \param [in] points The points for which the support nodes will be identified.
+     * \param [in] field_nodes The field nodes.
+     * \return [void]
      */
     inline void FastInfluenceNodesSearch_2d(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes);
     
     /**
-     * @brief 
-     * 
-     * @param nodes 
+     * \brief Search the support nodes of the points with range queries of the field nodes' support domains on a 3D CGAL kd-tree.
+     * \param [in] points The points for which the support nodes will be identified.
+     * \param [in] field_nodes The field nodes.
+     * \return [void]
      */
     inline void FastInfluenceNodesSearch_3d(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes);
 
 
     /**
-     * @brief 
-     * @param points 
-     * @param field_nodes 
+     * \brief Search the support nodes of the points with range queries of the field nodes' support domains on a CGAL kd-tree.
+     * The range queries run in parallel over contiguous ranges of field nodes. The output does not depend on the threads number.
+     * \param [in] points The points for which the support nodes will be identified.
+     * \param [in] field_nodes The field nodes.
+     * \param [in] to_point Function converting a node to a CGAL point of the kd-tree's dimension.
+     * \return [void]
+     */
+    template<class POINT_T, class TRAITS_BASE_T, class TO_POINT_T>
+    inline void KdTreeInfluenceNodesSearch(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes,
+                                           const TO_POINT_T &to_point);
+
+
+    /**
+     * \brief Search the nearest support nodes of the field nodes on CGAL kd-trees of all, surface and inside field nodes.
+     * The three trees are built concurrently and the nearest neighbor queries run in parallel into preallocated storage.
+     * The output does not depend on the threads number.
+     * \param [in] field_nodes The field nodes.
+     * \param [in] surf_nodeset The set of the field nodes on the surface of the domain.
+     * \param [in] neigh_num The number of nearest support nodes of each field node.
+     * \return [void]
      */
     inline void FastSearchNearestInfluenceNodes_3d(const std::vector<IMP::Vec<DIM, double>> &field_nodes, const IMP::NodeSet &surf_nodeset, int neigh_num);
     //#endif
 
+
+    /**
+     * \brief Search the support nodes of the points using a cell list of the field nodes' support domains.
+     * Dependency-free alternative of the CGAL-based search for 2D and 3D domains giving identical support nodes.
+     * \param [in] points The points for which the support nodes will be identified.
+     * \param [in] field_nodes The field nodes.
+     * \return [void]
+     */
+    inline void CellListInfluenceNodesSearch(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes);
+
+
+    /**
+     * \brief Get the number of threads to be used in a parallel loop.
+     * \param [in] entries_num The number of entries of the loop.
+     * \return [std::size_t] The number of threads. A single thread is used if there are not more entries than threads.
+     */
+    inline std::size_t SearchThreadsNumber(std::size_t entries_num) const;
+
 public:
 
     /**
@@ -176,6 +223,23 @@ public:
      * \return [void]
      */
     inline void SetDilateCoeff(double dilate_coeff);
+
+
+    /**
+     * \brief Set the number of threads used in the support nodes search and the support radius computation.
+     * \param [in] threads_num The number of threads. If zero, the number of available hardware threads is used. [Default: 0]
+     * \return [void]
+     */
+    inline void SetThreadsNumber(std::size_t threads_num);
+
+
+    /**
+     * \brief Set the cell list search for the identification of the support nodes in range instead of the CGAL kd-tree search.
+     * \param [in] use_cell_list Conditional to use the cell list search.
+     * \param [in] threads_num The number of threads used in the cell list search and the support radius computation. If zero, the number of available hardware threads is used.
+     * \return [void]
+     */
+    inline void SetCellListSearch(bool use_cell_list, std::size_t threads_num = 0);
     
     
     /**
@@ -187,9 +251,10 @@ public:
 
 
     /**
-     * \brief 
-     * \tparam CELL_NODES 
-     * \param mesh 
+     * \brief Compute the support radius of each field node as the mean length of the cell edges connected to the node.
+     * \tparam CELL_NODES The number of nodes of the grid cells.
+     * \param [in] grid The irregular grid of the field nodes.
+     * \return [void]
      */
     template<short CELL_NODES>
     void ComputeRadiusFromIrregularGrid(const IMP::Grid<DIM, CELL_NODES> &grid);
@@ -287,25 +352,25 @@ public:
 
     /**
      * \brief Get the indices of the nodes in the support domain for all field nodes. 
-     * \return [const std::vector<std::vector<int>>&] The indices of the nodes in the support domain for all field nodes.
+     * \return [const NeighborList&] The indices of the nodes in the support domain for all field nodes.
      */
-    inline const std::vector<std::vector<int>> & InfluenceNodeIds() const { return this->influence_node_ids_; }
+    inline const NeighborList & InfluenceNodeIds() const { return this->influence_node_ids_; }
 
 
     /**
      * \brief Get the indices of the nodes in the support domain for a specified field node.
      * Fast access with no range check.
-     * \return [const std::vector<int>&] The indices of the nodes in the support domain for a specified field node.
+     * \return [NeighborSpan] The indices of the nodes in the support domain for a specified field node.
      */
-    inline const std::vector<int> & InfluenceNodeIds(std::size_t id) const { return this->influence_node_ids_[id]; }
+    inline NeighborSpan InfluenceNodeIds(std::size_t id) const { return this->influence_node_ids_[id]; }
 
 
     /**
      * \brief Get the indices of the nodes in the support domain for a specified field node.
      * Slower access with range check.
-     * \return [const std::vector<std::vector<int>>&] The indices of the nodes in the support domain for a specified field node.
+     * \return [NeighborSpan] The indices of the nodes in the support domain for a specified field node.
      */
-    inline const std::vector<int> & InfluenceNodeIdsAt(std::size_t id) const { return this->influence_node_ids_.at(id); }
+    inline NeighborSpan InfluenceNodeIdsAt(std::size_t id) const { return this->influence_node_ids_.At(id); }
 
 
     /**
@@ -38,19 +38,19 @@ void SupportDomain<DIM>::ExhaustiveInfluenceNodesSearch(const std::vector<IMP::V
     }
 
     // Re initialize support nodes indices containers.
-    this->influence_node_ids_.clear();
-    this->influence_node_ids_.resize(points.size(), std::vector<int>());
+    this->influence_node_ids_.Clear();
+    this->influence_node_ids_.Reserve(points.size(), 0);
 
     // Reset min and max support domain nodes number.
     this->min_influence_nodes_num_ = std::numeric_limits<int>::max();
     this->max_influence_nodes_num_ = 0;
 
     // Iterate over the points nodes.
+    std::vector<int> neigh_ids;
     for (const auto &point : points) {
 
-        auto pid = &point - &points[0];
-
         // Iterate over the field nodes to find neighbors.
+        neigh_ids.clear();
         bool in_support;
         for (const auto &neigh_node : field_nodes) {
 
@@ -66,98 +66,64 @@ void SupportDomain<DIM>::ExhaustiveInfluenceNodesSearch(const std::vector<IMP::V
 
             // Add the index of the neighbor id in the influence domain of the point.
             if (in_support) {
-                this->influence_node_ids_[pid].emplace_back(neigh_id);
+                neigh_ids.emplace_back(static_cast<int>(neigh_id));
             }
 
         } // End of Iterate over the nodes to find neighbors.
 
+        // Store the support nodes of the point.
+        this->influence_node_ids_.Append(neigh_ids.begin(), neigh_ids.end());
+
         // Update min - max support domain nodes number.
-        if (static_cast<int>(influence_node_ids_[pid].size()) > this->max_influence_nodes_num_) { this->max_influence_nodes_num_ = static_cast<int>(influence_node_ids_[pid].size()); }
-        if (static_cast<int>(influence_node_ids_[pid].size()) < this->min_influence_nodes_num_) { this->min_influence_nodes_num_ = static_cast<int>(influence_node_ids_[pid].size()); }
+        if (static_cast<int>(neigh_ids.size()) > this->max_influence_nodes_num_) { this->max_influence_nodes_num_ = static_cast<int>(neigh_ids.size()); }
+        if (static_cast<int>(neigh_ids.size()) < this->min_influence_nodes_num_) { this->min_influence_nodes_num_ = static_cast<int>(neigh_ids.size()); }
     
 
     } // End of Iterate over the points.
 }
 
 
-//#ifdef CLOUDEA_WITH_CGAL
 template<short DIM>
-void SupportDomain<DIM>::FastInfluenceNodesSearch_2d(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes)
+void SupportDomain<DIM>::CellListInfluenceNodesSearch(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes)
 {
-    // CGAL types declaration.
-    typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
-    typedef K::Point_2 Point;
-    typedef boost::tuple<Point, int> Point_and_int;
-    typedef CGAL::Search_traits_2<K> Traits_base;
-    typedef CGAL::Search_traits_adapter<Point_and_int, CGAL::Nth_of_tuple_property_map<0, Point_and_int>, Traits_base> Traits;
-    typedef CGAL::Kd_tree<Traits> Tree;
-    typedef CGAL::Fuzzy_sphere<Traits> Fuzzy_sphere;
-
     // Check nodes number consistency.
     if (this->field_nodes_num_ != static_cast<int>(field_nodes.size())) {
-        std::string error_str = "Could not perform fast search for support nodes. " 
+        std::string error_str = "Could not perform cell list search for support nodes. "
                                 "The support domain nodes number does not match with the size of the given nodes.";
-        
+
         throw std::invalid_argument(Logger::Error(error_str, __FILE__, __LINE__));
     }
 
-    // Re initialize support nodes indices containers.
-    this->influence_node_ids_.clear();
-    this->influence_node_ids_.resize(points.size(), std::vector<int>());
-
-    // Initialize tree tuple points coordinates.
-    std::vector<Point> points_coords;
-    points_coords.reserve(points.size());
-
-    // Initialize tree tuple points indices.
-    std::vector<int> points_ids;
-    points_ids.reserve(points.size());
-
-    auto pid = 0;
-    for (auto &point : points) {
-        points_coords.emplace_back(Point(point[0], point[1]));
-        points_ids.emplace_back(pid++);
+    // Compute the dilated support domain radius of the field nodes.
+    std::vector<double> dilated_radius(field_nodes.size());
+    for (std::size_t i = 0; i != field_nodes.size(); ++i) {
+        dilated_radius[i] = this->dilate_coeff_[i]*this->radius_[i];
     }
-    
-    // Insert <point,id> tuples in the searching tree.
-    Tree tree(boost::make_zip_iterator(boost::make_tuple(points_coords.begin(), points_ids.begin())),
-              boost::make_zip_iterator(boost::make_tuple(points_coords.end(), points_ids.end())));    
-    
-    // Find the influence field nodes for influenced point.
-    std::vector<Point_and_int> neighs;
-    for (auto &field_node : field_nodes) {
-        auto fn_id = &field_node - &field_nodes[0];
-
-        // Set field node as the influence domain's center.
-        Point influence_center(field_node[0], field_node[1]);
 
-        // Set the influence domain range.
-        Fuzzy_sphere influence_range(influence_center, this->dilate_coeff_[fn_id]*this->radius_[fn_id]);
+    // Find the influence field nodes of each point.
+    CellListSearch<DIM> cell_list;
+    cell_list.SetThreadsNumber(this->search_threads_num_);
+    cell_list.SetSpheres(field_nodes, dilated_radius);
+    this->influence_node_ids_ = cell_list.ContainingSpheresIds(points);
 
-        // Get the influence domain nodes.
-        tree.search(std::back_inserter(neighs), influence_range);
-
-        // Establish the domains as influence or influence domain.
-        for (const auto &neigh : neighs) {
-                // Store the influencing field node index in the support of the neighbor (influenced) node.
-                this->influence_node_ids_[boost::get<1>(neigh)].emplace_back(fn_id);
-        }
+    // Update min - max support domain nodes number.
+    this->min_influence_nodes_num_ = static_cast<int>(this->influence_node_ids_.MinListSize());
+    this->max_influence_nodes_num_ = static_cast<int>(this->influence_node_ids_.MaxListSize());
 
-        // Clear support nodes vector for next iteration.
-        neighs.clear();
-    }
+}
 
-    // Update min - max support domain nodes number.
-    std::size_t min_sd = std::numeric_limits<std::size_t>::max();
-    std::size_t max_sd = 0;
-    for (const auto &sd_nodes : this->influence_node_ids_) {
-        if (sd_nodes.size() > max_sd) { max_sd = sd_nodes.size(); }
-        if (sd_nodes.size() < min_sd) { min_sd = sd_nodes.size(); }
-    }
 
-    this->min_influence_nodes_num_ = static_cast<int>(min_sd);
-    this->max_influence_nodes_num_ = static_cast<int>(max_sd);
+//#ifdef CLOUDEA_WITH_CGAL
+template<short DIM>
+void SupportDomain<DIM>::FastInfluenceNodesSearch_2d(const std::vector<IMP::Vec<DIM, double>> &points, const std::vector<IMP::Vec<DIM, double>> &field_nodes)
+{
+    // CGAL types declaration.
+    typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+    typedef K::Point_2 Point;
+    typedef CGAL::Search_traits_2<K> Traits_base;
 
+    this->template KdTreeInfluenceNodesSearch<Point, Traits_base>(points, field_nodes,
+            [](const IMP::Vec<DIM, double> &node) { return Point(node[0], node[1]); });
 }
 
 
@@ -167,9 +133,21 @@ void SupportDomain<DIM>::FastInfluenceNodesSearch_3d(const std::vector<IMP::Vec<
     // CGAL types declaration.
     typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
     typedef K::Point_3 Point;
-    typedef boost::tuple<Point, int> Point_and_int;
     typedef CGAL::Search_traits_3<K> Traits_base;
-    typedef CGAL::Search_traits_adapter<Point_and_int, CGAL::Nth_of_tuple_property_map<0, Point_and_int>, Traits_base> Traits;
+
+    this->template KdTreeInfluenceNodesSearch<Point, Traits_base>(points, field_nodes,
+            [](const IMP::Vec<DIM, double> &node) { return Point(node[0], node[1], node[2]); });
+}
+
+
+template<short DIM>
+template<class POINT_T, class TRAITS_BASE_T, class TO_POINT_T>
+void SupportDomain<DIM>::KdTreeInfluenceNodesSearch(const std::vector<IMP::Vec<DIM, double>> &points,
+                                                    const std::vector<IMP::Vec<DIM, double>> &field_nodes, const TO_POINT_T &to_point)
+{
+    // CGAL types declaration.
+    typedef boost::tuple<POINT_T, int> Point_and_int;
+    typedef CGAL::Search_traits_adapter<Point_and_int, CGAL::Nth_of_tuple_property_map<0, Point_and_int>, TRAITS_BASE_T> Traits;
     typedef CGAL::Kd_tree<Traits> Tree;
     typedef CGAL::Fuzzy_sphere<Traits> Fuzzy_sphere;
 
@@ -181,61 +159,81 @@ void SupportDomain<DIM>::FastInfluenceNodesSearch_3d(const std::vector<IMP::Vec<
         throw std::invalid_argument(Logger::Error(error_str, __FILE__, __LINE__));
     }
 
-    // Reset support nodes indices containers.
-    this->influence_node_ids_.clear();
-    this->influence_node_ids_.resize(points.size(), std::vector<int>());
-
     // Initialize tree tuple points coordinates.
-    std::vector<Point> points_coords;
+    std::vector<POINT_T> points_coords;
     points_coords.reserve(points.size());
 
     // Initialize tree tuple points indices.
     std::vector<int> points_ids;
     points_ids.reserve(points.size());
 
-    for (const auto &point : points) {
-        auto pid = &point - &points[0];
-
-        points_coords.emplace_back(Point(point[0], point[1], point[2]));
-        points_ids.emplace_back(pid);
+    auto pid = 0;
+    for (auto &point : points) {
+        points_coords.emplace_back(to_point(point));
+        points_ids.emplace_back(pid++);
     }
     
-    // Insert <point,id> tuples in the searching tree.
+    // Insert <point,id> tuples in the searching tree. Build the tree before the concurrent queries.
     Tree tree(boost::make_zip_iterator(boost::make_tuple(points_coords.begin(), points_ids.begin())),
-              boost::make_zip_iterator(boost::make_tuple(points_coords.end(), points_ids.end())));   
-    
-    // Find the influence nodes for each influenced point.
-    std::vector<Point_and_int> neighs;
-    for (const auto &field_node : field_nodes) {
-        auto field_nid = &field_node - &field_nodes[0];
+              boost::make_zip_iterator(boost::make_tuple(points_coords.end(), points_ids.end())));
+    tree.build();
 
-        // Set field node as the influence domain's center.
-        Point influence_center(field_node[0], field_node[1], field_node[2]);
+    // Find the influenced points of the field nodes in the range [start, end).
+    auto search_range = [&](std::size_t start, std::size_t end, NeighborList &range_influenced_ids) {
+        std::vector<Point_and_int> neighs;
+        std::vector<int> neighs_ids;
+        range_influenced_ids.Reserve(end-start, 0);
+        for (auto field_nid = start; field_nid != end; ++field_nid) {
 
-        // Set the influence domain range.
-        Fuzzy_sphere influence_range(influence_center, this->dilate_coeff_[field_nid]*this->radius_[field_nid]);
+            // Set field node as the influence domain's center.
+            POINT_T influence_center = to_point(field_nodes[field_nid]);
 
-        // Get the influence domain nodes.
-        tree.search(std::back_inserter(neighs), influence_range);
-        
-        // Add the node id to the influence domain of the influenced points.
-        for (const auto &neigh : neighs) {
-            this->influence_node_ids_[boost::get<1>(neigh)].emplace_back(field_nid);
+            // Set the influence domain range.
+            Fuzzy_sphere influence_range(influence_center, this->dilate_coeff_[field_nid]*this->radius_[field_nid]);
+
+            // Get the influence domain nodes.
+            tree.search(std::back_inserter(neighs), influence_range);
+
+            // Store the indices of the points influenced by the field node.
+            for (const auto &neigh : neighs) { neighs_ids.emplace_back(boost::get<1>(neigh)); }
+            range_influenced_ids.Append(neighs_ids.begin(), neighs_ids.end());
+
+            // Clear neighbor nodes vectors for next iteration.
+            neighs.clear();
+            neighs_ids.clear();
         }
-        
-        // Clear neighbor nodes vector for next iteration.
-        neighs.clear();
+    };
+
+    // Search in contiguous ranges of field nodes, one per thread.
+    ThreadLoopManager loop_manager;
+    auto threads_num = this->SearchThreadsNumber(field_nodes.size());
+    loop_manager.SetLoopRanges(field_nodes.size(), threads_num);
+
+    std::vector<NeighborList> thread_influenced_ids(threads_num);
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num);
+    for (std::size_t t = 0; t != threads_num; ++t) {
+        threads.emplace_back(std::thread(search_range, loop_manager.LoopStartId(t), loop_manager.LoopEndId(t),
+                                         std::ref(thread_influenced_ids[t])));
     }
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    // Concatenate the thread results in thread order for deterministic output.
+    NeighborList influenced_ids;
+    std::size_t ids_num = 0;
+    for (const auto &ids : thread_influenced_ids) { ids_num += ids.IdsNum(); }
+    influenced_ids.Reserve(field_nodes.size(), ids_num);
+    for (auto &ids : thread_influenced_ids) {
+        influenced_ids.AppendLists(ids);
+        ids.Release();
+    }
+
+    // Add the field nodes indices to the influence domain of the influenced points in increasing order.
+    this->influence_node_ids_ = influenced_ids.Transposed(points.size());
 
     // Update min - max influence domain nodes number.
-    std::size_t min_sd = std::numeric_limits<std::size_t>::max();
-    std::size_t max_sd = 0;
-    for (const auto &sd_nodes : this->influence_node_ids_) {
-        if (sd_nodes.size() > max_sd) { max_sd = sd_nodes.size(); }
-        if (sd_nodes.size() < min_sd) { min_sd = sd_nodes.size(); }
-    }
-    this->min_influence_nodes_num_ = static_cast<int>(min_sd);
-    this->max_influence_nodes_num_ = static_cast<int>(max_sd);
+    this->min_influence_nodes_num_ = static_cast<int>(this->influence_node_ids_.MinListSize());
+    this->max_influence_nodes_num_ = static_cast<int>(this->influence_node_ids_.MaxListSize());
 }
 
 
@@ -256,10 +254,6 @@ void SupportDomain<DIM>::FastSearchNearestInfluenceNodes_3d(const std::vector<IM
     typedef K_neighbor_search::Tree                             Tree;
     typedef K_neighbor_search::Distance                         Distance;
 
-    // Reset support domain influence nodes indices.
-    this->influence_node_ids_.clear();
-    this->influence_node_ids_.resize(field_nodes.size(), std::vector<int>());
-
     // Reset support domain radius.
     this->radius_.clear();
     this->radius_.resize(field_nodes.size(), 0.);
@@ -308,56 +302,91 @@ void SupportDomain<DIM>::FastSearchNearestInfluenceNodes_3d(const std::vector<IM
     Tree inside_tree(boost::make_zip_iterator(boost::make_tuple(std::begin(inside_points), std::begin(inside_point_ids))),
                      boost::make_zip_iterator(boost::make_tuple(std::end(inside_points), std::end(inside_point_ids))) );
 
-    // Search for the nearest influence nodes to each point.
-    Distance tr_dist;
-    for (const auto &query : points) {
-        auto id = &query - &points[0];
-
-        if (onsurf_flag[id]) {
-            // Get the nearest influence node for the query point from the surface.
-            K_neighbor_search onsurf_search(onsurf_tree, query, onsurf_neigh_num);
-
-            // Get the nearest influence node for the query point from inside.
-            K_neighbor_search inside_search(inside_tree, query, inside_neigh_num);
-
-            for (K_neighbor_search::iterator it = onsurf_search.begin(); it != onsurf_search.end(); it++) {
-                this->influence_node_ids_[id].emplace_back(boost::get<1>(it->first));
-            }
-
-            for (K_neighbor_search::iterator it = inside_search.begin(); it != inside_search.end(); it++) {
-                this->influence_node_ids_[id].emplace_back(boost::get<1>(it->first));
-            }
-
-            // Set support domain radius and dilatation coefficient according to nearest neighbors.
-            double min_neigh_dist = std::sqrt(tr_dist.transformed_distance((onsurf_search.begin()+1)->second));
-            double max_neigh_dist = std::sqrt(tr_dist.transformed_distance((onsurf_search.end()-1)->second));
-
-            if (min_neigh_dist > std::sqrt(tr_dist.transformed_distance((inside_search.begin()+1)->second))) {
-                min_neigh_dist = std::sqrt(tr_dist.transformed_distance((inside_search.begin()+1)->second));
-            }
-
-            if (max_neigh_dist < std::sqrt(tr_dist.transformed_distance((inside_search.end()-1)->second))) {
-                max_neigh_dist = std::sqrt(tr_dist.transformed_distance((inside_search.end()-1)->second));
-            }
-
-            this->radius_[id] = min_neigh_dist;
-            this->dilate_coeff_[id] = max_neigh_dist/min_neigh_dist;
-
-        } else {
-            // Get the nearest influence node for the query point.
-            K_neighbor_search full_search(full_tree, query, neigh_num);
-            for (K_neighbor_search::iterator it = full_search.begin(); it != full_search.end(); it++) {
-                this->influence_node_ids_[id].emplace_back(boost::get<1>(it->first));
+    // Build the three trees concurrently before the concurrent queries.
+    {
+        std::vector<std::thread> build_threads;
+        for (auto tree : {&full_tree, &onsurf_tree, &inside_tree}) {
+            build_threads.emplace_back(std::thread([tree]() { if (tree->size() != 0) { tree->build(); } }));
+        }
+        std::for_each(build_threads.begin(), build_threads.end(), std::mem_fn(&std::thread::join));
+    }
+
+    // Preallocate the nearest influence nodes of each point. Searches return at most as many nodes as the tree size.
+    auto full_num = std::min(static_cast<std::size_t>(neigh_num), full_tree.size());
+    auto onsurf_num = std::min(static_cast<std::size_t>(onsurf_neigh_num), onsurf_tree.size()) +
+                      std::min(static_cast<std::size_t>(inside_neigh_num), inside_tree.size());
+    std::vector<std::size_t> neighs_nums(field_nodes.size(), full_num);
+    for (std::size_t id = 0; id != field_nodes.size(); ++id) {
+        if (onsurf_flag[id]) { neighs_nums[id] = onsurf_num; }
+    }
+    this->influence_node_ids_.Allocate(neighs_nums);
+
+    // Search for the nearest influence nodes to the points in the range [start, end).
+    auto search_range = [&](std::size_t start, std::size_t end) {
+        Distance tr_dist;
+        for (auto id = start; id != end; ++id) {
+            const auto &query = points[id];
+            int *neighs_ids = this->influence_node_ids_.Data(id);
+            std::size_t pos = 0;
+
+            if (onsurf_flag[id]) {
+                // Get the nearest influence node for the query point from the surface.
+                K_neighbor_search onsurf_search(onsurf_tree, query, onsurf_neigh_num);
+
+                // Get the nearest influence node for the query point from inside.
+                K_neighbor_search inside_search(inside_tree, query, inside_neigh_num);
+
+                for (K_neighbor_search::iterator it = onsurf_search.begin(); it != onsurf_search.end(); it++) {
+                    neighs_ids[pos++] = boost::get<1>(it->first);
+                }
+
+                for (K_neighbor_search::iterator it = inside_search.begin(); it != inside_search.end(); it++) {
+                    neighs_ids[pos++] = boost::get<1>(it->first);
+                }
+
+                // Set support domain radius and dilatation coefficient according to nearest neighbors.
+                double min_neigh_dist = std::sqrt(tr_dist.transformed_distance((onsurf_search.begin()+1)->second));
+                double max_neigh_dist = std::sqrt(tr_dist.transformed_distance((onsurf_search.end()-1)->second));
+
+                if (min_neigh_dist > std::sqrt(tr_dist.transformed_distance((inside_search.begin()+1)->second))) {
+                    min_neigh_dist = std::sqrt(tr_dist.transformed_distance((inside_search.begin()+1)->second));
+                }
+
+                if (max_neigh_dist < std::sqrt(tr_dist.transformed_distance((inside_search.end()-1)->second))) {
+                    max_neigh_dist = std::sqrt(tr_dist.transformed_distance((inside_search.end()-1)->second));
+                }
+
+                this->radius_[id] = min_neigh_dist;
+                this->dilate_coeff_[id] = max_neigh_dist/min_neigh_dist;
+
+            } else {
+                // Get the nearest influence node for the query point.
+                K_neighbor_search full_search(full_tree, query, neigh_num);
+                for (K_neighbor_search::iterator it = full_search.begin(); it != full_search.end(); it++) {
+                    neighs_ids[pos++] = boost::get<1>(it->first);
+                }
+
+                // Set support domain radius and dilatation coefficient according to nearest neighbors.
+                double min_neigh_dist = std::sqrt(tr_dist.transformed_distance((full_search.begin()+1)->second));
+                double max_neigh_dist = std::sqrt(tr_dist.transformed_distance((full_search.end()-1)->second));
+
+                this->radius_[id] = min_neigh_dist;
+                this->dilate_coeff_[id] = max_neigh_dist/min_neigh_dist;
             }
+        }
+    };
 
-            // Set support domain radius and dilatation coefficient according to nearest neighbors.
-            double min_neigh_dist = std::sqrt(tr_dist.transformed_distance((full_search.begin()+1)->second));
-            double max_neigh_dist = std::sqrt(tr_dist.transformed_distance((full_search.end()-1)->second));
+    // Search in contiguous ranges of points, one per thread. Each point writes in its own preallocated storage.
+    ThreadLoopManager loop_manager;
+    auto threads_num = this->SearchThreadsNumber(points.size());
+    loop_manager.SetLoopRanges(points.size(), threads_num);
 
-            this->radius_[id] = min_neigh_dist;
-            this->dilate_coeff_[id] = max_neigh_dist/min_neigh_dist;
-        }
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num);
+    for (std::size_t t = 0; t != threads_num; ++t) {
+        threads.emplace_back(std::thread(search_range, loop_manager.LoopStartId(t), loop_manager.LoopEndId(t)));
     }
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
 
     // Update min - max influence domain nodes number.
     this->min_influence_nodes_num_ = neigh_num;
@@ -369,7 +398,8 @@ void SupportDomain<DIM>::FastSearchNearestInfluenceNodes_3d(const std::vector<IM
 
 template<short DIM>
 SupportDomain<DIM>::SupportDomain() : influence_node_ids_(), radius_(), dilate_coeff_(), field_nodes_num_(0),
-    min_influence_nodes_num_(std::numeric_limits<int>::max()), max_influence_nodes_num_(0)
+    min_influence_nodes_num_(std::numeric_limits<int>::max()), max_influence_nodes_num_(0),
+    use_cell_list_search_(false), search_threads_num_(0)
 {}
 
 
@@ -459,6 +489,33 @@ void SupportDomain<DIM>::SetDilateCoeff(double dilate_coeff)
 }
 
 
+template<short DIM>
+std::size_t SupportDomain<DIM>::SearchThreadsNumber(std::size_t entries_num) const
+{
+    std::size_t threads_num = this->search_threads_num_;
+    if (threads_num == 0) { threads_num = static_cast<std::size_t>(std::thread::hardware_concurrency()); }
+    if (threads_num == 0) { threads_num = 1; }
+
+    // Use a single thread if there are not more entries than threads.
+    return (threads_num >= entries_num) ? 1 : threads_num;
+}
+
+
+template<short DIM>
+void SupportDomain<DIM>::SetThreadsNumber(std::size_t threads_num)
+{
+    this->search_threads_num_ = threads_num;
+}
+
+
+template<short DIM>
+void SupportDomain<DIM>::SetCellListSearch(bool use_cell_list, std::size_t threads_num)
+{
+    this->use_cell_list_search_ = use_cell_list;
+    this->search_threads_num_ = threads_num;
+}
+
+
 template<short DIM>
 void SupportDomain<DIM>::ComputeRadiusFromRegularGrid(const std::vector<IMP::Vec<DIM, double>> &field_nodes)
 {
@@ -508,72 +565,19 @@ void SupportDomain<DIM>::ComputeRadiusFromIrregularGrid(const IMP::Grid<DIM, CEL
     }
 
 
-    // Clear the influence radiuses container.
-    this->radius_.clear();
-    this->radius_.resize(this->field_nodes_num_, 0.);
-
-    // The number of connected nodes to each influence node.
-    std::vector<int> connected_nodes_number(this->field_nodes_num_, 0);
-
-    // Extract edges of triangle or quadrilateral cells.
-    auto ExtractEdges2D = [] (const IMP::Cell<DIM, CELL_NODES> &cell) { 
-        std::vector<IMP::Cell<DIM,2>> edges(CELL_NODES, IMP::Cell<DIM,2>());
-        for (int i = 0; i != CELL_NODES-1; ++i) {
-            edges[i].SetConnectivity({cell.N(i), cell.N(i+1)});
-        }
-        edges[CELL_NODES-1].SetConnectivity({cell.N(CELL_NODES-1), cell.N(0)});
-        return edges;
-    };
-
-    // Extract edges of tetrahedral cell.
-    auto ExtractEdgesTet = [] (const IMP::Cell<DIM, CELL_NODES> &cell) { 
-        std::vector<IMP::Cell<DIM,2>> edges(6, IMP::Cell<DIM,2>());
-        int pos = 0;
-        for (int i = 0; i != 3; ++i) {
-            for (int j = i+1; j != 4; ++j) {
-                edges[pos].SetConnectivity({cell.N(i), cell.N(j)});
-                pos++;
-            }
-        }
-        return edges;
-    };
+    // Extract the unique edges of line, triangle, quadrilateral or tetrahedral cells.
+    MeshEdges mesh_edges;
+    mesh_edges.SetThreadsNumber(this->search_threads_num_);
+    const auto &cells = grid.GhostCells();
+    mesh_edges.Extract(static_cast<std::size_t>(this->field_nodes_num_), cells.size(),
+                       MeshEdges::CellLocalEdges(CELL_NODES, DIM == 3), CELL_NODES,
+                       [&cells](std::size_t cell_id, std::size_t local_id) { return cells[cell_id].N(static_cast<int>(local_id)); });
 
-    // Iterate over the cells of the grid.
-    std::vector<IMP::Cell<DIM,2>> cell_edges;
-    for (const auto &cell : grid.GhostCells()){
+    // Compute the length of each unique edge once.
+    mesh_edges.ComputeLengths([&grid](int n1, int n2) { return std::sqrt( grid.Nodes(n1).Distance2(grid.Nodes(n2)) ); });
 
-        // Get the edges of the cell.
-        if (CELL_NODES == 2) {
-            IMP::Cell<DIM,2> edge;
-            edge.SetConnectivity({cell.N(0), cell.N(1)});
-            cell_edges.clear();
-            cell_edges.emplace_back(edge);
-        }
-        else if (DIM == 2 && CELL_NODES > 2) {
-            cell_edges = ExtractEdges2D(cell);
-        } else {
-            cell_edges = ExtractEdgesTet(cell);
-        }
-
-        // Iterate over the cell's edges
-        for (const auto &edge : cell_edges) {
-            double dist = std::sqrt( grid.Nodes(edge.N(0)).Distance2(grid.Nodes(edge.N(1))) );
-
-            // Add the distance value to the support of the influence nodes at the corners of the edge.
-            this->radius_[edge.N(0)] += dist;
-            this->radius_[edge.N(1)] += dist;
-            
-            // Increase the number of connected nodes to each of the nodes at the corners of the edge.
-            connected_nodes_number[edge.N(0)] += 1;
-            connected_nodes_number[edge.N(1)] += 1;
-        }
-    }
-
-    // Normalize the influence radiuses with the number of connected nodes for each influence node.
-    for (int id = 0; id != this->field_nodes_num_; ++id) {
-        // Normalize the influence radius of the current influence node.
-        this->radius_[id] /= connected_nodes_number[id];
-    }
+    // Set the support radius to the mean length of the connected edges over all the cells of each field node.
+    mesh_edges.MeanIncidentLengths(this->radius_, false);
 
 }
 
@@ -643,6 +647,9 @@ void SupportDomain<DIM>::IdentifyInfluenceNodesInRange(const std::vector<IMP::Ve
         if (DIM == 1) {
             this->ExhaustiveInfluenceNodesSearch(points, field_nodes);
         }
+        else if (this->use_cell_list_search_ && (DIM == 2 || DIM == 3)) {
+            this->CellListInfluenceNodesSearch(points, field_nodes);
+        }
         else if (DIM == 2) {
             this->FastInfluenceNodesSearch_2d(points, field_nodes);
         }
@@ -699,11 +706,24 @@ void SupportDomain<DIM>::IdentifyInfluenceNodesVoronoi(const IMP::Voronoi<DIM> &
     this->field_nodes_num_ = voronoi.NodesNum();
 
     // Reset support domain influence nodes indices.
-    this->influence_node_ids_.clear();
-    this->influence_node_ids_.resize(this->field_nodes_num_, std::vector<int>());
+    this->influence_node_ids_.Clear();
+
+    // Count the neighbors of each node through the internal facets. First influence node is the nth node itself.
+    std::vector<std::size_t> neighs_num(this->field_nodes_num_, 1);
+    for (const auto &facet : voronoi.Facets()) {
+        if (!facet.IsFree()) {
+            neighs_num[facet.ParentCellId()]++;
+            neighs_num[facet.NeighCellId()]++;
+        }
+    }
+    this->influence_node_ids_.Allocate(neighs_num);
+
+    // Store each node as the first influence node of itself.
+    std::vector<std::size_t> fill_pos(this->field_nodes_num_, 1);
+    for (int id = 0; id != this->field_nodes_num_; ++id) {
+        this->influence_node_ids_.Data(id)[0] = id;
+    }
 
-    std::vector<std::vector<int>> neigh_nodes(this->field_nodes_num_, std::vector<int>());
-    
     int n1 = 0, n2 = 0;
     for (const auto &facet : voronoi.Facets()) {
         if (!facet.IsFree()) {
@@ -712,31 +732,20 @@ void SupportDomain<DIM>::IdentifyInfluenceNodesVoronoi(const IMP::Voronoi<DIM> &
             n2 = facet.NeighCellId();
             
             // Add each node as neighbor to the other.
-            neigh_nodes[n1].emplace_back(n2);
-            neigh_nodes[n2].emplace_back(n1);
+            this->influence_node_ids_.Data(n1)[fill_pos[n1]++] = n2;
+            this->influence_node_ids_.Data(n2)[fill_pos[n2]++] = n1;
         }
     }
 
-    int id = 0;
-    for (auto &neighs : neigh_nodes) {
-        // Sort the neighs indices.
-        std::sort(neighs.begin(), neighs.end());
-
-        // Store the influence nodes indices. First influence node is the nth node itself.
-        this->influence_node_ids_[id].emplace_back(id);
-        for (const auto &n : neighs) { this->influence_node_ids_[id].emplace_back(n); }
-        id++;
+    // Sort the neighs indices after the node itself.
+    for (int id = 0; id != this->field_nodes_num_; ++id) {
+        auto neighs = this->influence_node_ids_.Data(id);
+        std::sort(neighs+1, neighs+neighs_num[id]);
     }
 
     // Update min - max influence domain nodes number.
-    std::size_t min_sd = std::numeric_limits<std::size_t>::max();
-    std::size_t max_sd = 0;
-    for (const auto &inf_nodes : this->influence_node_ids_) {
-        if (inf_nodes.size() > max_sd)  max_sd = inf_nodes.size(); 
-        if (inf_nodes.size() < min_sd)  min_sd = inf_nodes.size(); 
-    }
-    this->min_influence_nodes_num_ = static_cast<int>(min_sd);
-    this->max_influence_nodes_num_ = static_cast<int>(max_sd);
+    this->min_influence_nodes_num_ = static_cast<int>(this->influence_node_ids_.MinListSize());
+    this->max_influence_nodes_num_ = static_cast<int>(this->influence_node_ids_.MaxListSize());
 
 }
 
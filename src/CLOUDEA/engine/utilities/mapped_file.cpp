@@ -0,0 +1,114 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "CLOUDEA/engine/utilities/mapped_file.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define CLOUDEA_MAPPED_FILE_MMAP
+#endif
+
+
+namespace CLOUDEA {
+
+
+std::shared_ptr<const void> MappedFile::Map(const std::string &filename, const std::string &file_type,
+                                            std::size_t &file_size, bool sequential)
+{
+#ifdef CLOUDEA_MAPPED_FILE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::string error = Logger::Error("Could not open the " + file_type + " file: \"") + filename + "\". Check given path.";
+        throw std::runtime_error(error.c_str());
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) == -1) {
+        ::close(fd);
+        std::string error = Logger::Error("Could not get the size of the " + file_type + " file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+    file_size = static_cast<std::size_t>(file_stat.st_size);
+
+    // An empty file can not be mapped.
+    if (file_size == 0) {
+        ::close(fd);
+        return std::shared_ptr<const void>();
+    }
+
+    // Map the file. The mapping stays valid after closing the file descriptor.
+    void *data = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        std::string error = Logger::Error("Could not memory map the " + file_type + " file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+    if (sequential) { ::madvise(data, file_size, MADV_SEQUENTIAL); }
+
+    auto mapped_size = file_size;
+    return std::shared_ptr<const void>(data, [mapped_size](const void *ptr) { ::munmap(const_cast<void *>(ptr), mapped_size); });
+#else
+    static_cast<void>(sequential);
+
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::string error = Logger::Error("Could not open the " + file_type + " file: \"") + filename + "\". Check given path.";
+        throw std::runtime_error(error.c_str());
+    }
+    file_size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    if (file_size == 0) { return std::shared_ptr<const void>(); }
+
+    // Read the file in 8-byte aligned memory.
+    auto buffer = std::make_shared<std::vector<std::uint64_t> >((file_size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    file.read(reinterpret_cast<char *>(buffer->data()), static_cast<std::streamsize>(file_size));
+    if (!file) {
+        std::string error = Logger::Error("Could not read the " + file_type + " file: \"") + filename + "\"";
+        throw std::runtime_error(error.c_str());
+    }
+    return std::shared_ptr<const void>(buffer, buffer->data());
+#endif
+}
+
+
+std::size_t MappedFile::ReadPrefix(const std::string &filename, const std::string &file_type, char *buffer, std::size_t bytes)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::string error = Logger::Error("Could not open the " + file_type + " file: \"") + filename + "\". Check given path.";
+        throw std::runtime_error(error.c_str());
+    }
+    auto file_size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    file.read(buffer, static_cast<std::streamsize>(std::min(file_size, bytes)));
+    return file_size;
+}
+
+
+} //end of namespace CLOUDEA
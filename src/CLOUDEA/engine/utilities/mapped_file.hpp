@@ -0,0 +1,88 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*!
+   \file mapped_file.hpp
+   \brief MappedFile class header file.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#ifndef CLOUDEA_UTILITIES_MAPPED_FILE_HPP_
+#define CLOUDEA_UTILITIES_MAPPED_FILE_HPP_
+
+
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <exception>
+
+
+namespace CLOUDEA {
+
+/*!
+ *  \addtogroup Utilities
+ *  @{
+ */
+
+
+/*!
+ * \class MappedFile
+ * \brief Class implementing the read-only memory mapping of the files read by CLOUDEA.
+ *
+ * Files are memory mapped where supported (POSIX). Elsewhere they are read in 8-byte aligned memory,
+ * so the callers can access the mapped data with the same alignment guarantees in both cases.
+ */
+
+class MappedFile
+{
+public:
+
+    /*!
+     * \brief Map a file in memory.
+     * \param [in] filename The file to be mapped.
+     * \param [in] file_type The description of the file type used in the error messages (e.g. "mesh").
+     * \param [out] file_size The size of the file in bytes.
+     * \param [in] sequential Conditional to advise the system that the file will be read sequentially.
+     * \return [std::shared_ptr<const void>] The mapped file storage. It is unmapped when released. Empty for empty files.
+     */
+    static std::shared_ptr<const void> Map(const std::string &filename, const std::string &file_type,
+                                           std::size_t &file_size, bool sequential = false);
+
+
+    /*!
+     * \brief Read the first bytes of a file without mapping it.
+     * \param [in] filename The file to be read.
+     * \param [in] file_type The description of the file type used in the error messages (e.g. "mesh").
+     * \param [out] buffer The buffer where the first bytes of the file are stored.
+     * \param [in] bytes The number of bytes to be read. Fewer bytes are read if the file is shorter.
+     * \return [std::size_t] The size of the file in bytes.
+     */
+    static std::size_t ReadPrefix(const std::string &filename, const std::string &file_type, char *buffer, std::size_t bytes);
+
+};
+
+
+/*! @} End of Doxygen Groups*/
+} //end of namespace CLOUDEA
+
+#endif //CLOUDEA_UTILITIES_MAPPED_FILE_HPP_
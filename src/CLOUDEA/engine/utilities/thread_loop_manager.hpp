@@ -104,6 +104,9 @@ public:
 
     inline auto LoopEndId(std::size_t thread_id) const { return this->end_id_[thread_id]; }
 
+
+    inline auto LoopsNum() const { return this->start_id_.size(); }
+
 };
 
 
@@ -0,0 +1,256 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file abaqus_io_test.cpp
+   \brief Test of the parallel parsing of Abaqus meshes on a small mesh with offsetted indices and on a generated mesh.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/mesh_io/abaqus_io.hpp"
+#include "CLOUDEA/engine/elements/node.hpp"
+#include "CLOUDEA/engine/elements/tetrahedron.hpp"
+#include "CLOUDEA/engine/sets/node_set.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// The parsed contents of an Abaqus mesh.
+struct ParsedMesh {
+    std::vector<Node> nodes;
+    std::vector<Tetrahedron> tetras;
+    std::vector<NodeSet> node_sets;
+};
+
+
+// Write the given contents in a file.
+void WriteFile(const std::string &filename, const std::string &contents)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << contents;
+}
+
+
+// Parse an Abaqus mesh file with the given number of threads.
+ParsedMesh ParseMesh(const std::string &filename, std::size_t threads)
+{
+    ParsedMesh mesh;
+    AbaqusIO abaqus_io;
+    abaqus_io.SetThreadsNumber(threads);
+    abaqus_io.LoadMeshFrom(filename);
+    abaqus_io.LoadNodesIn(mesh.nodes);
+    abaqus_io.LoadElementsIn(mesh.tetras);
+    abaqus_io.LoadPartitionsIn(mesh.tetras);
+    abaqus_io.LoadBoundarySetsIn(mesh.node_sets);
+    return mesh;
+}
+
+
+// Get the connectivity of a tetrahedron.
+std::array<int, 4> Connectivity(const Tetrahedron &tetra)
+{
+    return std::array<int, 4>{{tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()}};
+}
+
+
+// Check the parsing of a small mesh with offsetted node and element indices, element sets and a node set.
+bool SmallMeshIsParsed(const std::string &filename)
+{
+    WriteFile(filename, "*Heading\n"
+                        "test\n"
+                        "*NODE\n"
+                        "10, 0.0, 0.0, 0.0\n"
+                        "11, 1.0, 0.0, 0.0\n"
+                        "12, 0.0, 1.0, 0.0\n"
+                        "13, 0.0, 0.0, 1.0\n"
+                        "14, 1.0, 1.0, 1.0\n"
+                        "*ELEMENT, type=C3D4, ELSET=Vol\n"
+                        "5, 10, 11, 12, 13\n"
+                        "6, 11, 12, 13, 14\n"
+                        "*ELSET, ELSET=PartA\n"
+                        "5\n"
+                        "*ELSET, ELSET=PartB\n"
+                        "6,\n"
+                        "*NSET, NSET=Fixed\n"
+                        "10, 11,\n"
+                        "12\n"
+                        "*End\n");
+
+    const std::array<std::array<double, 3>, 5> coords{{ {{0.,0.,0.}}, {{1.,0.,0.}}, {{0.,1.,0.}}, {{0.,0.,1.}}, {{1.,1.,1.}} }};
+    for (std::size_t threads : {1, 3, 8}) {
+        auto mesh = ParseMesh(filename, threads);
+        bool passed = mesh.nodes.size() == 5 && mesh.tetras.size() == 2 && mesh.node_sets.size() == 1;
+
+        for (std::size_t i = 0; passed && i != mesh.nodes.size(); ++i) {
+            const auto &node = mesh.nodes[i];
+            passed = node.Id() == static_cast<int>(i) && node.Coordinates().X() == coords[i][0] &&
+                     node.Coordinates().Y() == coords[i][1] && node.Coordinates().Z() == coords[i][2];
+        }
+
+        if (passed) {
+            passed = mesh.tetras[0].Id() == 0 && mesh.tetras[1].Id() == 1 &&
+                     Connectivity(mesh.tetras[0]) == std::array<int, 4>{{0, 1, 2, 3}} &&
+                     Connectivity(mesh.tetras[1]) == std::array<int, 4>{{1, 2, 3, 4}} &&
+                     mesh.tetras[0].PartitionId() == 0 && mesh.tetras[0].PartitionName() == "parta" &&
+                     mesh.tetras[1].PartitionId() == 1 && mesh.tetras[1].PartitionName() == "partb";
+        }
+
+        if (passed) {
+            passed = mesh.node_sets[0].Name() == "fixed" && mesh.node_sets[0].NodeIds() == std::vector<int>{0, 1, 2};
+        }
+
+        if (!passed) {
+            std::cerr << Logger::Error("The small Abaqus mesh was not parsed correctly with " + std::to_string(threads) + " threads.") << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// Check that the parsing of a generated mesh with several threads gives the same mesh as the serial parsing.
+bool GeneratedMeshIsParsed(const std::string &filename)
+{
+    // Nodes of a grid and a corner tetrahedron per grid cell. The elements are split in two element sets.
+    const int side_num = 12;
+    std::string contents = "*Heading\ngenerated\n*NODE\n";
+    for (int k = 0; k != side_num; ++k) {
+        for (int j = 0; j != side_num; ++j) {
+            for (int i = 0; i != side_num; ++i) {
+                contents += std::to_string(1 + i + side_num*(j + side_num*k)) + ", " + std::to_string(0.5*i) + ", " +
+                            std::to_string(0.25*j) + ", " + std::to_string(0.125*k) + "\n";
+            }
+        }
+    }
+    contents += "*ELEMENT, type=C3D4, ELSET=Vol\n";
+    int elems_num = 0;
+    for (int k = 0; k != side_num-1; ++k) {
+        for (int j = 0; j != side_num-1; ++j) {
+            for (int i = 0; i != side_num-1; ++i) {
+                int n0 = 1 + i + side_num*(j + side_num*k);
+                contents += std::to_string(++elems_num) + ", " + std::to_string(n0) + ", " + std::to_string(n0+1) + ", " +
+                            std::to_string(n0+side_num) + ", " + std::to_string(n0+side_num*side_num) + "\n";
+            }
+        }
+    }
+    contents += "*ELSET, ELSET=Lower\n";
+    for (int e = 1; e <= elems_num/2; ++e) { contents += std::to_string(e) + ((e % 16 == 0) ? ",\n" : ", "); }
+    contents += "\n*ELSET, ELSET=Upper\n";
+    for (int e = elems_num/2 + 1; e <= elems_num; ++e) { contents += std::to_string(e) + ((e % 16 == 0) ? ",\n" : ", "); }
+    contents += "\n*NSET, NSET=Bottom\n";
+    for (int n = 1; n <= side_num*side_num; ++n) { contents += std::to_string(n) + ((n % 16 == 0) ? ",\n" : ", "); }
+    contents += "\n*End\n";
+    WriteFile(filename, contents);
+
+    auto serial = ParseMesh(filename, 1);
+    if (serial.nodes.size() != static_cast<std::size_t>(side_num*side_num*side_num) ||
+            serial.tetras.size() != static_cast<std::size_t>(elems_num) || serial.node_sets.size() != 1 ||
+            serial.node_sets[0].NodeIds().size() != static_cast<std::size_t>(side_num*side_num) ||
+            serial.tetras.front().PartitionName() != "lower" || serial.tetras.back().PartitionName() != "upper" ||
+            serial.tetras.back().PartitionId() == serial.tetras.front().PartitionId()) {
+        std::cerr << Logger::Error("The generated Abaqus mesh was not parsed correctly.") << std::endl;
+        return false;
+    }
+
+    for (std::size_t threads : {2, 8}) {
+        auto mesh = ParseMesh(filename, threads);
+        bool passed = mesh.nodes.size() == serial.nodes.size() && mesh.tetras.size() == serial.tetras.size() &&
+                      mesh.node_sets.size() == serial.node_sets.size() &&
+                      mesh.node_sets[0].NodeIds() == serial.node_sets[0].NodeIds();
+        for (std::size_t i = 0; passed && i != mesh.nodes.size(); ++i) {
+            passed = mesh.nodes[i].Id() == serial.nodes[i].Id() && mesh.nodes[i].Coordinates().X() == serial.nodes[i].Coordinates().X() &&
+                     mesh.nodes[i].Coordinates().Y() == serial.nodes[i].Coordinates().Y() &&
+                     mesh.nodes[i].Coordinates().Z() == serial.nodes[i].Coordinates().Z();
+        }
+        for (std::size_t i = 0; passed && i != mesh.tetras.size(); ++i) {
+            passed = Connectivity(mesh.tetras[i]) == Connectivity(serial.tetras[i]) &&
+                     mesh.tetras[i].PartitionId() == serial.tetras[i].PartitionId();
+        }
+
+        if (!passed) {
+            std::cerr << Logger::Error("The generated Abaqus mesh parsed with " + std::to_string(threads) +
+                                       " threads differs from the serial parsing.") << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// Check that an element set with elements not in the mesh is rejected.
+bool InvalidElementSetIsRejected(const std::string &filename)
+{
+    WriteFile(filename, "*NODE\n"
+                        "1, 0.0, 0.0, 0.0\n"
+                        "2, 1.0, 0.0, 0.0\n"
+                        "3, 0.0, 1.0, 0.0\n"
+                        "4, 0.0, 0.0, 1.0\n"
+                        "*ELEMENT, type=C3D4, ELSET=Vol\n"
+                        "1, 1, 2, 3, 4\n"
+                        "*ELSET, ELSET=Missing\n"
+                        "1, 7\n"
+                        "*End\n");
+    try {
+        ParseMesh(filename, 4);
+    }
+    catch (const std::out_of_range &) {
+        return true;
+    }
+
+    std::cerr << Logger::Error("An element set with elements not in the mesh was not rejected.") << std::endl;
+    return false;
+}
+
+
+int main()
+{
+    const std::string filename = "abaqus_io_test.inp";
+    bool passed = true;
+
+    try {
+        passed = SmallMeshIsParsed(filename) && passed;
+        passed = GeneratedMeshIsParsed(filename) && passed;
+        passed = InvalidElementSetIsRejected(filename) && passed;
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        passed = false;
+    }
+
+    std::remove(filename.c_str());
+
+    if (!passed) { return EXIT_FAILURE; }
+    std::cout << Logger::Message("The Abaqus meshes were parsed correctly.\n");
+    return EXIT_SUCCESS;
+}
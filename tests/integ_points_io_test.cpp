@@ -0,0 +1,177 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file integ_points_io_test.cpp
+   \brief Test of the round trip of the binary integration points files and of the rejection of corrupted files.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/integration/integ_points.hpp"
+#include "CLOUDEA/engine/integration/integ_points_io.hpp"
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// The size in bytes of the header of the binary integration points files.
+const std::size_t header_bytes = 64;
+
+
+// Flip the bits of a byte of a file.
+void CorruptByte(const std::string &filename, std::size_t offset)
+{
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    char byte = 0;
+    file.get(byte);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.put(static_cast<char>(~byte));
+}
+
+
+// Check that loading a file is rejected.
+bool LoadIsRejected(const IntegPointsIO &ip_io, const std::string &filename)
+{
+    std::vector<Vec3<double> > coordinates;
+    std::vector<double> weights, nodal_volumes;
+    std::size_t nodal_points_num = 0;
+    std::vector<std::uint16_t> region_ids;
+    try {
+        ip_io.Load(filename, coordinates, weights, nodal_volumes, nodal_points_num, region_ids);
+    }
+    catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+
+int main()
+{
+    const std::string filename = "integ_points_io_test.ipt";
+    bool passed = true;
+
+    try {
+        // Random integration points with nodal volumes and material regions.
+        const std::size_t points_num = 5000, nodal_points_num = 700;
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> value(-1., 1.);
+        std::uniform_int_distribution<int> region(0, 3);
+        std::vector<Vec3<double> > coordinates(points_num);
+        std::vector<double> weights(points_num), nodal_volumes(nodal_points_num);
+        std::vector<std::uint16_t> region_ids(points_num);
+        for (std::size_t i = 0; i != points_num; ++i) {
+            coordinates[i].Set(value(generator), value(generator), value(generator));
+            weights[i] = value(generator);
+            region_ids[i] = static_cast<std::uint16_t>(region(generator));
+        }
+        for (auto &volume : nodal_volumes) { volume = value(generator); }
+
+        // Round trip with several threads numbers. The values must be restored exactly.
+        for (std::size_t threads : {1, 4}) {
+            IntegPointsIO ip_io;
+            ip_io.SetThreadsNumber(threads);
+            ip_io.Save(filename, coordinates, weights, nodal_volumes, nodal_points_num, region_ids);
+
+            std::vector<Vec3<double> > loaded_coordinates;
+            std::vector<double> loaded_weights, loaded_volumes;
+            std::size_t loaded_nodal_num = 0;
+            std::vector<std::uint16_t> loaded_regions;
+            ip_io.Load(filename, loaded_coordinates, loaded_weights, loaded_volumes, loaded_nodal_num, loaded_regions);
+
+            bool coordinates_equal = loaded_coordinates.size() == points_num;
+            for (std::size_t i = 0; coordinates_equal && i != points_num; ++i) {
+                coordinates_equal = loaded_coordinates[i].X() == coordinates[i].X() && loaded_coordinates[i].Y() == coordinates[i].Y() &&
+                                    loaded_coordinates[i].Z() == coordinates[i].Z();
+            }
+            if (!coordinates_equal || loaded_weights != weights || loaded_volumes != nodal_volumes ||
+                    loaded_nodal_num != nodal_points_num || loaded_regions != region_ids) {
+                std::cerr << Logger::Error("The binary integration points round trip with " + std::to_string(threads) +
+                                           " threads did not restore the integration points.") << std::endl;
+                passed = false;
+            }
+        }
+
+        // Round trip of the integration points container.
+        IntegPoints integ_points;
+        integ_points.SetPoints(coordinates, weights, region_ids);
+        integ_points.SaveToFile(filename);
+        IntegPoints loaded_points;
+        loaded_points.LoadFromFile(filename);
+        if (loaded_points.PointsNum() != integ_points.PointsNum() || loaded_points.Weights() != integ_points.Weights() ||
+                loaded_points.RegionIds() != integ_points.RegionIds() || loaded_points.IsNodal()) {
+            std::cerr << Logger::Error("The integration points container round trip did not restore the integration points.") << std::endl;
+            passed = false;
+        }
+
+        // Files with a corrupted coordinate, nodal volume or region index must fail the checksum verification.
+        IntegPointsIO ip_io;
+        const std::size_t volumes_offset = header_bytes + 4*points_num*sizeof(double);
+        const std::size_t regions_offset = volumes_offset + nodal_points_num*sizeof(double);
+        for (std::size_t offset : {header_bytes + 17*sizeof(double) + 3, volumes_offset + 5, regions_offset + 2*points_num - 1}) {
+            ip_io.Save(filename, coordinates, weights, nodal_volumes, nodal_points_num, region_ids);
+            CorruptByte(filename, offset);
+            if (!LoadIsRejected(ip_io, filename)) {
+                std::cerr << Logger::Error("A binary integration points file corrupted at byte " + std::to_string(offset) +
+                                           " was not rejected.") << std::endl;
+                passed = false;
+            }
+        }
+
+        // Truncated files must be rejected.
+        ip_io.Save(filename, coordinates, weights, nodal_volumes, nodal_points_num, region_ids);
+        std::ifstream input(filename, std::ios::in | std::ios::binary);
+        std::vector<char> contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        input.close();
+        std::ofstream output(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        output.write(contents.data(), static_cast<std::streamsize>(contents.size() - 8));
+        output.close();
+        if (!LoadIsRejected(ip_io, filename)) {
+            std::cerr << Logger::Error("A truncated binary integration points file was not rejected.") << std::endl;
+            passed = false;
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        passed = false;
+    }
+
+    std::remove(filename.c_str());
+
+    if (!passed) { return EXIT_FAILURE; }
+    std::cout << Logger::Message("The binary integration points files round trip and corrupted files are rejected.\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,351 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file mass_update_test.cpp
+   \brief Test of the incremental support domain, shape function, compressed neighbor list and mass updates against full computations.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/models/weak_model_3d.hpp"
+#include "CLOUDEA/engine/approximants/mmls_3d.hpp"
+#include "CLOUDEA/engine/mesh/tetramesh.hpp"
+#include "CLOUDEA/engine/elements/node.hpp"
+#include "CLOUDEA/engine/elements/tetrahedron.hpp"
+#include "CLOUDEA/engine/integration/integ_options.hpp"
+#include "CLOUDEA/engine/support_domain/inf_support_domain.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/support_domain/compressed_neighbor_list.hpp"
+#include "CLOUDEA/engine/vectors/vec3.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// Generate a unit cube of cells split in six tetrahedra each.
+void BuildCubeMesh(int cells_num, TetraMesh &tetramesh)
+{
+    int side_num = cells_num + 1;
+    double h = 1. / static_cast<double>(cells_num);
+    std::vector<Node> nodes;
+    for (int k = 0; k != side_num; ++k) {
+        for (int j = 0; j != side_num; ++j) {
+            for (int i = 0; i != side_num; ++i) {
+                Node node;
+                node.SetId(static_cast<int>(nodes.size()));
+                node.SetCoordinates(i*h, j*h, k*h);
+                nodes.emplace_back(node);
+            }
+        }
+    }
+
+    std::vector<Tetrahedron> tetras;
+    auto node_id = [side_num](int i, int j, int k) { return i + side_num*(j + side_num*k); };
+    const std::array<std::array<int, 3>, 6> axes_orders{{ {{0,1,2}}, {{0,2,1}}, {{1,0,2}}, {{1,2,0}}, {{2,0,1}}, {{2,1,0}} }};
+    for (int k = 0; k != cells_num; ++k) {
+        for (int j = 0; j != cells_num; ++j) {
+            for (int i = 0; i != cells_num; ++i) {
+                for (const auto &axes : axes_orders) {
+                    std::array<int, 3> corner{{i, j, k}};
+                    std::array<int, 4> conn;
+                    conn[0] = node_id(corner[0], corner[1], corner[2]);
+                    for (std::size_t a = 0; a != 3; ++a) {
+                        corner[axes[a]]++;
+                        conn[a+1] = node_id(corner[0], corner[1], corner[2]);
+                    }
+                    Tetrahedron tetra;
+                    tetra.SetId(static_cast<int>(tetras.size()));
+                    tetra.SetConnectivity(conn[0], conn[1], conn[2], conn[3]);
+                    tetras.emplace_back(tetra);
+                }
+            }
+        }
+    }
+
+    tetramesh.SetNodes(std::move(nodes));
+    tetramesh.SetElements(std::move(tetras));
+}
+
+
+// Get the centroids of the tetrahedra of a mesh.
+std::vector<Vec3<double> > Centroids(const std::vector<Node> &nodes, const std::vector<Tetrahedron> &tetras)
+{
+    std::vector<Vec3<double> > centroids;
+    centroids.reserve(tetras.size());
+    for (const auto &tetra : tetras) {
+        Vec3<double> centroid(0., 0., 0.);
+        for (int n : {tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()}) {
+            centroid.Set(centroid.X() + 0.25*nodes[n].Coordinates().X(), centroid.Y() + 0.25*nodes[n].Coordinates().Y(),
+                         centroid.Z() + 0.25*nodes[n].Coordinates().Z());
+        }
+        centroids.emplace_back(centroid);
+    }
+    return centroids;
+}
+
+
+// Get the maximum absolute difference of two sparse matrices relative to the maximum absolute value of the reference.
+double RelativeDifference(const Eigen::SparseMatrix<double> &matrix, const Eigen::SparseMatrix<double> &reference)
+{
+    double max_value = Eigen::MatrixXd(reference).cwiseAbs().maxCoeff();
+    return Eigen::MatrixXd(matrix - reference).cwiseAbs().maxCoeff() / max_value;
+}
+
+
+// Compare the incremental update of the influence radiuses, the neighbor lists, the compressed neighbor lists and the
+// shape function columns after a local node move with the full computation on the moved geometry.
+bool SupportUpdateMatchesCompute()
+{
+    const int cells_num = 4;
+    const double dilatation_coeff = 2.;
+    TetraMesh tetramesh;
+    BuildCubeMesh(cells_num, tetramesh);
+    const auto &tetras = tetramesh.Elements();
+
+    // Support domains and shape functions of the tetrahedra centroids before the move.
+    InfSupportDomain support;
+    support.SetInfluenceNodes(tetramesh.Nodes());
+    support.SetInfluenceTetrahedra(tetras);
+    support.ComputeInfluenceNodesRadiuses(dilatation_coeff);
+    auto eval_coords = Centroids(tetramesh.Nodes(), tetras);
+    NeighborList neighbor_ids = support.CellListClosestNodesIdsTo(eval_coords);
+    CompressedNeighborList compressed_ids(neighbor_ids);
+
+    Mmls3d mmls;
+    mmls.SetBasisFunctionType("quadratic");
+    mmls.ComputeShFuncAndDerivs(tetramesh.Nodes(), eval_coords, neighbor_ids, support.InfluenceNodesRadiuses());
+
+    // Move an interior node.
+    const int side_num = cells_num + 1;
+    const int moved_id = 2 + side_num*(1 + side_num*2);
+    tetramesh.EditNodes([&](std::vector<Node> &nodes) {
+        const auto coords = nodes[moved_id].Coordinates();
+        nodes[moved_id].SetCoordinates(coords.X() + 0.04, coords.Y() - 0.05, coords.Z() + 0.03);
+    });
+    eval_coords = Centroids(tetramesh.Nodes(), tetras);
+
+    // Incremental update. The centroids of the tetrahedra of the moved node are updated too.
+    auto modified_ids = support.UpdateInfluenceNodes(tetramesh.Nodes(), tetras, {moved_id}, dilatation_coeff);
+    auto updated_ids = support.AffectedEvalNodesIds(modified_ids, eval_coords, neighbor_ids);
+    for (std::size_t ip = 0; ip != tetras.size(); ++ip) {
+        const auto &tetra = tetras[ip];
+        if (tetra.N1() == moved_id || tetra.N2() == moved_id || tetra.N3() == moved_id || tetra.N4() == moved_id) {
+            updated_ids.emplace_back(static_cast<int>(ip));
+        }
+    }
+    std::sort(updated_ids.begin(), updated_ids.end());
+    updated_ids.erase(std::unique(updated_ids.begin(), updated_ids.end()), updated_ids.end());
+
+    support.UpdateClosestNodesIds(updated_ids, eval_coords, neighbor_ids);
+    compressed_ids.Update(neighbor_ids, updated_ids);
+    mmls.UpdateShFuncAndDerivs(tetramesh.Nodes(), eval_coords, neighbor_ids, support.InfluenceNodesRadiuses(), updated_ids);
+
+    // Full computation on the moved geometry.
+    InfSupportDomain reference;
+    reference.SetInfluenceNodes(tetramesh.Nodes());
+    reference.SetInfluenceTetrahedra(tetras);
+    reference.ComputeInfluenceNodesRadiuses(dilatation_coeff);
+    NeighborList ref_neighbor_ids = reference.CellListClosestNodesIdsTo(eval_coords);
+
+    Mmls3d ref_mmls;
+    ref_mmls.SetBasisFunctionType("quadratic");
+    ref_mmls.ComputeShFuncAndDerivs(tetramesh.Nodes(), eval_coords, ref_neighbor_ids, reference.InfluenceNodesRadiuses());
+
+    if (updated_ids.empty() || updated_ids.size() == tetras.size()) {
+        std::cerr << Logger::Error("The node move should update the support domain of some but not all the evaluation points. Updated: " +
+                                   std::to_string(updated_ids.size())) << std::endl;
+        return false;
+    }
+    if (support.InfluenceNodesRadiuses() != reference.InfluenceNodesRadiuses()) {
+        std::cerr << Logger::Error("The updated influence radiuses differ from the computed influence radiuses.") << std::endl;
+        return false;
+    }
+    if (!(neighbor_ids == ref_neighbor_ids)) {
+        std::cerr << Logger::Error("The updated neighbor lists differ from the computed neighbor lists.") << std::endl;
+        return false;
+    }
+    if (!(compressed_ids.Decompress() == ref_neighbor_ids)) {
+        std::cerr << Logger::Error("The updated compressed neighbor lists differ from the computed neighbor lists.") << std::endl;
+        return false;
+    }
+
+    double max_error = std::max({RelativeDifference(mmls.ShapeFunction(), ref_mmls.ShapeFunction()),
+                                 RelativeDifference(mmls.ShapeFunctionDx(), ref_mmls.ShapeFunctionDx()),
+                                 RelativeDifference(mmls.ShapeFunctionDy(), ref_mmls.ShapeFunctionDy()),
+                                 RelativeDifference(mmls.ShapeFunctionDz(), ref_mmls.ShapeFunctionDz())});
+    if (max_error > 1.e-12) {
+        std::cerr << Logger::Error("The updated shape function columns differ from the computed shape functions. Maximum relative error: " +
+                                   std::to_string(max_error)) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+// Create the grid and the one-point integration of a model with the given mesh.
+void CreateModel(const TetraMesh &tetramesh, WeakModel3D &model)
+{
+    model.TetrahedralMesh().SetNodes(tetramesh.Nodes());
+    model.TetrahedralMesh().SetElements(tetramesh.Elements());
+    model.CreateGridRepresentation();
+
+    IntegOptions options;
+    options.integ_points_per_tetra_ = 1;
+    model.CreateIntegrationPoints(options, InfSupportDomain());
+}
+
+
+// Compare the incremental mass update after changes of the weights, densities, time steps and
+// support domains of some integration points with the full mass computation.
+bool UpdateMatchesCompute(bool scaling)
+{
+    const int cells_num = 3;
+    TetraMesh tetramesh;
+    BuildCubeMesh(cells_num, tetramesh);
+
+    WeakModel3D model;
+    CreateModel(tetramesh, model);
+    const auto points_num = static_cast<std::size_t>(model.IntegrationPoints().PointsNum());
+
+    // The support domain of each integration point is the nodes of its tetrahedron.
+    NeighborList support_ids;
+    for (const auto &tetra : tetramesh.Elements()) {
+        std::vector<int> conn{tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()};
+        support_ids.Append(conn.begin(), conn.end());
+    }
+
+    std::mt19937 generator(scaling ? 2 : 1);
+    std::uniform_real_distribution<double> density_dist(900., 1100.);
+    std::uniform_real_distribution<double> step_dist(0.2, 0.8);
+    std::vector<double> density(points_num), time_steps(points_num);
+    for (auto &d : density) { d = density_dist(generator); }
+    for (auto &dt : time_steps) { dt = step_dist(generator); }
+    const double max_time_step = 1.;
+
+    model.ComputeMass(density, time_steps, max_time_step, support_ids, scaling);
+    const auto prev_weights_all = model.IntegrationPoints().Weights();
+
+    // Move an interior node. The weights of the integration points of its tetrahedra change.
+    const int side_num = cells_num + 1;
+    const int moved_id = 1 + side_num*(1 + side_num);
+    tetramesh.EditNodes([&](std::vector<Node> &nodes) {
+        const auto coords = nodes[moved_id].Coordinates();
+        nodes[moved_id].SetCoordinates(coords.X() + 0.05, coords.Y() - 0.03, coords.Z() + 0.02);
+    });
+    model.TetrahedralMesh().SetNodes(tetramesh.Nodes());
+    model.CreateGridRepresentation();
+    IntegOptions options;
+    options.integ_points_per_tetra_ = 1;
+    model.CreateIntegrationPoints(options, InfSupportDomain());
+
+    // Updated points: the tetrahedra of the moved node and every fifth point, which gets a new density,
+    // time step and an extra support node.
+    std::vector<int> updated_ids;
+    std::vector<double> prev_density, prev_weights, prev_time_steps;
+    NeighborList prev_support_ids;
+    std::vector<double> new_density = density, new_time_steps = time_steps;
+    NeighborList new_support_ids;
+    for (std::size_t ip = 0; ip != points_num; ++ip) {
+        const auto &tetra = tetramesh.Elements()[ip];
+        std::vector<int> conn{tetra.N1(), tetra.N2(), tetra.N3(), tetra.N4()};
+        bool is_moved = std::find(conn.begin(), conn.end(), moved_id) != conn.end();
+        bool is_changed = (ip % 5 == 0);
+
+        if (is_changed) {
+            new_density[ip] *= 1.2;
+            new_time_steps[ip] *= 0.9;
+            int extra_id = (conn[0] == 0) ? moved_id : 0;
+            if (std::find(conn.begin(), conn.end(), extra_id) == conn.end()) { conn.emplace_back(extra_id); }
+        }
+        new_support_ids.Append(conn.begin(), conn.end());
+
+        if (is_moved || is_changed) {
+            updated_ids.emplace_back(static_cast<int>(ip));
+            prev_density.emplace_back(density[ip]);
+            prev_weights.emplace_back(prev_weights_all[ip]);
+            prev_time_steps.emplace_back(time_steps[ip]);
+            prev_support_ids.Append(support_ids[ip]);
+        }
+    }
+
+    model.UpdateMass(new_density, prev_density, prev_weights, prev_time_steps, prev_support_ids,
+                     new_time_steps, max_time_step, new_support_ids, updated_ids);
+
+    // Full mass computation of the modified model.
+    WeakModel3D reference;
+    CreateModel(tetramesh, reference);
+    reference.ComputeMass(new_density, new_time_steps, max_time_step, new_support_ids, scaling);
+
+    const auto &mass = model.Mass();
+    const auto &ref_mass = reference.Mass();
+    if (mass.size() != ref_mass.size()) {
+        std::cerr << Logger::Error("The updated mass has a different size than the computed mass.") << std::endl;
+        return false;
+    }
+
+    double max_mass = 0., max_error = 0.;
+    for (std::size_t i = 0; i != mass.size(); ++i) {
+        max_mass = std::max(max_mass, std::abs(ref_mass[i]));
+        max_error = std::max(max_error, std::abs(mass[i] - ref_mass[i]));
+    }
+    double matrix_error = (model.MassMatrix() - reference.MassMatrix()).cwiseAbs().maxCoeff();
+    if (max_error > 1.e-12*max_mass || matrix_error > 1.e-12*max_mass) {
+        std::cerr << Logger::Error("The updated mass differs from the computed mass" + std::string(scaling ? " with" : " without") +
+                                   " mass scaling. Maximum error: " + std::to_string(max_error)) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    try {
+        bool passed = SupportUpdateMatchesCompute();
+        passed = UpdateMatchesCompute(false) && passed;
+        passed = UpdateMatchesCompute(true) && passed;
+
+        if (!passed) { return EXIT_FAILURE; }
+        std::cout << Logger::Message("The incremental support domain, shape function and mass updates match the full computations.\n");
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
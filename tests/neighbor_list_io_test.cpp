@@ -0,0 +1,153 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*!
+   \file neighbor_list_io_test.cpp
+   \brief Test of the round trip of the binary neighbor list files and of the rejection of stale files.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/support_domain/neighbor_list.hpp"
+#include "CLOUDEA/engine/support_domain/neighbor_list_io.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// Check that loading a file with the given key is rejected.
+bool LoadIsRejected(const NeighborListIO &nbl_io, const std::string &filename, const NeighborListKey &key)
+{
+    try {
+        nbl_io.Load(filename, key);
+    }
+    catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+
+int main()
+{
+    const std::string filename = "neighbor_list_io_test.nbl";
+    bool passed = true;
+
+    try {
+        // Random neighbor lists of varying size, with unsorted indices in some lists.
+        const std::size_t points_num = 3000, nodes_num = 900;
+        std::mt19937 generator(1);
+        std::uniform_int_distribution<int> node(0, static_cast<int>(nodes_num)-1);
+        std::uniform_int_distribution<int> list_size(0, 40);
+        NeighborList neighbor_ids;
+        std::vector<int> ids;
+        for (std::size_t i = 0; i != points_num; ++i) {
+            ids.resize(static_cast<std::size_t>(list_size(generator)));
+            for (auto &id : ids) { id = node(generator); }
+            neighbor_ids.Append(ids.begin(), ids.end());
+        }
+
+        NeighborListKey key;
+        key.mesh_hash = 0x1234abcd5678ef90ULL;
+        key.nodes_num = nodes_num;
+        key.points_num = points_num;
+        key.points_hash = 0x0fedcba987654321ULL;
+        key.dilatation_coeff = 1.;
+        key.radius_mode = SupportRadiusMode::target_count;
+        key.min_neighs_num = 12;
+        key.max_neighs_num = 40;
+        key.support_margin = 1.25;
+
+        NeighborListIO nbl_io;
+        for (bool compress : {false, true}) {
+            const std::string storage = compress ? "compressed" : "uncompressed";
+
+            // Round trip. The neighbor lists must be restored exactly.
+            nbl_io.Save(filename, neighbor_ids, key, compress);
+            if (!(nbl_io.Load(filename, key) == neighbor_ids)) {
+                std::cerr << Logger::Error("The " + storage + " binary neighbor list round trip did not restore the neighbor lists.") << std::endl;
+                passed = false;
+            }
+
+            // Files computed for a different mesh, evaluation points or influence radiuses must be rejected.
+            std::vector<std::pair<std::string, NeighborListKey> > stale_keys(9, std::make_pair(std::string(""), key));
+            stale_keys[0].first = "mesh hash";
+            stale_keys[0].second.mesh_hash ^= 1;
+            stale_keys[1].first = "nodes number";
+            stale_keys[1].second.nodes_num += 1;
+            stale_keys[2].first = "points number";
+            stale_keys[2].second.points_num -= 1;
+            stale_keys[3].first = "points hash";
+            stale_keys[3].second.points_hash ^= 1;
+            stale_keys[4].first = "dilatation coefficient";
+            stale_keys[4].second.dilatation_coeff = 1.7;
+            stale_keys[5].first = "influence radiuses mode";
+            stale_keys[5].second.radius_mode = SupportRadiusMode::dilatation;
+            stale_keys[6].first = "minimum support nodes number";
+            stale_keys[6].second.min_neighs_num = 10;
+            stale_keys[7].first = "maximum support nodes number";
+            stale_keys[7].second.max_neighs_num = 0;
+            stale_keys[8].first = "support margin";
+            stale_keys[8].second.support_margin = 1.5;
+            for (const auto &stale : stale_keys) {
+                if (!LoadIsRejected(nbl_io, filename, stale.second)) {
+                    std::cerr << Logger::Error("A " + storage + " binary neighbor list file with a different " + stale.first +
+                                               " was not rejected.") << std::endl;
+                    passed = false;
+                }
+            }
+
+            // Files with indices outside the influence nodes must be rejected.
+            std::size_t invalid_list = points_num/2;
+            while (neighbor_ids.ListSize(invalid_list) == 0) { invalid_list++; }
+            for (int invalid_id : {static_cast<int>(nodes_num), -1}) {
+                NeighborList invalid_ids = neighbor_ids;
+                invalid_ids.Data(invalid_list)[0] = invalid_id;
+                nbl_io.Save(filename, invalid_ids, key, compress);
+                if (!LoadIsRejected(nbl_io, filename, key)) {
+                    std::cerr << Logger::Error("A " + storage + " binary neighbor list file with the index " + std::to_string(invalid_id) +
+                                               " was not rejected.") << std::endl;
+                    passed = false;
+                }
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        passed = false;
+    }
+
+    std::remove(filename.c_str());
+
+    if (!passed) { return EXIT_FAILURE; }
+    std::cout << Logger::Message("The binary neighbor list files round trip and stale files are rejected.\n");
+    return EXIT_SUCCESS;
+}
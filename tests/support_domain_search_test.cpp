@@ -0,0 +1,126 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/*!
+   \file support_domain_search_test.cpp
+   \brief Test of the 2D and 3D kd-tree and cell list support nodes searches of SupportDomain against the exhaustive search.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/support_domain/support_domain.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <IMP/Vectors>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace CLOUDEA;
+
+
+// Support domain exposing the searches of the support nodes.
+template<short DIM>
+class TestSupportDomain : public SupportDomain<DIM> {
+public:
+    using SupportDomain<DIM>::ExhaustiveInfluenceNodesSearch;
+    using SupportDomain<DIM>::FastInfluenceNodesSearch_2d;
+    using SupportDomain<DIM>::FastInfluenceNodesSearch_3d;
+    using SupportDomain<DIM>::CellListInfluenceNodesSearch;
+};
+
+
+// Random points in the unit box.
+template<short DIM>
+std::vector<IMP::Vec<DIM, double>> RandomPoints(std::size_t points_num, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<double> coord(0., 1.);
+    std::vector<IMP::Vec<DIM, double>> points(points_num);
+    for (auto &point : points) {
+        for (short d = 0; d != DIM; ++d) { point[d] = coord(generator); }
+    }
+    return points;
+}
+
+
+// Compare the kd-tree and cell list searches with the exhaustive search for several threads numbers.
+template<short DIM>
+bool SearchesMatchExhaustive(std::size_t field_nodes_num, std::size_t points_num, double radius)
+{
+    std::mt19937 generator(DIM);
+    auto field_nodes = RandomPoints<DIM>(field_nodes_num, generator);
+    auto points = RandomPoints<DIM>(points_num, generator);
+
+    TestSupportDomain<DIM> support;
+    support.SetFieldNodesNum(static_cast<int>(field_nodes.size()));
+    support.SetRadius(radius);
+    support.SetDilateCoeff(1.5);
+
+    support.ExhaustiveInfluenceNodesSearch(points, field_nodes);
+    const NeighborList exhaustive_ids = support.InfluenceNodeIds();
+    if (exhaustive_ids.ListsNum() != points.size() || exhaustive_ids.MinListSize() == 0) {
+        std::cerr << Logger::Error("The exhaustive search did not find support nodes for every point in " +
+                                   std::to_string(DIM) + "D.") << std::endl;
+        return false;
+    }
+
+    for (std::size_t threads : {1, 3, 8}) {
+        support.SetThreadsNumber(threads);
+
+        if (DIM == 2) { support.FastInfluenceNodesSearch_2d(points, field_nodes); }
+        else { support.FastInfluenceNodesSearch_3d(points, field_nodes); }
+        if (!(support.InfluenceNodeIds() == exhaustive_ids)) {
+            std::cerr << Logger::Error("The " + std::to_string(DIM) + "D kd-tree search with " + std::to_string(threads) +
+                                       " threads differs from the exhaustive search.") << std::endl;
+            return false;
+        }
+
+        support.CellListInfluenceNodesSearch(points, field_nodes);
+        if (!(support.InfluenceNodeIds() == exhaustive_ids)) {
+            std::cerr << Logger::Error("The " + std::to_string(DIM) + "D cell list search with " + std::to_string(threads) +
+                                       " threads differs from the exhaustive search.") << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    try {
+        bool passed = SearchesMatchExhaustive<2>(400, 300, 0.08);
+        passed = SearchesMatchExhaustive<3>(1000, 500, 0.15) && passed;
+
+        if (!passed) { return EXIT_FAILURE; }
+        std::cout << Logger::Message("Support domain searches match the exhaustive search.\n");
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
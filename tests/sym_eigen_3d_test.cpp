@@ -0,0 +1,125 @@
+/*
+ * CLOUDEA - Software for solving PDEs using explicit methods.
+ * Copyright (C) 2017  <Konstantinos A. Mountris> <konstantinos.mountris@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*!
+   \file sym_eigen_3d_test.cpp
+   \brief Test of the closed-form eigen decomposition of SymEigen3d against the iterative Eigen solver.
+   \author Konstantinos A. Mountris
+   \date 19/10/2026
+*/
+
+#include "CLOUDEA/engine/materials/sym_eigen_3d.hpp"
+#include "CLOUDEA/engine/utilities/logger.hpp"
+
+#include <Eigen/Dense>
+#include <Eigen/Eigenvalues>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+
+
+using namespace CLOUDEA;
+
+
+// Random symmetric matrix with the given eigenvalues and random orthonormal eigenvectors.
+Eigen::Matrix3d SpectrumMatrix(const Eigen::Vector3d &eigenvalues, std::mt19937 &generator)
+{
+    std::normal_distribution<double> value(0., 1.);
+    Eigen::Matrix3d random;
+    for (Eigen::Index i = 0; i != 9; ++i) { random(i) = value(generator); }
+    Eigen::Matrix3d rotation = Eigen::HouseholderQR<Eigen::Matrix3d>(random).householderQ();
+    return rotation * eigenvalues.asDiagonal() * rotation.transpose();
+}
+
+
+// Compare SymEigen3d with SelfAdjointEigenSolver for matrices with eigenvalues generated by the given function.
+// The eigenvalues must match and the eigenvectors must be orthonormal and reconstruct the matrix.
+template <typename SPECTRUM_FUNC>
+bool DecompositionMatches(const std::string &spectrum, SPECTRUM_FUNC &&spectrum_func, double tolerance)
+{
+    std::mt19937 generator(7);
+    double max_values_error = 0., max_vectors_error = 0.;
+    for (int sample = 0; sample != 2000; ++sample) {
+        Eigen::Matrix3d mat = SpectrumMatrix(spectrum_func(generator), generator);
+        mat = 0.5*(mat + mat.transpose());
+        const double scale = mat.cwiseAbs().maxCoeff();
+
+        SymEigen3d sym_eigen;
+        sym_eigen.Compute(mat);
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> reference(mat);
+
+        const auto &values = sym_eigen.Eigenvalues();
+        const auto &vectors = sym_eigen.Eigenvectors();
+        double values_error = (values - reference.eigenvalues()).cwiseAbs().maxCoeff() / scale;
+        double reconstruction_error = (vectors * values.asDiagonal() * vectors.transpose() - mat).cwiseAbs().maxCoeff() / scale;
+        double orthonormality_error = (vectors.transpose() * vectors - Eigen::Matrix3d::Identity()).cwiseAbs().maxCoeff();
+        max_values_error = std::max(max_values_error, values_error);
+        max_vectors_error = std::max({max_vectors_error, reconstruction_error, orthonormality_error});
+    }
+
+    if (max_values_error > tolerance || max_vectors_error > tolerance) {
+        std::cerr << Logger::Error("The SymEigen3d decomposition of matrices with " + spectrum + " differs from SelfAdjointEigenSolver."
+                                   " Maximum eigenvalues error: " + std::to_string(max_values_error) +
+                                   " / eigenvectors error: " + std::to_string(max_vectors_error)) << std::endl;
+        return false;
+    }
+    std::cout << Logger::Message("SymEigen3d matches SelfAdjointEigenSolver for matrices with ") << spectrum
+              << " - maximum eigenvalues error: " << max_values_error << " / eigenvectors error: " << max_vectors_error << "\n";
+    return true;
+}
+
+
+int main()
+{
+    try {
+        std::uniform_real_distribution<double> value(-1., 1.);
+        std::uniform_real_distribution<double> stretch(0.2, 3.);
+
+        // Random spectra.
+        bool passed = DecompositionMatches("random spectra", [&](std::mt19937 &generator) {
+            return Eigen::Vector3d(value(generator), value(generator), value(generator));
+        }, 1.e-12);
+
+        // Spectra of stretch tensors with two eigenvalues 1e-9 apart. The closed-form decomposition loses accuracy
+        // of the order of the eigenvalues gap.
+        passed = DecompositionMatches("near-repeated spectra", [&](std::mt19937 &generator) {
+            double lambda = stretch(generator);
+            return Eigen::Vector3d(lambda, lambda + 1.e-9, stretch(generator));
+        }, 1.e-8) && passed;
+
+        // Spectra with two and three exactly repeated eigenvalues.
+        passed = DecompositionMatches("exactly repeated spectra", [&](std::mt19937 &generator) {
+            double lambda = stretch(generator);
+            return Eigen::Vector3d(lambda, lambda, (generator() % 2) ? lambda : stretch(generator));
+        }, 1.e-12) && passed;
+
+        if (!passed) { return EXIT_FAILURE; }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}